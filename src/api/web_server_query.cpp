@@ -35,7 +35,8 @@ namespace bumo {
 		Json::Value record = Json::Value(Json::arrayValue);
 		Json::Value &result = reply_json["result"];
 
-		if (!Environment::AccountFromDB(address, acc)) {
+		StateView::pointer view = LedgerManager::Instance().GetStateView();
+		if (view == nullptr || !view->GetAccount(address, acc)) {
 			error_code = protocol::ERRCODE_NOT_EXIST;
 			LOG_TRACE("Failed to get account, account(%s) not exist", address.c_str());
 		}
@@ -68,9 +69,8 @@ namespace bumo {
 		Json::Value record = Json::Value(Json::arrayValue);
 		Json::Value &result = reply_json["result"];
 
-		utils::ReadLockGuard guard(Storage::Instance().account_ledger_lock_);
-
-		if (!Environment::AccountFromDB(address, acc)) {
+		StateView::pointer view = LedgerManager::Instance().GetStateView();
+		if (view == nullptr || !view->GetAccount(address, acc)) {
 			error_code = protocol::ERRCODE_NOT_EXIST;
 			LOG_TRACE("Failed to get account, account(%s) not exist", address.c_str());
 		}
@@ -135,9 +135,8 @@ namespace bumo {
 		Json::Value record = Json::Value(Json::arrayValue);
 		Json::Value &result = reply_json["result"];
 
-		utils::ReadLockGuard guard(Storage::Instance().account_ledger_lock_);
-
-		if (!Environment::AccountFromDB(address, acc)) {
+		StateView::pointer view = LedgerManager::Instance().GetStateView();
+		if (view == nullptr || !view->GetAccount(address, acc)) {
 			error_code = protocol::ERRCODE_NOT_EXIST;
 			LOG_TRACE("Failed to get account, account(%s) not exist", address.c_str());
 		}
@@ -193,9 +192,8 @@ namespace bumo {
 		Json::Value record = Json::Value(Json::arrayValue);
 		Json::Value &result = reply_json["result"];
 
-		utils::ReadLockGuard guard(Storage::Instance().account_ledger_lock_);
-
-		if (!Environment::AccountFromDB(address, acc)) {
+		StateView::pointer view = LedgerManager::Instance().GetStateView();
+		if (view == nullptr || !view->GetAccount(address, acc)) {
 			error_code = protocol::ERRCODE_NOT_EXIST;
 			LOG_TRACE("Failed to get account, account(%s) not exist", address.c_str());
 		}
@@ -309,7 +307,6 @@ namespace bumo {
 
 	void WebServer::GetTransactionHistory(const http::server::request &request, std::string &reply) {
 		WebServerConfigure &web_config = Configure::Instance().webserver_configure_;
-		bumo::KeyValueDb *db = bumo::Storage::Instance().ledger_db();
 
 		std::string seq = request.GetParamValue("ledger_seq");
 		std::string hash = request.GetParamValue("hash");
@@ -331,11 +328,15 @@ namespace bumo {
 		result["total_count"] = 0;
 
 		do {
-			utils::ReadLockGuard guard(Storage::Instance().account_ledger_lock_);
+			StateView::pointer view = LedgerManager::Instance().GetStateView();
+			if (view == nullptr) {
+				error_code = protocol::ERRCODE_NOT_EXIST;
+				break;
+			}
+			bumo::KeyValueDb *db = view->ledger_db();
 
 			protocol::EntryList list;
 			//Use block height (seq) or transaction hash to search for transaction(s).
-			protocol::LedgerHeader header = LedgerManager::Instance().GetLastClosedLedger();
 			if (!seq.empty()) {
 				std::string hashlist;
 				if (db->Get(ComposePrefix(General::LEDGER_TRANSACTION_PREFIX, seq), hashlist) <= 0) {
@@ -377,7 +378,7 @@ namespace bumo {
 				i < start_int + limit_int;
 			i++) {
 				TransactionFrm txfrm;
-				if (txfrm.LoadFromDb(list.entry(i)) > 0) {
+				if (txfrm.LoadFromDb(list.entry(i), db) > 0) {
 					result["total_count"] = 0;
 					error_code = protocol::ERRCODE_NOT_EXIST;
 					break;
@@ -531,7 +532,7 @@ namespace bumo {
 		Json::Value reply_json = Json::Value(Json::objectValue);
 		Json::Value &result = reply_json["result"];
 
-		const protocol::LedgerHeader &ledger = LedgerManager::Instance().GetLastClosedLedger();
+		const protocol::LedgerHeader &ledger = LedgerManager::Instance().GetWrittenLedger();
 		result["transaction_count"] = ledger.tx_count();
 		result["account_count"] = LedgerManager::Instance().GetAccountNum();
 
@@ -561,7 +562,7 @@ namespace bumo {
 
 		std::string ledger_seq = request.GetParamValue("seq");
 		if (ledger_seq.empty())
-			ledger_seq = utils::String::ToString(LedgerManager::Instance().GetLastClosedLedger().seq());
+			ledger_seq = utils::String::ToString(LedgerManager::Instance().GetWrittenLedger().seq());
 
 		protocol::ValidatorSet set;
 		if (!LedgerManager::Instance().GetValidators(utils::String::Stoi64(ledger_seq), set)) {
@@ -583,9 +584,10 @@ namespace bumo {
 		std::string with_block_reward = request.GetParamValue("with_block_reward");
 
 
-		/// By default query the last closed ledger
+		/// By default query the last closed ledger, the ledgers not yet durable are not shown
+		int64_t written_seq = LedgerManager::Instance().GetWrittenLedger().seq();
 		if (ledger_seq.empty())
-			ledger_seq = utils::String::ToString(LedgerManager::Instance().GetLastClosedLedger().seq());
+			ledger_seq = utils::String::ToString(written_seq);
 
 
 		int32_t error_code = protocol::ERRCODE_SUCCESS;
@@ -597,7 +599,7 @@ namespace bumo {
 		do {
 			utils::ReadLockGuard guard(Storage::Instance().account_ledger_lock_);
 			int64_t seq = utils::String::Stoi64(ledger_seq);
-			if (!frm.LoadFromDb(seq)) {
+			if (seq > written_seq || !frm.LoadFromDb(seq)) {
 				error_code = protocol::ERRCODE_NOT_EXIST;
 				break;
 			}
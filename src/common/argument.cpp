@@ -499,8 +499,10 @@ namespace bumo {
 				int64_t int_ledger_db_seq = utils::String::Stoi64(ledger_db_seq);
 				int64_t int_account_db_seq = utils::String::Stoi64(account_db_seq);
 				
-				if (int_account_db_seq != int_ledger_db_seq - 1) {
-					printf("Error, ledger seq (%s) from ledger-db not equal with seq (%s) + 1 from account-db\n",
+				//With db.async_commit the storage writer syncs the ledger db before the account db,
+				//so a crash may leave up to a queue of ledgers in the ledger db only, not just the last one.
+				if (int_account_db_seq >= int_ledger_db_seq) {
+					printf("Error, ledger seq (%s) from ledger-db is not greater than seq (%s) from account-db\n",
 						ledger_db_seq.c_str(), account_db_seq.c_str());
 					return true;
 				}
@@ -514,8 +516,8 @@ namespace bumo {
 					return true;
 				}
 
-				if (!ledger_db->Put(General::KEY_LEDGER_SEQ, account_db_seq)) {
-					printf("Failed to get ledger seq from account-db\n");
+				if (!StorageWriter::Rewind(ledger_db, int_ledger_db_seq, int_account_db_seq)) {
+					printf("Failed to rewind ledger-db, %s\n", ledger_db->error_desc().c_str());
 					return true;
 				}
 
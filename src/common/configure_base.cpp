@@ -19,6 +19,61 @@
 #include "configure_base.h"
 
 namespace bumo {
+	DbTuneConfigure::DbTuneConfigure() {
+		bloom_bits_per_key_ = 10;
+		write_buffer_size_ = 64 * utils::BYTES_PER_MEGA;
+		compaction_style_ = "level";
+		column_families_ = false;
+	}
+
+	DbTuneConfigure::~DbTuneConfigure() {}
+
+	bool DbTuneConfigure::Load(const Json::Value &value) {
+		ConfigureBase::GetValue(value, "bloom_bits_per_key", bloom_bits_per_key_);
+		if (value.isMember("compression")) {
+			compression_.clear();
+			ConfigureBase::GetValue(value, "compression", compression_);
+		}
+		if (value.isMember("write_buffer_size")) {
+			ConfigureBase::GetValue(value, "write_buffer_size", write_buffer_size_);
+			write_buffer_size_ *= utils::BYTES_PER_MEGA;
+		}
+		ConfigureBase::GetValue(value, "compaction_style", compaction_style_);
+		ConfigureBase::GetValue(value, "column_families", column_families_);
+		if (value.isMember("column_family_options")) {
+			column_family_options_ = value["column_family_options"];
+		}
+
+		for (utils::StringList::const_iterator iter = compression_.begin(); iter != compression_.end(); iter++) {
+			const std::string &type = *iter;
+			if (type != "none" && type != "snappy" && type != "zlib" && type != "bzip2" && type != "lz4" && type != "lz4hc") {
+				LOG_STD_ERR("Unknown db compression(%s)", type.c_str());
+				return false;
+			}
+		}
+
+		if (compaction_style_ != "level" && compaction_style_ != "universal" && compaction_style_ != "fifo") {
+			LOG_STD_ERR("Unknown db compaction style(%s)", compaction_style_.c_str());
+			return false;
+		}
+
+		//The options of every column family are checked here, they are only applied when the db is opened.
+		if (!column_family_options_.isNull() && !column_family_options_.isObject()) {
+			LOG_STD_ERR("The db column_family_options must be an object");
+			return false;
+		}
+		Json::Value::Members families = column_family_options_.getMemberNames();
+		for (size_t i = 0; i < families.size(); i++) {
+			DbTuneConfigure family = *this;
+			family.column_family_options_ = Json::Value(Json::objectValue);
+			if (!column_family_options_[families[i]].isObject() || !family.Load(column_family_options_[families[i]])) {
+				LOG_STD_ERR("Failed to load the options of db column family(%s)", families[i].c_str());
+				return false;
+			}
+		}
+		return true;
+	}
+
 	DbConfigure::DbConfigure() {
 		keyvalue_db_path_ = General::DEFAULT_KEYVALUE_DB_PATH;
 		ledger_db_path_ = General::DEFAULT_LEDGER_DB_PATH;
@@ -26,6 +81,12 @@ namespace bumo {
 		tmp_path_ = "tmp";
 		async_write_sql_ = false; //default sync write sql
 		async_write_kv_ = false; //default sync write kv
+		async_commit_ = false;
+		block_cache_size_ = 128 * utils::BYTES_PER_MEGA;
+
+		//Small and rarely written
+		keyvalue_tune_.write_buffer_size_ = 4 * utils::BYTES_PER_MEGA;
+		account_tune_.column_families_ = true;
 	}
 
 	DbConfigure::~DbConfigure() {}
@@ -40,6 +101,17 @@ namespace bumo {
 		ConfigureBase::GetValue(value, "tmp_path", tmp_path_);
 		ConfigureBase::GetValue(value, "async_write_sql", async_write_sql_);
 		ConfigureBase::GetValue(value, "async_write_kv", async_write_kv_);
+		ConfigureBase::GetValue(value, "async_commit", async_commit_);
+
+		if (value.isMember("block_cache_size")) {
+			ConfigureBase::GetValue(value, "block_cache_size", block_cache_size_);
+			block_cache_size_ *= utils::BYTES_PER_MEGA;
+		}
+		if (!keyvalue_tune_.Load(value["keyvalue_options"]) ||
+			!ledger_tune_.Load(value["ledger_options"]) ||
+			!account_tune_.Load(value["account_options"])) {
+			return false;
+		}
 
 
 		std::string rational_decode;
@@ -40,6 +40,21 @@ namespace bumo {
 		bool Load(const Json::Value &value);
 	};
 
+	//RocksDB tuning of one database, or of one of its column families.
+	class DbTuneConfigure {
+	public:
+		DbTuneConfigure();
+		~DbTuneConfigure();
+
+		int32_t bloom_bits_per_key_; //0 : no bloom filter
+		utils::StringList compression_; //Per level: none, snappy, zlib, bzip2, lz4 or lz4hc. Empty for the default.
+		int64_t write_buffer_size_; //Byte
+		std::string compaction_style_; //level, universal or fifo
+		bool column_families_; //Split the account tree nodes, leaves, assets and metadata when the database is created
+		Json::Value column_family_options_; //Overrides of the settings above, keyed by the column family name
+		bool Load(const Json::Value &value);
+	};
+
 	class DbConfigure {
 	public:
 		DbConfigure();
@@ -53,6 +68,11 @@ namespace bumo {
 		std::string tmp_path_;
 		bool async_write_sql_;
 		bool async_write_kv_;
+		bool async_commit_; //Write the closed ledgers in the background storage writer
+		int64_t block_cache_size_; //Byte, shared by all the databases
+		DbTuneConfigure keyvalue_tune_;
+		DbTuneConfigure ledger_tune_;
+		DbTuneConfigure account_tune_;
 		bool Load(const Json::Value &value);
 	};
 
@@ -30,7 +30,15 @@ namespace bumo {
 	*/
 	const uint32_t General::LEDGER_VERSION_HISTORY_1000 = 1000;
 	const uint32_t General::LEDGER_VERSION_HISTORY_1001 = 1001;
-	const uint32_t General::LEDGER_VERSION = 1002;
+	/*
+		Based on ledger 1002, the following changes have been modified.
+		1.The contracts run in isolates leased from a pool, their memory does not count the context and the compilation.
+		2.The compiled code of the contracts is cached.
+		3.The contexts of the contracts are created from a startup snapshot.
+		4.A fee vote of an unknown fee type fails.
+	*/
+	const uint32_t General::LEDGER_VERSION_HISTORY_1002 = 1002;
+	const uint32_t General::LEDGER_VERSION = 1003;
 	const uint32_t General::LEDGER_MIN_VERSION = 1000;
 	const uint32_t General::MONITOR_VERSION = 1000;
 	const char *General::BUMO_VERSION = "1.2.0";
@@ -66,6 +74,8 @@ namespace bumo {
 
 	const char *General::STATISTICS = "statistics";
 	const char *General::KEY_LEDGER_SEQ = "max_seq";
+	const char *General::KEY_PRUNED_SEQ = "pruned_seq";
+	const char *General::KEY_STATE_SYNC = "state_sync";
 	const char *General::KEY_GENE_ACCOUNT = "genesis_account";
 	const char *General::VALIDATORS = "validators";
 	const char *General::PEERS_TABLE = "peers_table";
@@ -78,6 +88,8 @@ namespace bumo {
 	const char *General::TRANSACTION_PREFIX = "tx";
 	const char *General::LEDGER_TRANSACTION_PREFIX = "lgtx";
 	const char *General::CONSENSUS_VALUE_PREFIX = "cosv";
+	const char *General::CODE_CACHE_PREFIX = "code_cache";
+	const char *General::STATE_NODE_PREFIX = "sync_node";
 
 	const char *General::ACCOUNT_PREFIX = "acc";
 	const char *General::ASSET_PREFIX = "ast";
@@ -124,6 +136,10 @@ namespace bumo {
 		return contract_result_;
 	}
 
+	Json::Value *Result::mutable_contract_result() {
+		return &contract_result_;
+	}
+
 	void Result::set_code(int32_t code){
 		code_ = code;
 	}
@@ -29,6 +29,7 @@ namespace bumo {
 		const static uint32_t OVERLAY_MIN_VERSION;
 		const static uint32_t LEDGER_VERSION_HISTORY_1000;
 		const static uint32_t LEDGER_VERSION_HISTORY_1001;
+		const static uint32_t LEDGER_VERSION_HISTORY_1002;
 		const static uint32_t LEDGER_VERSION;
 		const static uint32_t LEDGER_MIN_VERSION;
 		const static uint32_t MONITOR_VERSION;
@@ -79,6 +80,8 @@ namespace bumo {
 		const static char *TRANSACTION_PREFIX;
 		const static char *LEDGER_TRANSACTION_PREFIX;
 		const static char *CONSENSUS_VALUE_PREFIX;
+		const static char *CODE_CACHE_PREFIX;
+		const static char *STATE_NODE_PREFIX;
 		const static char *PEERS_TABLE;
 		const static char *LAST_TX_HASHS;
 		const static char *LAST_PROOF;
@@ -86,6 +89,8 @@ namespace bumo {
 		const static int ACCOUNT_LENGTH_MAX = 40;
 
 		const static char *KEY_LEDGER_SEQ;
+		const static char *KEY_PRUNED_SEQ;
+		const static char *KEY_STATE_SYNC;
 		const static char *KEY_GENE_ACCOUNT;
 		const static char *VALIDATORS;
 
@@ -148,6 +153,7 @@ namespace bumo {
 		int32_t code() const;
 		std::string desc() const;
 		const Json::Value &contract_result() const;
+		Json::Value *mutable_contract_result();
 
 		void set_code(int32_t code);
 		void set_desc(const std::string desc);
@@ -298,6 +304,7 @@ namespace bumo {
 
 #define CHECK_VERSION_GT_1000 (LedgerManager::Instance().GetLastClosedLedger().version() > General::LEDGER_VERSION_HISTORY_1000)
 #define CHECK_VERSION_GT_1001 (LedgerManager::Instance().GetLastClosedLedger().version() > General::LEDGER_VERSION_HISTORY_1001)
+#define CHECK_VERSION_GT_1002 (LedgerManager::Instance().GetLastClosedLedger().version() > General::LEDGER_VERSION_HISTORY_1002)
 }
 
 #endif
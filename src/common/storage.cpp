@@ -17,8 +17,14 @@
 #include <utils/strings.h>
 #include <utils/logger.h>
 #include <utils/file.h>
+#include <utils/timestamp.h>
+#include <proto/cpp/overlay.pb.h>
 #include "storage.h"
 #include "general.h"
+#ifndef WIN32
+#include <rocksdb/table.h>
+#include <rocksdb/filter_policy.h>
+#endif
 #define BUMO_ROCKSDB_MAX_OPEN_FILES 5000
 
 namespace bumo {
@@ -26,6 +32,89 @@ namespace bumo {
 
 	KeyValueDb::~KeyValueDb() {}
 
+	class KeyValueDb::PendingHandler : public WRITE_BATCH::Handler {
+	public:
+		PendingHandler(KeyValueDb *db, int64_t job, bool add) : db_(db), job_(job), add_(add) {}
+
+		virtual void Put(const SLICE &key, const SLICE &value) {
+			Update(key.ToString(), value.ToString(), false);
+		}
+
+		virtual void Delete(const SLICE &key) {
+			Update(key.ToString(), "", true);
+		}
+
+	private:
+		void Update(const std::string &key, const std::string &value, bool deleted) {
+			if (add_) {
+				PendingValue &pending = db_->pending_[key];
+				pending.value_ = value;
+				pending.deleted_ = deleted;
+				pending.job_ = job_;
+				return;
+			}
+
+			std::unordered_map<std::string, PendingValue>::iterator iter = db_->pending_.find(key);
+			if (iter != db_->pending_.end() && iter->second.job_ == job_) {
+				db_->pending_.erase(iter);
+			}
+		}
+
+		KeyValueDb *db_;
+		int64_t job_;
+		bool add_;
+	};
+
+	KeyValueDb *KeyValueDb::NewSnapshot() {
+		return NULL;
+	}
+
+	bool KeyValueDb::CompactRange(const std::string &, const std::string &) {
+		return true;
+	}
+
+	int32_t KeyValueDb::GetPending(const std::string &key, std::string &value) {
+		utils::MutexGuard guard(pending_mutex_);
+		if (pending_.empty()) {
+			return -1;
+		}
+
+		std::unordered_map<std::string, PendingValue>::const_iterator iter = pending_.find(key);
+		if (iter == pending_.end()) {
+			return -1;
+		}
+		if (iter->second.deleted_) {
+			return 0;
+		}
+		value = iter->second.value_;
+		return 1;
+	}
+
+	void KeyValueDb::AddPending(WRITE_BATCH &batch, int64_t job) {
+		PendingHandler handler(this, job, true);
+		utils::MutexGuard guard(pending_mutex_);
+		batch.Iterate(&handler);
+	}
+
+	void KeyValueDb::RemovePending(WRITE_BATCH &batch, int64_t job) {
+		PendingHandler handler(this, job, false);
+		utils::MutexGuard guard(pending_mutex_);
+		batch.Iterate(&handler);
+	}
+
+	bool KeyValueDb::MultiGet(const std::vector<std::string> &keys, std::vector<std::string> &values, std::vector<int32_t> &stats) {
+		values.assign(keys.size(), "");
+		stats.assign(keys.size(), 0);
+		bool ret = true;
+		for (size_t i = 0; i < keys.size(); i++) {
+			stats[i] = Get(keys[i], values[i]);
+			if (stats[i] < 0) {
+				ret = false;
+			}
+		}
+		return ret;
+	}
+
 #ifdef WIN32
 	LevelDbDriver::LevelDbDriver() {
 		db_ = NULL;
@@ -61,10 +150,13 @@ namespace bumo {
 
 	int32_t LevelDbDriver::Get(const std::string &key, std::string &value) {
 		assert(db_ != NULL);
+		int32_t ret = GetPending(key, value);
+		if (ret >= 0) {
+			return ret;
+		}
 
 		//Retry 10 times. Interval is 0.1 second.
 		size_t timers = 0;
-		int32_t ret = -1;
 		while (timers < 10) {
 
 			leveldb::Status status = db_->Get(leveldb::ReadOptions(), key, &value);
@@ -111,10 +203,10 @@ namespace bumo {
 		return status.ok();
 	}
 
-	bool LevelDbDriver::WriteBatch(WRITE_BATCH &write_batch) {
+	bool LevelDbDriver::WriteBatch(WRITE_BATCH &write_batch, bool sync) {
 
 		leveldb::WriteOptions opt;
-		opt.sync = true;
+		opt.sync = sync;
 		leveldb::Status status = db_->Write(opt, &write_batch);
 		if (!status.ok()) {
 			utils::MutexGuard guard(mutex_);
@@ -131,14 +223,168 @@ namespace bumo {
 		return true;
 	}
 
+	class LevelDbDriver::Snapshot : public KeyValueDb {
+	public:
+		Snapshot(leveldb::DB *db) : db_(db) {
+			snapshot_ = db_->GetSnapshot();
+			options_.snapshot = snapshot_;
+		}
+
+		~Snapshot() {
+			db_->ReleaseSnapshot(snapshot_);
+		}
+
+		bool Open(const std::string &, int) {
+			return false;
+		}
+
+		bool Close() {
+			return true;
+		}
+
+		int32_t Get(const std::string &key, std::string &value) {
+			leveldb::Status status = db_->Get(options_, key, &value);
+			if (status.ok()) {
+				return 1;
+			}
+			else if (status.IsNotFound()) {
+				return 0;
+			}
+			utils::MutexGuard guard(mutex_);
+			error_desc_ = status.ToString();
+			return -1;
+		}
+
+		bool Put(const std::string &, const std::string &) {
+			return ReadOnly();
+		}
+
+		bool Delete(const std::string &) {
+			return ReadOnly();
+		}
+
+		bool GetOptions(Json::Value &) {
+			return true;
+		}
+
+		bool WriteBatch(WRITE_BATCH &, bool) {
+			return ReadOnly();
+		}
+
+		void* NewIterator() {
+			return db_->NewIterator(options_);
+		}
+
+	private:
+		bool ReadOnly() {
+			utils::MutexGuard guard(mutex_);
+			error_desc_ = "Snapshot is read-only";
+			return false;
+		}
+
+		leveldb::DB *db_;
+		const leveldb::Snapshot *snapshot_;
+		leveldb::ReadOptions options_;
+	};
+
+	KeyValueDb *LevelDbDriver::NewSnapshot() {
+		assert(db_ != NULL);
+		return new Snapshot(db_);
+	}
+
+	bool LevelDbDriver::CompactRange(const std::string &begin, const std::string &end) {
+		leveldb::Slice begin_slice(begin), end_slice(end);
+		db_->CompactRange(&begin_slice, &end_slice);
+		return true;
+	}
+
 #else
 
+	//Column families of the account database, a key goes to the first one whose prefix it starts with.
+	static const std::vector<std::pair<std::string, std::string>> &AccountColumnFamilies() {
+		static std::vector<std::pair<std::string, std::string>> families;
+		if (families.empty()) {
+			//The locations of the account tree leaves start with 0x02, the inner nodes with 0x00 or 0x01.
+			families.push_back(std::make_pair("account_leaf", std::string(General::ACCOUNT_PREFIX) + '\x02'));
+			families.push_back(std::make_pair("account_node", std::string(General::ACCOUNT_PREFIX)));
+			families.push_back(std::make_pair("asset", ComposePrefix(General::ASSET_PREFIX, "")));
+			families.push_back(std::make_pair("metadata", ComposePrefix(General::METADATA_PREFIX, "")));
+		}
+		return families;
+	}
+
+	static rocksdb::CompressionType CompressionType(const std::string &name) {
+		if (name == "snappy") return rocksdb::kSnappyCompression;
+		if (name == "zlib") return rocksdb::kZlibCompression;
+		if (name == "bzip2") return rocksdb::kBZip2Compression;
+		if (name == "lz4") return rocksdb::kLZ4Compression;
+		if (name == "lz4hc") return rocksdb::kLZ4HCCompression;
+		return rocksdb::kNoCompression;
+	}
+
+	static void ApplyTune(const DbTuneConfigure &tune, std::shared_ptr<rocksdb::Cache> block_cache, rocksdb::ColumnFamilyOptions &options) {
+		rocksdb::BlockBasedTableOptions table_options;
+		if (block_cache != nullptr) {
+			table_options.block_cache = block_cache;
+		}
+		if (tune.bloom_bits_per_key_ > 0) {
+			table_options.filter_policy.reset(rocksdb::NewBloomFilterPolicy(tune.bloom_bits_per_key_, false));
+		}
+		options.table_factory.reset(rocksdb::NewBlockBasedTableFactory(table_options));
+
+		if (tune.write_buffer_size_ > 0) {
+			options.write_buffer_size = (size_t)tune.write_buffer_size_;
+		}
+
+		if (!tune.compression_.empty()) {
+			options.compression_per_level.clear();
+			for (utils::StringList::const_iterator iter = tune.compression_.begin(); iter != tune.compression_.end(); iter++) {
+				options.compression_per_level.push_back(CompressionType(*iter));
+			}
+			options.compression = options.compression_per_level.front();
+		}
+
+		if (tune.compaction_style_ == "universal") {
+			options.compaction_style = rocksdb::kCompactionStyleUniversal;
+		}
+		else if (tune.compaction_style_ == "fifo") {
+			options.compaction_style = rocksdb::kCompactionStyleFIFO;
+		}
+		else {
+			options.compaction_style = rocksdb::kCompactionStyleLevel;
+		}
+	}
+
+	class RocksDbDriver::RouteHandler : public rocksdb::WriteBatch::Handler {
+	public:
+		RouteHandler(RocksDbDriver *driver) : driver_(driver) {}
+
+		virtual void Put(const rocksdb::Slice &key, const rocksdb::Slice &value) {
+			routed_.Put(driver_->Route(key), key, value);
+		}
+
+		virtual void Delete(const rocksdb::Slice &key) {
+			routed_.Delete(driver_->Route(key), key);
+		}
+
+		rocksdb::WriteBatch routed_;
+	private:
+		RocksDbDriver *driver_;
+	};
+
 	RocksDbDriver::RocksDbDriver() {
 		db_ = NULL;
 	}
 
+	RocksDbDriver::RocksDbDriver(const DbTuneConfigure &tune, std::shared_ptr<rocksdb::Cache> block_cache) {
+		db_ = NULL;
+		tune_ = tune;
+		block_cache_ = block_cache;
+	}
+
 	RocksDbDriver::~RocksDbDriver() {
 		if (db_ != NULL) {
+			CloseHandles();
 			delete db_;
 			db_ = NULL;
 		}
@@ -151,23 +397,87 @@ namespace bumo {
 			options.max_open_files = max_open_files;
 		}
 		options.create_if_missing = true;
-		rocksdb::Status status = rocksdb::DB::Open(options, db_path, &db_);
+		options.create_missing_column_families = true;
+
+		//The column families of an existing database are kept as they were created,
+		//the layout of its keys can not change.
+		std::vector<std::string> names;
+		rocksdb::Status status = rocksdb::DB::ListColumnFamilies(options, db_path, &names);
+		if (!status.ok() || names.empty()) {
+			names.clear();
+			names.push_back(rocksdb::kDefaultColumnFamilyName);
+			if (tune_.column_families_) {
+				const std::vector<std::pair<std::string, std::string>> &families = AccountColumnFamilies();
+				for (size_t i = 0; i < families.size(); i++) {
+					names.push_back(families[i].first);
+				}
+			}
+		}
+
+		std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+		for (size_t i = 0; i < names.size(); i++) {
+			DbTuneConfigure tune = tune_;
+			if (tune_.column_family_options_.isMember(names[i]) && !tune.Load(tune_.column_family_options_[names[i]])) {
+				utils::MutexGuard guard(mutex_);
+				error_desc_ = utils::String::Format("Failed to load the options of column family(%s)", names[i].c_str());
+				return false;
+			}
+
+			rocksdb::ColumnFamilyOptions family_options(options);
+			ApplyTune(tune, block_cache_, family_options);
+			descriptors.push_back(rocksdb::ColumnFamilyDescriptor(names[i], family_options));
+		}
+
+		status = rocksdb::DB::Open(rocksdb::DBOptions(options), db_path, descriptors, &handles_, &db_);
 		if (!status.ok()) {
 			utils::MutexGuard guard(mutex_);
 			error_desc_ = status.ToString();
+			return false;
 		}
-		return status.ok();
+
+		const std::vector<std::pair<std::string, std::string>> &families = AccountColumnFamilies();
+		for (size_t i = 0; i < families.size(); i++) {
+			for (size_t j = 0; j < names.size(); j++) {
+				if (names[j] == families[i].first) {
+					routes_.push_back(std::make_pair(families[i].second, handles_[j]));
+				}
+			}
+		}
+		return true;
 	}
 
 	bool RocksDbDriver::Close() {
+		CloseHandles();
 		delete db_;
 		db_ = NULL;
 		return true;
 	}
 
+	void RocksDbDriver::CloseHandles() {
+		routes_.clear();
+		for (size_t i = 0; i < handles_.size(); i++) {
+			delete handles_[i];
+		}
+		handles_.clear();
+	}
+
+	rocksdb::ColumnFamilyHandle *RocksDbDriver::Route(const rocksdb::Slice &key) {
+		for (size_t i = 0; i < routes_.size(); i++) {
+			if (key.starts_with(routes_[i].first)) {
+				return routes_[i].second;
+			}
+		}
+		return db_->DefaultColumnFamily();
+	}
+
 	int32_t RocksDbDriver::Get(const std::string &key, std::string &value) {
 		assert(db_ != NULL);
-		rocksdb::Status status = db_->Get(rocksdb::ReadOptions(), key, &value);
+		int32_t ret = GetPending(key, value);
+		if (ret >= 0) {
+			return ret;
+		}
+
+		rocksdb::Status status = db_->Get(rocksdb::ReadOptions(), Route(key), key, &value);
 		if (status.ok()) {
 			return 1;
 		}
@@ -181,11 +491,57 @@ namespace bumo {
 		}
 	}
 
+	bool RocksDbDriver::MultiGet(const std::vector<std::string> &keys, std::vector<std::string> &values, std::vector<int32_t> &stats) {
+		assert(db_ != NULL);
+		values.assign(keys.size(), "");
+		stats.assign(keys.size(), 0);
+
+		//The keys not served by the pending batches
+		std::vector<size_t> indexes;
+		std::vector<rocksdb::Slice> slices;
+		std::vector<rocksdb::ColumnFamilyHandle*> families;
+		for (size_t i = 0; i < keys.size(); i++) {
+			int32_t pending = GetPending(keys[i], values[i]);
+			if (pending >= 0) {
+				stats[i] = pending;
+				continue;
+			}
+			indexes.push_back(i);
+			slices.push_back(keys[i]);
+			families.push_back(Route(slices.back()));
+		}
+		if (indexes.empty()) {
+			return true;
+		}
+
+		std::vector<std::string> found;
+		std::vector<rocksdb::Status> status = db_->MultiGet(rocksdb::ReadOptions(), families, slices, &found);
+
+		bool ret = true;
+		for (size_t j = 0; j < status.size(); j++) {
+			size_t i = indexes[j];
+			if (status[j].ok()) {
+				stats[i] = 1;
+				values[i].swap(found[j]);
+			}
+			else if (status[j].IsNotFound()) {
+				stats[i] = 0;
+			}
+			else {
+				utils::MutexGuard guard(mutex_);
+				error_desc_ = status[j].ToString();
+				stats[i] = -1;
+				ret = false;
+			}
+		}
+		return ret;
+	}
+
 	bool RocksDbDriver::Put(const std::string &key, const std::string &value) {
 		assert(db_ != NULL);
 		rocksdb::WriteOptions opt;
 		opt.sync = true;
-		rocksdb::Status status = db_->Put(opt, key, value);
+		rocksdb::Status status = db_->Put(opt, Route(key), key, value);
 		if (!status.ok()) {
 			utils::MutexGuard guard(mutex_);
 			error_desc_ = status.ToString();
@@ -197,7 +553,7 @@ namespace bumo {
 		assert(db_ != NULL);
 		rocksdb::WriteOptions opt;
 		opt.sync = true;
-		rocksdb::Status status = db_->Delete(opt, key);
+		rocksdb::Status status = db_->Delete(opt, Route(key), key);
 		if (!status.ok()) {
 			utils::MutexGuard guard(mutex_);
 			error_desc_ = status.ToString();
@@ -205,11 +561,21 @@ namespace bumo {
 		return status.ok();
 	}
 
-	bool RocksDbDriver::WriteBatch(WRITE_BATCH &write_batch) {
+	bool RocksDbDriver::WriteBatch(WRITE_BATCH &write_batch, bool sync) {
 
 		rocksdb::WriteOptions opt;
-		opt.sync = true;
-		rocksdb::Status status = db_->Write(opt, &write_batch);
+		opt.sync = sync;
+		rocksdb::Status status;
+		if (routes_.empty()) {
+			status = db_->Write(opt, &write_batch);
+		}
+		else {
+			RouteHandler handler(this);
+			status = write_batch.Iterate(&handler);
+			if (status.ok()) {
+				status = db_->Write(opt, &handler.routed_);
+			}
+		}
 		if (!status.ok()) {
 			utils::MutexGuard guard(mutex_);
 			error_desc_ = status.ToString();
@@ -231,14 +597,405 @@ namespace bumo {
 
 		db_->GetProperty("rocksdb.stats", &out);
 		options["rocksdb.stats"] = out;
+
+		Json::Value &families = options["column_families"];
+		families = Json::Value(Json::arrayValue);
+		for (size_t i = 0; i < handles_.size(); i++) {
+			families.append(handles_[i]->GetName());
+		}
+		return true;
+	}
+
+	class RocksDbDriver::Snapshot : public KeyValueDb {
+	public:
+		Snapshot(RocksDbDriver *driver) : driver_(driver) {
+			snapshot_ = driver_->db_->GetSnapshot();
+			options_.snapshot = snapshot_;
+		}
+
+		~Snapshot() {
+			driver_->db_->ReleaseSnapshot(snapshot_);
+		}
+
+		bool Open(const std::string &, int) {
+			return false;
+		}
+
+		bool Close() {
+			return true;
+		}
+
+		int32_t Get(const std::string &key, std::string &value) {
+			rocksdb::Status status = driver_->db_->Get(options_, driver_->Route(key), key, &value);
+			if (status.ok()) {
+				return 1;
+			}
+			else if (status.IsNotFound()) {
+				return 0;
+			}
+			utils::MutexGuard guard(mutex_);
+			error_desc_ = status.ToString();
+			return -1;
+		}
+
+		bool MultiGet(const std::vector<std::string> &keys, std::vector<std::string> &values, std::vector<int32_t> &stats) {
+			std::vector<rocksdb::Slice> slices(keys.begin(), keys.end());
+			std::vector<rocksdb::ColumnFamilyHandle*> families;
+			for (size_t i = 0; i < slices.size(); i++) {
+				families.push_back(driver_->Route(slices[i]));
+			}
+			values.clear();
+			std::vector<rocksdb::Status> status = driver_->db_->MultiGet(options_, families, slices, &values);
+
+			bool ret = true;
+			stats.assign(keys.size(), 0);
+			for (size_t i = 0; i < status.size(); i++) {
+				if (status[i].ok()) {
+					stats[i] = 1;
+				}
+				else if (!status[i].IsNotFound()) {
+					utils::MutexGuard guard(mutex_);
+					error_desc_ = status[i].ToString();
+					stats[i] = -1;
+					ret = false;
+				}
+			}
+			return ret;
+		}
+
+		bool Put(const std::string &, const std::string &) {
+			return ReadOnly();
+		}
+
+		bool Delete(const std::string &) {
+			return ReadOnly();
+		}
+
+		bool GetOptions(Json::Value &) {
+			return true;
+		}
+
+		bool WriteBatch(WRITE_BATCH &, bool) {
+			return ReadOnly();
+		}
+
+		void* NewIterator() {
+			return driver_->db_->NewIterator(options_);
+		}
+
+	private:
+		bool ReadOnly() {
+			utils::MutexGuard guard(mutex_);
+			error_desc_ = "Snapshot is read-only";
+			return false;
+		}
+
+		RocksDbDriver *driver_;
+		const rocksdb::Snapshot *snapshot_;
+		rocksdb::ReadOptions options_;
+	};
+
+	KeyValueDb *RocksDbDriver::NewSnapshot() {
+		assert(db_ != NULL);
+		return new Snapshot(this);
+	}
+
+	bool RocksDbDriver::CompactRange(const std::string &begin, const std::string &end) {
+		rocksdb::Slice begin_slice(begin), end_slice(end);
+		rocksdb::Status status = db_->CompactRange(Route(begin_slice), &begin_slice, &end_slice);
+		if (!status.ok()) {
+			utils::MutexGuard guard(mutex_);
+			error_desc_ = status.ToString();
+			return false;
+		}
 		return true;
 	}
 #endif
 
+	StorageWriter::StorageWriter() :thread_(this), slots_(MAX_QUEUE_SIZE) {
+		async_ = false;
+		written_seq_ = 0;
+		group_count_ = 0;
+		job_count_ = 0;
+		write_time_ = 0;
+	}
+
+	StorageWriter::~StorageWriter() {}
+
+	bool StorageWriter::Initialize(std::shared_ptr<KeyValueDb> ledger_db, std::shared_ptr<KeyValueDb> account_db, bool async) {
+		ledger_db_ = ledger_db;
+		account_db_ = account_db;
+		async_ = async;
+		if (!async_) {
+			return true;
+		}
+
+		if (!thread_.Start("storage-writer")) {
+			LOG_ERROR_ERRNO("Failed to start storage writer thread", STD_ERR_CODE, STD_ERR_DESC);
+			return false;
+		}
+		return true;
+	}
+
+	bool StorageWriter::Exit() {
+		if (!async_) {
+			utils::MutexGuard guard(mutex_);
+			snapshot_.reset();
+			ledger_db_.reset();
+			account_db_.reset();
+			return true;
+		}
+
+		//The clients are gone, only the queued batches are written.
+		do {
+			utils::MutexGuard guard(mutex_);
+			callbacks_.clear();
+		} while (false);
+
+		bool ret = thread_.JoinWithStop();
+		async_ = false;
+
+		//Release the snapshots before the databases are closed.
+		utils::MutexGuard guard(mutex_);
+		snapshot_.reset();
+		ledger_db_.reset();
+		account_db_.reset();
+		return ret;
+	}
+
+	void StorageWriter::Write(int64_t seq, std::shared_ptr<WRITE_BATCH> ledger_batch, std::shared_ptr<WRITE_BATCH> account_batch) {
+		Job job;
+		job.seq_ = seq;
+		job.ledger_batch_ = ledger_batch;
+		job.account_batch_ = account_batch;
+		if (!async_) {
+			std::list<Job> jobs(1, job);
+			WriteJobs(jobs);
+			return;
+		}
+
+		//The batches are readable before they are queued
+		ledger_db_->AddPending(*ledger_batch, seq);
+		account_db_->AddPending(*account_batch, seq);
+		while (!slots_.Wait()) {
+		}
+
+		utils::MutexGuard guard(mutex_);
+		jobs_.push_back(job);
+		sem_.Signal();
+	}
+
+	void StorageWriter::WriteLedgerDb(std::shared_ptr<WRITE_BATCH> ledger_batch) {
+		Job job;
+		job.seq_ = 0;
+		job.ledger_batch_ = ledger_batch;
+		if (!async_) {
+			std::list<Job> jobs(1, job);
+			WriteJobs(jobs);
+			return;
+		}
+
+		utils::Semaphore written;
+		job.written_ = [&written]() {
+			written.Signal();
+		};
+		while (!slots_.Wait()) {
+		}
+
+		do {
+			utils::MutexGuard guard(mutex_);
+			jobs_.push_back(job);
+			sem_.Signal();
+		} while (false);
+
+		while (!written.Wait()) {
+		}
+	}
+
+	void StorageWriter::OnWritten(int64_t seq, Callback callback) {
+		do {
+			utils::MutexGuard guard(mutex_);
+			if (seq > written_seq_) {
+				callbacks_.push_back(std::make_pair(seq, callback));
+				return;
+			}
+		} while (false);
+
+		callback();
+	}
+
+	int64_t StorageWriter::written_seq() {
+		utils::MutexGuard guard(mutex_);
+		return written_seq_;
+	}
+
+	void StorageWriter::TakeSnapshot(int64_t seq) {
+		std::shared_ptr<StorageSnapshot> snapshot = std::make_shared<StorageSnapshot>();
+		snapshot->seq_ = seq;
+		snapshot->ledger_owner_ = ledger_db_;
+		snapshot->account_owner_ = account_db_;
+		snapshot->ledger_db_.reset(ledger_db_->NewSnapshot());
+		snapshot->account_db_.reset(account_db_->NewSnapshot());
+		if (snapshot->ledger_db_ == nullptr || snapshot->account_db_ == nullptr) {
+			return;
+		}
+
+		utils::MutexGuard guard(mutex_);
+		snapshot_ = snapshot;
+	}
+
+	std::shared_ptr<StorageSnapshot> StorageWriter::snapshot() {
+		utils::MutexGuard guard(mutex_);
+		return snapshot_;
+	}
+
+	std::shared_ptr<StorageSnapshot> StorageWriter::WaitSnapshot(int64_t seq) {
+		do {
+			utils::MutexGuard guard(mutex_);
+			if (snapshot_ == nullptr || snapshot_->seq_ >= seq) {
+				return snapshot_;
+			}
+		} while (false);
+
+		utils::Semaphore written;
+		OnWritten(seq, [&written]() {
+			written.Signal();
+		});
+		while (!written.Wait()) {
+		}
+
+		//Written, the snapshot may have failed.
+		std::shared_ptr<StorageSnapshot> snapshot = this->snapshot();
+		return (snapshot != nullptr && snapshot->seq_ >= seq) ? snapshot : nullptr;
+	}
+
+	bool StorageWriter::Rewind(KeyValueDb *ledger_db, int64_t ledger_seq, int64_t seq) {
+		//What LedgerFrm::AddToDb wrote, the transactions found from the hash list of their ledger.
+		WRITE_BATCH batch;
+		for (int64_t i = seq + 1; i <= ledger_seq; i++) {
+			std::string hash_list;
+			int32_t ret = ledger_db->Get(ComposePrefix(General::LEDGER_TRANSACTION_PREFIX, i), hash_list);
+			if (ret < 0) {
+				return false;
+			}
+
+			protocol::EntryList list;
+			if (ret > 0 && list.ParseFromString(hash_list)) {
+				for (int32_t j = 0; j < list.entry_size(); j++) {
+					batch.Delete(ComposePrefix(General::TRANSACTION_PREFIX, list.entry(j)));
+				}
+			}
+			batch.Delete(ComposePrefix(General::LEDGER_TRANSACTION_PREFIX, i));
+			batch.Delete(ComposePrefix(General::LEDGER_PREFIX, i));
+			batch.Delete(ComposePrefix(General::CONSENSUS_VALUE_PREFIX, i));
+		}
+		batch.Put(General::KEY_LEDGER_SEQ, utils::String::ToString(seq));
+		return ledger_db->WriteBatch(batch);
+	}
+
+	void StorageWriter::GetModuleStatus(Json::Value &data) {
+		utils::MutexGuard guard(mutex_);
+		data["async"] = async_;
+		data["written_seq"] = written_seq_;
+		data["snapshot_seq"] = snapshot_ != nullptr ? snapshot_->seq_ : 0;
+		data["queue_size"] = (Json::UInt64)jobs_.size();
+		data["group_count"] = group_count_;
+		data["job_count"] = job_count_;
+		data["write_time"] = utils::String::Format(FMT_I64 " ms", write_time_ / utils::MICRO_UNITS_PER_MILLI);
+	}
+
+	void StorageWriter::Run(utils::Thread *thread) {
+		while (true) {
+			bool enabled = thread->enabled();
+			if (enabled) {
+				sem_.Wait(100);
+			}
+
+			std::list<Job> jobs;
+			do {
+				utils::MutexGuard guard(mutex_);
+				jobs.swap(jobs_);
+			} while (false);
+			WriteJobs(jobs);
+
+			if (!enabled) {
+				break;
+			}
+		}
+	}
+
+	void StorageWriter::WriteJobs(std::list<Job> &jobs) {
+		if (jobs.empty()) {
+			return;
+		}
+
+		//Only the last batch of each database is synced, which syncs the log of the former ones too.
+		int64_t time0 = utils::Timestamp::HighResolution();
+		size_t index = 0;
+		for (std::list<Job>::iterator iter = jobs.begin(); iter != jobs.end(); iter++, index++) {
+			if (!ledger_db_->WriteBatch(*iter->ledger_batch_, index + 1 == jobs.size())) {
+				PROCESS_EXIT("Failed to write ledger and transaction to database(%s)", ledger_db_->error_desc().c_str());
+			}
+		}
+
+		//The ledgers of the group, without the batches of WriteLedgerDb.
+		std::list<Job> ledgers;
+		for (std::list<Job>::iterator iter = jobs.begin(); iter != jobs.end(); iter++) {
+			if (iter->seq_ > 0) {
+				ledgers.push_back(*iter);
+			}
+		}
+
+		index = 0;
+		for (std::list<Job>::iterator iter = ledgers.begin(); iter != ledgers.end(); iter++, index++) {
+			if (!account_db_->WriteBatch(*iter->account_batch_, index + 1 == ledgers.size())) {
+				PROCESS_EXIT("Failed to write accounts to database: %s", account_db_->error_desc().c_str());
+			}
+		}
+
+		for (std::list<Job>::iterator iter = jobs.begin(); iter != jobs.end(); iter++) {
+			if (async_ && iter->seq_ > 0) {
+				ledger_db_->RemovePending(*iter->ledger_batch_, iter->seq_);
+				account_db_->RemovePending(*iter->account_batch_, iter->seq_);
+			}
+			if (async_) {
+				slots_.Signal();
+			}
+			if (iter->written_) {
+				iter->written_();
+			}
+		}
+		if (ledgers.empty()) {
+			return;
+		}
+
+		TakeSnapshot(ledgers.back().seq_);
+		int64_t time1 = utils::Timestamp::HighResolution();
+
+		std::list<Callback> ready;
+		do {
+			utils::MutexGuard guard(mutex_);
+			written_seq_ = ledgers.back().seq_;
+			group_count_++;
+			job_count_ += jobs.size();
+			write_time_ += time1 - time0;
+			for (std::list<std::pair<int64_t, Callback>>::iterator iter = callbacks_.begin(); iter != callbacks_.end();) {
+				if (iter->first <= written_seq_) {
+					ready.push_back(iter->second);
+					iter = callbacks_.erase(iter);
+				}
+				else {
+					iter++;
+				}
+			}
+		} while (false);
+
+		for (std::list<Callback>::iterator iter = ready.begin(); iter != ready.end(); iter++) {
+			(*iter)();
+		}
+	}
+
 	Storage::Storage() {
-		keyvalue_db_ = NULL;
-		ledger_db_ = NULL;
-		account_db_ = NULL;
 		check_interval_ = utils::MICRO_UNITS_PER_SEC;
 	}
 
@@ -269,7 +1026,7 @@ namespace bumo {
 				do {
 					//Check only for linux or mac whether the account db can be opened.
 #ifndef WIN32
-					KeyValueDb *account_db = NewKeyValueDb(db_config);
+					KeyValueDb *account_db = NewKeyValueDb(db_config, db_config.account_tune_);
 					if (!account_db->Open(db_config.account_db_path_, -1)) {
 						LOG_ERROR("Failed to drop db.Error description(%s)", account_db->error_desc().c_str());
 						delete account_db;
@@ -334,27 +1091,36 @@ namespace bumo {
 			LOG_INFO("Assigned number of file handles in mac os, max :%d, keyvaule used:%d, ledger used:%d, account used:%d:",
 				max_open_files, keyvaule_max_open_files, ledger_max_open_files, account_max_open_files);
 #endif
-			keyvalue_db_ = NewKeyValueDb(db_config);
+#ifndef WIN32
+			if (db_config.block_cache_size_ > 0) {
+				block_cache_ = rocksdb::NewLRUCache((size_t)db_config.block_cache_size_);
+			}
+#endif
+			keyvalue_db_.reset(NewKeyValueDb(db_config, db_config.keyvalue_tune_));
 			if (!keyvalue_db_->Open(db_config.keyvalue_db_path_, keyvaule_max_open_files)) {
 				LOG_ERROR("Failed to open keyvalue db path(%s), the reason is(%s)\n",
 					db_config.keyvalue_db_path_.c_str(), keyvalue_db_->error_desc().c_str());
 				break;
 			}
 
-			ledger_db_ = NewKeyValueDb(db_config);
+			ledger_db_.reset(NewKeyValueDb(db_config, db_config.ledger_tune_));
 			if (!ledger_db_->Open(db_config.ledger_db_path_, ledger_max_open_files)) {
 				LOG_ERROR("Failed to open ledger db path(%s), the reason is(%s)\n",
 					db_config.ledger_db_path_.c_str(), ledger_db_->error_desc().c_str());
 				break;
 			}
 
-			account_db_ = NewKeyValueDb(db_config);
+			account_db_.reset(NewKeyValueDb(db_config, db_config.account_tune_));
 			if (!account_db_->Open(db_config.account_db_path_, account_max_open_files)) {
 				LOG_ERROR("Failed to open account db path(%s), the reason is(%s)\n",
 					db_config.account_db_path_.c_str(), account_db_->error_desc().c_str());
 				break;
 			}
 
+			if (!writer_.Initialize(ledger_db_, account_db_, db_config.async_commit_)) {
+				break;
+			}
+
 			TimerNotify::RegisterModule(this);
 			return true;
 
@@ -367,22 +1133,28 @@ namespace bumo {
 
 	bool  Storage::CloseDb() {
 		bool ret1 = true, ret2 = true, ret3 = true;
+		if (!writer_.Exit()) {
+			LOG_ERROR("Failed to stop storage writer");
+		}
+
 		if (keyvalue_db_ != NULL) {
 			ret1 = keyvalue_db_->Close();
-			delete keyvalue_db_;
-			keyvalue_db_ = NULL;
+			keyvalue_db_.reset();
 		}
 
+		//A state view still held, by a ledger or a query, keeps the database open until it is released.
 		if (ledger_db_ != NULL) {
-			ret2 = ledger_db_->Close();
-			delete ledger_db_;
-			ledger_db_ = NULL;
+			if (ledger_db_.use_count() == 1) {
+				ret2 = ledger_db_->Close();
+			}
+			ledger_db_.reset();
 		}
 
 		if (account_db_ != NULL) {
-			ret3 = account_db_->Close();
-			delete account_db_;
-			account_db_ = NULL;
+			if (account_db_.use_count() == 1) {
+				ret3 = account_db_->Close();
+			}
+			account_db_.reset();
 		}
 
 		return ret1 && ret2 && ret3;
@@ -396,23 +1168,27 @@ namespace bumo {
 	}
 
 	KeyValueDb *Storage::keyvalue_db() {
-		return keyvalue_db_;
+		return keyvalue_db_.get();
 	}
 
 	KeyValueDb *Storage::ledger_db() {
-		return ledger_db_;
+		return ledger_db_.get();
 	}
 
 	KeyValueDb *Storage::account_db() {
-		return account_db_;
+		return account_db_.get();
+	}
+
+	StorageWriter &Storage::writer() {
+		return writer_;
 	}
 
-	KeyValueDb *Storage::NewKeyValueDb(const DbConfigure &db_config) {
+	KeyValueDb *Storage::NewKeyValueDb(const DbConfigure &db_config, const DbTuneConfigure &tune) {
 		KeyValueDb *db = NULL;
 #ifdef WIN32
 		db = new LevelDbDriver();
 #else
-		db = new RocksDbDriver();
+		db = new RocksDbDriver(tune, block_cache_);
 #endif
 
 		return db;
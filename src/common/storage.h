@@ -16,6 +16,8 @@
 #ifndef STORAGE_H_
 #define STORAGE_H_
 
+#include <list>
+#include <functional>
 #include <unordered_map>
 #include <utils/headers.h>
 #include <json/json.h>
@@ -25,6 +27,7 @@
 #include <leveldb/leveldb.h>
 #else
 #include <rocksdb/db.h>
+#include <rocksdb/cache.h>
 #endif
 
 namespace bumo {
@@ -46,27 +49,55 @@ namespace bumo {
 	protected:
 		utils::Mutex mutex_;
 		std::string error_desc_;
+
+		//Values of the batches queued in the StorageWriter, the reads are served from them until they are written.
+		struct PendingValue {
+			std::string value_;
+			bool deleted_;
+			int64_t job_;
+		};
+		utils::Mutex pending_mutex_;
+		std::unordered_map<std::string, PendingValue> pending_;
+		class PendingHandler;
+
+		//Return -1 if the key is not pending, otherwise the result of Get.
+		int32_t GetPending(const std::string &key, std::string &value);
 	public:
 		KeyValueDb();
-		~KeyValueDb();
+		virtual ~KeyValueDb();
 		virtual bool Open(const std::string &db_path, int max_open_files) = 0;
 		virtual bool Close() = 0;
 		virtual int32_t Get(const std::string &key, std::string &value) = 0;
+		//Read the keys in one call, stats receives the result of Get for each key.
+		//Return false if any of the reads failed.
+		virtual bool MultiGet(const std::vector<std::string> &keys, std::vector<std::string> &values, std::vector<int32_t> &stats);
 		virtual bool Put(const std::string &key, const std::string &value) = 0;
 		virtual bool Delete(const std::string &key) = 0;
 		virtual bool GetOptions(Json::Value &options) = 0;
 		std::string error_desc() {
 			return error_desc_;
 		}
-		virtual bool WriteBatch(WRITE_BATCH &values) = 0;
+		//Sync the write-ahead log unless sync is false, the batch is lost on a crash before a later synced write then.
+		virtual bool WriteBatch(WRITE_BATCH &values, bool sync = true) = 0;
 
+		//The iterators do not see the pending values.
 		virtual void* NewIterator() = 0;
+
+		//A read-only database pinned to the current content, without the pending values. NULL if not supported.
+		virtual KeyValueDb *NewSnapshot();
+		//Compact the keys in [begin, end] to drop the deleted ones, blocks until done.
+		virtual bool CompactRange(const std::string &begin, const std::string &end);
+
+		void AddPending(WRITE_BATCH &batch, int64_t job);
+		//Only the values still owned by the job are removed, a later job may have overwritten them.
+		void RemovePending(WRITE_BATCH &batch, int64_t job);
 	};
 
 #ifdef WIN32
 	class LevelDbDriver : public KeyValueDb {
 	private:
 		leveldb::DB* db_;
+		class Snapshot;
 
 	public:
 		LevelDbDriver();
@@ -78,46 +109,147 @@ namespace bumo {
 		bool Put(const std::string &key, const std::string &value);
 		bool Delete(const std::string &key);
 		bool GetOptions(Json::Value &options);
-		bool WriteBatch(WRITE_BATCH &values);
+		bool WriteBatch(WRITE_BATCH &values, bool sync = true);
 
 		void* NewIterator();
+		KeyValueDb *NewSnapshot();
+		bool CompactRange(const std::string &begin, const std::string &end);
 	};
 #else
 	class RocksDbDriver : public KeyValueDb {
 	private:
 		rocksdb::DB* db_;
+		DbTuneConfigure tune_;
+		std::shared_ptr<rocksdb::Cache> block_cache_;
 
+		//The keys are routed to the column families by prefix, the others go to the default one.
+		std::vector<rocksdb::ColumnFamilyHandle*> handles_;
+		std::vector<std::pair<std::string, rocksdb::ColumnFamilyHandle*>> routes_;
+		rocksdb::ColumnFamilyHandle *Route(const rocksdb::Slice &key);
+		class RouteHandler;
+		class Snapshot;
+
+		void CloseHandles();
 	public:
 		RocksDbDriver();
+		RocksDbDriver(const DbTuneConfigure &tune, std::shared_ptr<rocksdb::Cache> block_cache);
 		~RocksDbDriver();
 
 		bool Open(const std::string &db_path, int max_open_files);
 		bool Close();
 		int32_t Get(const std::string &key, std::string &value);
+		bool MultiGet(const std::vector<std::string> &keys, std::vector<std::string> &values, std::vector<int32_t> &stats);
 		bool Put(const std::string &key, const std::string &value);
 		bool Delete(const std::string &key);
 		bool GetOptions(Json::Value &options);
-		bool WriteBatch(WRITE_BATCH &values);
+		bool WriteBatch(WRITE_BATCH &values, bool sync = true);
 
+		//Iterates the default column family
 		void* NewIterator();
+		KeyValueDb *NewSnapshot();
+		//In the column family of begin
+		bool CompactRange(const std::string &begin, const std::string &end);
 	};
 #endif
 
+	//The databases as they were when a ledger was written, read without the ledger close locks.
+	struct StorageSnapshot {
+		int64_t seq_;
+		//The databases stay open until the snapshots, destroyed first, are released.
+		std::shared_ptr<KeyValueDb> ledger_owner_;
+		std::shared_ptr<KeyValueDb> account_owner_;
+		std::shared_ptr<KeyValueDb> ledger_db_;
+		std::shared_ptr<KeyValueDb> account_db_;
+	};
+
+	//Writes the batches of the closed ledgers in a background thread, so the next ledger is executed while the
+	//previous one is synced to the disk. The queued ledgers are written as one group with a single sync per
+	//database: the ledger db first, then the account db, whose KEY_LEDGER_SEQ marks the ledgers as complete.
+	//Without async, Write writes the batches at once as before.
+	class StorageWriter : public utils::Runnable {
+	public:
+		typedef std::function<void()> Callback;
+
+		StorageWriter();
+		~StorageWriter();
+
+		bool Initialize(std::shared_ptr<KeyValueDb> ledger_db, std::shared_ptr<KeyValueDb> account_db, bool async);
+		//Write the queued batches and stop the thread.
+		bool Exit();
+
+		//Blocks while the queue is full.
+		void Write(int64_t seq, std::shared_ptr<WRITE_BATCH> ledger_batch, std::shared_ptr<WRITE_BATCH> account_batch);
+		//Write a ledger db batch of no ledger, such as the removal of old ledgers, after the queued ones.
+		//Blocks until it is written.
+		void WriteLedgerDb(std::shared_ptr<WRITE_BATCH> ledger_batch);
+		//Run the callback in the writer thread once the ledger is durable, or at once if it is already.
+		void OnWritten(int64_t seq, Callback callback);
+
+		int64_t written_seq();
+		void GetModuleStatus(Json::Value &data);
+
+		//Pin the databases as the written state of the ledger seq, done after every write.
+		void TakeSnapshot(int64_t seq);
+		//The last written ledger, NULL before the ledger manager has started.
+		std::shared_ptr<StorageSnapshot> snapshot();
+		//Wait until the ledger seq is written, NULL if its snapshot cannot be taken.
+		std::shared_ptr<StorageSnapshot> WaitSnapshot(int64_t seq);
+
+		//Remove the ledgers after seq up to ledger_seq, which reached the ledger db but not the account db before a crash.
+		//The error is in the error_desc of ledger_db.
+		static bool Rewind(KeyValueDb *ledger_db, int64_t ledger_seq, int64_t seq);
+
+	private:
+		struct Job {
+			int64_t seq_; //0 for a batch of WriteLedgerDb
+			std::shared_ptr<WRITE_BATCH> ledger_batch_;
+			std::shared_ptr<WRITE_BATCH> account_batch_;
+			Callback written_;
+		};
+
+		virtual void Run(utils::Thread *thread);
+		void WriteJobs(std::list<Job> &jobs);
+
+		std::shared_ptr<KeyValueDb> ledger_db_;
+		std::shared_ptr<KeyValueDb> account_db_;
+		bool async_;
+		utils::Thread thread_;
+		utils::Semaphore sem_;
+		utils::Semaphore slots_; //Free places in the queue
+
+		utils::Mutex mutex_;
+		std::list<Job> jobs_;
+		std::list<std::pair<int64_t, Callback>> callbacks_;
+		int64_t written_seq_;
+		std::shared_ptr<StorageSnapshot> snapshot_;
+
+		int64_t group_count_;
+		int64_t job_count_;
+		int64_t write_time_;
+
+		static const size_t MAX_QUEUE_SIZE = 8;
+	};
+
 	class Storage : public utils::Singleton<bumo::Storage>, public TimerNotify {
 		friend class utils::Singleton<Storage>;
 	private:
 		Storage();
 		~Storage();
 
-		KeyValueDb *keyvalue_db_;
-		KeyValueDb *ledger_db_;
-		KeyValueDb *account_db_;
+		//Shared with the snapshots of the state views, which may outlive Exit.
+		std::shared_ptr<KeyValueDb> keyvalue_db_;
+		std::shared_ptr<KeyValueDb> ledger_db_;
+		std::shared_ptr<KeyValueDb> account_db_;
+		StorageWriter writer_;
+#ifndef WIN32
+		std::shared_ptr<rocksdb::Cache> block_cache_;
+#endif
 
 		bool CloseDb();
 		bool DescribeTable(const std::string &name, const std::string &sql_create_table);
 		bool ManualDescribeTables();
 
-		KeyValueDb *NewKeyValueDb(const DbConfigure &db_config);
+		KeyValueDb *NewKeyValueDb(const DbConfigure &db_config, const DbTuneConfigure &tune);
 	public:
 		bool Initialize(const DbConfigure &db_config, bool bdropdb);
 		bool Exit();
@@ -125,6 +257,7 @@ namespace bumo {
 		KeyValueDb *keyvalue_db();   //Store other data except account, ledger and transaction.
 		KeyValueDb *account_db();   //Store account tree.
 		KeyValueDb *ledger_db();    //Store transactions and ledgers.
+		StorageWriter &writer();    //Write the ledger db and account db batches of the closed ledgers.
 
 		//Lock the account db and ledger db to make the databases in synchronization.
 		utils::ReadWriteLock account_ledger_lock_;
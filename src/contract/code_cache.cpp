@@ -0,0 +1,219 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <utils/crypto.h>
+#include <utils/logger.h>
+#include "code_cache.h"
+
+namespace bumo {
+
+	CodeCache::CodeCache() {
+		size_ = 0;
+		capacity_ = 0;
+		persist_ = false;
+		registered_ = false;
+		check_interval_ = utils::MICRO_UNITS_PER_SEC;
+		timer_name_ = "Code Cache";
+		pending_ = std::make_shared<WRITE_BATCH>();
+		pending_count_ = 0;
+		hit_count_ = 0;
+		miss_count_ = 0;
+		load_count_ = 0;
+		rejected_count_ = 0;
+		eviction_count_ = 0;
+		hit_compile_time_ = 0;
+		miss_compile_time_ = 0;
+	}
+
+	CodeCache::~CodeCache() {}
+
+	void CodeCache::Initialize(int64_t capacity, bool persist) {
+		do {
+			utils::MutexGuard guard(mutex_);
+			capacity_ = capacity;
+			persist_ = capacity > 0 && persist;
+			Evict();
+		} while (false);
+
+		if (persist_) {
+			Load();
+			if (!registered_) {
+				registered_ = TimerNotify::RegisterModule(this);
+			}
+		}
+	}
+
+	bool CodeCache::Exit() {
+		WritePending();
+		return true;
+	}
+
+	bool CodeCache::enabled() const {
+		return capacity_ > 0;
+	}
+
+	std::string CodeCache::Key(const std::string &origin_name, const std::string &code) {
+		utils::Sha256 hash;
+		hash.Update(origin_name);
+		hash.Update("\0", 1);
+		hash.Update(code);
+		return hash.Final();
+	}
+
+	std::string CodeCache::DbKey(const std::string &key) {
+		return utils::String::Format("%s_%s", General::CODE_CACHE_PREFIX, utils::String::BinToHexString(key).c_str());
+	}
+
+	std::shared_ptr<const std::string> CodeCache::Get(const std::string &key) {
+		if (capacity_ <= 0) {
+			return nullptr;
+		}
+
+		utils::MutexGuard guard(mutex_);
+		EntryMap::iterator iter = index_.find(key);
+		if (iter == index_.end()) {
+			return nullptr;
+		}
+		entries_.splice(entries_.begin(), entries_, iter->second);
+		return iter->second->data_;
+	}
+
+	void CodeCache::Put(const std::string &key, const std::string &data) {
+		if (capacity_ <= 0) {
+			return;
+		}
+
+		utils::MutexGuard guard(mutex_);
+		if (persist_) {
+			pending_->Put(DbKey(key), data);
+			pending_count_++;
+		}
+		Insert(key, std::make_shared<std::string>(data));
+	}
+
+	void CodeCache::Remove(const std::string &key) {
+		utils::MutexGuard guard(mutex_);
+		if (persist_) {
+			pending_->Delete(DbKey(key));
+			pending_count_++;
+		}
+		rejected_count_++;
+		EntryMap::iterator iter = index_.find(key);
+		if (iter != index_.end()) {
+			size_ -= iter->second->data_->size();
+			entries_.erase(iter->second);
+			index_.erase(iter);
+		}
+	}
+
+	void CodeCache::OnCompiled(bool hit, int64_t time) {
+		utils::MutexGuard guard(mutex_);
+		if (hit) {
+			hit_count_++;
+			hit_compile_time_ += time;
+		}
+		else {
+			miss_count_++;
+			miss_compile_time_ += time;
+		}
+	}
+
+	void CodeCache::GetModuleStatus(Json::Value &data) {
+		utils::MutexGuard guard(mutex_);
+		data["capacity"] = capacity_;
+		data["persist"] = persist_;
+		data["count"] = (Json::UInt64)index_.size();
+		data["size"] = size_;
+		data["hit_count"] = hit_count_;
+		data["miss_count"] = miss_count_;
+		data["hit_rate"] = utils::String::Format("%.2f%%", hit_count_ + miss_count_ > 0 ? 100.0 * hit_count_ / (hit_count_ + miss_count_) : 0.0);
+		data["load_count"] = load_count_;
+		data["rejected_count"] = rejected_count_;
+		data["eviction_count"] = eviction_count_;
+		data["pending_count"] = pending_count_;
+		data["hit_compile_time"] = utils::String::Format(FMT_I64 " ms", hit_compile_time_ / utils::MICRO_UNITS_PER_MILLI);
+		data["miss_compile_time"] = utils::String::Format(FMT_I64 " ms", miss_compile_time_ / utils::MICRO_UNITS_PER_MILLI);
+	}
+
+	void CodeCache::Insert(const std::string &key, std::shared_ptr<const std::string> data) {
+		EntryMap::iterator iter = index_.find(key);
+		if (iter != index_.end()) {
+			size_ -= iter->second->data_->size();
+			iter->second->data_ = data;
+			entries_.splice(entries_.begin(), entries_, iter->second);
+		}
+		else {
+			Entry entry;
+			entry.key_ = key;
+			entry.data_ = data;
+			entries_.push_front(entry);
+			index_.insert(std::make_pair(key, entries_.begin()));
+		}
+		size_ += data->size();
+		Evict();
+	}
+
+	void CodeCache::Evict() {
+		while (size_ > capacity_ && !entries_.empty()) {
+			if (persist_) {
+				pending_->Delete(DbKey(entries_.back().key_));
+				pending_count_++;
+			}
+			size_ -= entries_.back().data_->size();
+			index_.erase(entries_.back().key_);
+			entries_.pop_back();
+			eviction_count_++;
+		}
+	}
+
+	void CodeCache::Load() {
+		KeyValueDb *db = Storage::Instance().keyvalue_db();
+		KVDB::Iterator *iter = (KVDB::Iterator *)db->NewIterator();
+		if (iter == NULL) {
+			return;
+		}
+
+		std::string prefix = utils::String::Format("%s_", General::CODE_CACHE_PREFIX);
+		utils::MutexGuard guard(mutex_);
+		for (iter->Seek(prefix); iter->Valid() && iter->key().starts_with(prefix); iter->Next()) {
+			std::string key = utils::String::HexStringToBin(iter->key().ToString().substr(prefix.size()));
+			Insert(key, std::make_shared<std::string>(iter->value().ToString()));
+			load_count_++;
+		}
+		delete iter;
+	}
+
+	void CodeCache::WritePending() {
+		std::shared_ptr<WRITE_BATCH> batch;
+		do {
+			utils::MutexGuard guard(mutex_);
+			if (pending_count_ == 0) {
+				return;
+			}
+			batch = pending_;
+			pending_ = std::make_shared<WRITE_BATCH>();
+			pending_count_ = 0;
+		} while (false);
+
+		KeyValueDb *db = Storage::Instance().keyvalue_db();
+		if (!db->WriteBatch(*batch, false)) {
+			LOG_ERROR("Failed to write the code cache of the contracts, %s", db->error_desc().c_str());
+		}
+	}
+
+	void CodeCache::OnSlowTimer(int64_t) {
+		WritePending();
+	}
+}
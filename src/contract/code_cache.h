@@ -0,0 +1,95 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CODE_CACHE_H_
+#define CODE_CACHE_H_
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utils/headers.h>
+#include <json/json.h>
+#include <common/general.h>
+#include <common/storage.h>
+
+namespace bumo {
+
+	//LRU cache of the V8 code cache data of the scripts compiled, keyed by the hash of the code and its origin name.
+	//A script compiled with the data is deserialized instead of parsed and compiled again.
+	//Persisted, the key value db keeps the same entries as the memory, so it survives a restart: they are loaded at
+	//startup, and the puts and the evictions are written to the db by the slow timer, not by the contracts.
+	//V8 rejects the data of another version or other flags, the script is then compiled from the source.
+	class CodeCache : public utils::Singleton<CodeCache>, public TimerNotify {
+		friend class utils::Singleton<CodeCache>;
+	public:
+		//Byte, 0 : disable the cache
+		void Initialize(int64_t capacity, bool persist);
+		//Write the pending changes of the db.
+		bool Exit();
+		bool enabled() const;
+
+		static std::string Key(const std::string &origin_name, const std::string &code);
+		//Null if the key is not cached
+		std::shared_ptr<const std::string> Get(const std::string &key);
+		void Put(const std::string &key, const std::string &data);
+		//The data was rejected by V8
+		void Remove(const std::string &key);
+
+		//hit : the script was compiled with the data cached
+		void OnCompiled(bool hit, int64_t time);
+		void GetModuleStatus(Json::Value &data);
+
+		virtual void OnTimer(int64_t) {};
+		virtual void OnSlowTimer(int64_t);
+
+	private:
+		CodeCache();
+		~CodeCache();
+
+		struct Entry {
+			std::string key_;
+			std::shared_ptr<const std::string> data_;
+		};
+		typedef std::list<Entry> EntryList;
+		typedef std::unordered_map<std::string, EntryList::iterator> EntryMap;
+
+		static std::string DbKey(const std::string &key);
+		void Insert(const std::string &key, std::shared_ptr<const std::string> data);
+		void Evict();
+		//Read the persisted entries, those over the capacity are deleted.
+		void Load();
+		void WritePending();
+
+		utils::Mutex mutex_;
+		EntryList entries_; //Most recently used at the front
+		EntryMap index_;
+		int64_t size_;
+
+		int64_t capacity_;
+		bool persist_;
+		bool registered_;
+		std::shared_ptr<WRITE_BATCH> pending_; //Changes of the db, under mutex_
+		int64_t pending_count_;
+		int64_t hit_count_;
+		int64_t miss_count_;
+		int64_t load_count_; //Read from the db at startup
+		int64_t rejected_count_;
+		int64_t eviction_count_;
+		int64_t hit_compile_time_;
+		int64_t miss_compile_time_;
+	};
+}
+
+#endif
@@ -26,12 +26,12 @@ namespace bumo{
 	ContractManager::~ContractManager() {}
 
 	bool ContractManager::Initialize(int argc, char** argv) {
-		V8Contract::Initialize(argc, argv);
-		return true;
+		return V8Contract::Initialize(argc, argv);
 	}
 
 	bool ContractManager::Exit() {
-		return true;
+		CodeCache::Instance().Exit();
+		return IsolatePool::Instance().Exit();
 	}
 
 	Result ContractManager::SourceCodeCheck(int32_t type, const std::string &code, uint32_t ldcontext_stack_size) {
@@ -97,7 +97,11 @@ namespace bumo{
 			LedgerContext *ledger_context = contract->GetParameter().ledger_context_;
 			ledger_context->PushContractId(contract->GetId());
 			contract->Execute();
-			ret = contract->GetResult();
+			//Moved out, the contract is deleted below
+			Result &result = contract->GetResult();
+			ret.set_code(result.code());
+			ret.set_desc(result.desc());
+			ret.mutable_contract_result()->swap(*result.mutable_contract_result());
 			ledger_context->PopContractId();
 			ledger_context->PushLog(contract->GetParameter().this_address_, contract->GetLogs());
 			do {
@@ -163,11 +167,12 @@ namespace bumo{
 			if (iter!= contracts_.end()) {
 				contract = iter->second;
 			} 
-		} while (false);
 
-		if (contract){
-			contract->Cancel();
-		} 
+			//Under the lock, so the contract is not deleted and its isolate not returned meanwhile
+			if (contract){
+				contract->Cancel();
+			} 
+		} while (false);
 
 		return true;
 	}
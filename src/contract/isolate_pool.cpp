@@ -0,0 +1,143 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <utils/logger.h>
+#include "isolate_pool.h"
+
+namespace bumo {
+
+	IsolatePool::IsolatePool() {
+		capacity_ = 0;
+		fresh_heap_size_ = 0;
+		leased_count_ = 0;
+		peak_leased_count_ = 0;
+		created_count_ = 0;
+		reused_count_ = 0;
+		disposed_count_ = 0;
+		create_time_ = 0;
+		reset_time_ = 0;
+	}
+
+	IsolatePool::~IsolatePool() {}
+
+	bool IsolatePool::Initialize(const v8::Isolate::CreateParams &params, size_t capacity) {
+		params_ = params;
+		capacity_ = capacity;
+
+		v8::Isolate *isolate = Create();
+		do {
+			v8::Locker locker(isolate);
+			fresh_heap_size_ = UsedHeapSize(isolate);
+		} while (false);
+		Return(isolate, false);
+
+		while (idle_.size() < capacity_) {
+			Return(Create(), false);
+		}
+		LOG_INFO("Created " FMT_SIZE " isolates for the contracts, the used heap of each is " FMT_I64 " bytes", idle_.size(), fresh_heap_size_);
+		return true;
+	}
+
+	bool IsolatePool::Exit() {
+		utils::MutexGuard guard(mutex_);
+		for (size_t i = 0; i < idle_.size(); i++) {
+			idle_[i]->Dispose();
+			disposed_count_++;
+		}
+		idle_.clear();
+		capacity_ = 0;
+		return true;
+	}
+
+	int64_t IsolatePool::UsedHeapSize(v8::Isolate *isolate) {
+		v8::HeapStatistics stats;
+		isolate->GetHeapStatistics(&stats);
+		return stats.used_heap_size();
+	}
+
+	int64_t IsolatePool::fresh_heap_size() const {
+		return fresh_heap_size_;
+	}
+
+	v8::Isolate *IsolatePool::Create() {
+		int64_t time0 = utils::Timestamp::HighResolution();
+		v8::Isolate *isolate = v8::Isolate::New(params_);
+		utils::MutexGuard guard(mutex_);
+		created_count_++;
+		create_time_ += utils::Timestamp::HighResolution() - time0;
+		return isolate;
+	}
+
+	v8::Isolate *IsolatePool::Lease() {
+		do {
+			utils::MutexGuard guard(mutex_);
+			leased_count_++;
+			peak_leased_count_ = std::max(peak_leased_count_, leased_count_);
+			if (idle_.empty()) {
+				break;
+			}
+
+			v8::Isolate *isolate = idle_.back();
+			idle_.pop_back();
+			reused_count_++;
+			return isolate;
+		} while (false);
+
+		return Create();
+	}
+
+	void IsolatePool::Return(v8::Isolate *isolate, bool terminated) {
+		int64_t time0 = utils::Timestamp::HighResolution();
+		bool reusable = !terminated && capacity_ > 0;
+		if (reusable) {
+			//Drop the garbage of the contract, so the next one starts from about the heap of a new isolate
+			//and does not collect it while it runs.
+			v8::Locker locker(isolate);
+			v8::Isolate::Scope isolate_scope(isolate);
+			isolate->ContextDisposedNotification();
+			isolate->LowMemoryNotification();
+			reusable = !isolate->IsExecutionTerminating() && UsedHeapSize(isolate) <= MAX_HEAP_SIZE;
+		}
+
+		do {
+			utils::MutexGuard guard(mutex_);
+			if (leased_count_ > 0) {
+				leased_count_--;
+			}
+			reset_time_ += utils::Timestamp::HighResolution() - time0;
+			if (reusable && idle_.size() < capacity_) {
+				idle_.push_back(isolate);
+				return;
+			}
+			disposed_count_++;
+		} while (false);
+
+		isolate->Dispose();
+	}
+
+	void IsolatePool::GetModuleStatus(Json::Value &data) {
+		utils::MutexGuard guard(mutex_);
+		data["capacity"] = (Json::UInt64)capacity_;
+		data["idle_count"] = (Json::UInt64)idle_.size();
+		data["leased_count"] = leased_count_;
+		data["peak_leased_count"] = peak_leased_count_;
+		data["created_count"] = created_count_;
+		data["reused_count"] = reused_count_;
+		data["disposed_count"] = disposed_count_;
+		data["fresh_heap_size"] = fresh_heap_size_;
+		data["create_time"] = utils::String::Format(FMT_I64 " ms", create_time_ / utils::MICRO_UNITS_PER_MILLI);
+		data["reset_time"] = utils::String::Format(FMT_I64 " ms", reset_time_ / utils::MICRO_UNITS_PER_MILLI);
+	}
+}
@@ -0,0 +1,74 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ISOLATE_POOL_H_
+#define ISOLATE_POOL_H_
+
+#include <vector>
+#include <utils/headers.h>
+#include <json/json.h>
+#include <v8.h>
+
+namespace bumo {
+
+	//Idle isolates kept for the contracts executed later, instead of creating and disposing one per contract.
+	//Leasing never waits: nested contracts hold several isolates at once, and a new isolate is created if none is idle.
+	//A returned isolate is reset by a full garbage collection and kept if the pool is not full, unless its
+	//execution was terminated or its heap stays above the limit. The reset time is reported with the creation time
+	//of the isolates it saves.
+	//Pooled isolates move between threads, so they are only used under a v8::Locker.
+	class IsolatePool : public utils::Singleton<IsolatePool> {
+		friend class utils::Singleton<IsolatePool>;
+	public:
+		//Create capacity isolates ahead. 0 : disable the pool
+		bool Initialize(const v8::Isolate::CreateParams &params, size_t capacity);
+		bool Exit();
+
+		//A reused isolate, or a new one if none is idle.
+		v8::Isolate *Lease();
+		//Called once the lock of the isolate is released. Keep the isolate reset, or dispose it.
+		void Return(v8::Isolate *isolate, bool terminated);
+		//Used heap of a new isolate
+		int64_t fresh_heap_size() const;
+
+		void GetModuleStatus(Json::Value &data);
+
+		//Called under the lock of the isolate
+		static int64_t UsedHeapSize(v8::Isolate *isolate);
+
+	private:
+		IsolatePool();
+		~IsolatePool();
+
+		v8::Isolate *Create();
+
+		v8::Isolate::CreateParams params_;
+		size_t capacity_;
+		int64_t fresh_heap_size_; //Used heap of a new isolate
+		const static int64_t MAX_HEAP_SIZE = 8 * utils::BYTES_PER_MEGA;
+
+		utils::Mutex mutex_;
+		std::vector<v8::Isolate *> idle_;
+		int64_t leased_count_;
+		int64_t peak_leased_count_;
+		int64_t created_count_;
+		int64_t reused_count_;
+		int64_t disposed_count_;
+		int64_t create_time_;
+		int64_t reset_time_;
+	};
+}
+
+#endif
@@ -6,6 +6,11 @@ namespace bumo {
 	#define ORIGIN_OBJ "Origin"
 	#define BLOCKCHAIN_OBJ "Chain"
 	#define UTILS_OBJ "Utils"
+	//Context embedder data of the functions of Chain and Utils
+	#define BLOCKCHAIN_FUNCTIONS_SLOT 1
+	#define UTILS_FUNCTIONS_SLOT 2
+	//Isolate data of the contract leasing the isolate
+	#define CONTRACT_DATA_SLOT 0
 	#define ToV8Int32(a) (v8::Int32::New(isolate_, (a)))
 	#define ToV8Number(a) (v8::Number::New(isolate_, (double)(a)))
 	#define ToV8String(a) (v8::String::NewFromUtf8(isolate_, (a), v8::NewStringType::kNormal).ToLocalChecked())
@@ -37,24 +42,37 @@ namespace bumo {
 	//for check source
 	const std::string V8Contract::call_jslint_ = "callJslint";
 
-	utils::Mutex V8Contract::isolate_to_contract_mutex_;
-	std::unordered_map<v8::Isolate*, V8Contract *> V8Contract::isolate_to_contract_;
-
 	v8::Platform* V8Contract::platform_ = nullptr;
 	v8::Isolate::CreateParams V8Contract::create_params_;
+	v8::StartupData V8Contract::snapshot_blob_ = { NULL, 0 };
+	size_t V8Contract::snapshot_contexts_[2] = { 0, 0 };
+	std::vector<intptr_t> V8Contract::external_references_;
 
 	V8Contract::V8Contract(bool readonly, const ContractParameter &parameter) : Contract(readonly, parameter) {
 		type_ = TYPE_V8;
-		isolate_ = v8::Isolate::New(create_params_);
-
-		utils::MutexGuard guard(isolate_to_contract_mutex_);
-		isolate_to_contract_[isolate_] = this;
+		//"VERSION CHECKING condition" may be removed after version 1003
+		pooled_ = CHECK_VERSION_GT_1002;
+		isolate_ = pooled_ ? IsolatePool::Instance().Lease() : v8::Isolate::New(create_params_);
+		locker_ = new v8::Locker(isolate_);
+		terminated_ = false;
+		heap_base_ = 0;
+		if (pooled_) {
+			//The growth from the lease plus the heap of a new isolate, whether the isolate is new or reused
+			heap_base_ = IsolatePool::UsedHeapSize(isolate_) - IsolatePool::Instance().fresh_heap_size();
+		}
+		isolate_->SetData(CONTRACT_DATA_SLOT, this);
 	}
 
 	V8Contract::~V8Contract() {
-		utils::MutexGuard guard(isolate_to_contract_mutex_);
-		isolate_to_contract_.erase(isolate_);
-		isolate_->Dispose();
+		isolate_->SetData(CONTRACT_DATA_SLOT, NULL);
+		delete locker_;
+		locker_ = NULL;
+		if (pooled_) {
+			IsolatePool::Instance().Return(isolate_, terminated_);
+		}
+		else {
+			isolate_->Dispose();
+		}
 		isolate_ = NULL;
 	}
 
@@ -214,6 +232,17 @@ namespace bumo {
 		create_params_.array_buffer_allocator =
 			v8::ArrayBuffer::Allocator::NewDefaultAllocator();
 
+		//The isolates of the ledgers up to version 1001 are created without the snapshot, as before
+		v8::Isolate::CreateParams pool_params = create_params_;
+		if (!CreateSnapshot(pool_params)) {
+			return false;
+		}
+		if (!IsolatePool::Instance().Initialize(pool_params, Configure::Instance().ledger_configure_.isolate_pool_size_)) {
+			LOG_ERROR("Failed to initialize the isolate pool of the contracts");
+			return false;
+		}
+		CodeCache::Instance().Initialize(Configure::Instance().ledger_configure_.code_cache_size_, Configure::Instance().ledger_configure_.code_cache_persist_);
+
 		return true;
 	}
 
@@ -227,7 +256,6 @@ namespace bumo {
 		SetV8InterfaceFunc(context, false);
 		CreateJsObject(context, false);
 
-		v8::Local<v8::String> v8src = ToV8String(parameter_.code_.c_str());
 		v8::Local<v8::Script> compiled_script;
 
 		std::string fn_name = parameter_.init_ ? init_name_ : main_name_;
@@ -244,9 +272,7 @@ namespace bumo {
 				break;
 			}
 
-			v8::ScriptOrigin origin_check_time_name(ToV8String("__enable_check_time__"));
-
-			if (!v8::Script::Compile(context, v8src, &origin_check_time_name).ToLocal(&compiled_script)) {
+			if (!CompileScript(context, parameter_.code_, "__enable_check_time__", compiled_script)) {
 				//"VERSION CHECKING condition" may be removed after version 1002
 				if (CHECK_VERSION_GT_1001) {
 					result_.set_code(protocol::ERRCODE_CONTRACT_EXECUTE_FAIL);
@@ -301,7 +327,7 @@ namespace bumo {
 
 			Json::Value temp_result;
 			JsValueToCppJson(context, callresult, temp_result);
-			result_.set_contract_result(temp_result);
+			result_.mutable_contract_result()->swap(temp_result);
 
 			return true;
 		} while (false);
@@ -315,6 +341,7 @@ namespace bumo {
 	}
 
 	bool V8Contract::Cancel() {
+		terminated_ = true;
 		v8::V8::TerminateExecution(isolate_);
 		return true;
 	}
@@ -338,9 +365,8 @@ namespace bumo {
 			return false;
 		}
 
-		v8::Local<v8::String> v8src = ToV8String(find_jslint_source->second.c_str());
 		v8::Local<v8::Script> compiled_script;
-		if (!v8::Script::Compile(context, v8src).ToLocal(&compiled_script)) {
+		if (!CompileScript(context, find_jslint_source->second, NULL, compiled_script)) {
 			result_.set_code(protocol::ERRCODE_CONTRACT_SYNTAX_ERROR);
 			result_.set_desc(ReportException(isolate_, &try_catch).toFastString());
 			LOG_ERROR("%s", result_.desc().c_str());
@@ -422,7 +448,6 @@ namespace bumo {
 		v8::Context::Scope context_scope(context);
 		SetV8InterfaceFunc(context, true);
 		CreateJsObject(context, true);
-		v8::Local<v8::String> v8src = ToV8String(parameter_.code_.c_str());
 		v8::Local<v8::Script> compiled_script;
 
 		Json::Value error_desc_f;
@@ -432,9 +457,7 @@ namespace bumo {
 				break;
 			}
 
-			v8::ScriptOrigin origin_check_time_name(ToV8String("__enable_check_time__"));
-
-			if (!v8::Script::Compile(context, v8src, &origin_check_time_name).ToLocal(&compiled_script)) {
+			if (!CompileScript(context, parameter_.code_, "__enable_check_time__", compiled_script)) {
 				error_desc_f = ReportException(isolate_, &try_catch);
 				break;
 			}
@@ -469,7 +492,7 @@ namespace bumo {
 			}
 
 			JsValueToCppJson(context, callRet, temp_result);
-			js_result["result"] = temp_result;
+			js_result["result"].swap(temp_result);
 			return true;
 		} while (false);
 
@@ -528,27 +551,47 @@ namespace bumo {
 
 		//blockchain.function
 		block_chain_obj->Set(ToV8String("thisAddress"), ToV8String(parameter_.this_address_.c_str()));
-		SetV8ObjectFunc(block_chain_obj, js_obj_[BLOCKCHAIN_OBJ].read_);
-		if (!readonly) {
-			SetV8ObjectFunc(block_chain_obj, js_obj_[BLOCKCHAIN_OBJ].write_);
+		if (!CopyV8ObjectFunc(context, block_chain_obj, BLOCKCHAIN_FUNCTIONS_SLOT)) {
+			SetV8ObjectFunc(isolate_, block_chain_obj, js_obj_[BLOCKCHAIN_OBJ].read_);
+			if (!readonly) {
+				SetV8ObjectFunc(isolate_, block_chain_obj, js_obj_[BLOCKCHAIN_OBJ].write_);
+			}
 		}
 		context->Global()->Set(context, ToV8String(BLOCKCHAIN_OBJ), block_chain_obj);
 
 		//for Utils
 		v8::Local<v8::Object> utils_obj = v8::Object::New(isolate_);
-		SetV8ObjectFunc(utils_obj, js_obj_[UTILS_OBJ].read_);
-		if (!readonly) {
-			SetV8ObjectFunc(utils_obj, js_obj_[UTILS_OBJ].write_);
+		if (!CopyV8ObjectFunc(context, utils_obj, UTILS_FUNCTIONS_SLOT)) {
+			SetV8ObjectFunc(isolate_, utils_obj, js_obj_[UTILS_OBJ].read_);
+			if (!readonly) {
+				SetV8ObjectFunc(isolate_, utils_obj, js_obj_[UTILS_OBJ].write_);
+			}
 		}
 		context->Global()->Set(context, ToV8String(UTILS_OBJ), utils_obj);
 	}
 
-	void V8Contract::SetV8ObjectFunc(v8::Local<v8::Object> object, JsFunctions &js_functions){
+	void V8Contract::SetV8ObjectFunc(v8::Isolate* isolate, v8::Local<v8::Object> object, JsFunctions &js_functions){
 		for (JsFunctions::iterator itr = js_functions.begin(); itr != js_functions.end(); itr++) {
-			object->Set(ToV8String(itr->first.c_str()), v8::Function::New(isolate_, itr->second));
+			object->Set(ToV8StringStatic(isolate, itr->first.c_str()), v8::Function::New(isolate, itr->second));
 		}
 	}
 
+	bool V8Contract::CopyV8ObjectFunc(v8::Local<v8::Context> context, v8::Local<v8::Object> object, int slot){
+		v8::Local<v8::Value> functions_value = context->GetEmbedderData(slot);
+		if (!functions_value->IsObject()) {
+			return false;
+		}
+
+		//In the order they were set, the same as SetV8ObjectFunc
+		v8::Local<v8::Object> functions = v8::Local<v8::Object>::Cast(functions_value);
+		v8::Local<v8::Array> names = functions->GetOwnPropertyNames(context).ToLocalChecked();
+		for (uint32_t i = 0; i < names->Length(); i++) {
+			v8::Local<v8::Value> name = names->Get(context, i).ToLocalChecked();
+			object->Set(context, name, functions->Get(context, name).ToLocalChecked());
+		}
+		return true;
+	}
+
 	void V8Contract::SetV8InterfaceFunc(v8::Local<v8::Context> context, bool readonly){
 		//for sender, this address, tx index, block number, timestamp
 		context->Global()->Set(context, ToV8String(sender_name_.c_str()), ToV8String(parameter_.msg_.sender_.c_str()));
@@ -576,13 +619,8 @@ namespace bumo {
 	}
 
 	V8Contract *V8Contract::GetContractFrom(v8::Isolate* isolate) {
-		utils::MutexGuard guard(isolate_to_contract_mutex_);
-		std::unordered_map<v8::Isolate*, V8Contract *>::iterator iter = isolate_to_contract_.find(isolate);
-		if (iter != isolate_to_contract_.end()) {
-			return iter->second;
-		}
-
-		return NULL;
+		//Only the thread holding the lock of the isolate calls back, no other lock is needed
+		return (V8Contract *)isolate->GetData(CONTRACT_DATA_SLOT);
 	}
 
 	bool V8Contract::RemoveRandom(v8::Isolate* isolate, Json::Value &error_msg) {
@@ -607,7 +645,140 @@ namespace bumo {
 		return true;
 	}
 
+	bool V8Contract::CompileScript(v8::Local<v8::Context> context, const std::string &code, const char *origin_name, v8::Local<v8::Script> &script) {
+		v8::Isolate *isolate = context->GetIsolate();
+		CodeCache &code_cache = CodeCache::Instance();
+		//"VERSION CHECKING condition" may be removed after version 1003
+		//Only the contracts in a pooled isolate, after version 1002, use the cache. Their memory does not count the compilation,
+		//which allocates differently whether the data is cached or not.
+		V8Contract *contract = GetContractFrom(isolate);
+		bool pooled = contract != NULL && contract->pooled_;
+		bool use_cache = pooled && code_cache.enabled();
+		int64_t heap0 = pooled ? IsolatePool::UsedHeapSize(isolate) : 0;
+
+		std::string key;
+		std::shared_ptr<const std::string> data;
+		v8::ScriptCompiler::CachedData *cached_data = NULL;
+		v8::ScriptCompiler::CompileOptions options = v8::ScriptCompiler::kNoCompileOptions;
+		if (use_cache) {
+			key = CodeCache::Key(origin_name ? origin_name : "", code);
+			data = code_cache.Get(key);
+			if (data) {
+				//Not owned by the source, the data is kept until the script is compiled
+				cached_data = new v8::ScriptCompiler::CachedData((const uint8_t *)data->data(), (int)data->size());
+				options = v8::ScriptCompiler::kConsumeCodeCache;
+			}
+			else {
+				options = v8::ScriptCompiler::kProduceCodeCache;
+			}
+		}
+
+		v8::ScriptOrigin origin(origin_name ? ToV8StringStatic(isolate, origin_name) : v8::Local<v8::String>());
+		v8::ScriptCompiler::Source source(ToV8StringStatic(isolate, code.c_str()), origin, cached_data);
+		int64_t time0 = utils::Timestamp::HighResolution();
+		bool compiled = v8::ScriptCompiler::Compile(context, &source, options).ToLocal(&script);
+		if (pooled) {
+			contract->heap_base_ += IsolatePool::UsedHeapSize(isolate) - heap0;
+		}
+		if (!compiled) {
+			return false;
+		}
+
+		if (use_cache) {
+			bool hit = cached_data != NULL && !source.GetCachedData()->rejected;
+			if (cached_data != NULL && !hit) {
+				code_cache.Remove(key);
+			}
+			else if (cached_data == NULL && source.GetCachedData() != NULL) {
+				code_cache.Put(key, std::string((const char *)source.GetCachedData()->data, source.GetCachedData()->length));
+			}
+			code_cache.OnCompiled(hit, utils::Timestamp::HighResolution() - time0);
+		}
+		return true;
+	}
+
+	std::string V8Contract::FunctionsName(const char *object_name) {
+		return utils::String::Format("__%s_functions__", object_name);
+	}
+
+	bool V8Contract::CreateSnapshot(v8::Isolate::CreateParams &params) {
+		for (std::map<std::string, JsFuncList>::iterator iter = js_obj_.begin(); iter != js_obj_.end(); iter++) {
+			for (JsFunctions::iterator itr = iter->second.read_.begin(); itr != iter->second.read_.end(); itr++) {
+				external_references_.push_back((intptr_t)itr->second);
+			}
+			for (JsFunctions::iterator itr = iter->second.write_.begin(); itr != iter->second.write_.end(); itr++) {
+				external_references_.push_back((intptr_t)itr->second);
+			}
+		}
+		external_references_.push_back(0);
+
+		v8::SnapshotCreator creator(external_references_.data());
+		v8::Isolate *isolate = creator.GetIsolate();
+		do {
+			v8::HandleScope handle_scope(isolate);
+			creator.SetDefaultContext(v8::Context::New(isolate));
+			for (int readonly = 0; readonly < 2; readonly++) {
+				v8::Local<v8::Context> context = NewContext(isolate, readonly != 0);
+				v8::Context::Scope context_scope(context);
+
+				//Kept on the global until the context is created from the snapshot
+				const char *objects[] = { BLOCKCHAIN_OBJ, UTILS_OBJ };
+				for (size_t i = 0; i < sizeof(objects) / sizeof(objects[0]); i++) {
+					v8::Local<v8::Object> functions = v8::Object::New(isolate);
+					SetV8ObjectFunc(isolate, functions, js_obj_[objects[i]].read_);
+					if (!readonly) {
+						SetV8ObjectFunc(isolate, functions, js_obj_[objects[i]].write_);
+					}
+					context->Global()->Set(context, ToV8StringStatic(isolate, FunctionsName(objects[i]).c_str()), functions);
+				}
+				snapshot_contexts_[readonly] = creator.AddContext(context);
+			}
+		} while (false);
+
+		snapshot_blob_ = creator.CreateBlob(v8::SnapshotCreator::FunctionCodeHandling::kClear);
+		if (snapshot_blob_.data == NULL) {
+			LOG_ERROR("Failed to create the startup snapshot of the contracts");
+			return false;
+		}
+
+		params.snapshot_blob = &snapshot_blob_;
+		params.external_references = external_references_.data();
+		LOG_INFO("Created the startup snapshot of the contracts, size(%d)", snapshot_blob_.raw_size);
+		return true;
+	}
+
 	v8::Local<v8::Context> V8Contract::CreateContext(v8::Isolate* isolate, bool readonly) {
+		//"VERSION CHECKING condition" may be removed after version 1003
+		//Only the pooled isolates, after version 1002, have the snapshot. The memory of their contracts does not count the context,
+		//which allocates differently from the snapshot.
+		V8Contract *contract = GetContractFrom(isolate);
+		bool pooled = contract != NULL && contract->pooled_;
+		int64_t heap0 = pooled ? IsolatePool::UsedHeapSize(isolate) : 0;
+
+		v8::Local<v8::Context> context;
+		if (!pooled || !v8::Context::FromSnapshot(isolate, snapshot_contexts_[readonly ? 1 : 0]).ToLocal(&context)) {
+			context = NewContext(isolate, readonly);
+			context->SetEmbedderData(BLOCKCHAIN_FUNCTIONS_SLOT, v8::Undefined(isolate));
+			context->SetEmbedderData(UTILS_FUNCTIONS_SLOT, v8::Undefined(isolate));
+		}
+		else {
+			//Take the functions off the global, so the contract sees the same global as without the snapshot
+			v8::Local<v8::Object> global = context->Global();
+			v8::Local<v8::String> chain_name = ToV8StringStatic(isolate, FunctionsName(BLOCKCHAIN_OBJ).c_str());
+			v8::Local<v8::String> utils_name = ToV8StringStatic(isolate, FunctionsName(UTILS_OBJ).c_str());
+			context->SetEmbedderData(BLOCKCHAIN_FUNCTIONS_SLOT, global->Get(context, chain_name).ToLocalChecked());
+			context->SetEmbedderData(UTILS_FUNCTIONS_SLOT, global->Get(context, utils_name).ToLocalChecked());
+			global->Delete(context, chain_name);
+			global->Delete(context, utils_name);
+		}
+
+		if (pooled) {
+			contract->heap_base_ += IsolatePool::UsedHeapSize(isolate) - heap0;
+		}
+		return context;
+	}
+
+	v8::Local<v8::Context> V8Contract::NewContext(v8::Isolate* isolate, bool readonly) {
 		// Create a template for the global object.
 		v8::Local<v8::ObjectTemplate> global = v8::ObjectTemplate::New(isolate);
 		JsFunctions &read_funcs = js_obj_[ORIGIN_OBJ].read_;
@@ -689,8 +860,11 @@ namespace bumo {
 			jsonvalue["value"] = jsvalue->BooleanValue();
 		}
 		else if (jsvalue->IsString()) {
+			//Copied once from the utf8 buffer, large query results are passed through several levels
+			v8::String::Utf8Value utf8_value(jsvalue);
+			Json::Value value(ToCString(utf8_value));
 			jsonvalue["type"] = "string";
-			jsonvalue["value"] = std::string(ToCString(v8::String::Utf8Value(jsvalue)));
+			jsonvalue["value"].swap(value);
 		}
 		else {
 			jsonvalue["type"] = "bool";
@@ -735,12 +909,8 @@ namespace bumo {
 			v8::TryCatch try_catch(args.GetIsolate());
 			std::string js_file = find_source->second; //load_file(*str);
 
-			v8::Local<v8::String> source = ToV8StringStatic(args.GetIsolate(), js_file.c_str());
 			v8::Local<v8::Script> script;
-
-			v8::ScriptOrigin origin_check_time_name(ToV8StringStatic(args.GetIsolate()->GetCurrentContext()->GetIsolate(), "__enable_check_time__"));
-
-			if (!v8::Script::Compile(args.GetIsolate()->GetCurrentContext(), source, &origin_check_time_name).ToLocal(&script)) {
+			if (!CompileScript(args.GetIsolate()->GetCurrentContext(), js_file, "__enable_check_time__", script)) {
 				ReportException(args.GetIsolate(), &try_catch);
 				break;
 			}
@@ -765,7 +935,7 @@ namespace bumo {
 			//Check the storage
 			v8::HeapStatistics stats;
 			args.GetIsolate()->GetHeapStatistics(&stats);
-			ptr->SetMemoryUsage(stats.used_heap_size());
+			ptr->SetMemoryUsage(std::max((int64_t)stats.used_heap_size() - v8_contract->heap_base_, (int64_t)0));
 
 			//Check the stack
 			v8::V8InternalInfo internal_info;
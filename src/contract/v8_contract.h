@@ -1,7 +1,10 @@
 #ifndef V8_CONTRACT_H_
 #define V8_CONTRACT_H_
 
+#include <atomic>
 #include "contract.h"
+#include "isolate_pool.h"
+#include "code_cache.h"
 
 #include <v8.h>
 #include <libplatform/libplatform.h>
@@ -11,6 +14,10 @@
 namespace bumo {
 	class V8Contract : public Contract {
 		v8::Isolate* isolate_;
+		v8::Locker* locker_; //Held while the isolate is leased
+		bool pooled_; //The isolate is leased from the pool, after version 1002
+		int64_t heap_base_; //Subtracted from the used heap to measure the memory of the contract
+		std::atomic<bool> terminated_; //Set by Cancel in another thread
 	public:
 		V8Contract(bool readonly, const ContractParameter &parameter);
 		virtual ~V8Contract();
@@ -21,6 +28,10 @@ namespace bumo {
 		virtual bool SourceCodeCheck();
 		static bool Initialize(int argc, char** argv);
 
+		//The results passed between the contracts and the node, {"type": bool/string, "value": ...}
+		static bool JsValueToCppJson(v8::Handle<v8::Context>& context, v8::Local<v8::Value>& jsvalue, Json::Value& jsonvalue);
+		static bool CppJsonToJsValue(v8::Isolate* isolate, const Json::Value& jsonvalue, v8::Local<v8::Value>& jsvalue);
+
 	private:
 		static bool LoadJsFuncList();
 		static bool LoadJsLibSource();
@@ -57,15 +68,24 @@ namespace bumo {
 		//for check source
 		static const std::string call_jslint_;
 
-		static utils::Mutex isolate_to_contract_mutex_;
-		static std::unordered_map<v8::Isolate*, V8Contract *> isolate_to_contract_;
-
 		static v8::Platform* 	platform_;
 		static v8::Isolate::CreateParams create_params_;
 
+		//Startup snapshot of the contexts, the global functions installed and the functions of Chain and Utils
+		//kept aside. Indexed by readonly.
+		static v8::StartupData snapshot_blob_;
+		static size_t snapshot_contexts_[2];
+		static std::vector<intptr_t> external_references_;
+		//Set the snapshot to the params of the pooled isolates
+		static bool CreateSnapshot(v8::Isolate::CreateParams &params);
+		static v8::Local<v8::Context> NewContext(v8::Isolate* isolate, bool readonly);
+		static std::string FunctionsName(const char *object_name);
+
 		static protocol::AssetKey GetAssetFromJsObject(v8::Isolate* isolate, v8::Local<v8::Object> js_object);
 		static bool RemoveRandom(v8::Isolate* isolate, Json::Value &error_msg);
 		static v8::Local<v8::Context> CreateContext(v8::Isolate* isolate, bool readonly);
+		//Compile with the code cache data of the code if any, or keep the data produced. origin_name may be null.
+		static bool CompileScript(v8::Local<v8::Context> context, const std::string &code, const char *origin_name, v8::Local<v8::Script> &script);
 		static V8Contract *GetContractFrom(v8::Isolate* isolate);
 		static Json::Value ReportException(v8::Isolate* isolate, v8::TryCatch* try_catch);
 		static const char* ToCString(const v8::String::Utf8Value& value);
@@ -92,8 +112,6 @@ namespace bumo {
 		static void CallBackGetContractProperty(const v8::FunctionCallbackInfo<v8::Value>& args);
 
 		static V8Contract *UnwrapContract(v8::Local<v8::Object> obj);
-		static bool JsValueToCppJson(v8::Handle<v8::Context>& context, v8::Local<v8::Value>& jsvalue, Json::Value& jsonvalue);
-		static bool CppJsonToJsValue(v8::Isolate* isolate, const Json::Value& jsonvalue, v8::Local<v8::Value>& jsvalue);
 		static void CallBackConfigFee(const v8::FunctionCallbackInfo<v8::Value>& args);
 		//Assert an expression.
 		static void CallBackAssert(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -152,7 +170,9 @@ namespace bumo {
 
 		void SetV8InterfaceFunc(v8::Local<v8::Context> context, bool readonly);
 		void CreateJsObject(v8::Local<v8::Context> context, bool readonly);
-		void SetV8ObjectFunc(v8::Local<v8::Object> object, JsFunctions &js_functions);
+		static void SetV8ObjectFunc(v8::Isolate* isolate, v8::Local<v8::Object> object, JsFunctions &js_functions);
+		//Copy the functions of the object from the snapshot. False if the context is not from the snapshot.
+		static bool CopyV8ObjectFunc(v8::Local<v8::Context> context, v8::Local<v8::Object> object, int slot);
 	};
 }
 
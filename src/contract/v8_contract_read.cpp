@@ -236,7 +236,7 @@ namespace bumo {
 				break;
 			}
 
-			Json::Value js_object = query_result["result"];
+			const Json::Value &js_object = query_result["result"];
 			v8::Local<v8::Value> v8_result;
 			CppJsonToJsValue(args.GetIsolate(), js_object, v8_result);
 			obj->Set(v8::String::NewFromUtf8(args.GetIsolate(), "result"), v8_result);
@@ -331,7 +331,7 @@ namespace bumo {
 				obj->Set(v8::String::NewFromUtf8(args.GetIsolate(), "error"), flag);
 			}
 			else {
-				Json::Value js_object = query_result["result"];
+				const Json::Value &js_object = query_result["result"];
 				v8::Local<v8::Value> v8_result;
 				CppJsonToJsValue(args.GetIsolate(), js_object, v8_result);
 				obj->Set(v8::String::NewFromUtf8(args.GetIsolate(), "result"), v8_result);
@@ -407,7 +407,7 @@ namespace bumo {
 				break;
 			}
 
-			Json::Value js_object = query_result["result"];
+			const Json::Value &js_object = query_result["result"];
 			v8::Local<v8::Value> v8_result;
 			CppJsonToJsValue(args.GetIsolate(), js_object, v8_result);
 			obj->Set(v8::String::NewFromUtf8(args.GetIsolate(), "result"), v8_result);
@@ -431,13 +431,28 @@ namespace bumo {
 			v8::HandleScope handle_scope(args.GetIsolate());
 			V8Contract *v8_contract = GetContractFrom(args.GetIsolate());
 
-			Json::Value jsonValidators;
 			LedgerContext *ledger_context = v8_contract->GetParameter().ledger_context_;
-			jsonValidators = ledger_context->GetTopTx()->environment_->GetValidators();
-
-			std::string strvalue = jsonValidators.toFastString();
-			v8::Local<v8::String> returnvalue = v8::String::NewFromUtf8(args.GetIsolate(), strvalue.c_str(), v8::NewStringType::kNormal).ToLocalChecked();
-			args.GetReturnValue().Set(v8::JSON::Parse(returnvalue));
+			const Environment::ValidatorSetting &setting = ledger_context->GetTopTx()->environment_->GetValidators();
+			if (setting.json_) {
+				//The value set by the contract in this ledger, as it was passed
+				std::string strvalue = setting.json_->toFastString();
+				v8::Local<v8::String> jsonvalue = v8::String::NewFromUtf8(args.GetIsolate(), strvalue.c_str(), v8::NewStringType::kNormal).ToLocalChecked();
+				args.GetReturnValue().Set(v8::JSON::Parse(jsonvalue));
+				return;
+			}
+
+			const protocol::ValidatorSet &validators = setting.validators_;
+
+			//[[address, pledge_coin_amount], ...], the amount as a string.
+			v8::Local<v8::Array> returnvalue = v8::Array::New(args.GetIsolate(), validators.validators_size());
+			for (int i = 0; i < validators.validators_size(); i++) {
+				const protocol::Validator &validator = validators.validators(i);
+				v8::Local<v8::Array> item = v8::Array::New(args.GetIsolate(), 2);
+				item->Set(0, v8::String::NewFromUtf8(args.GetIsolate(), validator.address().c_str(), v8::NewStringType::kNormal).ToLocalChecked());
+				item->Set(1, v8::String::NewFromUtf8(args.GetIsolate(), utils::String::ToString(validator.pledge_coin_amount()).c_str(), v8::NewStringType::kNormal).ToLocalChecked());
+				returnvalue->Set(i, item);
+			}
+			args.GetReturnValue().Set(returnvalue);
 
 			return;
 		} while (false);
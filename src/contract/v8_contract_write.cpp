@@ -35,7 +35,20 @@ namespace bumo {
 
 			LedgerContext *ledger_context = v8_contract->GetParameter().ledger_context_;
 			LOG_INFO("UpdateFee: bottom tx(%s), top tx(%s), result(%s)", utils::String::BinToHexString(ledger_context->GetBottomTx()->GetContentHash()).c_str(), utils::String::BinToHexString(ledger_context->GetTopTx()->GetContentHash()).c_str(), json.toFastString().c_str());
-			ledger_context->GetTopTx()->environment_->UpdateFeeConfig(json);
+			bool updated = true;
+			for (auto it = json.begin(); it != json.end(); it++) {
+				protocol::FeeConfig_Type fee_type = (protocol::FeeConfig_Type)utils::String::Stoi(it.memberName());
+				//"VERSION CHECKING condition" may be removed after version 1003
+				//The ledgers up to version 1002 ignore the unknown fee types.
+				if (!ledger_context->GetTopTx()->environment_->UpdateFeeConfig(fee_type, (*it).asInt64()) && CHECK_VERSION_GT_1002) {
+					error_desc = utils::String::Format("Failed to update the fee config(%s)", it.memberName());
+					updated = false;
+					break;
+				}
+			}
+			if (!updated) {
+				break;
+			}
 			args.GetReturnValue().Set(true);
 			return;
 		} while (false);
@@ -274,7 +287,13 @@ namespace bumo {
 			}
 
 			LedgerContext *ledger_context = v8_contract->GetParameter().ledger_context_;
-			ledger_context->GetTopTx()->environment_->UpdateNewValidators(json);
+			protocol::ValidatorSet validators;
+			for (Json::Value::UInt i = 0; i < json.size(); i++) {
+				protocol::Validator *validator = validators.add_validators();
+				validator->set_address(json[i][(Json::Value::UInt)0].asString());
+				validator->set_pledge_coin_amount(utils::String::Stoi64(json[i][1].asString()));
+			}
+			ledger_context->GetTopTx()->environment_->UpdateNewValidators(validators, json);
 			args.GetReturnValue().Set(true);
 			return;
 		} while (false);
@@ -339,6 +339,10 @@ namespace bumo {
 			|| iter != hardfork_points_.end());
 	}
 
+	bool GlueManager::CheckProof(const protocol::ValidatorSet &validators, const std::string &value_hash, const std::string &proof) {
+		return consensus_->CheckProof(validators, value_hash, proof);
+	}
+
 	int32_t GlueManager::CheckValue(const std::string &value) {
 		protocol::ConsensusValue consensus_value;
 		if (!consensus_value.ParseFromString(value)) {
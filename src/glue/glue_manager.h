@@ -76,6 +76,8 @@ namespace bumo {
 
 		//Should be called by the ledger manager.
 		bool CheckValueAndProof( const std::string &consensus_value, const std::string &proof);
+		//Check the proof against the given validators instead of the ones in the database.
+		bool CheckProof(const protocol::ValidatorSet &validators, const std::string &value_hash, const std::string &proof);
 		int32_t CheckValueHelper(const protocol::ConsensusValue &consensus_value, int64_t now);
 		size_t GetTransactionCacheSize();
 		void QueryTransactionCache(const uint32_t& num, std::vector<TransactionFrm::pointer>& txs);
@@ -28,7 +28,7 @@ namespace bumo {
 	//}
 
 	AccountFrm::AccountFrm(protocol::Account account_info) 
-		: account_info_(account_info) {
+		: account_info_(account_info), assets_dirty_(false), metadata_dirty_(false) {
 		utils::AtomicInc(&bumo::General::account_new_count);
 	}
 
@@ -36,6 +36,10 @@ namespace bumo {
 		account_info_.CopyFrom(account->ProtocolAccount());
 		assets_ = account->assets_;
 		metadata_ = account->metadata_;
+		snapshot_ = account->snapshot_;
+		stored_ = account->stored_;
+		assets_dirty_ = account->assets_dirty_;
+		metadata_dirty_ = account->metadata_dirty_;
 	}
 
 	AccountFrm::~AccountFrm() {
@@ -181,11 +185,30 @@ namespace bumo {
 		result = bumo::Proto2Json(account_info_);
 	}
 
+	void AccountFrm::SetSnapshot(std::shared_ptr<StorageSnapshot> snapshot) {
+		snapshot_ = snapshot;
+	}
+
+	void AccountFrm::SetStored(std::shared_ptr<const std::string> stored) {
+		stored_ = stored;
+	}
+
+	bool AccountFrm::IsStored(const std::string &serialized) const {
+		return stored_ != nullptr && *stored_ == serialized;
+	}
+
+	bool AccountFrm::InitTrie(KVTrie &trie, const std::string &prefix) {
+		auto batch = std::make_shared<WRITE_BATCH>();
+		if (snapshot_ != nullptr) {
+			return trie.Init(snapshot_->account_db_.get(), batch, prefix, 1, snapshot_->seq_);
+		}
+		return trie.Init(Storage::Instance().account_db(), batch, prefix, 1);
+	}
+
 	void AccountFrm::GetAllAssets(std::vector<protocol::AssetStore>& assets){
 		KVTrie trie;
-		auto batch = std::make_shared<WRITE_BATCH>();
 		std::string prefix = ComposePrefix(General::ASSET_PREFIX, DecodeAddress(account_info_.address()));
-		trie.Init(Storage::Instance().account_db(), batch, prefix, 1);
+		InitTrie(trie, prefix);
 		std::vector<std::string> values;
 		trie.GetAll("", values);
 		for (size_t i = 0; i < values.size(); i++){
@@ -197,9 +220,8 @@ namespace bumo {
 
 	void AccountFrm::GetAllMetaData(std::vector<protocol::KeyPair>& metadata){
 		KVTrie trie;
-		auto batch = std::make_shared<WRITE_BATCH>();
 		std::string prefix = ComposePrefix(General::METADATA_PREFIX, DecodeAddress(account_info_.address()));
-		trie.Init(Storage::Instance().account_db(), batch, prefix, 1);
+		InitTrie(trie, prefix);
 		std::vector<std::string> values;
 		trie.GetAll("", values);
 		for (size_t i = 0; i < values.size(); i++){
@@ -211,19 +233,18 @@ namespace bumo {
 
 	bool AccountFrm::GetAsset(const protocol::AssetKey &asset_key, protocol::AssetStore& asset){
 		//LOG_INFO("%p GetAsset", this);
-		auto it = assets_.find(asset_key);
-		if (it != assets_.end()){
-			if (it->second.action_ == utils::DEL){
+		const DataCache<protocol::AssetStore> *cached = assets_.Find(asset_key);
+		if (cached != NULL){
+			if (cached->action_ == utils::DEL){
 				return false;
 			}
-			asset.CopyFrom(it->second.data_);
+			asset.CopyFrom(cached->data_);
 			return true;
 		}
 
-		auto batch = std::make_shared<WRITE_BATCH>();
 		std::string asset_prefix = ComposePrefix(General::ASSET_PREFIX, DecodeAddress(account_info_.address()));
 		KVTrie trie;
-		trie.Init(Storage::Instance().account_db(), batch, asset_prefix, 1);
+		InitTrie(trie, asset_prefix);
 
 		auto asset_key_str = asset_key.SerializeAsString();
 		std::string buff;
@@ -233,13 +254,13 @@ namespace bumo {
 		}
 
 		DataCache<protocol::AssetStore> Rec;
-		Rec.action_ = utils::MOD;
+		Rec.action_ = utils::MAX;
 		
 		if (!asset.ParseFromString(buff)){
 			PROCESS_EXIT("fatal error,Asset ParseFromString fail, data may damaged");
 		}
 		Rec.data_.CopyFrom(asset);
-		assets_.insert({ asset_key, Rec });
+		assets_.Set(asset_key, Rec);
 		return true;
 	}
 
@@ -247,25 +268,25 @@ namespace bumo {
 		DataCache<protocol::AssetStore> Rec;
 		Rec.action_ = utils::ADD;
 		Rec.data_.CopyFrom(data_ptr);
-		assets_[data_ptr.key()] = Rec;
+		assets_.Set(data_ptr.key(), Rec);
+		assets_dirty_ = true;
 	}
 
 	//
 	bool AccountFrm::GetMetaData(const std::string& binkey, protocol::KeyPair& keypair_ptr){
 		//return assets_->GetEntry(asset_property, asset);
-		auto it = metadata_.find(binkey);
-		if (it != metadata_.end()){
-			if (it->second.action_ == utils::DEL){
+		const DataCache<protocol::KeyPair> *cached = metadata_.Find(binkey);
+		if (cached != NULL){
+			if (cached->action_ == utils::DEL){
 				return false;
 			}
-			keypair_ptr = it->second.data_;
+			keypair_ptr = cached->data_;
 			return true;
 		}
 
-		auto batch = std::make_shared<WRITE_BATCH>();
 		KVTrie trie;
 		std::string prefix = ComposePrefix(General::METADATA_PREFIX, DecodeAddress(account_info_.address()));
-		trie.Init(Storage::Instance().account_db(), batch, prefix, 1);
+		InitTrie(trie, prefix);
 
 		std::string buff;
 		if (!trie.Get(binkey, buff)){
@@ -276,9 +297,9 @@ namespace bumo {
 			PROCESS_EXIT("fatal error,Asset ParseFromString fail, data may damaged");
 		}
 		DataCache<protocol::KeyPair> Rec;
-		Rec.action_ = utils::MOD;
+		Rec.action_ = utils::MAX;
 		Rec.data_.CopyFrom(keypair_ptr);
-		metadata_.insert({ binkey, Rec });
+		metadata_.Set(binkey, Rec);
 
 		return true;
 	}
@@ -287,71 +308,81 @@ namespace bumo {
 		DataCache<protocol::KeyPair> Rec;
 		Rec.action_ = utils::ADD;
 		Rec.data_.CopyFrom(dataptr);
-		metadata_[dataptr.key()] = Rec;
+		metadata_.Set(dataptr.key(), Rec);
+		metadata_dirty_ = true;
 	}
 
 	bool AccountFrm::DeleteMetaData(const protocol::KeyPair& dataptr){		
 		DataCache<protocol::KeyPair> Rec;
 		Rec.action_ = utils::DEL;
 		Rec.data_.CopyFrom(dataptr);
-		metadata_[dataptr.key()] = Rec;
+		metadata_.Set(dataptr.key(), Rec);
+		metadata_dirty_ = true;
 		return true;
 	}
 
-	void AccountFrm::UpdateHash(std::shared_ptr<WRITE_BATCH> batch){
-		KVTrie trie_asset;
-		std::string asset_prefix = ComposePrefix(General::ASSET_PREFIX, DecodeAddress(account_info_.address()));
-		trie_asset.Init(Storage::Instance().account_db(), batch, asset_prefix, 1);
-
-		KVTrie trie_metadata;
-		std::string meta_prefix = ComposePrefix(General::METADATA_PREFIX, DecodeAddress(account_info_.address()));
-		trie_metadata.Init(Storage::Instance().account_db(), batch, meta_prefix, 1);
-
-		auto& map = assets_;
-		for (auto it = map.begin(); it != map.end(); it++){
-			auto action = it->second.action_;
-			auto asset = it->second.data_;
-			Json::Value tmp = Proto2Json(asset);
-			switch (action)
-			{
-			case utils::ADD:
-			case utils::MOD:
-				if (asset.amount() == 0)
-					trie_asset.Delete(asset.key().SerializeAsString());
-				else
-					trie_asset.Set(asset.key().SerializeAsString(), asset.SerializeAsString());
-				break;
-			case utils::DEL:
-				trie_asset.Delete(asset.key().SerializeAsString());
-				break;
-
-			default:
-				break;
+	int32_t AccountFrm::UpdateHash(std::shared_ptr<WRITE_BATCH> batch){
+		int32_t hashed = 0;
+
+		//A new account has no hashes yet, even without assets or metadata.
+		if (assets_dirty_ || account_info_.assets_hash().empty()){
+			std::string asset_prefix = ComposePrefix(General::ASSET_PREFIX, DecodeAddress(account_info_.address()));
+			std::shared_ptr<KVTrie> trie_asset = LedgerManager::Instance().GetAccountTrie(asset_prefix, batch);
+
+			std::map<protocol::AssetKey, DataCache<protocol::AssetStore>, AssetSort> map;
+			assets_.GetAll(map);
+			for (auto it = map.begin(); it != map.end(); it++){
+				const protocol::AssetStore &asset = it->second.data_;
+				switch (it->second.action_)
+				{
+				case utils::ADD:
+				case utils::MOD:
+					if (asset.amount() == 0)
+						trie_asset->Delete(asset.key().SerializeAsString());
+					else
+						trie_asset->Set(asset.key().SerializeAsString(), asset.SerializeAsString());
+					break;
+				case utils::DEL:
+					trie_asset->Delete(asset.key().SerializeAsString());
+					break;
+
+				default:
+					break;
+				}
 			}
+			trie_asset->UpdateHash();
+			trie_asset->FreeMemory(LedgerManager::ACCOUNT_TRIE_MEMORY_DEPTH);
+			account_info_.set_assets_hash(trie_asset->GetRootHash());
+			hashed++;
 		}
-		trie_asset.UpdateHash();
-		account_info_.set_assets_hash(trie_asset.GetRootHash());
-		
-		for (auto it = metadata_.begin(); it != metadata_.end(); it++){
-			auto action = it->second.action_;
-			auto kp = it->second.data_;
-
-			switch (action)
-			{
-			case utils::ADD:
-			case utils::MOD:
-				trie_metadata.Set(it->first, kp.SerializeAsString());
-				break;
-			case utils::DEL:
-				trie_metadata.Delete(it->first);
-				break;
-
-			default:
-				break;
+
+		if (metadata_dirty_ || account_info_.metadatas_hash().empty()){
+			std::string meta_prefix = ComposePrefix(General::METADATA_PREFIX, DecodeAddress(account_info_.address()));
+			std::shared_ptr<KVTrie> trie_metadata = LedgerManager::Instance().GetAccountTrie(meta_prefix, batch);
+
+			std::map<std::string, DataCache<protocol::KeyPair>> metadata;
+			metadata_.GetAll(metadata);
+			for (auto it = metadata.begin(); it != metadata.end(); it++){
+				switch (it->second.action_)
+				{
+				case utils::ADD:
+				case utils::MOD:
+					trie_metadata->Set(it->first, it->second.data_.SerializeAsString());
+					break;
+				case utils::DEL:
+					trie_metadata->Delete(it->first);
+					break;
+
+				default:
+					break;
+				}
 			}
+			trie_metadata->UpdateHash();
+			trie_metadata->FreeMemory(LedgerManager::ACCOUNT_TRIE_MEMORY_DEPTH);
+			account_info_.set_metadatas_hash(trie_metadata->GetRootHash());
+			hashed++;
 		}
-		trie_metadata.UpdateHash();
-		account_info_.set_metadatas_hash(trie_metadata.GetRootHash());
+		return hashed;
 	}
 
 	void AccountFrm::NonceIncrease(){
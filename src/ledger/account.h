@@ -23,6 +23,7 @@
 #include "proto/cpp/merkeltrie.pb.h"
 #include <common/storage.h>
 #include "utils/atom_map.h"
+#include "utils/cow_map.h"
 #include "kv_trie.h"
 namespace bumo {
 
@@ -104,23 +105,42 @@ namespace bumo {
 
 		bool UpdateSigner(const std::string &signer, int64_t weight);
 		bool UpdateTypeThreshold(const protocol::Operation::Type type, int64_t threshold);
-		void UpdateHash(std::shared_ptr<WRITE_BATCH> batch);
+		//Write the changed assets and metadata into their tries and rehash them, the others keep their hashes.
+		//Returns how many of the two tries were rehashed.
+		int32_t UpdateHash(std::shared_ptr<WRITE_BATCH> batch);
 		void NonceIncrease();
 		int64_t GetAccountBalance() const;
 		bool AddBalance(int64_t amount);
 		static AccountFrm::pointer CreatAccountFrm(const std::string& account_address, int64_t balance);
+
+		//Read the assets and metadata from a snapshot of the account db instead of the db.
+		void SetSnapshot(std::shared_ptr<StorageSnapshot> snapshot);
+
+		//The account as read from the account tree, NULL for an account not read from it.
+		//An account serialized the same when committed is not written again.
+		void SetStored(std::shared_ptr<const std::string> stored);
+		bool IsStored(const std::string &serialized) const;
 	public:
 
+		//action_ is utils::MAX for an entry only read from the trie, it is not written back.
 		template <class T>
 		struct DataCache{
 			utils::actType action_;
 			T data_;
 		};
 
-		std::map<protocol::AssetKey, DataCache<protocol::AssetStore>, AssetSort> assets_;
-		std::map<std::string, DataCache<protocol::KeyPair>> metadata_;
+		//Shared with the copies of the account in the stack frames until either of them writes.
+		utils::CowMap<protocol::AssetKey, DataCache<protocol::AssetStore>, AssetSort> assets_;
+		utils::CowMap<std::string, DataCache<protocol::KeyPair>> metadata_;
 	private:
+		bool InitTrie(KVTrie &trie, const std::string &prefix);
+
 		protocol::Account	account_info_;
+		std::shared_ptr<StorageSnapshot> snapshot_;
+		std::shared_ptr<const std::string> stored_;
+		//An asset or metadata was written since the account was read.
+		bool assets_dirty_;
+		bool metadata_dirty_;
 	};
 
 }
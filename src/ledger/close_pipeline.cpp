@@ -0,0 +1,160 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <utils/timestamp.h>
+#include <utils/strings.h>
+#include <utils/logger.h>
+#include "close_pipeline.h"
+
+namespace bumo {
+
+	class ClosePipeline::Task : public utils::Runnable {
+	public:
+		Task(ClosePipeline *pipeline, Stage stage)
+			:pipeline_(pipeline), stage_(stage){}
+
+		virtual void Run(utils::Thread *){
+			int64_t time0 = utils::Timestamp::HighResolution();
+			stage_();
+			pipeline_->OnSealed(utils::Timestamp::HighResolution() - time0);
+			pipeline_->done_.Signal();
+		}
+
+		ClosePipeline *pipeline_;
+		Stage stage_;
+	};
+
+	ClosePipeline::ClosePipeline() :
+		enabled_(false),
+		task_(NULL),
+		sealing_seq_(0),
+		sealed_count_(0),
+		execute_time_(0),
+		seal_time_(0),
+		wait_time_(0),
+		last_execute_time_(0),
+		last_seal_time_(0),
+		last_wait_time_(0),
+		ahead_used_count_(0),
+		ahead_discarded_count_(0){}
+
+	ClosePipeline::~ClosePipeline(){}
+
+	bool ClosePipeline::Initialize(bool enabled){
+		if (!enabled){
+			return true;
+		}
+
+		if (!pool_.Init("close", 1)){
+			LOG_ERROR_ERRNO("Failed to start close thread", STD_ERR_CODE, STD_ERR_DESC);
+			return false;
+		}
+		enabled_ = true;
+		return true;
+	}
+
+	bool ClosePipeline::Exit(){
+		Wait();
+		if (enabled_){
+			enabled_ = false;
+			return pool_.Exit();
+		}
+		return true;
+	}
+
+	bool ClosePipeline::enabled() const{
+		return enabled_;
+	}
+
+	void ClosePipeline::Seal(int64_t seq, Stage stage){
+		Wait();
+
+		do {
+			utils::MutexGuard guard(mutex_);
+			sealing_seq_ = seq;
+		} while (false);
+
+		Task *task = new Task(this, stage);
+		if (!enabled_){
+			task->Run(NULL);
+			done_.Wait();
+			delete task;
+			return;
+		}
+
+		task_ = task;
+		pool_.AddTask(task_);
+	}
+
+	void ClosePipeline::Wait(){
+		if (task_ == NULL){
+			return;
+		}
+
+		int64_t time0 = utils::Timestamp::HighResolution();
+		while (!done_.Wait()){
+		}
+		delete task_;
+		task_ = NULL;
+
+		utils::MutexGuard guard(mutex_);
+		last_wait_time_ = utils::Timestamp::HighResolution() - time0;
+		wait_time_ += last_wait_time_;
+	}
+
+	int64_t ClosePipeline::sealing_seq(){
+		utils::MutexGuard guard(mutex_);
+		return sealing_seq_;
+	}
+
+	void ClosePipeline::OnExecuted(int64_t time){
+		utils::MutexGuard guard(mutex_);
+		last_execute_time_ = time;
+		execute_time_ += time;
+	}
+
+	void ClosePipeline::OnSealed(int64_t time){
+		utils::MutexGuard guard(mutex_);
+		sealing_seq_ = 0;
+		sealed_count_++;
+		last_seal_time_ = time;
+		seal_time_ += time;
+	}
+
+	void ClosePipeline::OnRunAhead(bool used){
+		utils::MutexGuard guard(mutex_);
+		if (used){
+			ahead_used_count_++;
+		}
+		else{
+			ahead_discarded_count_++;
+		}
+	}
+
+	void ClosePipeline::GetModuleStatus(Json::Value &data){
+		utils::MutexGuard guard(mutex_);
+		data["enabled"] = enabled_;
+		data["sealing_seq"] = sealing_seq_;
+		data["sealed_count"] = sealed_count_;
+		data["execute_time"] = utils::String::Format(FMT_I64 " ms", execute_time_ / utils::MICRO_UNITS_PER_MILLI);
+		data["seal_time"] = utils::String::Format(FMT_I64 " ms", seal_time_ / utils::MICRO_UNITS_PER_MILLI);
+		data["wait_time"] = utils::String::Format(FMT_I64 " ms", wait_time_ / utils::MICRO_UNITS_PER_MILLI);
+		data["last_execute_time"] = utils::String::Format(FMT_I64 " us", last_execute_time_);
+		data["last_seal_time"] = utils::String::Format(FMT_I64 " us", last_seal_time_);
+		data["last_wait_time"] = utils::String::Format(FMT_I64 " us", last_wait_time_);
+		data["ahead_used_count"] = ahead_used_count_;
+		data["ahead_discarded_count"] = ahead_discarded_count_;
+	}
+}
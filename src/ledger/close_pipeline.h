@@ -0,0 +1,74 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CLOSE_PIPELINE_H_
+#define CLOSE_PIPELINE_H_
+
+#include <functional>
+#include <utils/thread.h>
+#include <json/json.h>
+
+namespace bumo {
+
+	//The two stages of closing a ledger. The caller executes the ledger, then hands the seal stage
+	//(committing the account tree, hashing and writing it) to the close thread and may execute the next one meanwhile.
+	//Only one ledger is sealed at a time: Seal and Wait block until the ledger before is sealed.
+	//Disabled, the seal stage runs in the caller at once.
+	class ClosePipeline {
+	public:
+		typedef std::function<void()> Stage;
+
+		ClosePipeline();
+		~ClosePipeline();
+
+		bool Initialize(bool enabled);
+		//Seal the ledger in flight and stop the close thread.
+		bool Exit();
+		bool enabled() const;
+
+		void Seal(int64_t seq, Stage stage);
+		void Wait();
+		//The ledger being sealed, 0 if none.
+		int64_t sealing_seq();
+
+		void OnExecuted(int64_t time);
+		//A ledger run ahead is used, or discarded and executed again after the one before is sealed.
+		void OnRunAhead(bool used);
+		void GetModuleStatus(Json::Value &data);
+
+	private:
+		class Task;
+		void OnSealed(int64_t time);
+
+		bool enabled_;
+		utils::ThreadPool pool_;
+		Task *task_;
+		utils::Semaphore done_;
+
+		utils::Mutex mutex_;
+		int64_t sealing_seq_;
+		int64_t sealed_count_;
+		int64_t execute_time_;
+		int64_t seal_time_;
+		int64_t wait_time_;
+		int64_t last_execute_time_;
+		int64_t last_seal_time_;
+		int64_t last_wait_time_;
+		int64_t ahead_used_count_;
+		int64_t ahead_discarded_count_;
+	};
+}
+
+#endif
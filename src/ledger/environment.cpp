@@ -19,19 +19,23 @@
 
 namespace bumo{
 
-	Environment::Environment(Map* data, settingKV* settings) :
-		utils::AtomMap<std::string, AccountFrm>(data), settings_(settings){}
+	Environment::Environment() :
+		base_(NULL), contract_read_(false){}
+
+	Environment::Environment(Map* data, FeeSettings::Map* fees, ValidatorSettings::Map* validators) :
+		utils::AtomMap<std::string, AccountFrm>(data), fees_(fees), validators_(validators), base_(NULL), contract_read_(false){}
 
 	bool Environment::GetEntry(const std::string &key, AccountFrm::pointer &frm){
 		return Get(key, frm);
 	}
 
 	bool Environment::Commit(){
-		return settings_.Commit() && AtomMap<std::string, AccountFrm>::Commit();
+		return fees_.Commit() && validators_.Commit() && AtomMap<std::string, AccountFrm>::Commit();
 	}
 
 	void Environment::ClearChangeBuf(){
-		settings_.ClearChangeBuf();
+		fees_.ClearChangeBuf();
+		validators_.ClearChangeBuf();
 		AtomMap<std::string, AccountFrm>::ClearChangeBuf();
 	}
 
@@ -40,9 +44,76 @@ namespace bumo{
 	}
 
 	bool Environment::GetFromDB(const std::string &address, AccountFrm::pointer &account_ptr){
+		if (base_ != NULL){
+			return GetFromBase(address, account_ptr);
+		}
+
+		if (state_view_ != nullptr){
+			return state_view_->GetAccount(address, account_ptr);
+		}
+
+		if (prefetched_ != nullptr){
+			auto iter = prefetched_->find(address);
+			if (iter != prefetched_->end()){
+				if (iter->second == nullptr){
+					return false;
+				}
+
+				account_ptr = std::make_shared<AccountFrm>(iter->second->account_);
+				account_ptr->SetStored(iter->second->stored_);
+				return true;
+			}
+		}
+
 		return AccountFromDB(address, account_ptr);
 	}
 
+	void Environment::Prefetch(const std::vector<std::string> &addresses){
+		//The account tree is being written by the ledger before.
+		if (state_view_ != nullptr){
+			return;
+		}
+
+		if (prefetched_ == nullptr){
+			prefetched_ = std::make_shared<AccountCache>();
+		}
+
+		std::vector<std::string> loading;
+		std::vector<std::string> indexes;
+		for (size_t i = 0; i < addresses.size(); i++){
+			if (prefetched_->find(addresses[i]) != prefetched_->end()){
+				continue;
+			}
+			(*prefetched_)[addresses[i]] = nullptr;
+			loading.push_back(addresses[i]);
+			indexes.push_back(DecodeAddress(addresses[i]));
+		}
+
+		if (indexes.empty()){
+			return;
+		}
+
+		std::vector<std::string> buffs;
+		std::vector<bool> found;
+		{
+			utils::WriteLockGuard guard(LedgerManager::Instance().GetTreeMutex());
+			LedgerManager::Instance().tree_->GetBatch(indexes, buffs, found);
+		}
+
+		for (size_t i = 0; i < loading.size(); i++){
+			if (!found[i]){
+				continue;
+			}
+
+			std::shared_ptr<CachedAccount> account = std::make_shared<CachedAccount>();
+			if (!account->account_.ParseFromString(buffs[i])){
+				PROCESS_EXIT("Failed to parse account(%s) from string, fatal error", loading[i].c_str());
+			}
+			account->stored_ = std::make_shared<std::string>(std::move(buffs[i]));
+			(*prefetched_)[loading[i]] = account;
+		}
+	}
+
 	bool Environment::AccountFromDB(const std::string &address, AccountFrm::pointer &account_ptr){
 		auto db = Storage::Instance().account_db();
 		std::string index = DecodeAddress(address);
@@ -61,114 +132,140 @@ namespace bumo{
 		}
 
 		account_ptr = std::make_shared<AccountFrm>(account);
+		account_ptr->SetStored(std::make_shared<std::string>(std::move(buff)));
 		return true;
 	}
 
 	std::shared_ptr<Environment> Environment::NewStackFrameEnv(){
 		Map& data	= GetChangeBuf();
-		settingKV& settings = settings_.GetChangeBuf();
-		std::shared_ptr<Environment> next = std::make_shared<Environment>(&data, &settings);
+		std::shared_ptr<Environment> next = std::make_shared<Environment>(&data, &fees_.GetChangeBuf(), &validators_.GetChangeBuf());
+		next->prefetched_ = prefetched_;
+		next->state_view_ = state_view_;
 
 		return next;
 	}
 
-	bool Environment::UpdateFeeConfig(const Json::Value &feeConfig) {
-		std::shared_ptr<Json::Value> fees;
-		settings_.Get(feesKey, fees);
+	void Environment::SetStateView(StateView::pointer view){
+		state_view_ = view;
+	}
+
+	std::shared_ptr<Environment> Environment::NewSpeculativeEnv(){
+		std::shared_ptr<Environment> next = std::make_shared<Environment>();
+		next->base_ = this;
+		return next;
+	}
 
-		if (!fees){
-			fees = std::make_shared<Json::Value>(feeConfig);
-			settings_.Set(feesKey, fees);
+	bool Environment::GetFromBase(const std::string &address, AccountFrm::pointer &account_ptr){
+		//The base is not modified while the speculative environments read it.
+		AccountFrm::pointer version;
+		bool found = false;
+		const Map &committed = base_->GetData();
+		auto iter = committed.find(address);
+		if (iter != committed.end()){
+			version = iter->second.ptr_;
+			if (iter->second.type_ != utils::DEL){
+				account_ptr = std::make_shared<AccountFrm>(*version);
+				found = true;
+			}
 		}
 		else{
-			for (auto it = feeConfig.begin(); it != feeConfig.end(); it++) {
-				(*fees)[it.memberName()] = feeConfig[it.memberName()];
-			}
+			found = base_->GetFromDB(address, account_ptr);
+		}
+		read_versions_.insert(std::make_pair(address, version));
+
+		if (found && !account_ptr->GetProtoAccount().contract().payload().empty()){
+			contract_read_ = true;
+			return false;
+		}
+		return found;
+	}
+
+	bool Environment::ReadsValid(){
+		if (contract_read_){
+			return false;
 		}
 
+		//A commit always replaces the account object, and the versions read are kept alive, so comparing the pointers is enough.
+		const Map &committed = base_->GetData();
+		for (auto it = read_versions_.begin(); it != read_versions_.end(); it++){
+			auto iter = committed.find(it->first);
+			AccountFrm::pointer current = (iter == committed.end()) ? nullptr : iter->second.ptr_;
+			if (current != it->second){
+				return false;
+			}
+		}
 		return true;
 	}
 
+	bool Environment::CommitToBase(){
+		const Map &committed = GetData();
+		for (auto it = committed.begin(); it != committed.end(); it++){
+			if (!base_->AddEntry(it->first, it->second.ptr_)){
+				return false;
+			}
+		}
+		return base_->Commit();
+	}
+
+	bool Environment::UpdateFeeConfig(protocol::FeeConfig_Type fee_type, int64_t price) {
+		switch (fee_type) {
+		case protocol::FeeConfig_Type_GAS_PRICE:
+		case protocol::FeeConfig_Type_BASE_RESERVE:
+			return fees_.Set(fee_type, std::make_shared<int64_t>(price));
+		default:
+			LOG_ERROR("Fee config type(%d) error", fee_type);
+			return false;
+		}
+	}
+
 	bool Environment::GetVotedFee(const protocol::FeeConfig &old_fee, protocol::FeeConfig& new_fee) {
 		bool change = false;
 		new_fee = old_fee;
 
-		std::shared_ptr<Json::Value> fees;
-		settings_.Get(feesKey, fees);
-		if (!fees) return false;
-
-		for (auto it = fees->begin(); it != fees->end(); it++) {
-			int32_t fee_type = (protocol::FeeConfig_Type)utils::String::Stoi(it.memberName());
-			int64_t price = (*fees)[it.memberName()].asInt64();
-
-			switch ((protocol::FeeConfig_Type)fee_type) {
-			case protocol::FeeConfig_Type_UNKNOWN:
-				LOG_ERROR("FeeConfig type error");
-				break;
-			case protocol::FeeConfig_Type_GAS_PRICE:
-				if (new_fee.gas_price() != price) {
-					new_fee.set_gas_price(price);
-					change = true;
-				}
-				break;
-			case protocol::FeeConfig_Type_BASE_RESERVE:
-				if (new_fee.base_reserve() != price) {
-					new_fee.set_base_reserve(price);
-					change = true;
-				}
-				break;
-			default:
-				LOG_ERROR("Fee config type(%d) error", fee_type);
-				break;
-			}
+		std::shared_ptr<int64_t> price;
+		if (fees_.Get(protocol::FeeConfig_Type_GAS_PRICE, price) && new_fee.gas_price() != *price) {
+			new_fee.set_gas_price(*price);
+			change = true;
+		}
+
+		price.reset();
+		if (fees_.Get(protocol::FeeConfig_Type_BASE_RESERVE, price) && new_fee.base_reserve() != *price) {
+			new_fee.set_base_reserve(*price);
+			change = true;
 		}
 
 		return change;
 	}
 
-	Json::Value& Environment::GetValidators(){
-		std::shared_ptr<Json::Value> validators;
-		settings_.Get(validatorsKey, validators);
+	const Environment::ValidatorSetting& Environment::GetValidators(){
+		std::shared_ptr<ValidatorSetting> validators;
+		validators_.Get(validatorsKey, validators);
 
 		if (!validators){
-			validators = std::make_shared<Json::Value>();
-			auto sets = LedgerManager::Instance().Validators();
-
-			for (int i = 0; i < sets.validators_size(); i++){
-				auto validator = sets.mutable_validators(i);
-				Json::Value value;
-				value.append(validator->address());
-				value.append(utils::String::ToString(validator->pledge_coin_amount()));
-				validators->append(value);
-			}
-
-			settings_.Set(validatorsKey, validators);
+			validators = std::make_shared<ValidatorSetting>();
+			validators->validators_ = LedgerManager::Instance().Validators();
+			validators_.Set(validatorsKey, validators);
 		}
 
 		return *validators;
 	}
 
-	bool Environment::UpdateNewValidators(const Json::Value& validators) {
-		return settings_.Set(validatorsKey, std::make_shared<Json::Value>(validators));
+	bool Environment::UpdateNewValidators(const protocol::ValidatorSet& validators, const Json::Value &json) {
+		std::shared_ptr<ValidatorSetting> setting = std::make_shared<ValidatorSetting>();
+		setting->validators_ = validators;
+		setting->json_ = std::make_shared<Json::Value>(json);
+		return validators_.Set(validatorsKey, setting);
 	}
 
 	bool Environment::GetVotedValidators(const protocol::ValidatorSet &old_validator, protocol::ValidatorSet& new_validator){
-		std::shared_ptr<Json::Value> validators;
-		bool ret = settings_.Get(validatorsKey, validators);
+		std::shared_ptr<ValidatorSetting> validators;
+		validators_.Get(validatorsKey, validators);
 		if (!validators){
 			new_validator = old_validator;
 			return false;
 		}
 
-		for (Json::Value::UInt i = 0; i < validators->size(); i++){
-			std::string address = (*validators)[i][(Json::Value::UInt)0].asString();
-			int64_t pledge_amount = utils::String::Stoi64( (*validators)[i][1].asString() );
-
-			auto validator = new_validator.add_validators();
-			validator->set_address(address);
-			validator->set_pledge_coin_amount(pledge_amount);
-		}
-
+		new_validator.mutable_validators()->MergeFrom(validators->validators_.validators());
 		return true;
 	}
 }
\ No newline at end of file
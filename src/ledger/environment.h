@@ -20,31 +20,47 @@
 #include <proto/cpp/consensus.pb.h>
 #include <utils/atom_map.h>
 #include <main/configure.h>
-#include <json/value.h>
 #include "account.h"
+#include "state_view.h"
 
 namespace bumo {
 	class Environment : public utils::AtomMap<std::string, AccountFrm>{
 	public:
-		typedef utils::AtomMap<std::string, Json::Value>::Map settingKV;
+		//The system settings voted by the transactions, committed with the accounts.
+		//The fees by protocol::FeeConfig_Type, and the validator set under validatorsKey.
+		typedef utils::AtomMap<int32_t, int64_t> FeeSettings;
+		//The validator set, with the value a contract set it from, NULL for the set of the last ledger.
+		//The contract reads back the value it set, as it did when the settings were kept as json.
+		struct ValidatorSetting {
+			protocol::ValidatorSet validators_;
+			std::shared_ptr<const Json::Value> json_;
+		};
+		typedef utils::AtomMap<std::string, ValidatorSetting> ValidatorSettings;
 		const std::string validatorsKey = "validators";
-		const std::string feesKey = "configFees";
 
-		AtomMap<std::string, Json::Value> settings_;
+		FeeSettings fees_;
+		ValidatorSettings validators_;
 
-		Environment() = default;
+		Environment();
 		Environment(Environment const&) = delete;
 		Environment& operator=(Environment const&) = delete;
-		Environment(Map* data, settingKV* settings);
+		Environment(Map* data, FeeSettings::Map* fees, ValidatorSettings::Map* validators);
+
+		//Accounts read from the account tree in one batch, parsed and as stored, NULL if the account does not exist.
+		struct CachedAccount {
+			protocol::Account account_;
+			std::shared_ptr<const std::string> stored_;
+		};
+		typedef std::unordered_map<std::string, std::shared_ptr<CachedAccount>> AccountCache;
 
 		bool GetEntry(const std::string& key, AccountFrm::pointer &frm);
 		bool AddEntry(const std::string& key, AccountFrm::pointer frm);
 
-		bool UpdateFeeConfig(const Json::Value &fee_config);
+		bool UpdateFeeConfig(protocol::FeeConfig_Type fee_type, int64_t price);
 		bool GetVotedFee(const protocol::FeeConfig &old_fee, protocol::FeeConfig& new_fee);
 
-		Json::Value& GetValidators();
-		bool UpdateNewValidators(const Json::Value& validators);
+		const ValidatorSetting& GetValidators();
+		bool UpdateNewValidators(const protocol::ValidatorSet& validators, const Json::Value &json);
 		bool GetVotedValidators(const protocol::ValidatorSet &old_validator, protocol::ValidatorSet& new_validator);
 
 		bool Commit();
@@ -53,6 +69,34 @@ namespace bumo {
 		virtual bool GetFromDB(const std::string &address, AccountFrm::pointer &account_ptr);
 		static bool AccountFromDB(const std::string &address, AccountFrm::pointer &account_ptr);
 		std::shared_ptr<Environment> NewStackFrameEnv();
+
+		//Read the accounts from the database in one pass, GetFromDB of this environment
+		//and of its stack frames is then served from memory.
+		void Prefetch(const std::vector<std::string> &addresses);
+
+		//Read the accounts from the view instead of the account tree, for running a ledger ahead of the one being sealed.
+		//The stack frames read from it too.
+		void SetStateView(StateView::pointer view);
+
+		//An environment running a transaction ahead of the ledger, over the accounts committed in this one so far.
+		//It keeps the version of every account it reads, and does not read the contract accounts,
+		//so the transaction cannot call a contract.
+		std::shared_ptr<Environment> NewSpeculativeEnv();
+		//Nothing read by the speculative environment has been committed in its base since, and no contract was read.
+		bool ReadsValid();
+		//Commit the accounts committed in the speculative environment into its base.
+		bool CommitToBase();
+
+	private:
+		bool GetFromBase(const std::string &address, AccountFrm::pointer &account_ptr);
+
+		std::shared_ptr<AccountCache> prefetched_;
+		StateView::pointer state_view_;
+
+		//For a speculative environment: the base, and the accounts read from it with the committed version, NULL if none.
+		Environment *base_;
+		std::unordered_map<std::string, AccountFrm::pointer> read_versions_;
+		bool contract_read_;
 	};
 }
 #endif
\ No newline at end of file
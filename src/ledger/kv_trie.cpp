@@ -14,11 +14,16 @@
 */
 
 #include "kv_trie.h"
+#include "node_cache.h"
 
 namespace bumo{
 
 	KVTrie::KVTrie(){
 		//leafcount_ = 0;
+		mdb_ = NULL;
+		cache_ = NULL;
+		cache_seq_ = -1;
+		time_ = 0;
 	}
 
 	KVTrie::~KVTrie(){
@@ -26,31 +31,46 @@ namespace bumo{
 	}
 
 
-	bool KVTrie::Init(bumo::KeyValueDb* db, std::shared_ptr<WRITE_BATCH> batch, const std::string& prefix, int depth){
+	bool KVTrie::Init(bumo::KeyValueDb* db, std::shared_ptr<WRITE_BATCH> batch, const std::string& prefix, int depth, int64_t cache_seq){
 		mdb_ = db;
+		cache_ = NodeCache::GetInstance();
+		cache_seq_ = cache_seq;
 		prefix_ = prefix;
 		batch_ = batch;
 		Location location;
 		location.push_back(0);
-		root_ = std::make_shared< NodeFrm>(location);
+		root_ = NodeFrm::Create(location);
 
-		protocol::Node info;
+		NodeInfo info;
 		if (storage_load(location, info)){
-			root_->info_.CopyFrom(info);
+			root_->SetInfo(info);
 			Load(root_, depth);
 		}
 		return true;
 	}
 
 	void KVTrie::Load(NodeFrm::POINTER node, int depth){
-		if (depth < 0){
-			return;
-		}
-		for (int i = 0; i < 16; i++){
-			NodeFrm::POINTER child = ChildMayFromDB(node, i);
-			if (child != nullptr){
-				Load(child, depth - 1);
+		//Breadth first, so that every level is read from the database in one batch.
+		std::vector<NodeFrm::POINTER> level(1, node);
+		for (; depth >= 0 && !level.empty(); depth--){
+			std::vector<Branch> branches;
+			for (size_t i = 0; i < level.size(); i++){
+				for (int j = 0; j < 16; j++){
+					if (level[i]->info_.Ref(j).type_ != protocol::NONE){
+						branches.push_back(Branch(level[i], j));
+					}
+				}
+			}
+			LoadChildren(branches);
+
+			std::vector<NodeFrm::POINTER> next;
+			for (size_t i = 0; i < branches.size(); i++){
+				NodeFrm::POINTER child = branches[i].first->GetChild(branches[i].second);
+				if (child != nullptr && branches[i].first->info_.Ref(branches[i].second).type_ == protocol::INNER){
+					next.push_back(child);
+				}
 			}
+			level.swap(next);
 		}
 	}
 
@@ -65,21 +85,31 @@ namespace bumo{
 	}
 
 	void KVTrie::StorageSaveNode(NodeFrm::POINTER node) {
-		std::string buff = node->info_.SerializeAsString();
+		std::string buff = node->info_.Serialize();
 		std::string key = Location2DBkey(node->location_, false);
+		if (cache_ != NULL){
+			cache_->Stage(batch_.get(), key, &node->info_);
+		}
+		utils::MutexGuard guard(batch_mutex_);
 		batch_->Put(key, buff);
 		//LOG_DEBUG("save INNER(%s)", utils::String::BinToHexString(key).c_str());
 	}
 
 	void  KVTrie::StorageSaveLeaf(NodeFrm::POINTER node){
 		std::string key = Location2DBkey(node->location_, true);
+		utils::MutexGuard guard(batch_mutex_);
 		batch_->Put(key, *node->leaf_);
 		//LOG_DEBUG("save LEAF(%s)", utils::String::BinToHexString(key).c_str());
 	}
 
-	bool KVTrie::storage_load(const Location& location, protocol::Node& info)  {
+	bool KVTrie::storage_load(const Location& location, NodeInfo& info)  {
 		int64_t t1 = utils::Timestamp::HighResolution();
 		std::string key = Location2DBkey(location, false);
+		int64_t generation = 0;
+		if (cache_ != NULL && cache_->Get(key, info, generation, cache_seq_)){
+			return true;
+		}
+
 		std::string buff;
 		//LOG_DEBUG("LOAD INNER:%s", utils::String::BinToHexString(key).c_str());
 		int32_t stat = mdb_->Get(key, buff);
@@ -88,7 +118,10 @@ namespace bumo{
 		time_ += (t2 - t1);
 
 		if (stat == 1){
-			info.ParseFromString(buff);
+			info.Parse(buff);
+			if (cache_ != NULL){
+				cache_->Put(key, info, generation);
+			}
 			return true;
 		}
 		else if (stat == 0)
@@ -98,15 +131,82 @@ namespace bumo{
 		}
 	}
 
+	void KVTrie::StorageLoadNodes(const std::vector<Location>& locations, std::vector<NodeInfo>& infos, std::vector<bool>& found){
+		int64_t t1 = utils::Timestamp::HighResolution();
+		infos.assign(locations.size(), NodeInfo());
+		found.assign(locations.size(), false);
+
+		std::vector<std::string> keys;
+		std::vector<size_t> indexes;
+		std::vector<int64_t> generations;
+		for (size_t i = 0; i < locations.size(); i++){
+			std::string key = Location2DBkey(locations[i], false);
+			int64_t generation = 0;
+			if (cache_ != NULL && cache_->Get(key, infos[i], generation, cache_seq_)){
+				found[i] = true;
+				continue;
+			}
+			keys.push_back(key);
+			indexes.push_back(i);
+			generations.push_back(generation);
+		}
+
+		if (keys.empty()){
+			return;
+		}
+
+		std::vector<std::string> buffs;
+		std::vector<int32_t> stats;
+		if (!mdb_->MultiGet(keys, buffs, stats)){
+			PROCESS_EXIT("Failed to read database. %s", mdb_->error_desc().c_str());
+		}
+		time_ += (utils::Timestamp::HighResolution() - t1);
+
+		for (size_t i = 0; i < keys.size(); i++){
+			if (stats[i] != 1){
+				continue;
+			}
+
+			NodeInfo &info = infos[indexes[i]];
+			info.Parse(buffs[i]);
+			found[indexes[i]] = true;
+			if (cache_ != NULL){
+				cache_->Put(keys[i], info, generations[i]);
+			}
+		}
+	}
+
+	void KVTrie::StorageGetLeaves(const std::vector<Location>& locations, std::vector<std::string>& values, std::vector<bool>& found){
+		std::vector<std::string> keys;
+		for (size_t i = 0; i < locations.size(); i++){
+			keys.push_back(Location2DBkey(locations[i], true));
+		}
+
+		std::vector<int32_t> stats;
+		if (!mdb_->MultiGet(keys, values, stats)){
+			PROCESS_EXIT("Failed to read storage. %s", mdb_->error_desc().c_str());
+		}
+
+		found.assign(locations.size(), false);
+		for (size_t i = 0; i < stats.size(); i++){
+			found[i] = (stats[i] == 1);
+		}
+	}
+
 	void KVTrie::StorageDeleteNode(NodeFrm::POINTER node) {
 		std::string key = Location2DBkey(node->location_, false);
 		//LOG_DEBUG("DELETE INNER %s", utils::String::BinToHexString(key).c_str());
+		if (cache_ != NULL){
+			cache_->Stage(batch_.get(), key, NULL);
+		}
+		utils::MutexGuard guard(batch_mutex_);
 		batch_->Delete(key);
 	}
 
 	void KVTrie::StorageDeleteLeaf(NodeFrm::POINTER node){
 		std::string key = Location2DBkey(node->location_, true);
 		//LOG_DEBUG("DELETE LEAF %s", utils::String::BinToHexString(key).c_str());
+		utils::MutexGuard guard(batch_mutex_);
 		batch_->Delete(key);
 	}
 
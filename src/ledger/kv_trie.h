@@ -21,16 +21,22 @@
 
 namespace bumo{
 
+	class NodeCache;
+
 	class KVTrie :public Trie{
 		KeyValueDb* mdb_;
 		std::string prefix_;
+		utils::Mutex batch_mutex_;
+		NodeCache *cache_;
+		int64_t cache_seq_;
 	public:
 		std::shared_ptr<WRITE_BATCH> batch_;
 		int64_t time_;
 	public:
 		KVTrie();
 		~KVTrie();
-		bool Init(bumo::KeyValueDb* db, std::shared_ptr<WRITE_BATCH>, const std::string& prefix, int depth);
+		//Pass the ledger seq of a db snapshot as cache_seq, only the cached nodes not changed after it are read.
+		bool Init(bumo::KeyValueDb* db, std::shared_ptr<WRITE_BATCH>, const std::string& prefix, int depth, int64_t cache_seq = -1);
 
 		//int LeafCount();
 		bool AddToDB();
@@ -44,8 +50,10 @@ namespace bumo{
 		virtual void StorageDeleteNode(NodeFrm::POINTER node) override;
 		virtual void StorageDeleteLeaf(NodeFrm::POINTER node) override;
 
-		virtual bool storage_load(const Location& location, protocol::Node& info) override;
+		virtual bool storage_load(const Location& location, NodeInfo& info) override;
 		virtual bool StorageGetLeaf(const Location& location, std::string& value)override;
+		virtual void StorageLoadNodes(const std::vector<Location>& locations, std::vector<NodeInfo>& infos, std::vector<bool>& found) override;
+		virtual void StorageGetLeaves(const std::vector<Location>& locations, std::vector<std::string>& values, std::vector<bool>& found) override;
 		virtual std::string HashCrypto(const std::string& input) override;
 	};
 }
@@ -154,10 +154,6 @@ namespace bumo {
 
 			batch.Put(General::LAST_TX_HASHS, new_last_hashs.SerializeAsString());
 		}
-
-		if (!db->WriteBatch(batch)){
-			PROCESS_EXIT("Failed to write ledger and transaction to database(%s)", db->error_desc().c_str());
-		}
 		return true;
 	}
 
@@ -239,6 +235,8 @@ namespace bumo {
 		uint32_t success_count = 0;
 		total_fee_ = 0;
 		environment_ = std::make_shared<Environment>();
+		environment_->SetStateView(state_view_);
+		PrepareTxs(request);
 
 		//init the txs map (transaction map).
 		std::set<int32_t> expire_txs, error_txs;
@@ -248,56 +246,70 @@ namespace bumo {
 			return false;
 		}
 
+		std::vector<AheadTx> ahead_txs;
+		std::shared_ptr<ParallelExecutor> executor = NewExecutor(request, APPLY_MODE_PROPOSE, std::set<int32_t>(), ahead_txs);
+
 		for (int i = 0; i < request.txset().txs_size() && enabled_; i++) {
 			const protocol::TransactionEnv &txproto = request.txset().txs(i);
 
-			TransactionFrm::pointer tx_frm = std::make_shared<TransactionFrm>(txproto);
-
-			if (!tx_frm->ValidForApply(environment_, !IsTestMode())) {
-				dropped_tx_frms_.push_back(tx_frm);
-				proposed_result.need_dropped_tx_.insert(i); //for drop
-				continue;
+			TransactionFrm::pointer tx_frm;
+			bool ret = false;
+			bool expired = false;
+			std::string error_info;
+			if (CommitAhead(executor.get(), i, ahead_txs)) {
+				tx_frm = ahead_txs[i].tx_frm_;
+				ret = ahead_txs[i].applied_;
+				expired = ahead_txs[i].expired_;
+				error_info = ahead_txs[i].error_info_;
 			}
+			else {
+				tx_frm = NewTransactionFrm(i, txproto);
 
-			//pay fee
-			if (!tx_frm->PayFee(environment_, total_fee_)) {
-				dropped_tx_frms_.push_back(tx_frm);
-				proposed_result.need_dropped_tx_.insert(i);//for drop
-				continue;
-			}
+				if (!tx_frm->ValidForApply(environment_, !IsTestMode())) {
+					dropped_tx_frms_.push_back(tx_frm);
+					proposed_result.need_dropped_tx_.insert(i); //for drop
+					continue;
+				}
 
-			ledger_context->transaction_stack_.push_back(tx_frm);
-			tx_frm->NonceIncrease(this, environment_);
-			environment_->Commit();
+				//pay fee
+				if (!tx_frm->PayFee(environment_, total_fee_)) {
+					dropped_tx_frms_.push_back(tx_frm);
+					proposed_result.need_dropped_tx_.insert(i);//for drop
+					continue;
+				}
 
-			tx_frm->EnableChecked();
-			tx_frm->SetMaxEndTime(utils::Timestamp::HighResolution() + General::TX_EXECUTE_TIME_OUT);
+				ledger_context->transaction_stack_.push_back(tx_frm);
+				tx_frm->NonceIncrease(this, environment_);
+				environment_->Commit();
 
-			bool ret = tx_frm->Apply(this, environment_);
-			//Calculate the required minimum fee by calculating the bytes of the transaction. Do not store the transaction when the user-specified fee is less than this fee. 
-			std::string error_info;
-			if (tx_frm->IsExpire(error_info)) {
+				tx_frm->EnableChecked();
+				tx_frm->SetMaxEndTime(utils::Timestamp::HighResolution() + General::TX_EXECUTE_TIME_OUT);
+
+				ret = tx_frm->Apply(this, environment_);
+				//Calculate the required minimum fee by calculating the bytes of the transaction. Do not store the transaction when the user-specified fee is less than this fee. 
+				expired = tx_frm->IsExpire(error_info);
+				if (!expired && ret) {
+					tx_frm->ReturnFee(total_fee_);
+					tx_frm->environment_->Commit();
+				}
+				ledger_context->transaction_stack_.pop_back();
+			}
+
+			if (expired) {
 				LOG_ERROR("Failed to apply transaction(%s): %s, %s",
 					utils::String::BinToHexString(tx_frm->GetContentHash()).c_str(), tx_frm->GetResult().desc().c_str(),
 					error_info.c_str());
 				expire_txs.insert(i - proposed_result.need_dropped_tx_.size());//for check
 			}
-			else {
-				if (!ret) {
-					LOG_ERROR("Failed to apply transaction(%s): %s",
-						utils::String::BinToHexString(tx_frm->GetContentHash()).c_str(), tx_frm->GetResult().desc().c_str());
-					error_txs.insert(i - proposed_result.need_dropped_tx_.size());//for check
-				}
-				else {
-					tx_frm->ReturnFee(total_fee_);
-					tx_frm->environment_->Commit();
-				}
+			else if (!ret) {
+				LOG_ERROR("Failed to apply transaction(%s): %s",
+					utils::String::BinToHexString(tx_frm->GetContentHash()).c_str(), tx_frm->GetResult().desc().c_str());
+				error_txs.insert(i - proposed_result.need_dropped_tx_.size());//for check
 			}
 
 			environment_->ClearChangeBuf();
 			apply_tx_frms_.push_back(tx_frm);
 			ledger_.add_transaction_envs()->CopyFrom(txproto);
-			ledger_context->transaction_stack_.pop_back();
 
 			if ( utils::Timestamp::HighResolution() - start_time > General::BLOCK_EXECUTE_TIME_OUT) {
 				LOG_ERROR("Applying block timeout(" FMT_I64 ") ", utils::Timestamp::HighResolution() - start_time);
@@ -323,6 +335,8 @@ namespace bumo {
 		uint32_t success_count = 0;
 		total_fee_ = 0;
 		environment_ = std::make_shared<Environment>();
+		environment_->SetStateView(state_view_);
+		PrepareTxs(request);
 
 		//init the txs map (transaction map).
 		std::set<int32_t> expire_txs_check,  error_txs_check;
@@ -332,54 +346,68 @@ namespace bumo {
 			return false;
 		}
 
-		for (int i = 0; i < request.txset().txs_size() && enabled_; i++) {
-			auto txproto = request.txset().txs(i);
+		std::vector<AheadTx> ahead_txs;
+		std::shared_ptr<ParallelExecutor> executor = NewExecutor(request, APPLY_MODE_CHECK, std::set<int32_t>(), ahead_txs);
 
-			TransactionFrm::pointer tx_frm = std::make_shared<TransactionFrm>(txproto);
+		for (int i = 0; i < request.txset().txs_size() && enabled_; i++) {
+			const protocol::TransactionEnv &txproto = request.txset().txs(i);
 
-			if (!tx_frm->ValidForApply(environment_, !IsTestMode())) {
-				LOG_ERROR("Validition for application failed: consensus value sequence(" FMT_I64 ")", request.ledger_seq());
-				return false;
+			TransactionFrm::pointer tx_frm;
+			bool ret = false;
+			bool expired = false;
+			std::string error_info;
+			if (CommitAhead(executor.get(), i, ahead_txs)) {
+				tx_frm = ahead_txs[i].tx_frm_;
+				ret = ahead_txs[i].applied_;
+				expired = ahead_txs[i].expired_;
+				error_info = ahead_txs[i].error_info_;
 			}
+			else {
+				tx_frm = NewTransactionFrm(i, txproto);
 
-			//pay fee
-			if (!tx_frm->PayFee(environment_, total_fee_)) {
-				LOG_ERROR("Failed to pay fee, consensus value sequence(" FMT_I64 ")", request.ledger_seq());
-				return false;
-			}
+				if (!tx_frm->ValidForApply(environment_, !IsTestMode())) {
+					LOG_ERROR("Validition for application failed: consensus value sequence(" FMT_I64 ")", request.ledger_seq());
+					return false;
+				}
 
-			ledger_context->transaction_stack_.push_back(tx_frm);
-			tx_frm->NonceIncrease(this, environment_);
-			environment_->Commit();
+				//pay fee
+				if (!tx_frm->PayFee(environment_, total_fee_)) {
+					LOG_ERROR("Failed to pay fee, consensus value sequence(" FMT_I64 ")", request.ledger_seq());
+					return false;
+				}
 
-			tx_frm->EnableChecked();
-			tx_frm->SetMaxEndTime(utils::Timestamp::HighResolution() + General::TX_EXECUTE_TIME_OUT);
+				ledger_context->transaction_stack_.push_back(tx_frm);
+				tx_frm->NonceIncrease(this, environment_);
+				environment_->Commit();
 
-			bool ret = tx_frm->Apply(this, environment_);
-			//Caculate the required mininum fee by calculting the bytes of the transaction. Do not store the transaction when the user-specified fee is less than this fee. 
-			std::string error_info;
-			if (tx_frm->IsExpire(error_info)) {
+				tx_frm->EnableChecked();
+				tx_frm->SetMaxEndTime(utils::Timestamp::HighResolution() + General::TX_EXECUTE_TIME_OUT);
+
+				ret = tx_frm->Apply(this, environment_);
+				//Caculate the required mininum fee by calculting the bytes of the transaction. Do not store the transaction when the user-specified fee is less than this fee. 
+				expired = tx_frm->IsExpire(error_info);
+				if (!expired && ret) {
+					tx_frm->ReturnFee(total_fee_);
+					tx_frm->environment_->Commit();
+				}
+				ledger_context->transaction_stack_.pop_back();
+			}
+
+			if (expired) {
 				LOG_ERROR("Failed to apply transaction(%s). %s, %s",
 					utils::String::BinToHexString(tx_frm->GetContentHash()).c_str(), tx_frm->GetResult().desc().c_str(),
 					error_info.c_str());
 				expire_txs.insert(i);//for check
 			}
-			else {
-				if (!ret) {
-					LOG_ERROR("Failed to apply transaction(%s). %s",
-						utils::String::BinToHexString(tx_frm->GetContentHash()).c_str(), tx_frm->GetResult().desc().c_str());
-					error_txs.insert(i);//for check
-				}
-				else {
-					tx_frm->ReturnFee(total_fee_);
-					tx_frm->environment_->Commit();
-				}
+			else if (!ret) {
+				LOG_ERROR("Failed to apply transaction(%s). %s",
+					utils::String::BinToHexString(tx_frm->GetContentHash()).c_str(), tx_frm->GetResult().desc().c_str());
+				error_txs.insert(i);//for check
 			}
 
 			environment_->ClearChangeBuf();
 			apply_tx_frms_.push_back(tx_frm);
 			ledger_.add_transaction_envs()->CopyFrom(txproto);
-			ledger_context->transaction_stack_.pop_back();
 
 			if (utils::Timestamp::HighResolution() - start_time > General::BLOCK_EXECUTE_TIME_OUT) {
 				LOG_ERROR("Applying block timeout(" FMT_I64 ") ", utils::Timestamp::HighResolution() - start_time);
@@ -408,6 +436,8 @@ namespace bumo {
 		uint32_t success_count = 0;
 		total_fee_= 0;
 		environment_ = std::make_shared<Environment>();
+		environment_->SetStateView(state_view_);
+		PrepareTxs(request);
 
 		//Init the txs map (transaction map).
 		std::set<int32_t> expire_txs_check, error_txs_check;
@@ -417,44 +447,57 @@ namespace bumo {
 			return false;
 		}
 
+		//The expired transactions are not applied, leave them to the serial pass.
+		std::vector<AheadTx> ahead_txs;
+		std::shared_ptr<ParallelExecutor> executor = NewExecutor(request, APPLY_MODE_FOLLOW, expire_txs_check, ahead_txs);
+
 		for (int i = 0; i < request.txset().txs_size() && enabled_; i++) {
-			auto txproto = request.txset().txs(i);
-			
-			TransactionFrm::pointer tx_frm = std::make_shared<TransactionFrm>(txproto);
+			const protocol::TransactionEnv &txproto = request.txset().txs(i);
 
-			//Pay fee
-			if (!tx_frm->PayFee(environment_, total_fee_)) {
-				LOG_WARN("Failed to pay fee.");
-				continue;
+			TransactionFrm::pointer tx_frm;
+			bool ret = false;
+			bool expired = false;
+			if (CommitAhead(executor.get(), i, ahead_txs)) {
+				tx_frm = ahead_txs[i].tx_frm_;
+				ret = ahead_txs[i].applied_;
 			}
+			else {
+				tx_frm = NewTransactionFrm(i, txproto);
 
-			ledger_context->transaction_stack_.push_back(tx_frm);
-			tx_frm->NonceIncrease(this, environment_);
-			environment_->Commit();
+				//Pay fee
+				if (!tx_frm->PayFee(environment_, total_fee_)) {
+					LOG_WARN("Failed to pay fee.");
+					continue;
+				}
 
+				ledger_context->transaction_stack_.push_back(tx_frm);
+				tx_frm->NonceIncrease(this, environment_);
+				environment_->Commit();
 
-			if ( expire_txs_check.find(i) != expire_txs_check.end()) {
-				//Follow the consensus value, and do not apply the transaction set.
-				tx_frm->ApplyExpireResult();
-			}
-			else {
-				bool ret = tx_frm->Apply(this, environment_);
-				if (!ret) {
-					LOG_ERROR("Failed to apply transaction(%s). %s",
-						utils::String::BinToHexString(tx_frm->GetContentHash()).c_str(), tx_frm->GetResult().desc().c_str());
-					error_txs.insert(i);//for check
+				if (expire_txs_check.find(i) != expire_txs_check.end()) {
+					//Follow the consensus value, and do not apply the transaction set.
+					tx_frm->ApplyExpireResult();
+					expired = true;
 				}
 				else {
-					tx_frm->ReturnFee(total_fee_);
-					tx_frm->environment_->Commit();
+					ret = tx_frm->Apply(this, environment_);
+					if (ret) {
+						tx_frm->ReturnFee(total_fee_);
+						tx_frm->environment_->Commit();
+					}
 				}
+				ledger_context->transaction_stack_.pop_back();
+			}
+
+			if (!expired && !ret) {
+				LOG_ERROR("Failed to apply transaction(%s). %s",
+					utils::String::BinToHexString(tx_frm->GetContentHash()).c_str(), tx_frm->GetResult().desc().c_str());
+				error_txs.insert(i);//for check
 			}
 
 			environment_->ClearChangeBuf();
-			apply_tx_frms_.push_back(tx_frm);			
+			apply_tx_frms_.push_back(tx_frm);
 			ledger_.add_transaction_envs()->CopyFrom(txproto);
-			ledger_context->transaction_stack_.pop_back();
-
 		}
 		AllocateReward();
 		apply_time_ = utils::Timestamp::HighResolution() - start_time;
@@ -474,25 +517,237 @@ namespace bumo {
 		return ledger_;
 	}
 
-	bool LedgerFrm::Commit(KVTrie* trie, int64_t& new_count, int64_t& change_count) {
+	class LedgerFrm::PrefetchTask : public utils::Runnable {
+	public:
+		PrefetchTask(Environment *environment, const protocol::TransactionEnvSet &txset)
+			:environment_(environment), txset_(txset){}
+
+		virtual void Run(utils::Thread *){
+			std::vector<std::string> addresses;
+			GetTouchedAccounts(txset_, addresses);
+			environment_->Prefetch(addresses);
+			done_.Signal();
+		}
+
+		Environment *environment_;
+		const protocol::TransactionEnvSet &txset_;
+		utils::Semaphore done_;
+	};
+
+	void LedgerFrm::GetTouchedAccounts(const protocol::TransactionEnvSet &txset, std::vector<std::string> &addresses) {
+		std::vector<std::string> accounts;
+		for (int i = 0; i < txset.txs_size(); i++) {
+			GetTouchedAccounts(txset.txs(i).transaction(), accounts);
+		}
+
+		std::set<std::string> touched(accounts.begin(), accounts.end());
+		touched.erase("");
+		addresses.assign(touched.begin(), touched.end());
+	}
+
+	void LedgerFrm::GetTouchedAccounts(const protocol::Transaction &tx, std::vector<std::string> &addresses) {
+		addresses.push_back(tx.source_address());
+		for (int j = 0; j < tx.operations_size(); j++) {
+			const protocol::Operation &ope = tx.operations(j);
+			if (!ope.source_address().empty()) {
+				addresses.push_back(ope.source_address());
+			}
+
+			switch (ope.type()) {
+			case protocol::Operation_Type_CREATE_ACCOUNT:
+				addresses.push_back(ope.create_account().dest_address());
+				break;
+			case protocol::Operation_Type_PAY_ASSET:
+				addresses.push_back(ope.pay_asset().dest_address());
+				break;
+			case protocol::Operation_Type_PAY_COIN:
+				addresses.push_back(ope.pay_coin().dest_address());
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	void LedgerFrm::PrepareTxs(const protocol::ConsensusValue& request) {
+		utils::ThreadPool *pool = &LedgerManager::Instance().apply_pool_;
+		PrefetchTask *task = new PrefetchTask(environment_.get(), request.txset());
+		if (pool->Size() > 0) {
+			pool->AddTask(task);
+		}
+		else {
+			task->Run(NULL);
+		}
+
+		SignatureVerifier verifier(pool->Size() > 0 ? pool : NULL);
+		verifier.Verify(request.txset(), verified_txs_);
+
+		while (!task->done_.Wait()) {
+		}
+		delete task;
+	}
+
+	TransactionFrm::pointer LedgerFrm::NewTransactionFrm(int32_t index, const protocol::TransactionEnv &txproto) {
+		if (index >= 0 && index < (int32_t)verified_txs_.size()) {
+			const SignatureVerifier::Verified &verified = verified_txs_[index];
+			return std::make_shared<TransactionFrm>(txproto, verified.data_, verified.hash_, verified.signers_);
+		}
+		return std::make_shared<TransactionFrm>(txproto);
+	}
+
+	bool LedgerFrm::CanRunAhead(const protocol::Transaction &tx) {
+		for (int i = 0; i < tx.operations_size(); i++) {
+			const protocol::Operation &ope = tx.operations(i);
+			switch (ope.type()) {
+			case protocol::Operation_Type_CREATE_ACCOUNT:
+				if (!ope.create_account().contract().payload().empty()) {
+					return false;
+				}
+				break;
+			//The payments to contract accounts are stopped by the speculative environment.
+			case protocol::Operation_Type_PAY_COIN:
+			case protocol::Operation_Type_PAY_ASSET:
+			case protocol::Operation_Type_ISSUE_ASSET:
+			case protocol::Operation_Type_SET_METADATA:
+			case protocol::Operation_Type_SET_SIGNER_WEIGHT:
+			case protocol::Operation_Type_SET_THRESHOLD:
+			case protocol::Operation_Type_LOG:
+			case protocol::Operation_Type_SET_PRIVILEGE:
+				break;
+			default:
+				return false;
+			}
+		}
+		return true;
+	}
+
+	std::shared_ptr<ParallelExecutor> LedgerFrm::NewExecutor(const protocol::ConsensusValue& request, APPLY_MODE mode,
+		const std::set<int32_t> &serial_txs, std::vector<AheadTx> &ahead_txs) {
+		utils::ThreadPool *pool = &LedgerManager::Instance().apply_pool_;
+		if (pool->Size() == 0 || IsTestMode() || request.txset().txs_size() < 2) {
+			return nullptr;
+		}
+
+		ahead_txs.resize(request.txset().txs_size());
+		std::shared_ptr<ParallelExecutor> executor = std::make_shared<ParallelExecutor>(pool, environment_,
+			[this, mode, &request, &ahead_txs](int32_t index, std::shared_ptr<Environment> environment) {
+			return RunAhead(mode, index, request.txset().txs(index), environment, ahead_txs[index]);
+		});
+
+		for (int i = 0; i < request.txset().txs_size(); i++) {
+			const protocol::Transaction &tx = request.txset().txs(i).transaction();
+			std::vector<std::string> accounts;
+			GetTouchedAccounts(tx, accounts);
+			executor->Add(serial_txs.find(i) == serial_txs.end() && CanRunAhead(tx), accounts);
+		}
+		return executor;
+	}
+
+	bool LedgerFrm::RunAhead(APPLY_MODE mode, int32_t index, const protocol::TransactionEnv &txproto, std::shared_ptr<Environment> environment, AheadTx &ahead) {
+		//The same steps as the serial pass, on the speculative environment and a fee of its own.
+		TransactionFrm::pointer tx_frm = NewTransactionFrm(index, txproto);
+		ahead.tx_frm_ = tx_frm;
+		ahead.applied_ = false;
+		ahead.expired_ = false;
+		ahead.fee_ = 0;
+
+		if (mode != APPLY_MODE_FOLLOW && !tx_frm->ValidForApply(environment, !IsTestMode())) {
+			return false;
+		}
+
+		if (!tx_frm->PayFee(environment, ahead.fee_)) {
+			return false;
+		}
+
+		tx_frm->NonceIncrease(this, environment);
+		environment->Commit();
+
+		if (mode != APPLY_MODE_FOLLOW) {
+			tx_frm->EnableChecked();
+			tx_frm->SetMaxEndTime(utils::Timestamp::HighResolution() + General::TX_EXECUTE_TIME_OUT);
+		}
+
+		ahead.applied_ = tx_frm->Apply(this, environment);
+		ahead.expired_ = (mode != APPLY_MODE_FOLLOW && tx_frm->IsExpire(ahead.error_info_));
+		if (!ahead.expired_ && ahead.applied_) {
+			tx_frm->ReturnFee(ahead.fee_);
+			environment->Commit();
+		}
+		environment->ClearChangeBuf();
+		return true;
+	}
+
+	bool LedgerFrm::CommitAhead(ParallelExecutor *executor, int32_t index, std::vector<AheadTx> &ahead_txs) {
+		if (executor == NULL || !executor->Validate(index)) {
+			return false;
+		}
+
+		//Where the serial PayFee would overflow the total fee, let it fail there.
+		AheadTx &ahead = ahead_txs[index];
+		int64_t total_fee = 0;
+		if (!utils::SafeIntAdd(total_fee_, ahead.tx_frm_->GetFeeLimit(), total_fee)) {
+			return false;
+		}
+
+		executor->Commit(index);
+		total_fee_ += ahead.fee_;
+		ahead.tx_frm_->environment_ = environment_;
+		return true;
+	}
+
+	LedgerFrm::CommitStat::CommitStat() :
+		new_count_(0),
+		change_count_(0),
+		unchanged_count_(0),
+		trie_hashed_count_(0),
+		trie_kept_count_(0) {}
+
+	Json::Value LedgerFrm::CommitStat::ToJson() const {
+		Json::Value result;
+		result["new_count"] = new_count_;
+		result["change_count"] = change_count_;
+		result["unchanged_count"] = unchanged_count_;
+		result["trie_hashed_count"] = trie_hashed_count_;
+		result["trie_kept_count"] = trie_kept_count_;
+		return result;
+	}
+
+	bool LedgerFrm::Commit(KVTrie* trie, CommitStat &stat) {
 		auto batch = trie->batch_;
 		auto entries = environment_->GetData();
 
+		//Load the paths of all the changed accounts level by level before updating them.
+		std::vector<std::string> indexes;
+		for (auto it = entries.begin(); it != entries.end(); it++){
+			if (it->second.type_ != utils::DEL){
+				indexes.push_back(DecodeAddress(it->first));
+			}
+		}
+		trie->Prefetch(indexes);
+
 		for (auto it = entries.begin(); it != entries.end(); it++){
 
 			if (it->second.type_ == utils::DEL)
 				continue; //There is no delete account function now.
 
 			std::shared_ptr<AccountFrm> account = it->second.ptr_;
-			account->UpdateHash(batch);
+			int32_t hashed = account->UpdateHash(batch);
+			stat.trie_hashed_count_ += hashed;
+			stat.trie_kept_count_ += 2 - hashed;
+
 			std::string ss = account->Serializer();
+			if (account->IsStored(ss)){
+				stat.unchanged_count_++;
+				continue;
+			}
+
 			std::string index = DecodeAddress(it->first);
 			bool is_new = trie->Set(index, ss);
 			if (is_new){
-				new_count++;
+				stat.new_count_++;
 			}
 			else{
-				change_count++;
+				stat.change_count_++;
 			}
 		}
 		return true;
@@ -21,6 +21,8 @@
 #include "transaction_frm.h"
 #include "glue/transaction_set.h"
 #include "account.h"
+#include "parallel_executor.h"
+#include "signature_verifier.h"
 #include "proto/cpp/consensus.pb.h"
 
 namespace bumo {
@@ -49,6 +51,18 @@ namespace bumo {
 			APPLY_MODE_FOLLOW = 2
 		} APPLY_MODE;
 
+		//The accounts committed by a ledger into the account tree.
+		struct CommitStat {
+			int64_t new_count_;
+			int64_t change_count_;
+			int64_t unchanged_count_; //Serialized the same as read, not written
+			int64_t trie_hashed_count_; //Asset and metadata tries rehashed
+			int64_t trie_kept_count_; //Asset and metadata tries not written, their hashes kept
+
+			CommitStat();
+			Json::Value ToJson() const;
+		};
+
 		LedgerFrm();
 		~LedgerFrm();
 
@@ -71,6 +85,7 @@ namespace bumo {
 
 		bool Cancel();
 
+		//Fill the batch with the ledger and its transactions, the caller writes it.
 		bool AddToDb(WRITE_BATCH& batch);
 
 		bool LoadFromDb(int64_t seq);
@@ -97,21 +112,55 @@ namespace bumo {
 
 		Json::Value ToJson();
 
-		bool Commit(KVTrie* trie, int64_t& new_count, int64_t& change_count);
+		bool Commit(KVTrie* trie, CommitStat &stat);
 
 		bool AllocateReward();
 		
 		void SetTestMode(bool test_mode);
 		bool IsTestMode();
 
+		//Only the operations which cannot call a contract run ahead.
+		static bool CanRunAhead(const protocol::Transaction &tx);
+		//The accounts known to be read by the transactions of the set without running them:
+		//the sources, and the destinations of the payments and of the created accounts.
+		static void GetTouchedAccounts(const protocol::TransactionEnvSet &txset, std::vector<std::string> &addresses);
+		//Append those of one transaction, which are also the accounts its parallel run conflicts on.
+		static void GetTouchedAccounts(const protocol::Transaction &tx, std::vector<std::string> &addresses);
+
 	private:
+		class PrefetchTask;
+		//Before applying the set, read its touched accounts in one pass on a pool thread,
+		//while its transactions are serialized, hashed and verified.
+		void PrepareTxs(const protocol::ConsensusValue& request);
+		TransactionFrm::pointer NewTransactionFrm(int32_t index, const protocol::TransactionEnv &txproto);
+
+		//A transaction run ahead of the ledger by the parallel executor.
+		struct AheadTx {
+			TransactionFrm::pointer tx_frm_;
+			bool applied_;
+			bool expired_;
+			std::string error_info_;
+			int64_t fee_; //The fee limit less the refund
+		};
+
+		//Run the transactions of the set ahead in parallel, NULL to apply them serially.
+		//The transactions in serial_txs are always applied serially.
+		std::shared_ptr<ParallelExecutor> NewExecutor(const protocol::ConsensusValue& request, APPLY_MODE mode,
+			const std::set<int32_t> &serial_txs, std::vector<AheadTx> &ahead_txs);
+		bool RunAhead(APPLY_MODE mode, int32_t index, const protocol::TransactionEnv &txproto, std::shared_ptr<Environment> environment, AheadTx &ahead);
+		//Commit the transaction as it ran ahead, false to apply it serially.
+		bool CommitAhead(ParallelExecutor *executor, int32_t index, std::vector<AheadTx> &ahead_txs);
+
 		protocol::Ledger ledger_;
 		bool is_test_mode_;
+		std::vector<SignatureVerifier::Verified> verified_txs_;
 	public:
 		std::shared_ptr<protocol::ConsensusValue> value_;
 		std::vector<TransactionFrm::pointer> apply_tx_frms_;
 		std::vector<TransactionFrm::pointer> dropped_tx_frms_;
 		std::shared_ptr<Environment> environment_;
+		//The state the ledger is applied on, NULL for the account tree
+		StateView::pointer state_view_;
 		LedgerContext *lpledger_context_;
 		int64_t apply_time_;
 		bool enabled_;
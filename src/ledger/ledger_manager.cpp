@@ -20,12 +20,16 @@
 #include "ledger_manager.h"
 #include <contract/contract_manager.h>
 #include "fee_calculate.h"
+#include "node_cache.h"
+#include "signature_cache.h"
+#include "state_stage.h"
 
 namespace bumo {
-	LedgerManager::LedgerManager() : tree_(NULL) {
+	LedgerManager::LedgerManager() : tree_(NULL), account_tries_(ACCOUNT_TRIE_CACHE_SIZE) {
 		check_interval_ = 500 * utils::MICRO_UNITS_PER_MILLI;
 		timer_name_ = "Ledger Mananger";
 		chain_max_ledger_probaly_ = 0;
+		pruned_seq_ = 0;
 	}
 
 	LedgerManager::~LedgerManager() {
@@ -36,6 +40,15 @@ namespace bumo {
 	}
 
 	bool LedgerManager::GetValidators(int64_t seq, protocol::ValidatorSet& validators_set) {
+		//The ledger being sealed is not written yet.
+		do {
+			utils::MutexGuard guard(sealing_mutex_);
+			if (sealing_ != nullptr && sealing_->seq_ == seq) {
+				validators_set = sealing_->validators_;
+				return true;
+			}
+		} while (false);
+
 		LedgerFrm frm;
 		if (!frm.LoadFromDb(seq)) {
 			return false;
@@ -53,7 +66,10 @@ namespace bumo {
 
 	bool LedgerManager::CheckAndRepairLedgerSeq(){
 #ifdef OS_LINUX
-		return true;
+		//The storage writer may have written several ledgers to the ledger db only.
+		if (!Configure::Instance().db_configure_.async_commit_) {
+			return true;
+		}
 #endif
 		auto ledger_db = Storage::Instance().ledger_db();
 		auto account_db = Storage::Instance().account_db();
@@ -83,14 +99,16 @@ namespace bumo {
 			return true;
 		}
 
-		if (int_account_db_seq != int_ledger_db_seq - 1) {
-			LOG_ERROR("Ledger seq (%s) from ledger-db not equal with seq (%s) + 1 from account-db",
+		//The account db is written after the ledger db, so it is the one left behind.
+		if (int_account_db_seq > int_ledger_db_seq) {
+			LOG_ERROR("Ledger seq (%s) from ledger-db is less than seq (%s) from account-db",
 				ledger_db_seq.c_str(), account_db_seq.c_str());
 			return false;
 		}
 
-		if (!ledger_db->Put(General::KEY_LEDGER_SEQ, account_db_seq)) {
-			LOG_ERROR("Failed to get ledger seq from account-db");
+		//The ledgers past the account db are dropped with their transactions, they are synced again.
+		if (!StorageWriter::Rewind(ledger_db, int_ledger_db_seq, int_account_db_seq)) {
+			LOG_ERROR("Failed to rewind ledger-db to seq (%s), %s", account_db_seq.c_str(), ledger_db->error_desc().c_str());
 			return false;
 		}
 
@@ -105,12 +123,37 @@ namespace bumo {
 		}
 
 		HashWrapper::SetLedgerHashType(Configure::Instance().ledger_configure_.hash_type_);
+		NodeCache::Instance().SetCapacity(Configure::Instance().ledger_configure_.node_cache_size_);
+		SignatureCache::Instance().SetCapacity(Configure::Instance().ledger_configure_.signature_cache_size_);
 
 		tree_ = new KVTrie();
 		auto batch = std::make_shared<WRITE_BATCH>();
 		tree_->Init(Storage::Instance().account_db(), batch, General::ACCOUNT_PREFIX, 4);
 
-		context_manager_.Initialize();
+		uint32_t hash_thread_count = Configure::Instance().ledger_configure_.hash_thread_count_;
+		if (hash_thread_count > 0) {
+			if (!hash_pool_.Init("hash", hash_thread_count)) {
+				LOG_ERROR_ERRNO("Failed to start hash thread pool", STD_ERR_CODE, STD_ERR_DESC);
+				return false;
+			}
+			tree_->SetHashPool(&hash_pool_);
+		}
+
+		uint32_t apply_thread_count = Configure::Instance().ledger_configure_.apply_thread_count_;
+		if (apply_thread_count > 0) {
+			if (!apply_pool_.Init("apply", apply_thread_count)) {
+				LOG_ERROR_ERRNO("Failed to start apply thread pool", STD_ERR_CODE, STD_ERR_DESC);
+				return false;
+			}
+		}
+
+		if (!pipeline_.Initialize(Configure::Instance().ledger_configure_.pipeline_close_)) {
+			return false;
+		}
+
+		if (!context_manager_.Initialize()) {
+			return false;
+		}
 
 		auto kvdb = Storage::Instance().account_db();
 		std::string str_max_seq;
@@ -141,10 +184,16 @@ namespace bumo {
 		if (kvdb->Get(General::STATISTICS, str)) {
 			statistics_.fromString(str);
 		}
+
+		if (Storage::Instance().ledger_db()->Get(General::KEY_PRUNED_SEQ, str) > 0) {
+			pruned_seq_ = utils::String::Stoi64(str);
+		}
 		//avoid dead lock
 		utils::WriteLockGuard guard(lcl_header_mutex_);
 		lcl_header_ = last_closed_ledger_->GetProtoHeader();
+		written_header_ = lcl_header_;
 
+		NodeCache::Instance().Clear(lcl_header_.seq());
 		tree_->UpdateHash();
 		const protocol::LedgerHeader& lclheader = last_closed_ledger_->GetProtoHeader();
 		std::string validators_hash = lclheader.validators_hash();
@@ -184,6 +233,14 @@ namespace bumo {
 			PROCESS_EXIT("Consensus ledger version:%d, software ledger version:%d", lclheader.version(), General::LEDGER_VERSION);
 		}
 
+		Storage::Instance().writer().TakeSnapshot(lclheader.seq());
+		written_snapshot_ = Storage::Instance().writer().snapshot();
+
+		if (!state_sync_.Initialize(validators_, lclheader.seq())) {
+			LOG_ERROR("Failed to initialize state sync");
+			return false;
+		}
+
 		TimerNotify::RegisterModule(this);
 		StatusModule::RegisterModule(this);
 		return true;
@@ -191,17 +248,28 @@ namespace bumo {
 
 	bool LedgerManager::Exit() {
 		LOG_INFO("Ledger manager stoping...");
+		state_sync_.Exit();
+		pipeline_.Exit();
+		context_manager_.Exit();
 
 		if (tree_) {
 			delete tree_;
 			tree_ = NULL;
 		}
+		hash_pool_.Exit();
+		apply_pool_.Exit();
+
+		//Let the storage close the databases, the views of the queries are gone.
+		do {
+			utils::WriteLockGuard guard(lcl_header_mutex_);
+			written_snapshot_.reset();
+		} while (false);
 		LOG_INFO("Ledger manager stoped. [OK]");
 		return true;
 	}
 
 	int LedgerManager::GetAccountNum() {
-		utils::MutexGuard guard(gmutex_);
+		utils::MutexGuard guard(statistics_mutex_);
 		return statistics_["account_count"].asInt();
 	}
 
@@ -209,8 +277,39 @@ namespace bumo {
 		return tree_mutex_;
 	}
 
+	StateView::pointer LedgerManager::GetStateView() {
+		std::shared_ptr<StorageSnapshot> snapshot;
+		do {
+			utils::ReadLockGuard guard(lcl_header_mutex_);
+			snapshot = written_snapshot_;
+		} while (false);
+		if (snapshot == nullptr) {
+			return nullptr;
+		}
+		return std::make_shared<StateView>(snapshot);
+	}
+
+	std::shared_ptr<KVTrie> LedgerManager::GetAccountTrie(const std::string& prefix, std::shared_ptr<WRITE_BATCH> batch) {
+		utils::MutexGuard guard(account_tries_mutex_);
+		std::shared_ptr<KVTrie> trie;
+		if (!account_tries_.get(prefix, trie)) {
+			//Only load the root, the modified paths are loaded on demand.
+			trie = std::make_shared<KVTrie>();
+			trie->Init(Storage::Instance().account_db(), batch, prefix, -1);
+			account_tries_.put(prefix, trie);
+		}
+
+		trie->batch_ = batch;
+		return trie;
+	}
+
 
 	void LedgerManager::OnTimer(int64_t current_time) {
+		if (state_sync_.IsActive()) {
+			state_sync_.OnTimer(current_time);
+			return;
+		}
+
 		int64_t next_seq = 0;
 		std::set<int64_t> active_peers = PeerManager::Instance().ConsensusNetwork().GetActivePeerIds();
 		std::set<int64_t> enable_peers;
@@ -267,7 +366,82 @@ namespace bumo {
 	}
 
 	void LedgerManager::OnSlowTimer(int64_t current_time) {
+		PruneHistory();
+	}
+
+	void LedgerManager::PruneHistory() {
+		const LedgerConfigure &ledger_config = Configure::Instance().ledger_configure_;
+		if (ledger_config.history_ledger_count_ <= 0) {
+			return;
+		}
+
+		//A few ledgers each round, so the deletes and their compaction do not compete with closing ledgers.
+		int64_t prune_end = GetLastClosedLedger().seq() - ledger_config.history_ledger_count_;
+		int64_t begin = GetPrunedSeq() + 1;
+		int64_t end = std::min(prune_end, begin + (int64_t)ledger_config.prune_ledger_per_round_ - 1);
+		if (end < begin) {
+			return;
+		}
+
+		KeyValueDb *ledger_db = Storage::Instance().ledger_db();
+		std::shared_ptr<WRITE_BATCH> batch = std::make_shared<WRITE_BATCH>();
+		for (int64_t seq = begin; seq <= end; seq++) {
+			std::string hash_list;
+			int32_t ret = ledger_db->Get(ComposePrefix(General::LEDGER_TRANSACTION_PREFIX, seq), hash_list);
+			if (ret < 0) {
+				LOG_ERROR("Failed to load transaction hashes of ledger(" FMT_I64 "), error desc(%s)", seq, ledger_db->error_desc().c_str());
+				return;
+			}
+
+			//The list also holds the transactions triggered by contracts.
+			protocol::EntryList list;
+			if (ret > 0 && !list.ParseFromString(hash_list)) {
+				LOG_ERROR("Failed to parse transaction hashes of ledger(" FMT_I64 ")", seq);
+				return;
+			}
+			for (int32_t i = 0; i < list.entry_size(); i++) {
+				batch->Delete(ComposePrefix(General::TRANSACTION_PREFIX, list.entry(i)));
+			}
+			batch->Delete(ComposePrefix(General::LEDGER_TRANSACTION_PREFIX, seq));
+			batch->Delete(ComposePrefix(General::CONSENSUS_VALUE_PREFIX, seq));
+		}
+		batch->Put(General::KEY_PRUNED_SEQ, utils::String::ToString(end));
+
+		//The peers are refused the ledgers before they are deleted.
+		do {
+			utils::MutexGuard guard(prune_mutex_);
+			pruned_seq_ = end;
+		} while (false);
+
+		//In order with the batches of the ledgers queued before, the deletes are not pending reads.
+		do {
+			utils::WriteLockGuard guard(Storage::Instance().account_ledger_lock_);
+			Storage::Instance().writer().WriteLedgerDb(batch);
+		} while (false);
+		LOG_TRACE("Pruned ledgers[" FMT_I64 "," FMT_I64 "]", begin, end);
+
+		//The deleted keys take space until they are compacted, which happens late for a range no longer written.
+		if ((begin - 1) / COMPACT_LEDGER_COUNT == end / COMPACT_LEDGER_COUNT) {
+			return;
+		}
+
+		const char *prefixes[] = { General::TRANSACTION_PREFIX, General::LEDGER_TRANSACTION_PREFIX, General::CONSENSUS_VALUE_PREFIX };
+		for (size_t i = 0; i < sizeof(prefixes) / sizeof(prefixes[0]); i++) {
+			//All the keys of the prefix, '`' follows '_'.
+			std::string prefix = prefixes[i];
+			int64_t time_start = utils::Timestamp::HighResolution();
+			if (!ledger_db->CompactRange(prefix + "_", prefix + "`")) {
+				LOG_ERROR("Failed to compact the pruned keys of prefix(%s), error desc(%s)", prefix.c_str(), ledger_db->error_desc().c_str());
+				return;
+			}
+			LOG_INFO("Compacted the pruned keys of prefix(%s) in " FMT_I64 " ms", prefix.c_str(),
+				(utils::Timestamp::HighResolution() - time_start) / utils::MICRO_UNITS_PER_MILLI);
+		}
+	}
 
+	int64_t LedgerManager::GetPrunedSeq() {
+		utils::MutexGuard guard(prune_mutex_);
+		return pruned_seq_;
 	}
 
 	protocol::LedgerHeader LedgerManager::GetLastClosedLedger() {
@@ -275,6 +449,11 @@ namespace bumo {
 		return lcl_header_;
 	}
 
+	protocol::LedgerHeader LedgerManager::GetWrittenLedger() {
+		utils::ReadLockGuard guard(lcl_header_mutex_);
+		return written_header_;
+	}
+
 	void LedgerManager::ValidatorsSet(std::shared_ptr<WRITE_BATCH> batch, const protocol::ValidatorSet& validators) {
 		//should be recoded
 		std::string hash = HashWrapper::Crypto(validators.SerializeAsString());
@@ -376,11 +555,15 @@ namespace bumo {
 		if (!last_closed_ledger_->AddToDb(batch_ledger)) {
 			PROCESS_EXIT("AddToDb failed");
 		}
+		if (!Storage::Instance().ledger_db()->WriteBatch(batch_ledger)) {
+			PROCESS_EXIT("Failed to write ledger and transaction to database(%s)", Storage::Instance().ledger_db()->error_desc().c_str());
+		}
 
 		batch->Put(General::STATISTICS, statistics_.toFastString());
 		if (!Storage::Instance().account_db()->WriteBatch(*batch)) {
 			PROCESS_EXIT("Failed to write account to database, %s", Storage::Instance().account_db()->error_desc().c_str());
 		}
+		NodeCache::Instance().Commit(batch.get(), header->seq());
 
 		return true;
 	}
@@ -465,8 +648,8 @@ namespace bumo {
 			//calculate block reward
 			ProposeTxsResult prop_result;
 			ledger_frm->ApplyPropose(request, NULL, prop_result);
-			int64_t new_count = 0, change_count = 0;
-			ledger_frm->Commit(LedgerManager::GetInstance()->tree_, new_count, change_count);
+			LedgerFrm::CommitStat commit_stat;
+			ledger_frm->Commit(LedgerManager::GetInstance()->tree_, commit_stat);
 
 			//Update account hash
 			LedgerManager::GetInstance()->tree_->UpdateHash();
@@ -477,6 +660,7 @@ namespace bumo {
 			if (!Storage::Instance().account_db()->WriteBatch(*batch_account)) {
 				PROCESS_EXIT("Failed to write account to database, %s", Storage::Instance().account_db()->error_desc().c_str());
 			}
+			NodeCache::Instance().Commit(batch_account.get(), request.ledger_seq());
 
 			header->set_hash(HashWrapper::Crypto(ledger_frm->ProtoLedger().SerializeAsString()));
 
@@ -565,14 +749,44 @@ namespace bumo {
 		data["time"] = utils::String::Format(FMT_I64 " ms",
 			(utils::Timestamp::HighResolution() - begin_time) / utils::MICRO_UNITS_PER_MILLI);
 		data["hash_type"] = HashWrapper::GetLedgerHashType() == HashWrapper::HASH_TYPE_SM3 ? "sm3" : "sha256";
+		data["hash_thread_count"] = (Json::UInt64)hash_pool_.Size();
+		data["apply_thread_count"] = (Json::UInt64)apply_pool_.Size();
+		do {
+			utils::MutexGuard guard(account_tries_mutex_);
+			data["account_trie_count"] = (Json::UInt64)account_tries_.size();
+		} while (false);
+		data["pruned_seq"] = GetPrunedSeq();
 		data["sync"] = sync_.ToJson();
+		state_sync_.GetModuleStatus(data["state_sync"]);
 		context_manager_.GetModuleStatus(data["ledger_context"]);
+		pipeline_.GetModuleStatus(data["close_pipeline"]);
+		do {
+			utils::MutexGuard guard(sealing_mutex_);
+			data["last_commit"] = last_commit_.ToJson();
+		} while (false);
+		SignatureVerifier::GetModuleStatus(data["signature"]);
+		NodeCache::Instance().GetModuleStatus(data["node_cache"]);
+		SignatureCache::Instance().GetModuleStatus(data["signature_cache"]);
+		IsolatePool::Instance().GetModuleStatus(data["isolate_pool"]);
+		CodeCache::Instance().GetModuleStatus(data["code_cache"]);
+		Storage::Instance().writer().GetModuleStatus(data["storage_writer"]);
 
 		data["chain_max_ledger_seq"] = chain_max_ledger_probaly_ > data["ledger_sequence"].asInt64() ?
 		chain_max_ledger_probaly_ : data["ledger_sequence"].asInt64();
 	}
 
 	bool LedgerManager::CloseLedger(const protocol::ConsensusValue& consensus_value, const std::string& proof) {
+		//The consensus takes the hash of the ledger at once.
+		bool ret = StartClose(consensus_value, proof, NULL, NULL);
+		pipeline_.Wait();
+		return ret;
+	}
+
+	bool LedgerManager::StartClose(const protocol::ConsensusValue& consensus_value, const std::string& proof,
+		LedgerFrm::pointer executed, StateView::pointer *ahead_view) {
+		//The value is checked against the hash and the validators of the ledger before.
+		pipeline_.Wait();
+
 		if (!GlueManager::Instance().CheckValueAndProof(consensus_value.SerializeAsString(), proof)) {
 
 			protocol::PbftProof proof_proto;
@@ -582,14 +796,25 @@ namespace bumo {
 				Proto2Json(consensus_value).toFastString().c_str(),
 				Proto2Json(proof_proto).toFastString().c_str());
 
+			if (executed != NULL) {
+				pipeline_.OnRunAhead(false);
+			}
 			return false;
 		}
 
 		std::string con_str = consensus_value.SerializeAsString();
 		std::string chash = HashWrapper::Crypto(con_str);
-		LedgerFrm::pointer closing_ledger = context_manager_.SyncProcess(consensus_value);
-		if (closing_ledger == NULL){
-			return false;
+		LedgerFrm::pointer closing_ledger = executed;
+		if (closing_ledger == NULL) {
+			int64_t time0 = utils::Timestamp::HighResolution();
+			closing_ledger = context_manager_.SyncProcess(consensus_value);
+			pipeline_.OnExecuted(utils::Timestamp::HighResolution() - time0);
+			if (closing_ledger == NULL) {
+				return false;
+			}
+		}
+		else {
+			pipeline_.OnRunAhead(true);
 		}
 
 		protocol::Ledger& ledger = closing_ledger->ProtoLedger();
@@ -601,22 +826,15 @@ namespace bumo {
 		header->set_chain_id(General::GetSelfChainId());
 		header->set_version(last_closed_ledger_->GetProtoHeader().version());
 
-		int64_t time0 = utils::Timestamp().HighResolution();
-		int64_t new_count = 0, change_count = 0;
-		closing_ledger->Commit(tree_, new_count, change_count);
-		statistics_["account_count"] = statistics_["account_count"].asInt64() + new_count;
-
-		int64_t time1 = utils::Timestamp().HighResolution();
+		std::shared_ptr<Sealing> sealing = std::make_shared<Sealing>();
+		sealing->seq_ = consensus_value.ledger_seq();
+		sealing->ledger_ = closing_ledger;
+		sealing->consensus_value_ = consensus_value;
+		sealing->proof_ = proof;
+		sealing->has_upgrade_ = consensus_value.has_ledger_upgrade();
 
-		tree_->UpdateHash();
-		int64_t time2 = utils::Timestamp().HighResolution();
-
-		header->set_account_tree_hash(tree_->GetRootHash());
-		header->set_tx_count(last_closed_ledger_->GetProtoHeader().tx_count() + closing_ledger->ProtoLedger().transaction_envs_size());
-
-		protocol::ValidatorSet new_set;
-		bool has_upgrade = consensus_value.has_ledger_upgrade();
-		if (has_upgrade) {
+		protocol::ValidatorSet &new_set = sealing->validators_;
+		if (sealing->has_upgrade_) {
 			const protocol::LedgerUpgrade &ledger_upgrade = consensus_value.ledger_upgrade();
 
 			//for ledger version
@@ -633,55 +851,161 @@ namespace bumo {
 			}
 		}
 
-		header->set_hash("");
-
-		int64_t ledger_seq = closing_ledger->GetProtoHeader().seq();
-		std::shared_ptr<WRITE_BATCH> account_db_batch = tree_->batch_;
-		account_db_batch->Put(bumo::General::KEY_LEDGER_SEQ, utils::String::Format(FMT_I64, ledger_seq));
-
+		//The validators and the fees take effect for the next ledger, which may be executed before this one is sealed.
 		//for validator upgrade
-		if (new_set.validators_size() > 0 || closing_ledger->environment_->GetVotedValidators(validators_, new_set)) {
-			ValidatorsSet(account_db_batch, new_set);
+		sealing->validators_changed_ = new_set.validators_size() > 0 || closing_ledger->environment_->GetVotedValidators(validators_, new_set);
+		if (sealing->validators_changed_) {
 			validators_ = new_set;
 		}
-		header->set_validators_hash(HashWrapper::Crypto(new_set.SerializeAsString()));//TODO
 
 		//for fee
 		protocol::FeeConfig new_fees;
-		if (closing_ledger->environment_->GetVotedFee(fees_, new_fees)) {
-			FeesConfigSet(account_db_batch, new_fees);
+		sealing->fees_changed_ = closing_ledger->environment_->GetVotedFee(fees_, new_fees);
+		if (sealing->fees_changed_) {
 			utils::WriteLockGuard guard(fee_config_mutex_);
 			fees_ = new_fees;
 		}
-		header->set_fees_hash(HashWrapper::Crypto(fees_.SerializeAsString()));
+		sealing->fees_ = fees_;
+
+		if (ahead_view != NULL) {
+			*ahead_view = NewAheadView(sealing);
+		}
+
+		do {
+			utils::MutexGuard guard(sealing_mutex_);
+			sealing_ = sealing;
+		} while (false);
+
+		pipeline_.Seal(sealing->seq_, [this, sealing]() {
+			SealLedger(sealing);
+		});
+		return true;
+	}
+
+	StateView::pointer LedgerManager::NewAheadView(std::shared_ptr<Sealing> sealing) {
+		//The next ledger reads the version of this one from the last closed ledger.
+		if (!pipeline_.enabled() || sealing->has_upgrade_) {
+			return NULL;
+		}
+
+		//The accounts not changed by this ledger are read from the written state of the ledger before.
+		int64_t lcl_seq = last_closed_ledger_->GetProtoHeader().seq();
+		std::shared_ptr<StorageSnapshot> snapshot = Storage::Instance().writer().WaitSnapshot(lcl_seq);
+		if (snapshot == nullptr || snapshot->seq_ != lcl_seq) {
+			return NULL;
+		}
+
+		//Copies, the seal stage updates the hashes of the accounts.
+		StateView::AccountMap accounts;
+		const Environment::Map &entries = sealing->ledger_->environment_->GetData();
+		for (auto it = entries.begin(); it != entries.end(); it++) {
+			if (it->second.type_ != utils::DEL) {
+				accounts[it->first] = std::make_shared<AccountFrm>(*it->second.ptr_);
+			}
+		}
+
+		StateView::pointer view = std::make_shared<StateView>(snapshot);
+		view->SetOverlay(sealing->seq_, accounts);
+		return view;
+	}
+
+	LedgerFrm::pointer LedgerManager::RunAhead(const protocol::ConsensusValue& consensus_value, StateView::pointer view) {
+		//A contract may read what is only known once the ledger before is sealed, such as its hash.
+		const protocol::TransactionEnvSet &txset = consensus_value.txset();
+		for (int32_t i = 0; i < txset.txs_size(); i++) {
+			if (!LedgerFrm::CanRunAhead(txset.txs(i).transaction())) {
+				return NULL;
+			}
+		}
+
+		int64_t time0 = utils::Timestamp::HighResolution();
+		LedgerFrm::pointer closing_ledger = context_manager_.SyncProcess(consensus_value, view);
+		pipeline_.OnExecuted(utils::Timestamp::HighResolution() - time0);
+
+		if (closing_ledger == NULL || view->ContractRefused()) {
+			LOG_INFO("Ledger(" FMT_I64 ") run ahead is discarded, it is executed again once the ledger before is sealed", consensus_value.ledger_seq());
+			pipeline_.OnRunAhead(false);
+			return NULL;
+		}
+		return closing_ledger;
+	}
+
+	void LedgerManager::SealLedger(std::shared_ptr<Sealing> sealing) {
+		LedgerFrm::pointer closing_ledger = sealing->ledger_;
+		protocol::Ledger& ledger = closing_ledger->ProtoLedger();
+		auto header = ledger.mutable_header();
+
+		int64_t time0 = utils::Timestamp().HighResolution();
+		int64_t time1 = 0;
+		LedgerFrm::CommitStat commit_stat;
+		do {
+			//Called in the close thread without gmutex_, while the environments without a state view read the tree.
+			utils::WriteLockGuard guard(tree_mutex_);
+			closing_ledger->Commit(tree_, commit_stat);
+			time1 = utils::Timestamp().HighResolution();
+			tree_->UpdateHash();
+		} while (false);
+		int64_t time2 = utils::Timestamp().HighResolution();
+
+		header->set_account_tree_hash(tree_->GetRootHash());
+		header->set_tx_count(last_closed_ledger_->GetProtoHeader().tx_count() + closing_ledger->ProtoLedger().transaction_envs_size());
+
+		header->set_hash("");
+
+		int64_t ledger_seq = sealing->seq_;
+		std::shared_ptr<WRITE_BATCH> account_db_batch = tree_->batch_;
+		account_db_batch->Put(bumo::General::KEY_LEDGER_SEQ, utils::String::Format(FMT_I64, ledger_seq));
+
+		if (sealing->validators_changed_) {
+			ValidatorsSet(account_db_batch, sealing->validators_);
+		}
+		header->set_validators_hash(HashWrapper::Crypto(sealing->validators_.SerializeAsString()));//TODO
+
+		if (sealing->fees_changed_) {
+			FeesConfigSet(account_db_batch, sealing->fees_);
+		}
+		header->set_fees_hash(HashWrapper::Crypto(sealing->fees_.SerializeAsString()));
 
 		//This header must be for the latest block.
 		header->set_hash(HashWrapper::Crypto(closing_ledger->ProtoLedger().SerializeAsString()));
 
 		//proof
-		account_db_batch->Put(bumo::General::LAST_PROOF, proof);
-		account_db_batch->Put(bumo::General::STATISTICS, statistics_.toFastString());
-		proof_ = proof;
+		account_db_batch->Put(bumo::General::LAST_PROOF, sealing->proof_);
+		do {
+			utils::MutexGuard guard(statistics_mutex_);
+			statistics_["account_count"] = statistics_["account_count"].asInt64() + commit_stat.new_count_;
+			account_db_batch->Put(bumo::General::STATISTICS, statistics_.toFastString());
+		} while (false);
 
 		//consensus value
-		WRITE_BATCH ledger_db_batch;
-		ledger_db_batch.Put(ComposePrefix(General::CONSENSUS_VALUE_PREFIX, consensus_value.ledger_seq()), consensus_value.SerializeAsString());
+		std::shared_ptr<WRITE_BATCH> ledger_db_batch = std::make_shared<WRITE_BATCH>();
+		ledger_db_batch->Put(ComposePrefix(General::CONSENSUS_VALUE_PREFIX, ledger_seq), sealing->consensus_value_.SerializeAsString());
 
 		do {
 			utils::WriteLockGuard guard(Storage::Instance().account_ledger_lock_);
 
-			if (!closing_ledger->AddToDb(ledger_db_batch)) {
+			if (!closing_ledger->AddToDb(*ledger_db_batch)) {
 				PROCESS_EXIT("Failed to write ledger to database.");
 			}
 
-			if (!Storage::Instance().account_db()->WriteBatch(*account_db_batch)) {
-				PROCESS_EXIT("Failed to write accounts to database: %s", Storage::Instance().account_db()->error_desc().c_str());
-			}
+			//With async_commit the batches are readable from the databases at once, and synced in the background.
+			Storage::Instance().writer().Write(ledger_seq, ledger_db_batch, account_db_batch);
+			NodeCache::Instance().Commit(account_db_batch.get(), ledger_seq);
 
 		} while (false);
 
 		//Update the variable when the write is successful.
-		last_closed_ledger_ = closing_ledger;
+		//The peers read the ledger and its proof from the network thread.
+		do {
+			utils::WriteLockGuard guard(lcl_header_mutex_);
+			last_closed_ledger_ = closing_ledger;
+			proof_ = sealing->proof_;
+		} while (false);
+		do {
+			utils::MutexGuard guard(sealing_mutex_);
+			sealing_.reset();
+			last_commit_ = commit_stat;
+		} while (false);
 
 		int64_t time3 = utils::Timestamp().HighResolution();
 		tree_->batch_ = std::make_shared<WRITE_BATCH>();
@@ -690,7 +1014,7 @@ namespace bumo {
 			tree_->FreeMemory(4);
 		}
 		LOG_INFO("ledger(" FMT_I64 "): closed transaction count(" FMT_SIZE "), ledger hash(%s), time of apply ledger ="  FMT_I64_EX(-8) " time of calculating hash="  FMT_I64_EX(-8) " time of addtodb=" FMT_I64_EX(-8)
-			" total=" FMT_I64_EX(-8) " LoadValue=" FMT_I64 " tsize=" FMT_SIZE,
+			" total=" FMT_I64_EX(-8) " LoadValue=" FMT_I64 " tsize=" FMT_SIZE " accounts written=" FMT_I64 " unchanged=" FMT_I64 " tries hashed=" FMT_I64 " kept=" FMT_I64,
 			closing_ledger->GetProtoHeader().seq(),
 			closing_ledger->GetTxOpeCount(),
 			utils::String::Bin4ToHexString(closing_ledger->GetProtoHeader().hash()).c_str(),
@@ -699,11 +1023,13 @@ namespace bumo {
 			time3 - time2,
 			time3 - time0 + closing_ledger->apply_time_,
 			tree_->time_,
-			closing_ledger->GetTxCount());
+			closing_ledger->GetTxCount(),
+			commit_stat.new_count_ + commit_stat.change_count_,
+			commit_stat.unchanged_count_,
+			commit_stat.trie_hashed_count_,
+			commit_stat.trie_kept_count_);
 
-		NotifyLedgerClose(closing_ledger, has_upgrade);
-
-		return true;
+		NotifyLedgerClose(closing_ledger, sealing->has_upgrade_);
 	}
 
 	void LedgerManager::NotifyLedgerClose(LedgerFrm::pointer closing_ledger, bool has_upgrade) {
@@ -723,8 +1049,29 @@ namespace bumo {
 
 		context_manager_.RemoveCompleted(tmp_lcl_header.seq());
 
+		// monitor
+		monitor::LedgerStatus ledger_status;
+		ledger_status.mutable_ledger_header()->CopyFrom(tmp_lcl_header);
+		ledger_status.set_transaction_size(GlueManager::Instance().GetTransactionCacheSize());
+		ledger_status.set_account_count(GetAccountNum());
+		ledger_status.set_timestamp(utils::Timestamp::HighResolution());
+
+		//The clients see the ledger once it is durable, the next ledger may be executing meanwhile.
+		//A ledger written in a group with the later ones has no snapshot, the clients see the last one of the group.
+		Storage::Instance().writer().OnWritten(tmp_lcl_header.seq(), [this, closing_ledger, tmp_lcl_header, ledger_status]() {
+			std::shared_ptr<StorageSnapshot> snapshot = Storage::Instance().writer().snapshot();
+			if (snapshot != nullptr && snapshot->seq_ == tmp_lcl_header.seq()) {
+				utils::WriteLockGuard guard(lcl_header_mutex_);
+				written_header_ = tmp_lcl_header;
+				written_snapshot_ = snapshot;
+			}
+			BroadcastLedgerClose(closing_ledger, tmp_lcl_header, ledger_status);
+		});
+	}
+
+	void LedgerManager::BroadcastLedgerClose(LedgerFrm::pointer closing_ledger, const protocol::LedgerHeader &header, const monitor::LedgerStatus &ledger_status) {
 		//Broadcast that the ledger is closed.
-		WebSocketServer::Instance().BroadcastMsg(protocol::CHAIN_LEDGER_HEADER, tmp_lcl_header.SerializeAsString());
+		WebSocketServer::Instance().BroadcastMsg(protocol::CHAIN_LEDGER_HEADER, header.SerializeAsString());
 
 		// The broadcast message is applied.
 		for (size_t i = 0; i < closing_ledger->apply_tx_frms_.size(); i++) {
@@ -770,12 +1117,6 @@ namespace bumo {
 		}
 		*/
 
-		// monitor
-		monitor::LedgerStatus ledger_status;
-		ledger_status.mutable_ledger_header()->CopyFrom(tmp_lcl_header);
-		ledger_status.set_transaction_size(GlueManager::Instance().GetTransactionCacheSize());
-		ledger_status.set_account_count(GetAccountNum());
-		ledger_status.set_timestamp(utils::Timestamp::HighResolution());
 		MonitorManager::Instance().SendMonitor(monitor::MONITOR_MSGTYPE_LEDGER, ledger_status.SerializeAsString());
 	}
 
@@ -793,46 +1134,17 @@ namespace bumo {
 
 		do {
 			utils::MutexGuard guard(gmutex_);
-			LOG_TRACE("OnRequestLedgers pid(" FMT_I64 "),[" FMT_I64 ", " FMT_I64 "]", peer_id, message.begin(), message.end());
-			if (message.end() - message.begin() + 1 > 5) {
-				LOG_ERROR("Only 5 blocks can be requested at a time while try to (" FMT_I64 ")", message.end() - message.begin());
-				return;
-			}
-
-			if (message.end() - message.begin() < 0) {
-				LOG_ERROR("Begin is greater than end [" FMT_I64 "," FMT_I64 "]", message.begin(), message.end());
-				return;
-			}
-
-			if (last_closed_ledger_->GetProtoHeader().seq() < message.end()) {
-				LOG_INFO("Peer node(" FMT_I64 ") request ledger[" FMT_I64 "," FMT_I64 "] while the max consensus value is (" FMT_I64 ")",
-					peer_id, message.begin(), message.end(), last_closed_ledger_->GetProtoHeader().seq());
-				return;
-			}
-
-
-			ledgers.set_max_seq(last_closed_ledger_->GetProtoHeader().seq());
-
-			for (int64_t i = message.begin(); i <= message.end(); i++) {
-				protocol::ConsensusValue item;
-				if (!ConsensusValueFromDB(i, item)) {
-					ret = false;
-					LOG_ERROR("Failed to get consensus value from database: consensus value sequence=" FMT_I64, i);
-					break;
-				}
-				ledgers.add_values()->CopyFrom(item);
-			}
+			//Published by the close thread, which does not hold gmutex_
+			int64_t lcl_seq = 0;
+			std::string lcl_proof;
+			do {
+				utils::ReadLockGuard lcl_guard(lcl_header_mutex_);
+				lcl_seq = last_closed_ledger_->GetProtoHeader().seq();
+				lcl_proof = proof_;
+			} while (false);
 
-			int64_t seq = message.end();
-			protocol::ConsensusValue next;
-
-			if (seq == last_closed_ledger_->GetProtoHeader().seq())
-				ledgers.set_proof(proof_);
-			else if (ConsensusValueFromDB(seq + 1, next))
-				ledgers.set_proof(next.previous_proof());
-			else {
-				LOG_ERROR("");
-			}
+			LOG_TRACE("OnRequestLedgers pid(" FMT_I64 "),[" FMT_I64 ", " FMT_I64 "]", peer_id, message.begin(), message.end());
+			ret = GetLedgers(message, lcl_seq, lcl_proof, GetPrunedSeq(), ledgers);
 		} while (false);
 		if (ret) {
 			bumo::WsMessagePointer ws = std::make_shared<protocol::WsMessage>();
@@ -844,6 +1156,56 @@ namespace bumo {
 		}
 	}
 
+	bool LedgerManager::GetLedgers(const protocol::GetLedgers &message, int64_t lcl_seq, const std::string &lcl_proof, int64_t pruned_seq, protocol::Ledgers &ledgers) {
+		if (message.end() - message.begin() + 1 > 5) {
+			LOG_ERROR("Only 5 blocks can be requested at a time while try to (" FMT_I64 ")", message.end() - message.begin());
+			return false;
+		}
+
+		if (message.end() - message.begin() < 0) {
+			LOG_ERROR("Begin is greater than end [" FMT_I64 "," FMT_I64 "]", message.begin(), message.end());
+			return false;
+		}
+
+		if (lcl_seq < message.end()) {
+			LOG_INFO("Request ledger[" FMT_I64 "," FMT_I64 "] while the max consensus value is (" FMT_I64 ")",
+				message.begin(), message.end(), lcl_seq);
+			return false;
+		}
+
+		//The peer moves on to another node.
+		if (message.begin() <= pruned_seq) {
+			LOG_INFO("Request ledger[" FMT_I64 "," FMT_I64 "] while the consensus values up to (" FMT_I64 ") are pruned",
+				message.begin(), message.end(), pruned_seq);
+			ledgers.set_sync_code(protocol::Ledgers::PRUNED);
+			ledgers.set_max_seq(lcl_seq);
+			return true;
+		}
+
+		ledgers.set_max_seq(lcl_seq);
+
+		for (int64_t i = message.begin(); i <= message.end(); i++) {
+			protocol::ConsensusValue item;
+			if (!ConsensusValueFromDB(i, item)) {
+				LOG_ERROR("Failed to get consensus value from database: consensus value sequence=" FMT_I64, i);
+				return false;
+			}
+			ledgers.add_values()->CopyFrom(item);
+		}
+
+		int64_t seq = message.end();
+		protocol::ConsensusValue next;
+
+		if (seq == lcl_seq)
+			ledgers.set_proof(lcl_proof);
+		else if (ConsensusValueFromDB(seq + 1, next))
+			ledgers.set_proof(next.previous_proof());
+		else {
+			LOG_ERROR("");
+		}
+		return true;
+	}
+
 	void LedgerManager::OnReceiveLedgers(const protocol::Ledgers &ledgers, int64_t peer_id) {
 		if (ledgers.chain_id() != General::GetSelfChainId()){
 			LOG_TRACE("Failed to check same chain, node self id(" FMT_I64 ") is not eq (" FMT_I64 ")",
@@ -856,6 +1218,20 @@ namespace bumo {
 
 		do {
 			utils::MutexGuard guard(gmutex_);
+			if (ledgers.sync_code() == protocol::Ledgers::PRUNED) {
+				//Ask the other nodes at once, not after the request times out.
+				auto iter = sync_.peers_.find(peer_id);
+				if (iter != sync_.peers_.end()) {
+					LOG_INFO("Peer node(" FMT_I64 ") has pruned the ledgers[" FMT_I64 "," FMT_I64 "]",
+						peer_id, iter->second.gl_.begin(), iter->second.gl_.end());
+					iter->second.send_time_ = 0;
+					iter->second.probation_ = utils::Timestamp::HighResolution() + 60 * utils::MICRO_UNITS_PER_SEC;
+					iter->second.gl_.set_begin(0);
+					iter->second.gl_.set_end(0);
+				}
+				break;
+			}
+
 			if (ledgers.values_size() == 0) {
 				LOG_ERROR("Received empty Ledgers from(" FMT_I64 ")", peer_id);
 				break;
@@ -886,6 +1262,9 @@ namespace bumo {
 			itm.gl_.set_begin(0);
 			itm.gl_.set_end(0);
 
+			//Every ledger is sealed in the close thread while the next one runs ahead on its state.
+			int64_t closing_seq = last_closed_ledger_->GetProtoHeader().seq();
+			LedgerFrm::pointer ahead;
 			for (int i = 0; i < ledgers.values_size(); i++) {
 				const protocol::ConsensusValue& consensus_value = ledgers.values(i);
 				std::string proof;
@@ -895,15 +1274,24 @@ namespace bumo {
 				else {
 					proof = ledgers.proof();
 				}
-				if (consensus_value.ledger_seq() == last_closed_ledger_->GetProtoHeader().seq() + 1) {
-					if (!CloseLedger(consensus_value, proof)) {
+				if (consensus_value.ledger_seq() == closing_seq + 1) {
+					StateView::pointer view;
+					bool last = (i == ledgers.values_size() - 1);
+					if (!StartClose(consensus_value, proof, ahead, last ? NULL : &view)) {
 						valid = false;
 						itm.probation_ = utils::Timestamp::HighResolution() + 60 * utils::MICRO_UNITS_PER_SEC;
 						break;
 					}
 					valid = true;
+					closing_seq++;
+
+					ahead = NULL;
+					if (view != NULL && ledgers.values(i + 1).ledger_seq() == closing_seq + 1) {
+						ahead = RunAhead(ledgers.values(i + 1), view);
+					}
 				}
 			}
+			pipeline_.Wait();
 			next = last_closed_ledger_->GetProtoHeader().seq() + 1;
 		} while (false);
 
@@ -925,6 +1313,128 @@ namespace bumo {
 		}
 	}
 
+	void LedgerManager::OnRequestStateNodes(const protocol::GetStateNodes &message, int64_t peer_id) {
+		state_sync_.OnRequest(message, peer_id);
+	}
+
+	void LedgerManager::OnReceiveStateNodes(const protocol::StateNodes &message, int64_t peer_id) {
+		state_sync_.OnReceive(message, peer_id);
+	}
+
+	bool LedgerManager::OnStateSynced(const protocol::StateSyncStatus &status) {
+		const protocol::LedgerHeader &header = status.ledger().header();
+		std::string seq = utils::String::ToString(header.seq());
+		KeyValueDb *account_db = Storage::Instance().account_db();
+
+		//Nothing is written at the keys of the genesis state before the whole state is checked.
+		if (!status.committing()) {
+			if (!StateStage::Verify(account_db, status)) {
+				StateStage::Discard(account_db, status);
+				if (!account_db->Delete(General::KEY_STATE_SYNC)) {
+					PROCESS_EXIT("Failed to write account to database, %s", account_db->error_desc().c_str());
+				}
+				return false;
+			}
+
+			//Moving the nodes goes on after a restart.
+			protocol::StateSyncStatus committing = status;
+			committing.clear_pending();
+			committing.set_committing(true);
+			if (!account_db->Put(General::KEY_STATE_SYNC, committing.SerializeAsString())) {
+				PROCESS_EXIT("Failed to write account to database, %s", account_db->error_desc().c_str());
+			}
+		}
+		StateStage::Apply(account_db, status);
+
+		utils::MutexGuard guard(gmutex_);
+
+		//The transactions of the checkpoint are not kept, so it counts as pruned.
+		WRITE_BATCH ledger_batch;
+		ledger_batch.Put(General::KEY_LEDGER_SEQ, seq);
+		ledger_batch.Put(ComposePrefix(General::LEDGER_PREFIX, header.seq()), header.SerializeAsString());
+		ledger_batch.Put(General::KEY_PRUNED_SEQ, seq);
+		if (!Storage::Instance().ledger_db()->WriteBatch(ledger_batch)) {
+			PROCESS_EXIT("Failed to write ledger to database(%s)", Storage::Instance().ledger_db()->error_desc().c_str());
+		}
+
+		WRITE_BATCH account_batch;
+		account_batch.Put(General::ACCOUNT_PREFIX + std::string(1, Trie::EVEN_PREFIX), status.account_root());
+		account_batch.Put(General::KEY_LEDGER_SEQ, seq);
+		account_batch.Put(General::LAST_PROOF, status.proof());
+		do {
+			utils::MutexGuard guard(statistics_mutex_);
+			statistics_["account_count"] = (Json::Int64)status.account_count();
+			account_batch.Put(General::STATISTICS, statistics_.toFastString());
+		} while (false);
+		account_batch.Delete(General::KEY_STATE_SYNC);
+		if (!Storage::Instance().account_db()->WriteBatch(account_batch)) {
+			PROCESS_EXIT("Failed to write account to database, %s", Storage::Instance().account_db()->error_desc().c_str());
+		}
+
+		//Nothing read from the genesis state is valid any more.
+		NodeCache::Instance().Clear(header.seq());
+		do {
+			utils::MutexGuard guard(account_tries_mutex_);
+			account_tries_.clear();
+		} while (false);
+		do {
+			utils::WriteLockGuard tree_guard(tree_mutex_);
+			delete tree_;
+			tree_ = new KVTrie();
+			tree_->Init(Storage::Instance().account_db(), std::make_shared<WRITE_BATCH>(), General::ACCOUNT_PREFIX, 4);
+			if (hash_pool_.Size() > 0) {
+				tree_->SetHashPool(&hash_pool_);
+			}
+			tree_->UpdateHash();
+		} while (false);
+
+		if (tree_->GetRootHash() != header.account_tree_hash()) {
+			PROCESS_EXIT("The downloaded account_root_hash(%s) != ledger account_tree_hash(%s)",
+				utils::String::Bin4ToHexString(tree_->GetRootHash()).c_str(),
+				utils::String::Bin4ToHexString(header.account_tree_hash()).c_str());
+		}
+
+		LedgerFrm::pointer lcl = std::make_shared<LedgerFrm>();
+		lcl->ProtoLedger().CopyFrom(status.ledger());
+		do {
+			utils::WriteLockGuard lcl_guard(lcl_header_mutex_);
+			last_closed_ledger_ = lcl;
+			proof_ = status.proof();
+			lcl_header_ = header;
+		} while (false);
+
+		do {
+			utils::MutexGuard prune_guard(prune_mutex_);
+			pruned_seq_ = header.seq();
+		} while (false);
+
+		if (!ValidatorsGet(header.validators_hash(), validators_)) {
+			PROCESS_EXIT("Failed to get validators!");
+		}
+
+		do {
+			utils::WriteLockGuard fee_guard(fee_config_mutex_);
+			if (!FeesConfigGet(header.fees_hash(), fees_)) {
+				PROCESS_EXIT("Failed to get config fee!");
+			}
+		} while (false);
+
+		Storage::Instance().writer().TakeSnapshot(header.seq());
+		do {
+			utils::WriteLockGuard lcl_guard(lcl_header_mutex_);
+			written_header_ = header;
+			written_snapshot_ = Storage::Instance().writer().snapshot();
+		} while (false);
+		Global::Instance().GetIoService().post([this]() {
+			GlueManager::Instance().UpdateValidators(validators_, proof_);
+		});
+
+		//Replay the ledgers after the checkpoint at once.
+		sync_.update_time_ = 0;
+		LOG_INFO("Fast synced to ledger(" FMT_I64 "), hash(%s)", header.seq(), utils::String::BinToHexString(header.hash()).c_str());
+		return true;
+	}
+
 	void LedgerManager::RequestConsensusValues(int64_t pid, protocol::GetLedgers& gl, int64_t time) {
 		LOG_TRACE("Request consensus values from peer(" FMT_I64 "), [" FMT_I64 "," FMT_I64 "]", pid, gl.begin(), gl.end());
 		do {
@@ -966,7 +1476,7 @@ namespace bumo {
 				new_tx->Apply(ledger_context->closing_ledger_.get(), cacheEnv, true);
 			}
 			else {
-				TransactionFrm::AddActualFee(bottom_tx, new_tx.get());
+				TransactionFrm::AddActualFee(bottom_tx.get(), new_tx.get());
 			}
 
 			//Throw the contract
@@ -17,6 +17,7 @@
 #define LEDGER_MANAGER_H_
 
 #include <utils/headers.h>
+#include <utils/lrucache.hpp>
 #include <common/general.h>
 #include <common/storage.h>
 #include <common/private_key.h>
@@ -26,7 +27,11 @@
 #include "ledgercontext_manager.h"
 #include "environment.h"
 #include "kv_trie.h"
+#include "state_view.h"
+#include "state_sync.h"
+#include "close_pipeline.h"
 #include "proto/cpp/consensus.pb.h"
+#include "proto/cpp/monitor.pb.h"
 
 #ifdef WIN32
 #include <leveldb/leveldb.h>
@@ -50,13 +55,25 @@ namespace bumo {
 		int OnConsent(const protocol::ConsensusValue &value, const std::string& proof);
 
 		protocol::LedgerHeader GetLastClosedLedger();
+		//The last closed ledger which is durable, the one shown to the clients.
+		//Behind the last closed ledger while the storage writer syncs it with db.async_commit.
+		protocol::LedgerHeader GetWrittenLedger();
 
 		int GetAccountNum();
 
 		void OnRequestLedgers(const protocol::GetLedgers &message, int64_t peer_id);
+		//The reply to a request of the consensus values, with the ledgers closed up to lcl_seq and pruned up to pruned_seq.
+		//Return false if the request gets no reply.
+		bool GetLedgers(const protocol::GetLedgers &message, int64_t lcl_seq, const std::string &lcl_proof, int64_t pruned_seq, protocol::Ledgers &ledgers);
 
 		void OnReceiveLedgers(const protocol::Ledgers &message, int64_t peer_id);
 
+		void OnRequestStateNodes(const protocol::GetStateNodes &message, int64_t peer_id);
+		void OnReceiveStateNodes(const protocol::StateNodes &message, int64_t peer_id);
+		//Take the downloaded state as the last closed ledger, the ledgers after it are synced as usual.
+		//Return false if the state does not match the checkpoint, the staged nodes are discarded.
+		bool OnStateSynced(const protocol::StateSyncStatus &status);
+
 		bool GetValidators(int64_t seq, protocol::ValidatorSet& validators_set);
 		const protocol::ValidatorSet& Validators()
 		{
@@ -72,6 +89,7 @@ namespace bumo {
 		bool CheckContractDepthSafe(uint32_t tx_size);
 
 		void NotifyLedgerClose(LedgerFrm::pointer closing_ledger, bool has_upgrade);
+		static void BroadcastLedgerClose(LedgerFrm::pointer closing_ledger, const protocol::LedgerHeader &header, const monitor::LedgerStatus &ledger_status);
 
 		virtual void OnTimer(int64_t current_time) override;
 		virtual void OnSlowTimer(int64_t current_time) override;
@@ -79,13 +97,32 @@ namespace bumo {
 
 		static void CreateHardforkLedger();
 		utils::ReadWriteLock& GetTreeMutex();
+		//The state of the written ledger, the one of GetWrittenLedger, for the reads that must not contend with the ledger close.
+		StateView::pointer GetStateView();
+
+		//Get the asset or metadata trie of an account for writing into the batch.
+		//The tries are shared, only the commit of a closing ledger, one at a time, may write into them.
+		std::shared_ptr<KVTrie> GetAccountTrie(const std::string& prefix, std::shared_ptr<WRITE_BATCH> batch);
 	private:
 		bool CheckAndRepairLedgerSeq();
+		//Delete the transactions and consensus values of the ledgers out of the history_ledger_count.
+		void PruneHistory();
+		int64_t GetPrunedSeq();
 	public:
 		utils::Mutex gmutex_;
+		//Updated by the close thread, which does not hold gmutex_
+		utils::Mutex statistics_mutex_;
 		Json::Value statistics_;
 		utils::ReadWriteLock tree_mutex_;
 		KVTrie* tree_;
+		utils::ThreadPool hash_pool_;
+		//Runs the transactions of a ledger ahead in parallel
+		utils::ThreadPool apply_pool_;
+
+		//The number of account asset/metadata tries kept warm across ledgers
+		static const size_t ACCOUNT_TRIE_CACHE_SIZE = 1024;
+		//The levels of an account trie kept in memory after committing, the rest is reloaded through the node cache
+		static const int ACCOUNT_TRIE_MEMORY_DEPTH = 2;
 
 		LedgerContextManager context_manager_;
 	private:
@@ -98,6 +135,29 @@ namespace bumo {
 
 		bool CloseLedger(const protocol::ConsensusValue& request, const std::string& proof);
 
+		//A ledger executed and handed to the close pipeline to be sealed.
+		struct Sealing {
+			int64_t seq_;
+			LedgerFrm::pointer ledger_;
+			protocol::ConsensusValue consensus_value_;
+			std::string proof_;
+			bool has_upgrade_;
+			bool validators_changed_;
+			protocol::ValidatorSet validators_;
+			bool fees_changed_;
+			protocol::FeeConfig fees_;
+		};
+
+		//Check the value and execute it unless it has run ahead, then seal it in the pipeline.
+		//If ahead_view is not NULL, it receives the state to run the next ledger ahead on, NULL if it cannot.
+		bool StartClose(const protocol::ConsensusValue& request, const std::string& proof,
+			LedgerFrm::pointer executed, StateView::pointer *ahead_view);
+		StateView::pointer NewAheadView(std::shared_ptr<Sealing> sealing);
+		//Execute the ledger on the state of the one being sealed, NULL if it must be executed after.
+		LedgerFrm::pointer RunAhead(const protocol::ConsensusValue& request, StateView::pointer view);
+		//Commit the accounts into the account tree, hash and write the ledger.
+		void SealLedger(std::shared_ptr<Sealing> sealing);
+
 		bool CreateGenesisAccount();
 
 		static void ValidatorsSet(std::shared_ptr<WRITE_BATCH> batch, const protocol::ValidatorSet& validators);
@@ -105,17 +165,32 @@ namespace bumo {
 
 		static void FeesConfigSet(std::shared_ptr<WRITE_BATCH> batch, const protocol::FeeConfig &fee);
 		
+		//last_closed_ledger_ and proof_ are written under lcl_header_mutex_, the close thread does not hold gmutex_
 		LedgerFrm::pointer last_closed_ledger_;
+		//Key: trie prefix. A trie is taken by the ledger closing, the lock only guards the cache itself.
+		utils::Mutex account_tries_mutex_;
+		cache::lru_cache<std::string, std::shared_ptr<KVTrie>> account_tries_;
 		protocol::ValidatorSet validators_;
 		std::string proof_;
 
 		utils::ReadWriteLock lcl_header_mutex_;
 		protocol::LedgerHeader lcl_header_;
+		protocol::LedgerHeader written_header_;
+		std::shared_ptr<StorageSnapshot> written_snapshot_; //The state of written_header_
 		int64_t chain_max_ledger_probaly_;
 
 		utils::ReadWriteLock fee_config_mutex_;
 		protocol::FeeConfig fees_;
 
+		ClosePipeline pipeline_;
+		utils::Mutex sealing_mutex_;
+		std::shared_ptr<Sealing> sealing_;
+		LedgerFrm::CommitStat last_commit_;
+
+		utils::Mutex prune_mutex_;
+		int64_t pruned_seq_; //The ledgers up to it only keep their headers
+		static const int64_t COMPACT_LEDGER_COUNT = 10000; //The pruned keys are compacted every that many ledgers
+
 		struct SyncStat{
 			int64_t send_time_;
 			protocol::GetLedgers gl_;
@@ -154,6 +229,7 @@ namespace bumo {
 		};
 
 		Sync sync_;
+		StateSync state_sync_;
 	};
 }
 #endif
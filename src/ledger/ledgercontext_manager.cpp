@@ -18,6 +18,25 @@
 #include <contract/contract_manager.h>
 
 namespace bumo {
+	//Runs a context in the process pool and frees itself. A context cancelled while it is queued is not run.
+	class ProcessTask : public utils::Runnable {
+	public:
+		ProcessTask(LedgerContextManager *manager, LedgerContext *ledger_context) :manager_(manager), ledger_context_(ledger_context){}
+
+		virtual void Run(utils::Thread *) {
+			if (manager_->PickUp(ledger_context_)) {
+				ledger_context_->Run();
+			}
+			else {
+				ledger_context_->Finish();
+			}
+			delete this;
+		}
+
+		LedgerContextManager *manager_;
+		LedgerContext *ledger_context_;
+	};
+
 	//For synchronizing blocks.
 	LedgerContext::LedgerContext(const std::string &chash, const protocol::ConsensusValue &consvalue) :
 		type_(AT_NORMAL),
@@ -25,9 +44,10 @@ namespace bumo {
 		hash_(chash),
 		consensus_value_(consvalue),
 		start_time_(-1),
+		apply_mode_(LedgerFrm::APPLY_MODE_FOLLOW),
 		tx_timeout_(-1),
 		timeout_tx_index_(-1),
-		apply_mode_(LedgerFrm::APPLY_MODE_FOLLOW) {
+		cancelled_(false) {
 		closing_ledger_ = std::make_shared<LedgerFrm>();
 	}
 
@@ -39,9 +59,12 @@ namespace bumo {
 		hash_(chash),
 		consensus_value_(consvalue),
 		start_time_(-1),
-		timeout_tx_index_(-1){
+		timeout_tx_index_(-1),
+		cancelled_(false){
 		apply_mode_ = propose ? LedgerFrm::APPLY_MODE_PROPOSE : LedgerFrm::APPLY_MODE_CHECK;
 		closing_ledger_ = std::make_shared<LedgerFrm>();
+		done_ = std::make_shared<std::promise<ProposeTxsResult> >();
+		future_ = done_->get_future().share();
 	}
 
 	//for test
@@ -50,7 +73,8 @@ namespace bumo {
 		const ContractTestParameter &parameter) :
 		type_(type), 
 		parameter_(parameter),
-		lpmanager_(NULL) {
+		lpmanager_(NULL),
+		cancelled_(false) {
 		apply_mode_ = LedgerFrm::APPLY_MODE_PROPOSE;
 		closing_ledger_ = std::make_shared<LedgerFrm>();
 	}
@@ -61,7 +85,8 @@ namespace bumo {
 		type_(type),
 		consensus_value_(consensus_value),
 		lpmanager_(NULL),
-		tx_timeout_(timeout) {
+		tx_timeout_(timeout),
+		cancelled_(false) {
 		apply_mode_ = LedgerFrm::APPLY_MODE_PROPOSE;
 		closing_ledger_ = std::make_shared<LedgerFrm>();
 	}
@@ -69,7 +94,6 @@ namespace bumo {
 
 	void LedgerContext::Run() {
 		LOG_INFO("Preprocessing the consensus value, ledger(" FMT_I64 ")", consensus_value_.ledger_seq());
-		start_time_ = utils::Timestamp::HighResolution();
 		switch (type_)
 		{
 		case AT_NORMAL:
@@ -99,7 +123,9 @@ namespace bumo {
 		header->set_consensus_value_hash(hash_);
 		header->set_chain_id(General::GetSelfChainId());
 		header->set_version(LedgerManager::Instance().GetLastClosedLedger().version());
-		LedgerManager::Instance().tree_->time_ = 0;
+		if (closing_ledger_->state_view_ == nullptr) {
+			LedgerManager::Instance().tree_->time_ = 0;
+		}
 		if (apply_mode_ == LedgerFrm::APPLY_MODE_PROPOSE) {
 			propose_result_.exec_result_ = closing_ledger_->ApplyPropose(consensus_value_, this, propose_result_);
 		}
@@ -112,14 +138,23 @@ namespace bumo {
 
 		//async
 		if (lpmanager_) {
-			//Move the finished transactions to the complete list.
-			if (propose_result_.exec_result_) {
-				lpmanager_->MoveRunningToComplete(this);
-			}
-			else { //delete
-				lpmanager_->MoveRunningToDelete(this);
-			}
+			Finish();
+		}
+	}
+
+	void LedgerContext::Finish() {
+		//The context may be freed once it is moved.
+		std::shared_ptr<std::promise<ProposeTxsResult> > done = done_;
+		ProposeTxsResult result = propose_result_;
+
+		//Move the finished transactions to the complete list.
+		if (propose_result_.exec_result_) {
+			lpmanager_->MoveRunningToComplete(this);
 		}
+		else { //delete
+			lpmanager_->MoveRunningToDelete(this);
+		}
+		done->set_value(result);
 	}
 
 	bool LedgerContext::TestV8() {
@@ -299,7 +334,8 @@ namespace bumo {
 	}
 
 	bool LedgerContext::CheckExpire(int64_t total_timeout) {
-		return utils::Timestamp::HighResolution() - start_time_ >= total_timeout;
+		//The time queued in the process pool is not counted.
+		return start_time_ >= 0 && utils::Timestamp::HighResolution() - start_time_ >= total_timeout;
 	}
 
 	void LedgerContext::PushLog(const std::string &address, const utils::StringList &logs) {
@@ -370,14 +406,56 @@ namespace bumo {
 		return propose_result_.exec_result_;
 	}
 
-	LedgerContextManager::LedgerContextManager() {
+	LedgerContextManager::LedgerContextManager() :
+		process_count_(0),
+		reuse_count_(0) {
 		check_interval_ = 10 * utils::MICRO_UNITS_PER_MILLI;
 	}
 	LedgerContextManager::~LedgerContextManager() {
 	}
 
-	void LedgerContextManager::Initialize() {
+	bool LedgerContextManager::Initialize() {
+		if (!pool_.Init("process-value", Configure::Instance().ledger_configure_.process_thread_count_)) {
+			LOG_ERROR_ERRNO("Failed to start the process pool", STD_ERR_CODE, STD_ERR_DESC);
+			return false;
+		}
+
 		TimerNotify::RegisterModule(this);
+		return true;
+	}
+
+	bool LedgerContextManager::Exit() {
+		//The queued values are cancelled, so the workers free them without running them.
+		do {
+			utils::MutexGuard guard(ctxs_lock_);
+			for (LedgerContextMultiMap::iterator iter = running_ctxs_.begin(); iter != running_ctxs_.end(); iter++) {
+				if (!iter->second->cancelled_) {
+					iter->second->cancelled_ = true;
+					iter->second->Cancel();
+				}
+			}
+		} while (false);
+		bool ret = pool_.WaitAndJoin();
+
+		utils::MutexGuard guard(ctxs_lock_);
+		for (LedgerContextMap::iterator iter = completed_ctxs_.begin(); iter != completed_ctxs_.end(); iter++) {
+			delete iter->second;
+		}
+		completed_ctxs_.clear();
+		for (LedgerContextTimeMultiMap::iterator iter = delete_ctxs_.begin(); iter != delete_ctxs_.end(); iter++) {
+			delete iter->second;
+		}
+		delete_ctxs_.clear();
+		return ret;
+	}
+
+	bool LedgerContextManager::PickUp(LedgerContext *ledger_context) {
+		utils::MutexGuard guard(ctxs_lock_);
+		if (ledger_context->cancelled_) {
+			return false;
+		}
+		ledger_context->start_time_ = utils::Timestamp::HighResolution();
+		return true;
 	}
 
 	int32_t LedgerContextManager::CheckComplete(const std::string &chash) {
@@ -392,19 +470,39 @@ namespace bumo {
 		return -1;
 	}
 
-	LedgerFrm::pointer LedgerContextManager::SyncProcess(const protocol::ConsensusValue& consensus_value) {
+	LedgerFrm::pointer LedgerContextManager::SyncProcess(const protocol::ConsensusValue& consensus_value, StateView::pointer view) {
 		std::string con_str = consensus_value.SerializeAsString();
 		std::string chash = HashWrapper::Crypto(con_str);
+		ProcessFuture future;
 		do {
 			utils::MutexGuard guard(ctxs_lock_);
 			LedgerContextMap::iterator iter = completed_ctxs_.find(chash);
 			if (iter != completed_ctxs_.end()) {
 				return iter->second->closing_ledger_;
 			}
+
+			LedgerContextMultiMap::iterator running = running_ctxs_.find(chash);
+			if (running != running_ctxs_.end()) {
+				future = running->second->future_;
+				reuse_count_++;
+			}
 		} while (false);
 
+		//Still being pre-executed, the result is taken from the complete list.
+		if (future.valid()) {
+			LOG_INFO("Waiting for the consensus value of ledger(" FMT_I64 ") being pre-executed", consensus_value.ledger_seq());
+			if (future.get().exec_result_) {
+				utils::MutexGuard guard(ctxs_lock_);
+				LedgerContextMap::iterator iter = completed_ctxs_.find(chash);
+				if (iter != completed_ctxs_.end()) {
+					return iter->second->closing_ledger_;
+				}
+			}
+		}
+
 		LOG_TRACE("Sync processing the consensus value, ledger seq(" FMT_I64 ")", consensus_value.ledger_seq());
 		LedgerContext ledger_context(chash, consensus_value);
+		ledger_context.closing_ledger_->state_view_ = view;
 		ledger_context.Do();
 		if (ledger_context.propose_result_.exec_result_) {
 			return ledger_context.closing_ledger_;
@@ -577,33 +675,41 @@ namespace bumo {
 			return check_complete == 1;
 		} 
 
-		LedgerContext *ledger_context = new LedgerContext(this, chash, consensus_value, propose);
-
-		if (!ledger_context->Start("process-value")) {
-			LOG_ERROR_ERRNO("Failed to start processing consensus value, consensus value hash(%s)", utils::String::BinToHexString(chash).c_str(), 
-				STD_ERR_CODE, STD_ERR_DESC);
+		//The same value checked again, for example after a view change, waits for the running execution.
+		ProcessFuture future;
+		do {
+			utils::MutexGuard guard(ctxs_lock_);
+			LedgerContextMultiMap::iterator iter = running_ctxs_.find(chash);
+			if (iter != running_ctxs_.end()) {
+				future = iter->second->future_;
+				reuse_count_++;
+				break;
+			}
 
-			propose_result.block_timeout_ = true;
-			delete ledger_context;
-			return false;
-		}
+			LedgerContext *ledger_context = new LedgerContext(this, chash, consensus_value, propose);
+			running_ctxs_.insert(std::make_pair(chash, ledger_context));
+			future = ledger_context->future_;
+			process_count_++;
+			pool_.AddTask(new ProcessTask(this, ledger_context));
+		} while (false);
 
 		int64_t time_start = utils::Timestamp::HighResolution();
-		while (ledger_context->IsRunning()) {
-			utils::Sleep(10);
-			if (utils::Timestamp::HighResolution() - time_start > General::BLOCK_EXECUTE_TIME_OUT) {
-				propose_result.block_timeout_ = true;
-				break;
-			}
-		}
+		if (future.wait_for(std::chrono::microseconds(General::BLOCK_EXECUTE_TIME_OUT)) != std::future_status::ready) { //cancel it
+			do {
+				utils::MutexGuard guard(ctxs_lock_);
+				LedgerContextMultiMap::iterator iter = running_ctxs_.find(chash);
+				if (iter != running_ctxs_.end() && !iter->second->cancelled_) {
+					iter->second->cancelled_ = true;
+					iter->second->Cancel();
+				}
+			} while (false);
 
-		if (propose_result.block_timeout_) { //cancel it
-			ledger_context->Cancel();
+			propose_result.block_timeout_ = true;
 			LOG_ERROR("Pre-executing consensus value(" FMT_I64 "ms) timeout", (utils::Timestamp::HighResolution() - time_start) / utils::MICRO_UNITS_PER_MILLI);
 			return false;
 		}
 
-		propose_result = ledger_context->propose_result_;
+		propose_result = future.get();
 		return propose_result.exec_result_;
 	}
 
@@ -626,6 +732,8 @@ namespace bumo {
 		utils::MutexGuard guard(ctxs_lock_);
 		data["completed_size"] = (Json::UInt64)completed_ctxs_.size();
 		data["running_size"] = (Json::UInt64)running_ctxs_.size();
+		data["process_count"] = process_count_;
+		data["reuse_count"] = reuse_count_;
 	}
 
 	void LedgerContextManager::OnTimer(int64_t current_time) {
@@ -633,14 +741,12 @@ namespace bumo {
 		std::vector<LedgerContext *> delete_context;
 		do {
 			utils::MutexGuard guard(ctxs_lock_);
+			//The expired contexts are cancelled, and moved to the delete list by their worker once it is done.
 			for (LedgerContextMultiMap::iterator iter = running_ctxs_.begin(); 
-				iter != running_ctxs_.end();) {
-				if (iter->second->CheckExpire( 5 * utils::MICRO_UNITS_PER_SEC)){
-					delete_context.push_back(iter->second);
-					iter = running_ctxs_.erase(iter);
-				}
-				else {
-					iter++;
+				iter != running_ctxs_.end(); iter++) {
+				if (!iter->second->cancelled_ && iter->second->CheckExpire( 5 * utils::MICRO_UNITS_PER_SEC)){
+					iter->second->cancelled_ = true;
+					iter->second->Cancel();
 				}
 			}
 
@@ -16,6 +16,7 @@
 #ifndef LEDGER_CONTEXT_MANAGER_H_
 #define LEDGER_CONTEXT_MANAGER_H_
 
+#include <future>
 #include <utils/headers.h>
 #include <common/general.h>
 #include <proto/cpp/chain.pb.h>
@@ -27,7 +28,9 @@ namespace bumo {
 	class LedgerContextManager;
 	class LedgerContext;
 	typedef std::function< void(bool check_result)> PreProcessCallback;
+	typedef std::shared_future<ProposeTxsResult> ProcessFuture;
 	class LedgerContext : public utils::Thread {
+		friend class LedgerContextManager;
 		std::stack<int64_t> contract_ids_; //The contract_ids may be called by checking the thread or executing the thread, so contract_ids needs to be locked.
 		//parameter
 		int32_t type_; // -1 : normal, 0 : test v8 , 1: test evm ,2 test transaction
@@ -35,12 +38,15 @@ namespace bumo {
 
 		std::string hash_;
 		LedgerContextManager *lpmanager_;
-		int64_t start_time_;
+		int64_t start_time_; //Set when a worker of the process pool picks the context up, under the lock of the manager
 
 		LedgerFrm::APPLY_MODE apply_mode_;
 
 		Json::Value logs_;
 		Json::Value rets_;
+
+		//Set once the value is executed in the process pool.
+		std::shared_ptr<std::promise<ProposeTxsResult> > done_;
 	public:
 		LedgerContext(
 			LedgerContextManager *lpmanager,
@@ -81,11 +87,15 @@ namespace bumo {
 		int32_t timeout_tx_index_;
 		//protocol::ConsensusValueValidation consvalue_validation_;
 		ProposeTxsResult propose_result_;
+		ProcessFuture future_;
+		bool cancelled_;
 
 		utils::Mutex lock_;
 
 		virtual void Run();
 		void Do();
+		//Hand the result to the waiters and move the context out of the running list.
+		void Finish();
 		bool TestV8();
 		bool TestTransaction();
 		void Cancel();
@@ -118,16 +128,24 @@ namespace bumo {
 		LedgerContextMultiMap running_ctxs_;
 		LedgerContextMap completed_ctxs_;
 		LedgerContextTimeMultiMap delete_ctxs_;
+
+		//The values are pre-executed by these workers, one context for each consensus value hash.
+		utils::ThreadPool pool_;
+		int64_t process_count_;
+		int64_t reuse_count_;
 	public:
 		LedgerContextManager();
 		~LedgerContextManager();
 
-		void Initialize();
+		bool Initialize();
+		bool Exit();
 		virtual void OnTimer(int64_t current_time);
 		virtual void OnSlowTimer(int64_t current_time);
 		void MoveRunningToComplete(LedgerContext *ledger_context);
 		void MoveRunningToDelete(LedgerContext *ledger_context);
 		void RemoveCompleted(int64_t ledger_seq);
+		//Start the clock of a context picked up by a worker, false if it was cancelled while it was queued.
+		bool PickUp(LedgerContext *ledger_context);
 		void GetModuleStatus(Json::Value &data);
 
 		bool SyncTestProcess(LedgerContext::ACTION_TYPE type,
@@ -142,11 +160,13 @@ namespace bumo {
 
 		//<0 : notfound 1: found and success 0: found and failed
 		int32_t CheckComplete(const std::string &chash);
+		//Wait for the execution of the value in the process pool, started if it is not running yet.
 		bool SyncPreProcess(const protocol::ConsensusValue& consensus_value, bool propose, ProposeTxsResult &propose_result);
 
 		//<0 : processing 1: found and success 0: found and failed
 //		int32_t AsyncPreProcess(const protocol::ConsensusValue& consensus_value, int64_t timeout, PreProcessCallback callback, int32_t &timeout_tx_index);
-		LedgerFrm::pointer SyncProcess(const protocol::ConsensusValue& consensus_value); //for ledger closing
+		//for ledger closing, on the view if not NULL. A value pre-executed or still running is not executed again.
+		LedgerFrm::pointer SyncProcess(const protocol::ConsensusValue& consensus_value, StateView::pointer view = nullptr);
 	};
 
 }
@@ -0,0 +1,147 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "node_cache.h"
+
+namespace bumo {
+
+	NodeCache::NodeCache() {
+		capacity_ = 0;
+		size_ = 0;
+		generation_ = 0;
+		seq_ = 0;
+		hit_count_ = 0;
+		miss_count_ = 0;
+		eviction_count_ = 0;
+	}
+
+	NodeCache::~NodeCache() {}
+
+	void NodeCache::SetCapacity(int64_t capacity) {
+		utils::MutexGuard guard(mutex_);
+		capacity_ = capacity;
+		Evict();
+	}
+
+	bool NodeCache::Get(const std::string &key, NodeInfo &info, int64_t &generation, int64_t seq) {
+		utils::MutexGuard guard(mutex_);
+		EntryMap::iterator iter = index_.find(key);
+		if (iter == index_.end() || (seq >= 0 && (seq > seq_ || iter->second->seq_ > seq))) {
+			miss_count_++;
+			//A node loaded from an older snapshot is not put, it may have changed since.
+			generation = (seq < 0 || seq == seq_) ? generation_ : -1;
+			return false;
+		}
+
+		hit_count_++;
+		entries_.splice(entries_.begin(), entries_, iter->second);
+		info = *iter->second->node_;
+		return true;
+	}
+
+	void NodeCache::Put(const std::string &key, const NodeInfo &info, int64_t generation) {
+		utils::MutexGuard guard(mutex_);
+		if (capacity_ <= 0 || generation != generation_ || index_.find(key) != index_.end()) {
+			return;
+		}
+
+		Insert(key, std::make_shared<NodeInfo>(info), seq_);
+		Evict();
+	}
+
+	void NodeCache::Stage(const WRITE_BATCH *batch, const std::string &key, const NodeInfo *info) {
+		utils::MutexGuard guard(mutex_);
+		if (capacity_ <= 0) {
+			return;
+		}
+
+		NodePointer node;
+		if (info != NULL) {
+			node = std::make_shared<NodeInfo>(*info);
+		}
+		staged_[batch][key] = node;
+	}
+
+	void NodeCache::Commit(const WRITE_BATCH *batch, int64_t seq) {
+		utils::MutexGuard guard(mutex_);
+		generation_++;
+		seq_ = seq;
+		auto staged = staged_.find(batch);
+		if (staged == staged_.end()) {
+			return;
+		}
+
+		for (auto iter = staged->second.begin(); iter != staged->second.end(); iter++) {
+			Erase(iter->first);
+			if (iter->second != nullptr) {
+				Insert(iter->first, iter->second, seq);
+			}
+		}
+		staged_.erase(staged);
+		Evict();
+	}
+
+	void NodeCache::Clear(int64_t seq) {
+		utils::MutexGuard guard(mutex_);
+		generation_++;
+		seq_ = seq;
+		entries_.clear();
+		index_.clear();
+		staged_.clear();
+		size_ = 0;
+	}
+
+	void NodeCache::GetModuleStatus(Json::Value &data) {
+		utils::MutexGuard guard(mutex_);
+		data["capacity"] = capacity_;
+		data["size"] = size_;
+		data["count"] = (Json::UInt64)index_.size();
+		data["hit_count"] = hit_count_;
+		data["miss_count"] = miss_count_;
+		data["eviction_count"] = eviction_count_;
+	}
+
+	void NodeCache::Insert(const std::string &key, NodePointer node, int64_t seq) {
+		Entry entry;
+		entry.key_ = key;
+		entry.node_ = node;
+		entry.seq_ = seq;
+		entry.size_ = (int64_t)(key.size() + node->MemorySize());
+		entries_.push_front(entry);
+		index_[key] = entries_.begin();
+		size_ += entry.size_;
+	}
+
+	void NodeCache::Erase(const std::string &key) {
+		EntryMap::iterator iter = index_.find(key);
+		if (iter == index_.end()) {
+			return;
+		}
+
+		size_ -= iter->second->size_;
+		entries_.erase(iter->second);
+		index_.erase(iter);
+	}
+
+	void NodeCache::Evict() {
+		while (size_ > capacity_ && !entries_.empty()) {
+			Entry &entry = entries_.back();
+			size_ -= entry.size_;
+			index_.erase(entry.key_);
+			entries_.pop_back();
+			eviction_count_++;
+		}
+	}
+}
@@ -0,0 +1,88 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NODE_CACHE_H_
+#define NODE_CACHE_H_
+
+#include <list>
+#include <unordered_map>
+#include <utils/headers.h>
+#include <json/json.h>
+#include <common/storage.h>
+#include "trie.h"
+
+namespace bumo {
+
+	//LRU cache of decoded trie inner nodes shared by all the KVTrie instances, keyed by the database key.
+	//It only holds committed nodes: the nodes written into a batch are staged with that batch,
+	//and replace the cached ones after the batch has been written to the database.
+	class NodeCache : public utils::Singleton<NodeCache> {
+		friend class utils::Singleton<NodeCache>;
+	public:
+		typedef std::shared_ptr<const NodeInfo> NodePointer;
+
+		//Byte, 0 : disable the cache
+		void SetCapacity(int64_t capacity);
+
+		//On a miss, generation receives the value to pass to Put after loading the node from the database.
+		//A snapshot of the ledger seq only gets the nodes not changed after it, -1 for the latest state.
+		bool Get(const std::string &key, NodeInfo &info, int64_t &generation, int64_t seq = -1);
+		//Ignored if a ledger was committed since the Get, the loaded node may be stale.
+		void Put(const std::string &key, const NodeInfo &info, int64_t generation);
+
+		//Record a node written into batch, NULL for a deleted node.
+		void Stage(const WRITE_BATCH *batch, const std::string &key, const NodeInfo *info);
+		//Call after batch, the state of ledger seq, has been written successfully.
+		void Commit(const WRITE_BATCH *batch, int64_t seq);
+		//Drop all the nodes, after the database has been written outside the ledger close with the state of ledger seq.
+		void Clear(int64_t seq);
+
+		void GetModuleStatus(Json::Value &data);
+
+	private:
+		NodeCache();
+		~NodeCache();
+
+		struct Entry {
+			std::string key_;
+			NodePointer node_;
+			int64_t size_;
+			int64_t seq_; //The node is unchanged since this ledger
+		};
+		typedef std::list<Entry> EntryList;
+		typedef std::unordered_map<std::string, EntryList::iterator> EntryMap;
+
+		void Insert(const std::string &key, NodePointer node, int64_t seq);
+		void Erase(const std::string &key);
+		void Evict();
+
+		utils::Mutex mutex_;
+		EntryList entries_; //Most recently used at the front
+		EntryMap index_;
+		typedef std::unordered_map<std::string, NodePointer> StagedNodes;
+		std::unordered_map<const WRITE_BATCH *, StagedNodes> staged_;
+
+		int64_t capacity_;
+		int64_t size_;
+		int64_t generation_;
+		int64_t seq_; //The ledger of the cached state
+
+		int64_t hit_count_;
+		int64_t miss_count_;
+		int64_t eviction_count_;
+	};
+}
+
+#endif
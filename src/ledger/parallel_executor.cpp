@@ -0,0 +1,133 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "parallel_executor.h"
+
+namespace bumo {
+
+	class ParallelExecutor::Task : public utils::Runnable {
+	public:
+		Task(ParallelExecutor *executor, int32_t index)
+			:executor_(executor), index_(index), done_(NULL){}
+
+		virtual void Run(utils::Thread *){
+			Item &item = executor_->items_[index_];
+			item.usable_ = executor_->runner_(index_, item.environment_);
+			done_->Signal();
+		}
+
+		ParallelExecutor *executor_;
+		int32_t index_;
+		utils::Semaphore *done_;
+	};
+
+	ParallelExecutor::ParallelExecutor(utils::ThreadPool *pool, std::shared_ptr<Environment> base, Runner runner) :
+		run_count_(0),
+		commit_count_(0),
+		conflict_count_(0),
+		pool_(pool),
+		base_(base),
+		runner_(runner),
+		wave_end_(0){}
+
+	ParallelExecutor::~ParallelExecutor(){}
+
+	void ParallelExecutor::Add(bool eligible, const std::vector<std::string> &accounts){
+		Item item;
+		item.eligible_ = eligible;
+		item.accounts_ = accounts;
+		item.usable_ = false;
+		items_.push_back(item);
+	}
+
+	void ParallelExecutor::RunWave(int32_t begin){
+		int32_t end = begin + WAVE_SIZE;
+		if (end > (int32_t)items_.size()){
+			end = (int32_t)items_.size();
+		}
+
+		std::vector<Task *> tasks;
+		std::set<std::string> accounts;
+		for (int32_t i = begin; i < end; i++){
+			Item &item = items_[i];
+			bool shared = false;
+			for (size_t j = 0; j < item.accounts_.size(); j++){
+				if (!accounts.insert(item.accounts_[j]).second){
+					shared = true;
+				}
+			}
+
+			if (item.eligible_ && !shared){
+				item.environment_ = base_->NewSpeculativeEnv();
+				tasks.push_back(new Task(this, i));
+			}
+		}
+		wave_end_ = end;
+		run_count_ += tasks.size();
+
+		//The base is only read until all of them are done.
+		utils::Semaphore done;
+		for (size_t i = 0; i < tasks.size(); i++){
+			tasks[i]->done_ = &done;
+			if (pool_ != NULL){
+				pool_->AddTask(tasks[i]);
+			}
+			else{
+				tasks[i]->Run(NULL);
+			}
+		}
+
+		for (size_t i = 0; i < tasks.size();){
+			if (done.Wait()){
+				i++;
+			}
+		}
+
+		for (size_t i = 0; i < tasks.size(); i++){
+			delete tasks[i];
+		}
+	}
+
+	bool ParallelExecutor::Validate(int32_t index){
+		if (index >= wave_end_){
+			RunWave(index);
+		}
+
+		Item &item = items_[index];
+		if (item.environment_ == nullptr){
+			return false;
+		}
+
+		if (!item.usable_){
+			item.environment_.reset();
+			return false;
+		}
+
+		if (!item.environment_->ReadsValid()){
+			conflict_count_++;
+			item.environment_.reset();
+			return false;
+		}
+		return true;
+	}
+
+	bool ParallelExecutor::Commit(int32_t index){
+		Item &item = items_[index];
+		bool ret = item.environment_->CommitToBase();
+		item.environment_.reset();
+		commit_count_++;
+		return ret;
+	}
+}
@@ -0,0 +1,72 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PARALLEL_EXECUTOR_H_
+#define PARALLEL_EXECUTOR_H_
+
+#include <functional>
+#include <utils/thread.h>
+#include "environment.h"
+
+namespace bumo {
+
+	//Optimistic parallel execution of a transaction set.
+	//The transactions of a wave run ahead in parallel, each in a speculative environment over the accounts
+	//committed in the base so far. The ledger then takes them in order: a run is committed into the base
+	//if none of the accounts it read has been committed since, otherwise the ledger applies the transaction serially.
+	class ParallelExecutor {
+	public:
+		//Transactions run ahead at once
+		static const int32_t WAVE_SIZE = 256;
+
+		//Run the transaction at the index in the environment, false if the run cannot be used.
+		typedef std::function<bool(int32_t index, std::shared_ptr<Environment> environment)> Runner;
+
+		ParallelExecutor(utils::ThreadPool *pool, std::shared_ptr<Environment> base, Runner runner);
+		~ParallelExecutor();
+
+		//Add the transactions in order with the accounts they are known to touch. Those not eligible are always
+		//applied serially, and the ones after a transaction touching the same account in a wave are not run ahead,
+		//they would conflict with it.
+		void Add(bool eligible, const std::vector<std::string> &accounts);
+
+		//The transaction at the index has been run ahead and can be committed.
+		bool Validate(int32_t index);
+		bool Commit(int32_t index);
+
+		int64_t run_count_;
+		int64_t commit_count_;
+		int64_t conflict_count_;
+
+	private:
+		class Task;
+		void RunWave(int32_t begin);
+
+		utils::ThreadPool *pool_;
+		std::shared_ptr<Environment> base_;
+		Runner runner_;
+
+		struct Item {
+			bool eligible_;
+			std::vector<std::string> accounts_;
+			bool usable_;
+			std::shared_ptr<Environment> environment_;
+		};
+		std::vector<Item> items_;
+		int32_t wave_end_;
+	};
+}
+
+#endif
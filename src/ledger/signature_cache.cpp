@@ -0,0 +1,132 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "signature_cache.h"
+
+namespace bumo {
+
+	//The signatures kept for a transaction, whatever the envelopes it is received in.
+	static const size_t MAX_ENTRY_SIGNATURES = 64;
+
+	SignatureCache::SignatureCache() {
+		capacity_ = 0;
+		hit_count_ = 0;
+		miss_count_ = 0;
+		eviction_count_ = 0;
+	}
+
+	SignatureCache::~SignatureCache() {}
+
+	void SignatureCache::SetCapacity(int64_t capacity) {
+		utils::MutexGuard guard(mutex_);
+		capacity_ = capacity;
+		Evict();
+	}
+
+	SignatureCache::SignatureKey SignatureCache::GetSignatureKey(const protocol::Signature &signature) {
+		return std::make_pair(signature.public_key(), signature.sign_data());
+	}
+
+	bool SignatureCache::Get(const std::string &hash, const protocol::TransactionEnv &env, std::set<std::string> &signers) {
+		utils::MutexGuard guard(mutex_);
+		if (capacity_ <= 0) {
+			return false;
+		}
+
+		EntryMap::iterator iter = index_.find(hash);
+		if (iter == index_.end()) {
+			miss_count_++;
+			return false;
+		}
+
+		const Entry &entry = *iter->second;
+		std::set<std::string> result;
+		for (int32_t i = 0; i < env.signatures_size(); i++) {
+			SignatureKey key = GetSignatureKey(env.signatures(i));
+			size_t j = 0;
+			for (; j < entry.signatures_.size() && entry.signatures_[j].first != key; j++) {
+			}
+
+			if (j == entry.signatures_.size()) {
+				miss_count_++;
+				return false;
+			}
+			if (!entry.signatures_[j].second.empty()) {
+				result.insert(entry.signatures_[j].second);
+			}
+		}
+
+		hit_count_++;
+		entries_.splice(entries_.begin(), entries_, iter->second);
+		signers.swap(result);
+		return true;
+	}
+
+	void SignatureCache::Put(const std::string &hash, const protocol::TransactionEnv &env, const std::vector<std::string> &addresses) {
+		if (addresses.size() != (size_t)env.signatures_size() || addresses.size() > MAX_ENTRY_SIGNATURES) {
+			return;
+		}
+
+		utils::MutexGuard guard(mutex_);
+		if (capacity_ <= 0) {
+			return;
+		}
+
+		EntryMap::iterator iter = index_.find(hash);
+		if (iter == index_.end()) {
+			Entry entry;
+			entry.hash_ = hash;
+			entries_.push_front(entry);
+			iter = index_.insert(std::make_pair(hash, entries_.begin())).first;
+		}
+		else {
+			entries_.splice(entries_.begin(), entries_, iter->second);
+		}
+
+		//The signatures of an envelope seen before are added to the ones cached,
+		//those of the other envelopes are dropped once there are too many of them.
+		Entry &entry = *iter->second;
+		if (entry.signatures_.size() + addresses.size() > MAX_ENTRY_SIGNATURES) {
+			entry.signatures_.clear();
+		}
+		for (int32_t i = 0; i < env.signatures_size(); i++) {
+			SignatureKey key = GetSignatureKey(env.signatures(i));
+			size_t j = 0;
+			for (; j < entry.signatures_.size() && entry.signatures_[j].first != key; j++) {
+			}
+			if (j == entry.signatures_.size()) {
+				entry.signatures_.push_back(std::make_pair(key, addresses[i]));
+			}
+		}
+		Evict();
+	}
+
+	void SignatureCache::GetModuleStatus(Json::Value &data) {
+		utils::MutexGuard guard(mutex_);
+		data["capacity"] = capacity_;
+		data["count"] = (Json::UInt64)index_.size();
+		data["hit_count"] = hit_count_;
+		data["miss_count"] = miss_count_;
+		data["eviction_count"] = eviction_count_;
+	}
+
+	void SignatureCache::Evict() {
+		while ((int64_t)index_.size() > capacity_ && !entries_.empty()) {
+			index_.erase(entries_.back().hash_);
+			entries_.pop_back();
+			eviction_count_++;
+		}
+	}
+}
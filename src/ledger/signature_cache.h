@@ -0,0 +1,74 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SIGNATURE_CACHE_H_
+#define SIGNATURE_CACHE_H_
+
+#include <list>
+#include <set>
+#include <unordered_map>
+#include <utils/headers.h>
+#include <json/json.h>
+#include <proto/cpp/chain.pb.h>
+
+namespace bumo {
+
+	//LRU cache of the signatures verified, keyed by the content hash of the transaction.
+	//A transaction checked when it is received is not verified again when its ledger is applied.
+	//The signatures themselves are kept with the results, so another envelope of the same transaction is only
+	//taken from the cache if it carries the same signatures.
+	class SignatureCache : public utils::Singleton<SignatureCache> {
+		friend class utils::Singleton<SignatureCache>;
+	public:
+		//The number of transactions, 0 : disable the cache
+		void SetCapacity(int64_t capacity);
+
+		//True if all the signatures of env are cached, signers receives the addresses of the valid ones.
+		bool Get(const std::string &hash, const protocol::TransactionEnv &env, std::set<std::string> &signers);
+		//addresses has the signer address of every signature of env, empty if it is invalid.
+		void Put(const std::string &hash, const protocol::TransactionEnv &env, const std::vector<std::string> &addresses);
+
+		void GetModuleStatus(Json::Value &data);
+
+	private:
+		SignatureCache();
+		~SignatureCache();
+
+		//The public key and the signature data are kept apart, so a signature split at another point is another key.
+		typedef std::pair<std::string, std::string> SignatureKey;
+
+		struct Entry {
+			std::string hash_;
+			//The public key and the signature data, with the signer address
+			std::vector<std::pair<SignatureKey, std::string> > signatures_;
+		};
+		typedef std::list<Entry> EntryList;
+		typedef std::unordered_map<std::string, EntryList::iterator> EntryMap;
+
+		static SignatureKey GetSignatureKey(const protocol::Signature &signature);
+		void Evict();
+
+		utils::Mutex mutex_;
+		EntryList entries_; //Most recently used at the front
+		EntryMap index_;
+
+		int64_t capacity_;
+		int64_t hit_count_;
+		int64_t miss_count_;
+		int64_t eviction_count_;
+	};
+}
+
+#endif
@@ -0,0 +1,153 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <utils/timestamp.h>
+#include <utils/strings.h>
+#include <utils/logger.h>
+#include <common/private_key.h>
+#include <common/general.h>
+#include "signature_verifier.h"
+#include "signature_cache.h"
+
+namespace bumo {
+
+	//The fewest signatures worth a task of the pool.
+	static const size_t TASK_SIZE = 64;
+
+	utils::Mutex SignatureVerifier::stat_mutex_;
+	int64_t SignatureVerifier::verified_count_ = 0;
+	int64_t SignatureVerifier::invalid_count_ = 0;
+	int64_t SignatureVerifier::verify_time_ = 0;
+
+	class SignatureVerifier::VerifyTask : public utils::Runnable {
+	public:
+		VerifyTask(Item *items, size_t count, utils::Semaphore *done)
+			:items_(items), count_(count), done_(done){}
+
+		virtual void Run(utils::Thread *){
+			VerifyItems(items_, count_);
+			done_->Signal();
+		}
+
+		Item *items_;
+		size_t count_;
+		utils::Semaphore *done_;
+	};
+
+	SignatureVerifier::SignatureVerifier(utils::ThreadPool *pool) :pool_(pool){}
+
+	SignatureVerifier::~SignatureVerifier(){}
+
+	void SignatureVerifier::VerifyItems(Item *items, size_t count){
+		for (size_t i = 0; i < count; i++){
+			Item &item = items[i];
+			item.valid_ = false;
+
+			PublicKey pubkey(item.signature_->public_key());
+			if (!pubkey.IsValid()){
+				continue;
+			}
+			item.address_ = pubkey.GetEncAddress();
+			item.valid_ = PublicKey::Verify(*item.data_, item.signature_->sign_data(), item.signature_->public_key());
+		}
+	}
+
+	void SignatureVerifier::Verify(const protocol::TransactionEnvSet &txset, std::vector<Verified> &txs){
+		int64_t time0 = utils::Timestamp::HighResolution();
+
+		//The transactions received before are taken from the cache.
+		SignatureCache *cache = SignatureCache::GetInstance();
+		txs.clear();
+		txs.resize(txset.txs_size());
+		std::vector<Item> items;
+		for (int32_t i = 0; i < txset.txs_size(); i++){
+			const protocol::TransactionEnv &env = txset.txs(i);
+			Verified &tx = txs[i];
+			tx.data_ = env.transaction().SerializeAsString();
+			tx.hash_ = HashWrapper::Crypto(tx.data_);
+			if (cache != NULL && cache->Get(tx.hash_, env, tx.signers_)){
+				continue;
+			}
+
+			for (int32_t j = 0; j < env.signatures_size(); j++){
+				Item item;
+				item.tx_index_ = i;
+				item.data_ = &tx.data_;
+				item.signature_ = &env.signatures(j);
+				item.valid_ = false;
+				items.push_back(item);
+			}
+		}
+
+		size_t threads = (pool_ == NULL) ? 0 : pool_->Size();
+		if (threads <= 1 || items.size() <= TASK_SIZE){
+			VerifyItems(items.empty() ? NULL : &items[0], items.size());
+		}
+		else{
+			size_t chunk = std::max((items.size() + threads - 1) / threads, TASK_SIZE);
+
+			utils::Semaphore done;
+			std::vector<VerifyTask*> tasks;
+			for (size_t begin = 0; begin < items.size(); begin += chunk){
+				tasks.push_back(new VerifyTask(&items[begin], std::min(chunk, items.size() - begin), &done));
+			}
+			for (size_t i = 0; i < tasks.size(); i++){
+				pool_->AddTask(tasks[i]);
+			}
+			for (size_t i = 0; i < tasks.size();){
+				if (done.Wait()){
+					i++;
+				}
+			}
+			for (size_t i = 0; i < tasks.size(); i++){
+				delete tasks[i];
+			}
+		}
+
+		int64_t invalid_count = 0;
+		std::vector<std::string> addresses;
+		for (size_t i = 0; i < items.size(); i++){
+			const Item &item = items[i];
+			if (item.valid_){
+				txs[item.tx_index_].signers_.insert(item.address_);
+				addresses.push_back(item.address_);
+			}
+			else{
+				LOG_ERROR("Invalid signature data(%s)", utils::String::BinToHexString(item.signature_->SerializeAsString()).c_str());
+				invalid_count++;
+				addresses.push_back("");
+			}
+
+			//The signatures of a transaction are in a row.
+			if (cache != NULL && (i + 1 == items.size() || items[i + 1].tx_index_ != item.tx_index_)){
+				cache->Put(txs[item.tx_index_].hash_, txset.txs(item.tx_index_), addresses);
+				addresses.clear();
+			}
+		}
+
+		utils::MutexGuard guard(stat_mutex_);
+		verified_count_ += items.size();
+		invalid_count_ += invalid_count;
+		verify_time_ += utils::Timestamp::HighResolution() - time0;
+	}
+
+	void SignatureVerifier::GetModuleStatus(Json::Value &data){
+		utils::MutexGuard guard(stat_mutex_);
+		data["verified_count"] = verified_count_;
+		data["invalid_count"] = invalid_count_;
+		data["verify_time"] = utils::String::Format(FMT_I64 " ms", verify_time_ / utils::MICRO_UNITS_PER_MILLI);
+		data["verified_per_sec"] = verify_time_ > 0 ? verified_count_ * utils::MICRO_UNITS_PER_SEC / verify_time_ : 0;
+	}
+}
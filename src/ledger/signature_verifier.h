@@ -0,0 +1,71 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SIGNATURE_VERIFIER_H_
+#define SIGNATURE_VERIFIER_H_
+
+#include <set>
+#include <vector>
+#include <utils/thread.h>
+#include <json/json.h>
+#include <proto/cpp/chain.pb.h>
+
+namespace bumo {
+
+	//Verifies all the signatures of a transaction set before it is executed, spread over the pool if there is one.
+	//Every signature is verified on its own as PublicKey::Verify does: the batch verification of ed25519-donna
+	//is cofactorless with random weights, so it may accept an R with a small order component which the single
+	//verification rejects, and the nodes would disagree on the signers of a transaction.
+	class SignatureVerifier {
+	public:
+		typedef std::set<std::string> Signers;
+
+		//A transaction of the set serialized and hashed once, with the addresses of its valid signers.
+		struct Verified {
+			std::string data_;
+			std::string hash_;
+			Signers signers_;
+		};
+
+		//Verified in the caller if pool is NULL.
+		SignatureVerifier(utils::ThreadPool *pool);
+		~SignatureVerifier();
+
+		void Verify(const protocol::TransactionEnvSet &txset, std::vector<Verified> &txs);
+
+		static void GetModuleStatus(Json::Value &data);
+
+	private:
+		struct Item {
+			int32_t tx_index_;
+			const std::string *data_;
+			const protocol::Signature *signature_;
+			bool valid_;
+			std::string address_;
+		};
+
+		class VerifyTask;
+		static void VerifyItems(Item *items, size_t count);
+
+		utils::ThreadPool *pool_;
+
+		static utils::Mutex stat_mutex_;
+		static int64_t verified_count_;
+		static int64_t invalid_count_;
+		static int64_t verify_time_;
+	};
+}
+
+#endif
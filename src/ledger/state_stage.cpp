@@ -0,0 +1,219 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <common/general.h>
+#include <common/private_key.h>
+#include "state_stage.h"
+#include "trie.h"
+
+namespace bumo {
+
+	std::string StateStage::EntryKey(const protocol::StateSyncEntry &entry) {
+		if (entry.type() == protocol::StateSyncEntry::VALUE) {
+			return entry.prefix();
+		}
+
+		std::string key = entry.location();
+		if (entry.type() != protocol::StateSyncEntry::INNER) {
+			key[0] = Trie::LEAF_PREFIX;
+		}
+		return entry.prefix() + key;
+	}
+
+	std::string StateStage::StagedKey(const std::string &key) {
+		return ComposePrefix(General::STATE_NODE_PREFIX, key);
+	}
+
+	void StateStage::AddRootEntries(const protocol::LedgerHeader &header, StateSyncEntries &entries) {
+		Location root;
+		root.push_back(Trie::EVEN_PREFIX);
+		protocol::StateSyncEntry *entry = entries.Add();
+		entry->set_type(protocol::StateSyncEntry::INNER);
+		entry->set_prefix(General::ACCOUNT_PREFIX);
+		entry->set_location(root);
+		entry->set_hash(header.account_tree_hash());
+
+		entry = entries.Add();
+		entry->set_type(protocol::StateSyncEntry::VALUE);
+		entry->set_prefix(utils::String::Format("validators-%s", utils::String::BinToHexString(header.validators_hash()).c_str()));
+		entry->set_hash(header.validators_hash());
+
+		entry = entries.Add();
+		entry->set_type(protocol::StateSyncEntry::VALUE);
+		entry->set_prefix(utils::String::Format("fees-%s", utils::String::BinToHexString(header.fees_hash()).c_str()));
+		entry->set_hash(header.fees_hash());
+	}
+
+	bool StateStage::IsRoot(const protocol::StateSyncEntry &entry) {
+		return entry.type() == protocol::StateSyncEntry::INNER && entry.prefix() == General::ACCOUNT_PREFIX && entry.location().size() == 1;
+	}
+
+	bool StateStage::Expand(const protocol::StateSyncEntry &entry, const std::string &value, StateSyncEntries &children) {
+		if (HashWrapper::Crypto(value) != entry.hash()) {
+			return false;
+		}
+
+		if (entry.type() == protocol::StateSyncEntry::INNER) {
+			NodeInfo info;
+			if (!info.Parse(value)) {
+				return false;
+			}
+
+			for (int i = 0; i < NodeInfo::BRANCH_COUNT; i++) {
+				const ChildRef &ref = info.Ref(i);
+				if (ref.type_ == protocol::NONE) {
+					continue;
+				}
+
+				protocol::StateSyncEntry *child = children.Add();
+				child->set_prefix(entry.prefix());
+				child->set_location(ref.sublocation_);
+				child->set_hash(ref.GetHash());
+				if (ref.type_ == protocol::INNER) {
+					child->set_type(protocol::StateSyncEntry::INNER);
+				}
+				else {
+					child->set_type(entry.prefix() == General::ACCOUNT_PREFIX ? protocol::StateSyncEntry::ACCOUNT : protocol::StateSyncEntry::LEAF);
+				}
+			}
+		}
+		else if (entry.type() == protocol::StateSyncEntry::ACCOUNT) {
+			protocol::Account account;
+			if (!account.ParseFromString(value)) {
+				return false;
+			}
+
+			std::string address = DecodeAddress(account.address());
+			Location root;
+			root.push_back(Trie::EVEN_PREFIX);
+			if (!account.assets_hash().empty()) {
+				protocol::StateSyncEntry *assets = children.Add();
+				assets->set_type(protocol::StateSyncEntry::INNER);
+				assets->set_prefix(ComposePrefix(General::ASSET_PREFIX, address));
+				assets->set_location(root);
+				assets->set_hash(account.assets_hash());
+			}
+			if (!account.metadatas_hash().empty()) {
+				protocol::StateSyncEntry *metadata = children.Add();
+				metadata->set_type(protocol::StateSyncEntry::INNER);
+				metadata->set_prefix(ComposePrefix(General::METADATA_PREFIX, address));
+				metadata->set_location(root);
+				metadata->set_hash(account.metadatas_hash());
+			}
+		}
+		return true;
+	}
+
+	bool StateStage::Read(KeyValueDb *db, const std::vector<protocol::StateSyncEntry> &entries, std::vector<std::string> &values, std::vector<int32_t> &found) {
+		//The staged keys first, then the keys themselves.
+		std::vector<std::string> keys;
+		for (size_t i = 0; i < entries.size(); i++) {
+			keys.push_back(StagedKey(EntryKey(entries[i])));
+		}
+		for (size_t i = 0; i < entries.size(); i++) {
+			keys.push_back(EntryKey(entries[i]));
+		}
+
+		std::vector<std::string> results;
+		std::vector<int32_t> stats;
+		if (!db->MultiGet(keys, results, stats)) {
+			return false;
+		}
+
+		values.assign(entries.size(), std::string());
+		found.assign(entries.size(), NOT_FOUND);
+		for (size_t i = 0; i < entries.size(); i++) {
+			if (stats[i] == 1) {
+				values[i].swap(results[i]);
+				found[i] = STAGED;
+			}
+			else if (stats[entries.size() + i] == 1) {
+				values[i].swap(results[entries.size() + i]);
+				found[i] = AT_KEY;
+			}
+		}
+		return true;
+	}
+
+	bool StateStage::Verify(KeyValueDb *db, const protocol::StateSyncStatus &status) {
+		return Walk(db, status, WALK_VERIFY);
+	}
+
+	void StateStage::Apply(KeyValueDb *db, const protocol::StateSyncStatus &status) {
+		if (!Walk(db, status, WALK_APPLY)) {
+			PROCESS_EXIT("Failed to apply the state of ledger(" FMT_I64 ")", status.ledger().header().seq());
+		}
+	}
+
+	void StateStage::Discard(KeyValueDb *db, const protocol::StateSyncStatus &status) {
+		Walk(db, status, WALK_DISCARD);
+	}
+
+	bool StateStage::Walk(KeyValueDb *db, const protocol::StateSyncStatus &status, WalkMode mode) {
+		int64_t seq = status.ledger().header().seq();
+		StateSyncEntries pending;
+		AddRootEntries(status.ledger().header(), pending);
+
+		//Depth first, so only the siblings on the path are pending.
+		while (pending.size() > 0) {
+			std::vector<protocol::StateSyncEntry> entries;
+			while (pending.size() > 0 && entries.size() < READ_COUNT) {
+				entries.push_back(pending.Get(pending.size() - 1));
+				pending.RemoveLast();
+			}
+
+			std::vector<std::string> values;
+			std::vector<int32_t> found;
+			if (!Read(db, entries, values, found)) {
+				LOG_ERROR("Failed to read the state of ledger(" FMT_I64 "), %s", seq, db->error_desc().c_str());
+				return false;
+			}
+
+			WRITE_BATCH batch;
+			for (size_t i = 0; i < entries.size(); i++) {
+				std::string key = EntryKey(entries[i]);
+				if (IsRoot(entries[i])) {
+					values[i] = status.account_root();
+					found[i] = values[i].empty() ? NOT_FOUND : AT_KEY;
+				}
+
+				if (found[i] == NOT_FOUND || !Expand(entries[i], values[i], pending)) {
+					//The download of a discarded state may not be complete.
+					if (mode == WALK_DISCARD) {
+						continue;
+					}
+					LOG_ERROR("The state node(%s) of ledger(" FMT_I64 ") is %s", utils::String::BinToHexString(key).c_str(),
+						seq, found[i] == NOT_FOUND ? "missing" : "invalid");
+					return false;
+				}
+
+				if (found[i] != STAGED || mode == WALK_VERIFY) {
+					continue;
+				}
+				if (mode == WALK_APPLY) {
+					batch.Put(key, values[i]);
+				}
+				batch.Delete(StagedKey(key));
+			}
+
+			//Synced by the write which completes the state sync.
+			if (mode != WALK_VERIFY && !db->WriteBatch(batch, false)) {
+				LOG_ERROR("Failed to write the state of ledger(" FMT_I64 "), %s", seq, db->error_desc().c_str());
+				return false;
+			}
+		}
+		return true;
+	}
+}
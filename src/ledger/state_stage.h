@@ -0,0 +1,68 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef STATE_STAGE_H_
+#define STATE_STAGE_H_
+
+#include <common/storage.h>
+#include <proto/cpp/overlay.pb.h>
+
+namespace bumo {
+
+	typedef google::protobuf::RepeatedPtrField<protocol::StateSyncEntry> StateSyncEntries;
+
+	//The nodes downloaded by the state sync are written under STATE_NODE_PREFIX, so the state of the genesis ledger
+	//is kept until the whole state of the checkpoint has been checked. Then they are moved to their keys.
+	//The state is walked from the account root of the status, the nodes are read where they are staged, or at their keys,
+	//those of the genesis state which match the hashes are kept.
+	class StateStage {
+	public:
+		//Read with one MultiGet call
+		static const size_t READ_COUNT = 256;
+		//Where Read found the value
+		enum {
+			NOT_FOUND = 0,
+			AT_KEY = 1,
+			STAGED = 2
+		};
+
+		static std::string EntryKey(const protocol::StateSyncEntry &entry);
+		static std::string StagedKey(const std::string &key);
+		//The account tree, kept in the status, the validators and the fees of the checkpoint.
+		static void AddRootEntries(const protocol::LedgerHeader &header, StateSyncEntries &entries);
+		static bool IsRoot(const protocol::StateSyncEntry &entry);
+		//Check the value against the hash of the entry, and append the entries it refers to.
+		static bool Expand(const protocol::StateSyncEntry &entry, const std::string &value, StateSyncEntries &children);
+		//Return false on a database error.
+		static bool Read(KeyValueDb *db, const std::vector<protocol::StateSyncEntry> &entries, std::vector<std::string> &values, std::vector<int32_t> &found);
+
+		//The state is complete and matches the account tree hash of the checkpoint.
+		static bool Verify(KeyValueDb *db, const protocol::StateSyncStatus &status);
+		//Move the staged nodes to their keys, the root is written by the caller. It goes on where a former call stopped.
+		static void Apply(KeyValueDb *db, const protocol::StateSyncStatus &status);
+		//Delete the staged nodes.
+		static void Discard(KeyValueDb *db, const protocol::StateSyncStatus &status);
+
+	private:
+		enum WalkMode {
+			WALK_VERIFY,
+			WALK_APPLY,
+			WALK_DISCARD
+		};
+		static bool Walk(KeyValueDb *db, const protocol::StateSyncStatus &status, WalkMode mode);
+	};
+}
+
+#endif
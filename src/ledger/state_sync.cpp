@@ -0,0 +1,597 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <common/private_key.h>
+#include <main/configure.h>
+#include <overlay/peer_manager.h>
+#include <glue/glue_manager.h>
+#include "state_sync.h"
+#include "state_stage.h"
+#include "ledger_manager.h"
+
+namespace bumo {
+
+	//Timeout of a request
+	static const int64_t STATE_SYNC_REQUEST_TIMEOUT = 30 * utils::MICRO_UNITS_PER_SEC;
+	//Wait for the checkpoint to be followed by two closed ledgers
+	static const int64_t STATE_SYNC_RETRY_INTERVAL = 5 * utils::MICRO_UNITS_PER_SEC;
+	static const int64_t STATE_SYNC_PROBATION = 60 * utils::MICRO_UNITS_PER_SEC;
+	static const int64_t STATE_SYNC_SAVE_INTERVAL = 10 * utils::MICRO_UNITS_PER_SEC;
+	//The served checkpoint is replaced if no peer has asked for it for this long
+	static const int64_t STATE_SERVE_IDLE_TIME = 60 * utils::MICRO_UNITS_PER_SEC;
+	//Checkpoints not confirmed by the trusted validators before the ledgers are synced as usual
+	static const int32_t MAX_CHECKPOINT_FAILURES = 3;
+
+	StateSync::StateSync() {
+		active_ = false;
+		completing_ = false;
+		saved_ = false;
+		need_checkpoint_ = true;
+		peer_id_ = 0;
+		request_time_ = 0;
+		retry_time_ = 0;
+		save_time_ = 0;
+		checkpoint_failures_ = 0;
+		serve_time_ = 0;
+	}
+
+	StateSync::~StateSync() {}
+
+	bool StateSync::Initialize(const protocol::ValidatorSet &validators, int64_t lcl_seq) {
+		const LedgerConfigure &ledger_config = Configure::Instance().ledger_configure_;
+		if (ledger_config.fast_sync_validators_.empty()) {
+			trusted_validators_ = validators;
+		}
+		else {
+			for (utils::StringList::const_iterator iter = ledger_config.fast_sync_validators_.begin();
+				iter != ledger_config.fast_sync_validators_.end();
+				iter++) {
+				trusted_validators_.add_validators()->set_address(*iter);
+			}
+		}
+
+		std::string buff;
+		int32_t ret = Storage::Instance().account_db()->Get(General::KEY_STATE_SYNC, buff);
+		if (ret < 0) {
+			LOG_ERROR("Failed to read the state sync status, %s", Storage::Instance().account_db()->error_desc().c_str());
+			return false;
+		}
+
+		//The state written so far is not the one of the genesis ledger, so the download must go on.
+		if (ret > 0) {
+			if (!status_.ParseFromString(buff)) {
+				LOG_ERROR("Failed to parse the state sync status");
+				return false;
+			}
+			active_ = true;
+			saved_ = true;
+			need_checkpoint_ = false;
+			LOG_INFO("Resume the state sync of ledger(" FMT_I64 "), " FMT_I64 " nodes downloaded",
+				status_.ledger().header().seq(), status_.node_count());
+
+			//Verified before the restart, the staged nodes are moved on.
+			if (status_.committing()) {
+				completing_ = true;
+				Global::Instance().GetIoService().post([this]() {
+					Complete();
+				});
+			}
+			return true;
+		}
+
+		active_ = ledger_config.fast_sync_ && lcl_seq == 1;
+		return true;
+	}
+
+	void StateSync::Exit() {
+		utils::MutexGuard guard(serve_mutex_);
+		serve_view_.reset();
+	}
+
+	bool StateSync::IsActive() {
+		utils::MutexGuard guard(mutex_);
+		return active_;
+	}
+
+	void StateSync::OnTimer(int64_t current_time) {
+		utils::MutexGuard guard(mutex_);
+		if (!active_ || completing_) {
+			return;
+		}
+
+		if (request_time_ != 0) {
+			if (current_time - request_time_ < STATE_SYNC_REQUEST_TIMEOUT) {
+				return;
+			}
+
+			LOG_ERROR("The state sync request to peer(" FMT_I64 ") timed out", peer_id_);
+			probation_[peer_id_] = current_time + STATE_SYNC_PROBATION;
+			Requeue();
+		}
+
+		if (current_time < retry_time_) {
+			return;
+		}
+
+		SendRequest(current_time);
+	}
+
+	int64_t StateSync::ChoosePeer(int64_t current_time) {
+		std::set<int64_t> active_peers = PeerManager::Instance().ConsensusNetwork().GetActivePeerIds();
+		for (std::map<int64_t, int64_t>::iterator iter = probation_.begin(); iter != probation_.end();) {
+			if (iter->second < current_time || active_peers.find(iter->first) == active_peers.end()) {
+				iter = probation_.erase(iter);
+			}
+			else {
+				iter++;
+			}
+		}
+
+		//Stay with the peer serving our checkpoint.
+		if (active_peers.find(peer_id_) != active_peers.end() && probation_.find(peer_id_) == probation_.end()) {
+			return peer_id_;
+		}
+
+		for (std::set<int64_t>::iterator iter = active_peers.begin(); iter != active_peers.end(); iter++) {
+			if (probation_.find(*iter) == probation_.end()) {
+				return *iter;
+			}
+		}
+		return 0;
+	}
+
+	void StateSync::SendRequest(int64_t current_time) {
+		protocol::GetStateNodes message;
+		message.set_chain_id(General::GetSelfChainId());
+		if (!need_checkpoint_) {
+			WRITE_BATCH batch;
+			TakeEntries(batch);
+			Save(batch, false, current_time);
+
+			if (in_flight_.empty()) {
+				if (status_.pending_size() == 0) {
+					completing_ = true;
+					Global::Instance().GetIoService().post([this]() {
+						Complete();
+					});
+				}
+				return;
+			}
+
+			message.set_ledger_seq(status_.ledger().header().seq());
+			for (size_t i = 0; i < in_flight_.size(); i++) {
+				message.add_keys(StateStage::EntryKey(in_flight_[i]));
+			}
+		}
+
+		int64_t peer_id = ChoosePeer(current_time);
+		if (peer_id == 0) {
+			Requeue();
+			return;
+		}
+
+		if (peer_id != peer_id_ && !need_checkpoint_) {
+			//Another peer serves another checkpoint, the nodes already written are kept.
+			Requeue();
+			need_checkpoint_ = true;
+			message.set_ledger_seq(0);
+			message.clear_keys();
+		}
+
+		peer_id_ = peer_id;
+		request_time_ = current_time;
+		LOG_TRACE("Request " FMT_SIZE " state nodes of ledger(" FMT_I64 ") from peer(" FMT_I64 ")",
+			in_flight_.size(), message.ledger_seq(), peer_id);
+		PeerManager::Instance().ConsensusNetwork().SendRequest(peer_id, protocol::OVERLAY_MSGTYPE_STATE_NODES, message.SerializeAsString());
+	}
+
+	void StateSync::TakeEntries(WRITE_BATCH &batch) {
+		KeyValueDb *db = Storage::Instance().account_db();
+		//Bound the local work done in one round.
+		for (int32_t round = 0; round < 16 && in_flight_.empty() && status_.pending_size() > 0; round++) {
+			std::vector<protocol::StateSyncEntry> entries;
+			while (status_.pending_size() > 0 && (int32_t)entries.size() < MAX_NODES_PER_REQUEST) {
+				entries.push_back(status_.pending(status_.pending_size() - 1));
+				status_.mutable_pending()->RemoveLast();
+			}
+
+			//Staged before a restart, or kept from the genesis state.
+			std::vector<std::string> values;
+			std::vector<int32_t> found;
+			if (!StateStage::Read(db, entries, values, found)) {
+				PROCESS_EXIT("Failed to read account db, %s", db->error_desc().c_str());
+			}
+
+			for (size_t i = 0; i < entries.size(); i++) {
+				if (found[i] != StateStage::NOT_FOUND && ApplyEntry(entries[i], values[i], batch, false)) {
+					continue;
+				}
+				in_flight_.push_back(entries[i]);
+			}
+		}
+	}
+
+	bool StateSync::ApplyEntry(const protocol::StateSyncEntry &entry, const std::string &value, WRITE_BATCH &batch, bool write) {
+		if (!StateStage::Expand(entry, value, *status_.mutable_pending())) {
+			return false;
+		}
+
+		if (entry.type() == protocol::StateSyncEntry::ACCOUNT) {
+			status_.set_account_count(status_.account_count() + 1);
+		}
+		status_.set_node_count(status_.node_count() + 1);
+		if (write) {
+			if (StateStage::IsRoot(entry)) {
+				status_.set_account_root(value);
+			}
+			else {
+				batch.Put(StateStage::StagedKey(StateStage::EntryKey(entry)), value);
+			}
+		}
+		return true;
+	}
+
+	void StateSync::Requeue() {
+		for (size_t i = 0; i < in_flight_.size(); i++) {
+			*status_.add_pending() = in_flight_[i];
+		}
+		in_flight_.clear();
+		request_time_ = 0;
+	}
+
+	void StateSync::Save(WRITE_BATCH &batch, bool nodes, int64_t current_time) {
+		//The nodes may be written without the status, they are found in the account db after a restart.
+		if (current_time - save_time_ >= STATE_SYNC_SAVE_INTERVAL) {
+			protocol::StateSyncStatus status = status_;
+			for (size_t i = 0; i < in_flight_.size(); i++) {
+				*status.add_pending() = in_flight_[i];
+			}
+			batch.Put(General::KEY_STATE_SYNC, status.SerializeAsString());
+			save_time_ = current_time;
+			saved_ = true;
+			nodes = true;
+		}
+
+		if (!nodes) {
+			return;
+		}
+
+		KeyValueDb *db = Storage::Instance().account_db();
+		if (!db->WriteBatch(batch, false)) {
+			PROCESS_EXIT("Failed to write account db, %s", db->error_desc().c_str());
+		}
+	}
+
+	bool StateSync::CheckCheckpoint(const protocol::StateNodes &message) {
+		const protocol::LedgerHeader &header = message.ledger().header();
+		if (header.seq() != message.ledger_seq() || message.next_value().ledger_seq() != header.seq() + 1) {
+			LOG_ERROR("The checkpoint ledger(" FMT_I64 ") does not match the next consensus value(" FMT_I64 ")",
+				header.seq(), message.next_value().ledger_seq());
+			return false;
+		}
+
+		if (header.chain_id() != General::GetSelfChainId()) {
+			LOG_ERROR("The checkpoint ledger is on chain(" FMT_I64 ")", header.chain_id());
+			return false;
+		}
+
+		if (header.version() > General::LEDGER_VERSION) {
+			LOG_ERROR("Consensus ledger version:" FMT_I64 ", software ledger version:%d", header.version(), General::LEDGER_VERSION);
+			return false;
+		}
+
+		protocol::Ledger ledger = message.ledger();
+		ledger.mutable_header()->set_hash("");
+		std::string hash = HashWrapper::Crypto(ledger.SerializeAsString());
+		if (hash != header.hash() || hash != message.next_value().previous_ledger_hash()) {
+			LOG_ERROR("The hash of the checkpoint ledger(" FMT_I64 ") is invalid", header.seq());
+			return false;
+		}
+
+		std::string value_hash = HashWrapper::Crypto(message.next_value().SerializeAsString());
+		if (!GlueManager::Instance().CheckProof(trusted_validators_, value_hash, message.next_proof())) {
+			LOG_ERROR("The checkpoint ledger(" FMT_I64 ") is not confirmed by the trusted validators", header.seq());
+			return false;
+		}
+		return true;
+	}
+
+	void StateSync::SetCheckpoint(const protocol::StateNodes &message) {
+		const protocol::LedgerHeader &header = message.ledger().header();
+		need_checkpoint_ = false;
+		if (status_.ledger().header().seq() == header.seq()) {
+			return;
+		}
+
+		LOG_INFO("Download the state of ledger(" FMT_I64 ") from peer(" FMT_I64 ")", header.seq(), peer_id_);
+		//The nodes staged for another checkpoint would never be moved.
+		if (status_.has_ledger()) {
+			StateStage::Discard(Storage::Instance().account_db(), status_);
+		}
+		status_.Clear();
+		*status_.mutable_ledger() = message.ledger();
+		status_.set_proof(message.next_value().previous_proof());
+		StateStage::AddRootEntries(header, *status_.mutable_pending());
+		save_time_ = 0;
+	}
+
+	void StateSync::OnReceive(const protocol::StateNodes &message, int64_t peer_id) {
+		int64_t current_time = utils::Timestamp::HighResolution();
+		utils::MutexGuard guard(mutex_);
+		if (!active_ || completing_ || peer_id != peer_id_ || request_time_ == 0) {
+			LOG_ERROR("Received unexpected state nodes from peer(" FMT_I64 ")", peer_id);
+			return;
+		}
+		request_time_ = 0;
+
+		if (message.sync_code() != protocol::StateNodes::OK || message.chain_id() != General::GetSelfChainId()) {
+			LOG_INFO("Peer(" FMT_I64 ") failed to serve the state of ledger(" FMT_I64 "), code(%d)",
+				peer_id, message.ledger_seq(), message.sync_code());
+			Requeue();
+			if (message.sync_code() == protocol::StateNodes::NOT_READY) {
+				retry_time_ = current_time + STATE_SYNC_RETRY_INTERVAL;
+			}
+			else if (message.sync_code() == protocol::StateNodes::EXPIRED) {
+				need_checkpoint_ = true;
+			}
+			else {
+				probation_[peer_id] = current_time + STATE_SYNC_PROBATION;
+			}
+			return;
+		}
+
+		if (need_checkpoint_) {
+			if (!CheckCheckpoint(message)) {
+				probation_[peer_id] = current_time + STATE_SYNC_PROBATION;
+				//The trusted validators may have changed, do not wait for them forever.
+				if (++checkpoint_failures_ >= MAX_CHECKPOINT_FAILURES) {
+					LOG_WARN("No checkpoint is confirmed by the trusted validators after %d tries, sync the ledgers as usual", checkpoint_failures_);
+					Stop();
+				}
+				return;
+			}
+			checkpoint_failures_ = 0;
+
+			//Nothing has been written, so a short chain is replayed as usual.
+			if (!saved_ && message.ledger_seq() < MIN_LEDGER_COUNT) {
+				LOG_INFO("The chain has only " FMT_I64 " ledgers, replay them instead of syncing the state", message.ledger_seq());
+				active_ = false;
+				return;
+			}
+
+			SetCheckpoint(message);
+			SendRequest(current_time);
+			return;
+		}
+
+		bool valid = message.ledger_seq() == status_.ledger().header().seq() &&
+			message.keys_size() == message.values_size() &&
+			message.keys_size() > 0 &&
+			(size_t)message.keys_size() <= in_flight_.size();
+		for (int32_t i = 0; valid && i < message.keys_size(); i++) {
+			valid = message.keys(i) == StateStage::EntryKey(in_flight_[i]) && HashWrapper::Crypto(message.values(i)) == in_flight_[i].hash();
+		}
+		if (!valid) {
+			LOG_ERROR("Received invalid state nodes of ledger(" FMT_I64 ") from peer(" FMT_I64 ")", message.ledger_seq(), peer_id);
+			probation_[peer_id] = current_time + STATE_SYNC_PROBATION;
+			Requeue();
+			return;
+		}
+
+		WRITE_BATCH batch;
+		std::vector<protocol::StateSyncEntry> entries;
+		entries.swap(in_flight_);
+		for (size_t i = 0; i < entries.size(); i++) {
+			if (i >= (size_t)message.keys_size()) {
+				*status_.add_pending() = entries[i];
+			}
+			else if (!ApplyEntry(entries[i], message.values(i), batch, true)) {
+				//The hash matched, so the checkpoint itself is broken.
+				PROCESS_EXIT("Failed to parse the state node(%s) of ledger(" FMT_I64 ")",
+					utils::String::BinToHexString(message.keys(i)).c_str(), message.ledger_seq());
+			}
+		}
+		Save(batch, true, current_time);
+		SendRequest(current_time);
+	}
+
+	void StateSync::Complete() {
+		protocol::StateSyncStatus status;
+		do {
+			utils::MutexGuard guard(mutex_);
+			status = status_;
+		} while (false);
+
+		LOG_INFO("Downloaded the state of ledger(" FMT_I64 "): " FMT_I64 " nodes, " FMT_I64 " accounts",
+			status.ledger().header().seq(), status.node_count(), status.account_count());
+		bool synced = LedgerManager::Instance().OnStateSynced(status);
+
+		utils::MutexGuard guard(mutex_);
+		completing_ = false;
+		if (synced) {
+			active_ = false;
+			status_.Clear();
+			return;
+		}
+
+		//The staged nodes are discarded, download another checkpoint from another peer.
+		LOG_ERROR("The state of ledger(" FMT_I64 ") downloaded from peer(" FMT_I64 ") is invalid, download it again",
+			status.ledger().header().seq(), peer_id_);
+		probation_[peer_id_] = utils::Timestamp::HighResolution() + STATE_SYNC_PROBATION;
+		status_.Clear();
+		in_flight_.clear();
+		need_checkpoint_ = true;
+		saved_ = false;
+		request_time_ = 0;
+		save_time_ = 0;
+	}
+
+	void StateSync::Stop() {
+		if (status_.has_ledger()) {
+			KeyValueDb *db = Storage::Instance().account_db();
+			StateStage::Discard(db, status_);
+			if (!db->Delete(General::KEY_STATE_SYNC)) {
+				PROCESS_EXIT("Failed to write account db, %s", db->error_desc().c_str());
+			}
+		}
+		active_ = false;
+		status_.Clear();
+		in_flight_.clear();
+		request_time_ = 0;
+	}
+
+	void StateSync::OnRequest(const protocol::GetStateNodes &message, int64_t peer_id) {
+		if (message.chain_id() != General::GetSelfChainId()) {
+			LOG_TRACE("Failed to check same chain, node self id(" FMT_I64 ") is not eq (" FMT_I64 ")",
+				General::GetSelfChainId(), message.chain_id());
+			return;
+		}
+
+		int64_t current_time = utils::Timestamp::HighResolution();
+		protocol::StateNodes reply;
+		reply.set_chain_id(General::GetSelfChainId());
+		reply.set_ledger_seq(message.ledger_seq());
+
+		StateView::pointer view;
+		do {
+			utils::MutexGuard guard(serve_mutex_);
+			if (serve_view_ != nullptr && current_time - serve_time_ > STATE_SERVE_IDLE_TIME) {
+				serve_view_.reset();
+			}
+			if (serve_view_ == nullptr && message.ledger_seq() == 0 && !IsActive()) {
+				serve_view_ = LedgerManager::Instance().GetStateView();
+			}
+			if (serve_view_ != nullptr && (message.ledger_seq() == 0 || message.ledger_seq() == serve_view_->seq())) {
+				serve_time_ = current_time;
+				view = serve_view_;
+			}
+		} while (false);
+
+		do {
+			if (view == nullptr) {
+				reply.set_sync_code(message.ledger_seq() == 0 ? protocol::StateNodes::NOT_READY : protocol::StateNodes::EXPIRED);
+				break;
+			}
+
+			int64_t seq = view->seq();
+			reply.set_ledger_seq(seq);
+			if (message.ledger_seq() == 0) {
+				//The proof of the next ledger is in the consensus value after it.
+				protocol::ConsensusValue next;
+				if (LedgerManager::Instance().GetLastClosedLedger().seq() < seq + 2) {
+					reply.set_sync_code(protocol::StateNodes::NOT_READY);
+					break;
+				}
+
+				if (!LoadLedger(view->ledger_db(), seq, *reply.mutable_ledger()) ||
+					!LedgerManager::Instance().ConsensusValueFromDB(seq + 1, *reply.mutable_next_value()) ||
+					!LedgerManager::Instance().ConsensusValueFromDB(seq + 2, next)) {
+					LOG_ERROR("Failed to load the checkpoint ledger(" FMT_I64 ")", seq);
+					reply.set_sync_code(protocol::StateNodes::INTERNAL);
+					break;
+				}
+				reply.set_next_proof(next.previous_proof());
+				break;
+			}
+
+			if (message.keys_size() > MAX_NODES_PER_REQUEST) {
+				reply.set_sync_code(protocol::StateNodes::OUT_OF_NODES);
+				break;
+			}
+
+			std::vector<std::string> keys(message.keys().begin(), message.keys().end());
+			std::vector<std::string> values;
+			std::vector<int32_t> stats;
+			if (!view->account_db()->MultiGet(keys, values, stats)) {
+				LOG_ERROR("Failed to read the state of ledger(" FMT_I64 "), %s", seq, view->account_db()->error_desc().c_str());
+				reply.set_sync_code(protocol::StateNodes::INTERNAL);
+				break;
+			}
+
+			int64_t size = 0;
+			for (size_t i = 0; i < keys.size() && size < MAX_REPLY_SIZE; i++) {
+				if (stats[i] != 1) {
+					LOG_ERROR("Failed to find the state node(%s) of ledger(" FMT_I64 ")", utils::String::BinToHexString(keys[i]).c_str(), seq);
+					reply.set_sync_code(protocol::StateNodes::INTERNAL);
+					break;
+				}
+				reply.add_keys(keys[i]);
+				reply.add_values(values[i]);
+				size += keys[i].size() + values[i].size();
+			}
+		} while (false);
+
+		if (reply.sync_code() != protocol::StateNodes::OK) {
+			reply.clear_keys();
+			reply.clear_values();
+		}
+
+		bumo::WsMessagePointer ws = std::make_shared<protocol::WsMessage>();
+		ws->set_data(reply.SerializeAsString());
+		ws->set_type(protocol::OVERLAY_MSGTYPE_STATE_NODES);
+		ws->set_request(false);
+		LOG_TRACE("Send %d state nodes of ledger(" FMT_I64 ") to(" FMT_I64 ")", reply.keys_size(), reply.ledger_seq(), peer_id);
+		PeerManager::Instance().ConsensusNetwork().SendMsgToPeer(peer_id, ws);
+	}
+
+	bool StateSync::LoadLedger(KeyValueDb *db, int64_t seq, protocol::Ledger &ledger) {
+		std::string buff;
+		if (db->Get(ComposePrefix(General::LEDGER_PREFIX, seq), buff) <= 0 || !ledger.mutable_header()->ParseFromString(buff)) {
+			return false;
+		}
+
+		protocol::EntryList list;
+		if (db->Get(ComposePrefix(General::LEDGER_TRANSACTION_PREFIX, seq), buff) <= 0 || !list.ParseFromString(buff)) {
+			return false;
+		}
+
+		//The transactions triggered by a contract follow the one applied by the ledger.
+		std::set<std::string> contract_txs;
+		for (int32_t i = 0; i < list.entry_size(); i++) {
+			if (contract_txs.find(list.entry(i)) != contract_txs.end()) {
+				continue;
+			}
+
+			protocol::TransactionEnvStore store;
+			if (db->Get(ComposePrefix(General::TRANSACTION_PREFIX, list.entry(i)), buff) <= 0 || !store.ParseFromString(buff)) {
+				return false;
+			}
+			*ledger.add_transaction_envs() = store.transaction_env();
+			contract_txs.insert(store.contract_tx_hashes().begin(), store.contract_tx_hashes().end());
+		}
+
+		//Check it against the header, as the peer will.
+		protocol::Ledger hashed = ledger;
+		hashed.mutable_header()->set_hash("");
+		return HashWrapper::Crypto(hashed.SerializeAsString()) == ledger.header().hash();
+	}
+
+	void StateSync::GetModuleStatus(Json::Value &data) {
+		do {
+			utils::MutexGuard guard(mutex_);
+			data["active"] = active_;
+			if (active_) {
+				data["ledger_seq"] = status_.ledger().header().seq();
+				data["peer_id"] = peer_id_;
+				data["pending_count"] = status_.pending_size() + (Json::UInt64)in_flight_.size();
+				data["node_count"] = status_.node_count();
+				data["account_count"] = status_.account_count();
+			}
+		} while (false);
+
+		utils::MutexGuard guard(serve_mutex_);
+		data["serve_ledger_seq"] = serve_view_ == nullptr ? 0 : serve_view_->seq();
+	}
+}
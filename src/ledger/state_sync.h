@@ -0,0 +1,98 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef STATE_SYNC_H_
+#define STATE_SYNC_H_
+
+#include <utils/headers.h>
+#include <common/storage.h>
+#include <proto/cpp/overlay.pb.h>
+#include <proto/cpp/consensus.pb.h>
+#include "state_view.h"
+
+namespace bumo {
+
+	//Fast sync: a new node downloads the account state of a recent checkpoint ledger from a peer,
+	//then replays only the ledgers after it.
+	//The checkpoint is trusted through the proof of the ledger following it, signed by the trusted validators.
+	//Every trie node is checked against the hash its parent refers to, starting from the account_tree_hash,
+	//and staged in the account db, see StateStage. The pending nodes are saved in the account db,
+	//so the download goes on after a restart, and the nodes already staged are not downloaded again.
+	//Once the whole state has been verified, the nodes are moved to their keys and the root is written last.
+	//If no checkpoint is confirmed by the trusted validators, the ledgers are synced as usual.
+	class StateSync {
+	public:
+		//Keys per request, and the reply is cut at this size
+		static const int32_t MAX_NODES_PER_REQUEST = 256;
+		static const int64_t MAX_REPLY_SIZE = 2 * utils::BYTES_PER_MEGA;
+		//A chain shorter than this is replayed
+		static const int64_t MIN_LEDGER_COUNT = 1000;
+
+		StateSync();
+		~StateSync();
+
+		//Start or resume the download if this node is at the genesis ledger.
+		bool Initialize(const protocol::ValidatorSet &validators, int64_t lcl_seq);
+		void Exit();
+		//The ledgers are not synced before the state is downloaded.
+		bool IsActive();
+
+		void OnTimer(int64_t current_time);
+		void OnRequest(const protocol::GetStateNodes &message, int64_t peer_id);
+		void OnReceive(const protocol::StateNodes &message, int64_t peer_id);
+
+		void GetModuleStatus(Json::Value &data);
+
+		//Read the ledger with the transactions applied by it, as it was hashed.
+		static bool LoadLedger(KeyValueDb *db, int64_t seq, protocol::Ledger &ledger);
+
+	private:
+		bool CheckCheckpoint(const protocol::StateNodes &message);
+		void SetCheckpoint(const protocol::StateNodes &message);
+		//Take the next pending entries, those found in the account db are applied without downloading.
+		void TakeEntries(WRITE_BATCH &batch);
+		bool ApplyEntry(const protocol::StateSyncEntry &entry, const std::string &value, WRITE_BATCH &batch, bool write);
+		void Requeue();
+		void Save(WRITE_BATCH &batch, bool nodes, int64_t current_time);
+		void SendRequest(int64_t current_time);
+		int64_t ChoosePeer(int64_t current_time);
+		void Complete();
+		//Discard the download and sync the ledgers as usual.
+		void Stop();
+
+		utils::Mutex mutex_;
+		bool active_;
+		bool completing_;
+		bool saved_;                 //The download has written into the account db
+		protocol::ValidatorSet trusted_validators_;
+		protocol::StateSyncStatus status_;
+		bool need_checkpoint_;
+		std::vector<protocol::StateSyncEntry> in_flight_;
+		int32_t checkpoint_failures_;
+
+		int64_t peer_id_;
+		int64_t request_time_;
+		int64_t retry_time_;
+		int64_t save_time_;
+		std::map<int64_t, int64_t> probation_; //Peer id, until
+
+		//The checkpoint served to the peers, kept while they keep downloading it
+		utils::Mutex serve_mutex_;
+		StateView::pointer serve_view_;
+		int64_t serve_time_;
+	};
+}
+
+#endif
@@ -0,0 +1,88 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <common/private_key.h>
+#include "state_view.h"
+#include "kv_trie.h"
+
+namespace bumo {
+
+	StateView::StateView(std::shared_ptr<StorageSnapshot> snapshot) : snapshot_(snapshot), overlay_seq_(0), contract_refused_(0) {}
+
+	StateView::~StateView() {}
+
+	int64_t StateView::seq() const {
+		return overlay_seq_ > 0 ? overlay_seq_ : snapshot_->seq_;
+	}
+
+	KeyValueDb *StateView::ledger_db() {
+		return snapshot_->ledger_db_.get();
+	}
+
+	KeyValueDb *StateView::account_db() {
+		return snapshot_->account_db_.get();
+	}
+
+	bool StateView::GetAccount(const std::string &address, AccountFrm::pointer &account_ptr) {
+		auto iter = overlay_.find(address);
+		if (iter != overlay_.end()) {
+			//Its assets and metadata changed by the overlay ledger are cached, the others are read from the snapshot.
+			account_ptr = std::make_shared<AccountFrm>(*iter->second);
+			account_ptr->SetSnapshot(snapshot_);
+			//The account tree is written with the overlay ledger, not as the account was read before it.
+			account_ptr->SetStored(nullptr);
+		}
+		else if (!GetSnapshotAccount(address, account_ptr)) {
+			return false;
+		}
+
+		if (overlay_seq_ > 0 && !account_ptr->GetProtoAccount().contract().payload().empty()) {
+			utils::AtomicInc(&contract_refused_);
+			account_ptr = nullptr;
+			return false;
+		}
+		return true;
+	}
+
+	void StateView::SetOverlay(int64_t seq, const AccountMap &accounts) {
+		overlay_seq_ = seq;
+		overlay_ = accounts;
+	}
+
+	bool StateView::ContractRefused() {
+		return contract_refused_ > 0;
+	}
+
+	bool StateView::GetSnapshotAccount(const std::string &address, AccountFrm::pointer &account_ptr) {
+		KVTrie trie;
+		trie.Init(snapshot_->account_db_.get(), std::make_shared<WRITE_BATCH>(), General::ACCOUNT_PREFIX, -1, snapshot_->seq_);
+
+		std::string buff;
+		if (!trie.Get(DecodeAddress(address), buff)) {
+			return false;
+		}
+
+		protocol::Account account;
+		if (!account.ParseFromString(buff)) {
+			PROCESS_EXIT("Failed to parse account(%s) from string, fatal error", address.c_str());
+		}
+
+		account_ptr = std::make_shared<AccountFrm>(account);
+		account_ptr->SetSnapshot(snapshot_);
+		account_ptr->SetStored(std::make_shared<std::string>(std::move(buff)));
+		return true;
+	}
+}
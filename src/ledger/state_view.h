@@ -0,0 +1,60 @@
+/*
+	bumo is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	bumo is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef STATE_VIEW_H_
+#define STATE_VIEW_H_
+
+#include <unordered_map>
+#include <common/storage.h>
+#include "account.h"
+
+namespace bumo {
+
+	//Read-only state of a closed ledger on the database snapshots taken when it was written.
+	//Every read walks its own trie from the snapshot, so the readers take no ledger lock, and the ledgers
+	//closed meanwhile are not seen. The cached nodes are read when they are not changed after the snapshot.
+	class StateView {
+	public:
+		typedef std::shared_ptr<StateView> pointer;
+
+		StateView(std::shared_ptr<StorageSnapshot> snapshot);
+		~StateView();
+
+		int64_t seq() const;
+		KeyValueDb *ledger_db();
+		KeyValueDb *account_db();
+
+		//The account reads its assets and metadata from the snapshot too.
+		bool GetAccount(const std::string &address, AccountFrm::pointer &account_ptr);
+
+		//The accounts of the ledger after the snapshot, while it is sealed and not written yet.
+		//The next ledger runs ahead on the view, the objects are not modified afterwards.
+		typedef std::unordered_map<std::string, AccountFrm::pointer> AccountMap;
+		void SetOverlay(int64_t seq, const AccountMap &accounts);
+		//With an overlay the contract accounts are not served, a ledger reading one is executed again once the overlay ledger is closed.
+		bool ContractRefused();
+
+	private:
+		bool GetSnapshotAccount(const std::string &address, AccountFrm::pointer &account_ptr);
+
+		std::shared_ptr<StorageSnapshot> snapshot_;
+		int64_t overlay_seq_;
+		AccountMap overlay_;
+		volatile long contract_refused_;
+	};
+}
+
+#endif
@@ -22,6 +22,7 @@
 #include <contract/contract_manager.h>
 #include "fee_calculate.h"
 #include "ledger_frm.h"
+#include "signature_cache.h"
 namespace bumo {
 
 	TransactionFrm::TransactionFrm() :
@@ -69,6 +70,29 @@ namespace bumo {
 		utils::AtomicInc(&bumo::General::tx_new_count);
 	}
 
+	TransactionFrm::TransactionFrm(const protocol::TransactionEnv &env, const std::string &data, const std::string &hash, const std::set<std::string> &signers) :
+		apply_time_(0),
+		ledger_seq_(0),
+		result_(),
+		transaction_env_(env),
+		hash_(hash),
+		data_(data),
+		full_data_(env.SerializeAsString()),
+		valid_signature_(signers),
+		ledger_(),
+		processing_operation_(0),
+		actual_gas_(0),
+		actual_gas_for_query_(0),
+		max_end_time_(0),
+		contract_step_(0),
+		contract_memory_usage_(0),
+		contract_stack_usage_(0),
+		contract_stack_max_vaule_(0),
+		enable_check_(false), apply_start_time_(0), apply_use_time_(0),
+		incoming_time_(utils::Timestamp::HighResolution()) {
+		utils::AtomicInc(&bumo::General::tx_new_count);
+	}
+
 	TransactionFrm::~TransactionFrm() {
 		utils::AtomicInc(&bumo::General::tx_delete_count);
 	}
@@ -102,6 +126,13 @@ namespace bumo {
 		hash_ = HashWrapper::Crypto(data_);
 		full_data_ = transaction_env_.SerializeAsString();
 
+		//Verified before, when the transaction was received or applied.
+		SignatureCache *cache = SignatureCache::GetInstance();
+		if (cache != NULL && cache->Get(hash_, transaction_env_, valid_signature_)) {
+			return;
+		}
+
+		std::vector<std::string> addresses(transaction_env_.signatures_size());
 		for (int32_t i = 0; i < transaction_env_.signatures_size(); i++) {
 			const protocol::Signature &signature = transaction_env_.signatures(i);
 			PublicKey pubkey(signature.public_key());
@@ -114,7 +145,12 @@ namespace bumo {
 				LOG_ERROR("Invalid signature data(%s)", utils::String::BinToHexString(signature.SerializeAsString()).c_str());
 				continue;
 			}
-			valid_signature_.insert(pubkey.GetEncAddress());
+			addresses[i] = pubkey.GetEncAddress();
+			valid_signature_.insert(addresses[i]);
+		}
+
+		if (cache != NULL) {
+			cache->Put(hash_, transaction_env_, addresses);
 		}
 	}
 
@@ -633,7 +669,7 @@ namespace bumo {
 		return true;
 	}
 
-	bool TransactionFrm::AddActualFee(TransactionFrm::pointer bottom_tx, TransactionFrm* txfrm){
+	bool TransactionFrm::AddActualFee(TransactionFrm* bottom_tx, TransactionFrm* txfrm){
 		bottom_tx->AddActualGas(txfrm->GetSelfGas());
 		int64_t actual_fee = 0;
 		if (!utils::SafeIntMul(bottom_tx->GetActualGas(), bottom_tx->GetGasPrice(), actual_fee)){
@@ -699,8 +735,10 @@ namespace bumo {
 		return result_;
 	}
 
-	uint32_t TransactionFrm::LoadFromDb(const std::string &hash) {
-		KeyValueDb *db = Storage::Instance().ledger_db();
+	uint32_t TransactionFrm::LoadFromDb(const std::string &hash, KeyValueDb *db) {
+		if (db == NULL) {
+			db = Storage::Instance().ledger_db();
+		}
 
 		std::string txenv_store;
 		int res = db->Get(ComposePrefix(General::TRANSACTION_PREFIX, hash), txenv_store);
@@ -761,7 +799,9 @@ namespace bumo {
 		ledger_ = ledger_frm;
 		environment_ = parent;
 
-		bool ret = TransactionFrm::AddActualFee(ledger_frm->lpledger_context_->GetBottomTx(), this);
+		//A transaction applied by the ledger is itself the bottom of the stack.
+		TransactionFrm* bottom_tx = bool_contract ? ledger_frm->lpledger_context_->GetBottomTx().get() : this;
+		bool ret = TransactionFrm::AddActualFee(bottom_tx, this);
 		if (!ret) return ret;
 
 		bool bSucess = true;
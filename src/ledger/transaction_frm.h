@@ -40,6 +40,8 @@ namespace bumo {
 		//Valid only when the transaction belongs to a txset.
 		TransactionFrm();
 		TransactionFrm(const protocol::TransactionEnv &env);
+		//Serialized, hashed and verified with the txset, signers are the addresses of the valid signatures.
+		TransactionFrm(const protocol::TransactionEnv &env, const std::string &data, const std::string &hash, const std::set<std::string> &signers);
 		
 		virtual ~TransactionFrm();
 		
@@ -64,7 +66,8 @@ namespace bumo {
 
 		void Initialize();
 
-		uint32_t LoadFromDb(const std::string &hash);
+		//Read from the ledger db if db is NULL.
+		uint32_t LoadFromDb(const std::string &hash, KeyValueDb *db = NULL);
 
 		bool CheckTimeout(int64_t expire_time);
 		void NonceIncrease(LedgerFrm* ledger_frm, std::shared_ptr<Environment> env);
@@ -87,7 +90,7 @@ namespace bumo {
 		bool ValidForApply(std::shared_ptr<Environment> environment, bool check_priv = true);
 
 		bool CheckFee(const int64_t& gas_price, const int64_t& fee_limit, AccountFrm::pointer account);
-		static bool AddActualFee(TransactionFrm::pointer bottom_tx, TransactionFrm* txfrm);
+		static bool AddActualFee(TransactionFrm* bottom_tx, TransactionFrm* txfrm);
 
 		bool PayFee(std::shared_ptr<Environment> environment,int64_t& total_fee);
 		bool ReturnFee(int64_t& total_fee);
@@ -13,6 +13,7 @@
 	along with bumo.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <set>
 #include <utils/logger.h>
 #include "utils/strings.h"
 #include "trie.h"
@@ -30,48 +31,336 @@ namespace bumo{
 	-----------------------------
 	*/
 
-	NodeFrm::NodeFrm(const Location& location)
-		:leaf_(nullptr),  /*indb_(false),leaf_indb_(false),*/ leaf_deleted_(false), modified_(true), location_(location){
-		for (int i = 0; i <= 16; i++){
-			protocol::Child* ch = info_.add_children();
-			if (i != 16)
-				children_[i] = nullptr;
+	static int BitCount(uint32_t v){
+		v = v - ((v >> 1) & 0x55555555);
+		v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+		return (int)((((v + (v >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24);
+	}
+
+	static void AppendVarint(std::string& out, uint64_t value){
+		while (value >= 0x80){
+			out.push_back((char)(value | 0x80));
+			value >>= 7;
+		}
+		out.push_back((char)value);
+	}
+
+	static void AppendBytes(std::string& out, char tag, const char* data, size_t size){
+		out.push_back(tag);
+		AppendVarint(out, size);
+		out.append(data, size);
+	}
+
+	//Keeps the freed node blocks for reuse, the account tree releases and reloads its lower levels on every ledger.
+	class NodePool{
+	public:
+		static const size_t MAX_FREE_COUNT = 65536;
+
+		static void* Allocate(size_t size){
+			do {
+				utils::MutexGuard guard(mutex_);
+				if (size != block_size_ || free_.empty()){
+					break;
+				}
+				void* block = free_.back();
+				free_.pop_back();
+				return block;
+			} while (false);
+			return ::operator new(size);
+		}
+
+		static void Free(void* block, size_t size){
+			do {
+				utils::MutexGuard guard(mutex_);
+				if (block_size_ == 0){
+					block_size_ = size;
+				}
+				if (size != block_size_ || free_.size() >= MAX_FREE_COUNT){
+					break;
+				}
+				free_.push_back(block);
+				return;
+			} while (false);
+			::operator delete(block);
+		}
+
+	private:
+		static utils::Mutex mutex_;
+		static std::vector<void*> free_;
+		static size_t block_size_;
+	};
+
+	utils::Mutex NodePool::mutex_;
+	std::vector<void*> NodePool::free_;
+	size_t NodePool::block_size_ = 0;
+
+	template<class T>
+	class NodeAllocator{
+	public:
+		typedef T value_type;
+		typedef T* pointer;
+		typedef const T* const_pointer;
+		typedef T& reference;
+		typedef const T& const_reference;
+		typedef size_t size_type;
+		typedef ptrdiff_t difference_type;
+
+		template<class U>
+		struct rebind{
+			typedef NodeAllocator<U> other;
+		};
+
+		NodeAllocator(){}
+		template<class U>
+		NodeAllocator(const NodeAllocator<U>&){}
+
+		T* allocate(size_t n){
+			return (T*)NodePool::Allocate(n * sizeof(T));
+		}
+
+		void deallocate(T* p, size_t n){
+			NodePool::Free(p, n * sizeof(T));
 		}
+
+		size_t max_size() const{
+			return ((size_t)-1) / sizeof(T);
+		}
+
+		template<class U, class... Args>
+		void construct(U* p, Args&&... args){
+			::new((void*)p) U(std::forward<Args>(args)...);
+		}
+
+		template<class U>
+		void destroy(U* p){
+			p->~U();
+		}
+	};
+
+	template<class T, class U>
+	bool operator==(const NodeAllocator<T>&, const NodeAllocator<U>&){
+		return true;
+	}
+
+	template<class T, class U>
+	bool operator!=(const NodeAllocator<T>&, const NodeAllocator<U>&){
+		return false;
+	}
+
+	ChildRef::ChildRef() :type_(protocol::NONE), hash_size_(0){}
+
+	HASH ChildRef::GetHash() const{
+		return HASH(hash_, hash_size_);
+	}
+
+	void ChildRef::SetHash(const HASH& hash){
+		assert(hash.size() <= MAX_HASH_SIZE);
+		hash_size_ = (uint8_t)hash.size();
+		memcpy(hash_, hash.c_str(), hash_size_);
+	}
+
+	bool ChildRef::IsEmpty() const{
+		return sublocation_.empty() && hash_size_ == 0 && type_ == protocol::NONE;
+	}
+
+	void ChildRef::Clear(){
+		sublocation_.clear();
+		hash_size_ = 0;
+		type_ = protocol::NONE;
+	}
+
+	void ChildRef::ToProto(protocol::Child& child) const{
+		child.set_sublocation(sublocation_);
+		child.set_hash(hash_, hash_size_);
+		child.set_childtype((protocol::CHILDTYPE)type_);
+	}
+
+	void ChildRef::FromProto(const protocol::Child& child){
+		sublocation_ = child.sublocation();
+		SetHash(child.hash());
+		type_ = (uint8_t)child.childtype();
+	}
+
+	void ChildRef::Serialize(std::string& out) const{
+		if (!sublocation_.empty()){
+			AppendBytes(out, 0x0a, sublocation_.c_str(), sublocation_.size());
+		}
+		if (hash_size_ > 0){
+			AppendBytes(out, 0x12, hash_, hash_size_);
+		}
+		if (type_ != protocol::NONE){
+			out.push_back(0x18);
+			AppendVarint(out, type_);
+		}
+	}
+
+	NodeInfo::NodeInfo() :bitmap_(0){}
+
+	bool NodeInfo::Has(int branch) const{
+		return (bitmap_ & (1u << branch)) != 0;
+	}
+
+	int NodeInfo::Index(int branch) const{
+		return BitCount(bitmap_ & ((1u << branch) - 1));
+	}
+
+	const ChildRef& NodeInfo::Ref(int branch) const{
+		static const ChildRef empty;
+		if (!Has(branch)){
+			return empty;
+		}
+		return refs_[Index(branch)];
+	}
+
+	void NodeInfo::ToProto(protocol::Node& node) const{
+		node.Clear();
+		for (int i = 0; i < BRANCH_COUNT; i++){
+			Ref(i).ToProto(*node.add_children());
+		}
+	}
+
+	void NodeInfo::FromProto(const protocol::Node& node){
+		bitmap_ = 0;
+		refs_.clear();
+		for (int i = 0; i < BRANCH_COUNT && i < node.children_size(); i++){
+			ChildRef ref;
+			ref.FromProto(node.children(i));
+			if (!ref.IsEmpty()){
+				bitmap_ |= (1u << i);
+				refs_.push_back(ref);
+			}
+		}
+	}
+
+	std::string NodeInfo::Serialize() const{
+		std::string out;
+		std::string child;
+		for (int i = 0; i < BRANCH_COUNT; i++){
+			child.clear();
+			Ref(i).Serialize(child);
+			AppendBytes(out, 0x0a, child.c_str(), child.size());
+		}
+		return out;
+	}
+
+	bool NodeInfo::Parse(const std::string& buff){
+		protocol::Node node;
+		if (!node.ParseFromString(buff)){
+			return false;
+		}
+		FromProto(node);
+		return true;
+	}
+
+	size_t NodeInfo::MemorySize() const{
+		size_t size = sizeof(NodeInfo) + refs_.capacity() * sizeof(ChildRef);
+		for (size_t i = 0; i < refs_.size(); i++){
+			//Short locations are stored inside the string object
+			if (refs_[i].sublocation_.capacity() > 15){
+				size += refs_[i].sublocation_.capacity() + 1;
+			}
+		}
+		return size;
+	}
+
+	NodeFrm::NodeFrm(const Location& location)
+		:location_(location), modified_(true), /*indb_(false),leaf_indb_(false),*/ leaf_deleted_(false), leaf_(nullptr){
 		NEWCOUNT++;
 	}
 
+	NodeFrm::POINTER NodeFrm::Create(const Location& location){
+		return std::allocate_shared<NodeFrm>(NodeAllocator<NodeFrm>(), location);
+	}
+
 	void NodeFrm::SetValue(const std::string& v){
 		modified_ = true;
 		leaf_deleted_ = false;
-		leaf_ = std::make_shared<std::string>(v);
-		protocol::Child* ch16 = info_.mutable_children(16);
-		ch16->set_childtype(protocol::LEAF);
-		ch16->set_sublocation(location_);
+		leaf_.reset(new std::string(v));
+		ChildRef& ch16 = MutableRef(16);
+		ch16.type_ = protocol::LEAF;
+		ch16.sublocation_ = location_;
 	}
 
 	void NodeFrm::MarkRemove(){
 		modified_ = true;
 		leaf_deleted_ = true;
 		leaf_ = nullptr;
-		protocol::Child* ch16 = info_.mutable_children(16);
-		ch16->Clear();
+		ClearRef(16);
 	}
 
 	void NodeFrm::SetChild(int branch, POINTER child){
 		assert(branch < 16);
 		modified_ = true;
-		children_[branch] = child;
-		info_.mutable_children(branch)->set_sublocation(child->location_);
+		ChildRef& ref = MutableRef(branch);
+		children_[info_.Index(branch)] = child;
+		ref.sublocation_ = child->location_;
 		//info_.mutable_children(branch)->set_childtype();
 	}
 
+	NodeFrm::POINTER NodeFrm::GetChild(int branch) const{
+		if (!info_.Has(branch)){
+			return nullptr;
+		}
+		return children_[info_.Index(branch)];
+	}
+
+	void NodeFrm::SetInfo(const NodeInfo& info){
+		info_ = info;
+		children_.assign(info_.refs_.size(), nullptr);
+	}
+
+	ChildRef& NodeFrm::MutableRef(int branch){
+		int index = info_.Index(branch);
+		if (!info_.Has(branch)){
+			info_.bitmap_ |= (1u << branch);
+			info_.refs_.insert(info_.refs_.begin() + index, ChildRef());
+			children_.insert(children_.begin() + index, nullptr);
+		}
+		return info_.refs_[index];
+	}
+
+	void NodeFrm::ClearRef(int branch){
+		if (!info_.Has(branch)){
+			return;
+		}
+
+		int index = info_.Index(branch);
+		if (children_[index] != nullptr){
+			info_.refs_[index].Clear();
+			return;
+		}
+
+		//Nothing refers to the branch any more, drop it.
+		info_.bitmap_ &= ~(1u << branch);
+		info_.refs_.erase(info_.refs_.begin() + index);
+		children_.erase(children_.begin() + index);
+	}
+
 	NodeFrm::~NodeFrm(){
 		DELCOUNT++;
 	}
 
+	class Trie::HashTask : public utils::Runnable {
+	public:
+		HashTask(Trie* trie, NodeFrm::POINTER parent, int branch)
+			:trie_(trie), parent_(parent), branch_(branch), done_(NULL){}
+
+		virtual void Run(utils::Thread *){
+			result_ = trie_->update_hash(parent_->GetChild(branch_));
+			done_->Signal();
+		}
+
+		Trie* trie_;
+		NodeFrm::POINTER parent_;
+		int branch_;
+		utils::Semaphore* done_;
+		ChildRef result_;
+	};
+
 	Trie::Trie(){
 		rootl = "";
 		rootl.push_back(0);
+		hash_pool_ = NULL;
 	}
 
 
@@ -84,7 +373,7 @@ namespace bumo{
 	}
 
 	void Trie::Release(NodeFrm::POINTER node, int depth){
-		for (int i = 0; i < 16; i++){
+		for (size_t i = 0; i < node->children_.size(); i++){
 			auto child = node->children_[i];
 			if (child != nullptr){
 				Release(child, depth - 1);
@@ -96,28 +385,90 @@ namespace bumo{
 	}
 
 	NodeFrm::POINTER Trie::ChildMayFromDB(NodeFrm::POINTER node, int branch) {
-		if (node->children_[branch] == nullptr){
-			NodeFrm::POINTER frm = nullptr;
-			const protocol::Child& chd = node->info_.children(branch);
-			if (chd.childtype() == protocol::NONE){
+		NodeFrm::POINTER frm = node->GetChild(branch);
+		if (frm == nullptr){
+			const ChildRef& chd = node->info_.Ref(branch);
+			if (chd.type_ == protocol::NONE){
 				return nullptr;
 			}
 
-			frm = std::make_shared<NodeFrm>(chd.sublocation());
+			frm = NodeFrm::Create(chd.sublocation_);
 			frm->modified_ = false;
 
-			if (chd.childtype() == protocol::LEAF){
-				frm->info_.mutable_children(16)->CopyFrom(node->info_.children(branch));
+			if (chd.type_ == protocol::LEAF){
+				frm->MutableRef(16) = chd;
 
 			}
-			else if (chd.childtype() == protocol::INNER){
-				if (!storage_load(chd.sublocation(), frm->info_)){
-					PROCESS_EXIT("load:%s failed", utils::String::BinToHexString(chd.sublocation()).c_str());
+			else if (chd.type_ == protocol::INNER){
+				NodeInfo info;
+				if (!storage_load(chd.sublocation_, info)){
+					PROCESS_EXIT("load:%s failed", utils::String::BinToHexString(chd.sublocation_).c_str());
 				}
+				frm->SetInfo(info);
 			}
-			node->children_[branch] = frm;
+			node->children_[node->info_.Index(branch)] = frm;
+		}
+		return frm;
+	}
+
+	void Trie::LoadChildren(const std::vector<Branch>& branches){
+		std::set<std::pair<NodeFrm*, int>> requested;
+		std::vector<Branch> inners;
+		std::vector<Location> locations;
+		for (size_t i = 0; i < branches.size(); i++){
+			NodeFrm::POINTER node = branches[i].first;
+			int branch = branches[i].second;
+			if (node->GetChild(branch) != nullptr){
+				continue;
+			}
+
+			const ChildRef& chd = node->info_.Ref(branch);
+			if (chd.type_ != protocol::INNER){
+				//Nothing to read for a leaf.
+				ChildMayFromDB(node, branch);
+				continue;
+			}
+
+			if (requested.insert(std::make_pair(node.get(), branch)).second){
+				inners.push_back(branches[i]);
+				locations.push_back(chd.sublocation_);
+			}
+		}
+
+		if (locations.empty()){
+			return;
+		}
+
+		std::vector<NodeInfo> infos;
+		std::vector<bool> found;
+		StorageLoadNodes(locations, infos, found);
+		for (size_t i = 0; i < inners.size(); i++){
+			if (!found[i]){
+				PROCESS_EXIT("load:%s failed", utils::String::BinToHexString(locations[i]).c_str());
+			}
+
+			NodeFrm::POINTER node = inners[i].first;
+			NodeFrm::POINTER frm = NodeFrm::Create(locations[i]);
+			frm->modified_ = false;
+			frm->SetInfo(infos[i]);
+			node->children_[node->info_.Index(inners[i].second)] = frm;
+		}
+	}
+
+	void Trie::StorageLoadNodes(const std::vector<Location>& locations, std::vector<NodeInfo>& infos, std::vector<bool>& found){
+		infos.assign(locations.size(), NodeInfo());
+		found.assign(locations.size(), false);
+		for (size_t i = 0; i < locations.size(); i++){
+			found[i] = storage_load(locations[i], infos[i]);
+		}
+	}
+
+	void Trie::StorageGetLeaves(const std::vector<Location>& locations, std::vector<std::string>& values, std::vector<bool>& found){
+		values.assign(locations.size(), "");
+		found.assign(locations.size(), false);
+		for (size_t i = 0; i < locations.size(); i++){
+			found[i] = StorageGetLeaf(locations[i], values[i]);
 		}
-		return node->children_[branch];
 	}
 
 
@@ -179,61 +530,45 @@ namespace bumo{
 		return location + key;
 	}
 
-	protocol::Child Trie::update_hash(NodeFrm::POINTER node){
+	ChildRef Trie::update_hash(NodeFrm::POINTER node){
 
 		int branch_count = 0;
 		int onlybranch = -1;
-		int64_t children_count = 0;
 
 		//////////////////////////////////////////////////////////////
 		if (!node->leaf_deleted_){
 			if (node->leaf_ != nullptr){
-				protocol::Child* this_child = node->info_.mutable_children(16);
-#ifdef COUNT
-				this_child->set_count(1);
-#endif
-				this_child->set_sublocation(node->location_);
-				this_child->set_hash(HashCrypto(*(node->leaf_)));
-				this_child->set_childtype(protocol::LEAF);
+				ChildRef& this_child = node->MutableRef(16);
+				this_child.sublocation_ = node->location_;
+				this_child.SetHash(HashCrypto(*(node->leaf_)));
+				this_child.type_ = protocol::LEAF;
 				StorageSaveLeaf(node);
 			}
 		}
 		else{
-			protocol::Child* ch = node->info_.mutable_children(16);
-			ch->Clear();
+			node->ClearRef(16);
 			StorageDeleteLeaf(node);
 		}
 
-		if (node->info_.children(16).childtype() != protocol::CHILDTYPE::NONE){
+		if (node->info_.Ref(16).type_ != protocol::CHILDTYPE::NONE){
 			branch_count++;
 			onlybranch = 16;
-			children_count++;
 		}
 
 		for (int i = 0; i < 16; i++){
-			NodeFrm::POINTER child = node->children_[i];
+			NodeFrm::POINTER child = node->GetChild(i);
 			if ((child != nullptr) && (child->modified_)){
-				protocol::Child childresult = update_hash(child);
-				node->info_.mutable_children(i)->CopyFrom(childresult);
+				node->MutableRef(i) = update_hash(child);
 			}
 
-			if (node->info_.children(i).childtype() != protocol::CHILDTYPE::NONE){
+			if (node->info_.Ref(i).type_ != protocol::CHILDTYPE::NONE){
 				branch_count++;
 				onlybranch = i;
-#ifdef COUNT
-				if (node->info_.children(i).count() == 0){
-					printf("fatel error");
-				}
-				children_count += node->info_.children(i).count();
-#endif
 			}
 		}
 
 
-		protocol::Child result;
-#ifdef COUNT
-		result.set_count(children_count);
-#endif		
+		ChildRef result;
 		if (branch_count == 0 && node->location_ != rootl){
 			StorageDeleteNode(node);
 			//node->indb_ = false;
@@ -241,16 +576,13 @@ namespace bumo{
 		else if (branch_count == 1 && node->location_ != rootl){
 			StorageDeleteNode(node);
 			//node->indb_ = false;
-			result.CopyFrom(node->info_.children(onlybranch));
+			result = node->info_.Ref(onlybranch);
 		}
 		else {
 			StorageSaveNode(node);
-			result.set_hash(HashCrypto(node->info_.SerializeAsString()));
-			result.set_sublocation(node->location_);
-			result.set_childtype(protocol::CHILDTYPE::INNER);
-#ifdef COUNT
-			result.set_count(children_count);
-#endif
+			result.SetHash(HashCrypto(node->info_.Serialize()));
+			result.sublocation_ = node->location_;
+			result.type_ = protocol::CHILDTYPE::INNER;
 		}
 		node->modified_ = false;
 		return result;
@@ -270,13 +602,13 @@ namespace bumo{
 		int branch = NextBranch(common, location);
 
 		NodeFrm::POINTER node2 = ChildMayFromDB(node, branch);
-		protocol::Child child2 = node->info_.children(branch);
+		ChildRef child2 = node->info_.Ref(branch);
 		if (node2 == nullptr){
-			NodeFrm::POINTER newnode = std::make_shared<NodeFrm>(location);
+			NodeFrm::POINTER newnode = NodeFrm::Create(location);
 			newnode->SetValue(data);
 
 			node->SetChild(branch, newnode);
-			node->info_.mutable_children(branch)->set_childtype(protocol::LEAF);
+			node->MutableRef(branch).type_ = protocol::LEAF;
 			
 			return true;
 		}
@@ -298,14 +630,14 @@ namespace bumo{
 				|
 				node2
 				*/
-			NodeFrm::POINTER newnode = std::make_shared< NodeFrm>(location);
+			NodeFrm::POINTER newnode = NodeFrm::Create(location);
 			newnode->SetValue(data);
 			int b1 = NextBranch(newcommon, location2);
 			newnode->SetChild(b1, node2);
-			newnode->info_.mutable_children(b1)->CopyFrom(child2);
+			newnode->MutableRef(b1) = child2;
 
 			node->SetChild(branch, newnode);
-			node->info_.mutable_children(branch)->set_childtype(protocol::INNER);
+			node->MutableRef(branch).type_ = protocol::INNER;
 			return true;
 		}
 		else {
@@ -323,15 +655,15 @@ namespace bumo{
 						  */
 			/************************************************************************/
 
-			NodeFrm::POINTER mnode = std::make_shared< NodeFrm>(newcommon);
-			NodeFrm::POINTER newnode = std::make_shared< NodeFrm>(location);
+			NodeFrm::POINTER mnode = NodeFrm::Create(newcommon);
+			NodeFrm::POINTER newnode = NodeFrm::Create(location);
 			newnode->SetValue(data);
 
 			int b1 = NextBranch(newcommon, location);
 			int b2 = NextBranch(newcommon, location2);
 			mnode->SetChild(b1, newnode);
 			mnode->SetChild(b2, node2);
-			mnode->info_.mutable_children(b2)->CopyFrom(child2);
+			mnode->MutableRef(b2) = child2;
 			node->SetChild(branch, mnode);
 			return true;
 		}
@@ -368,7 +700,7 @@ namespace bumo{
 	}
 
 	void Trie::GetAllItem(const Location& node, const Location& location, std::vector<std::string>& result){
-		protocol::Node info;
+		NodeInfo info;
 		if (!storage_load(node, info)){
 			return;
 		}
@@ -380,7 +712,7 @@ namespace bumo{
 
 		if (common == node){
 			int nextbranch = NextBranch(common, location);
-			Location location2 = info.children(nextbranch).sublocation();
+			Location location2 = info.Ref(nextbranch).sublocation_;
 			GetAllItem(location2, location, result);
 		}
 
@@ -406,11 +738,11 @@ namespace bumo{
 		auto common = CommonPrefix(node->location_, key);
 		int branch = NextBranch(common, key);
 
-		if (node->info_.children(branch).childtype() == protocol::CHILDTYPE::NONE){
+		if (node->info_.Ref(branch).type_ == protocol::CHILDTYPE::NONE){
 			return false;
 		}
 
-		Location location2 = node->info_.children(branch).sublocation();
+		Location location2 = node->info_.Ref(branch).sublocation_;
 
 		auto common2 = CommonPrefix(location2, key);
 		if (common2 != location2){
@@ -420,6 +752,68 @@ namespace bumo{
 		return Exists(child, key);
 	}
 
+	void Trie::Prefetch(const std::vector<std::string>& keys){
+		typedef std::pair<NodeFrm::POINTER, Location> Path;
+		std::vector<Path> paths;
+		for (size_t i = 0; i < keys.size(); i++){
+			paths.push_back(Path(root_, Key2Location(keys[i])));
+		}
+
+		while (!paths.empty()){
+			std::vector<Branch> missing;
+			std::vector<Path> pending;
+			for (size_t i = 0; i < paths.size(); i++){
+				NodeFrm::POINTER node = paths[i].first;
+				const Location& key = paths[i].second;
+
+				//Walk down the loaded part of the path, the same way as Exists.
+				while (node->location_ != key){
+					int branch = NextBranch(CommonPrefix(node->location_, key), key);
+					const ChildRef& chd = node->info_.Ref(branch);
+					if (chd.type_ != protocol::INNER || CommonPrefix(chd.sublocation_, key) != chd.sublocation_){
+						break;
+					}
+
+					NodeFrm::POINTER child = node->GetChild(branch);
+					if (child == nullptr){
+						missing.push_back(Branch(node, branch));
+						pending.push_back(Path(node, key));
+						break;
+					}
+					node = child;
+				}
+			}
+
+			LoadChildren(missing);
+			paths.swap(pending);
+		}
+	}
+
+	void Trie::GetBatch(const std::vector<std::string>& keys, std::vector<std::string>& values, std::vector<bool>& found){
+		Prefetch(keys);
+
+		std::vector<Location> locations;
+		std::vector<size_t> indexes;
+		for (size_t i = 0; i < keys.size(); i++){
+			Location location = Key2Location(keys[i]);
+			if (Exists(root_, location)){
+				locations.push_back(location);
+				indexes.push_back(i);
+			}
+		}
+
+		std::vector<std::string> leaves;
+		std::vector<bool> leaf_found;
+		StorageGetLeaves(locations, leaves, leaf_found);
+
+		values.assign(keys.size(), "");
+		found.assign(keys.size(), false);
+		for (size_t i = 0; i < indexes.size(); i++){
+			values[indexes[i]].swap(leaves[i]);
+			found[indexes[i]] = leaf_found[i];
+		}
+	}
+
 	void Trie::GetAll(const std::string& key, std::vector<std::string>& values){
 		Location location = Key2Location(key);
 		Location node = Key2Location("");
@@ -432,7 +826,62 @@ namespace bumo{
 	}
 
 	void Trie::UpdateHash(){
-		root_hash_ = update_hash(root_).hash();
+		if (hash_pool_ != NULL){
+			ParallelUpdateHash();
+		}
+		root_hash_ = update_hash(root_).GetHash();
+	}
+
+	void Trie::SetHashPool(utils::ThreadPool* pool){
+		hash_pool_ = pool;
+	}
+
+	void Trie::CollectHashTasks(NodeFrm::POINTER node, int depth, std::vector<HashTask*>& tasks){
+		for (int i = 0; i < 16; i++){
+			NodeFrm::POINTER child = node->GetChild(i);
+			if (child == nullptr || !child->modified_){
+				continue;
+			}
+
+			if (depth + 1 >= PARALLEL_HASH_DEPTH){
+				tasks.push_back(new HashTask(this, node, i));
+			}
+			else{
+				CollectHashTasks(child, depth + 1, tasks);
+			}
+		}
+	}
+
+	void Trie::ParallelUpdateHash(){
+		std::vector<HashTask*> tasks;
+		CollectHashTasks(root_, 0, tasks);
+
+		//Nothing to share, leave it to the serial pass.
+		if (tasks.size() <= 1){
+			for (size_t i = 0; i < tasks.size(); i++){
+				delete tasks[i];
+			}
+			return;
+		}
+
+		utils::Semaphore done;
+		for (size_t i = 0; i < tasks.size(); i++){
+			tasks[i]->done_ = &done;
+			hash_pool_->AddTask(tasks[i]);
+		}
+
+		for (size_t i = 0; i < tasks.size();){
+			if (done.Wait()){
+				i++;
+			}
+		}
+
+		//The subtrees are no longer modified, so the serial pass only hashes the levels above them.
+		for (size_t i = 0; i < tasks.size(); i++){
+			HashTask* task = tasks[i];
+			task->parent_->MutableRef(task->branch_) = task->result_;
+			delete task;
+		}
 	}
 
 	bool Trie::Delete(const std::string& key){
@@ -442,29 +891,28 @@ namespace bumo{
 
 
 	void Trie::StorageAssociated(const Location& location, std::vector<std::string>& result){
-		protocol::Node info;
+		NodeInfo info;
 		if (!storage_load(location, info)){
 			return;
 		}
-		if (info.children(16).childtype() == protocol::CHILDTYPE::LEAF){
+		if (info.Ref(16).type_ == protocol::CHILDTYPE::LEAF){
 			std::string v;
 			StorageGetLeaf(location, v);
 			result.push_back(v);
 		}
 
 		for (int i = 0; i < 16; i++){
-			protocol::Child chd = info.children(i);
-			protocol::CHILDTYPE type = chd.childtype();
-			switch (type)
+			const ChildRef& chd = info.Ref(i);
+			switch (chd.type_)
 			{
 			case protocol::NONE:
 				break;
 			case protocol::INNER:
-				StorageAssociated(chd.sublocation(), result);
+				StorageAssociated(chd.sublocation_, result);
 				break;
 			case protocol::LEAF:
 				std::string value;
-				StorageGetLeaf(chd.sublocation(), value);
+				StorageGetLeaf(chd.sublocation_, value);
 				result.push_back(value);
 				break;
 			}
@@ -507,7 +955,9 @@ namespace bumo{
 
 	protocol::Node Trie::getNode(NodeFrm::POINTER node, const Location& location){
 		if (node->location_ == location){
-			return node->info_;
+			protocol::Node info;
+			node->info_.ToProto(info);
+			return info;
 		}
 
 		Location common = CommonPrefix(location, node->location_);
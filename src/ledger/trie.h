@@ -17,23 +17,71 @@
 #define TRIE_H_
 
 #include <utils/sm3.h>
+#include <utils/thread.h>
 #include "proto/cpp/merkeltrie.pb.h"
 
 namespace bumo{
 	typedef std::string Location;
 	typedef std::string HASH;
 
+	//In-memory form of protocol::Child, the hash is kept inline.
+	class ChildRef{
+	public:
+		static const size_t MAX_HASH_SIZE = 32;
+
+		Location sublocation_;
+		uint8_t type_; //protocol::CHILDTYPE
+		uint8_t hash_size_;
+		char hash_[MAX_HASH_SIZE];
+
+		ChildRef();
+
+		HASH GetHash() const;
+		void SetHash(const HASH& hash);
+		bool IsEmpty() const;
+		void Clear();
+
+		void ToProto(protocol::Child& child) const;
+		void FromProto(const protocol::Child& child);
+		//Append the same bytes as protocol::Child::SerializeAsString.
+		void Serialize(std::string& out) const;
+	};
+
+	//In-memory form of protocol::Node. Branch 16 refers to the leaf of the node itself.
+	//Only the branches set in bitmap_ are stored, in ascending order.
+	class NodeInfo{
+	public:
+		static const int BRANCH_COUNT = 17;
+
+		uint32_t bitmap_;
+		std::vector<ChildRef> refs_;
+
+		NodeInfo();
+
+		bool Has(int branch) const;
+		int Index(int branch) const;
+		//Returns an empty reference if the branch is not stored.
+		const ChildRef& Ref(int branch) const;
+
+		void ToProto(protocol::Node& node) const;
+		void FromProto(const protocol::Node& node);
+		//Same bytes as protocol::Node::SerializeAsString, so the node hash is unchanged.
+		std::string Serialize() const;
+		bool Parse(const std::string& buff);
+
+		size_t MemorySize() const;
+	};
+
 	class NodeFrm{
 	public:
 		typedef std::shared_ptr<NodeFrm> POINTER;
 		Location location_;
-		POINTER children_[16];
-		
-		protocol::Node info_;
+		NodeInfo info_;
+		std::vector<POINTER> children_; //Parallel to info_.refs_, nullptr if not loaded
 		
 		bool modified_;
 		bool leaf_deleted_;
-		std::shared_ptr<std::string> leaf_;//nullptr default
+		std::unique_ptr<std::string> leaf_;//nullptr default
 
 		static int NEWCOUNT;
 		static int DELCOUNT;
@@ -42,9 +90,18 @@ namespace bumo{
 
 		~NodeFrm();
 
+		//Nodes are allocated from a pool shared by all the tries.
+		static POINTER Create(const Location& location);
+
 		void SetValue(const std::string& v);
 		void MarkRemove();
 		void SetChild(int branch, POINTER child);
+		POINTER GetChild(int branch) const;
+
+		void SetInfo(const NodeInfo& info);
+		//Stores the branch if it is not stored yet.
+		ChildRef& MutableRef(int branch);
+		void ClearRef(int branch);
 	};
 
 	class Trie
@@ -52,7 +109,11 @@ namespace bumo{
 
 		bool SetItem(NodeFrm::POINTER node, const Location &key, const std::string &value, int depth);
 		bool DeleteItem(NodeFrm::POINTER node, const Location& key);
-		protocol::Child update_hash(NodeFrm::POINTER node);
+		ChildRef update_hash(NodeFrm::POINTER node);
+
+		class HashTask;
+		void CollectHashTasks(NodeFrm::POINTER node, int depth, std::vector<HashTask*>& tasks);
+		void ParallelUpdateHash();
 
 		void Release(NodeFrm::POINTER node, int depth);
 		
@@ -62,9 +123,17 @@ namespace bumo{
 		NodeFrm::POINTER root_;
 		HASH root_hash_;
 		Location rootl ;
+		utils::ThreadPool* hash_pool_;
 		NodeFrm::POINTER ChildMayFromDB(NodeFrm::POINTER node, int branch);
 
-		virtual bool storage_load(const Location& location, protocol::Node& info) = 0;
+		typedef std::pair<NodeFrm::POINTER, int> Branch;
+		//Attach the children of the branches, the missing inner nodes are read with one StorageLoadNodes.
+		void LoadChildren(const std::vector<Branch>& branches);
+
+		virtual bool storage_load(const Location& location, NodeInfo& info) = 0;
+		//Batched reads, the default implementations read the locations one by one.
+		virtual void StorageLoadNodes(const std::vector<Location>& locations, std::vector<NodeInfo>& infos, std::vector<bool>& found);
+		virtual void StorageGetLeaves(const std::vector<Location>& locations, std::vector<std::string>& values, std::vector<bool>& found);
 
 		virtual void StorageSaveNode(NodeFrm::POINTER node) = 0;
 		virtual void StorageSaveLeaf(NodeFrm::POINTER node) = 0;
@@ -80,6 +149,9 @@ namespace bumo{
 		static const char ODD_PREFIX = 0x01;
 		static const char LEAF_PREFIX = 0x02;
 
+		//Dirty subtrees below this depth are hashed as independent tasks in parallel mode.
+		static const int PARALLEL_HASH_DEPTH = 2;
+
 		Trie();
 		~Trie();
 		
@@ -91,6 +163,11 @@ namespace bumo{
 		//Return false if it is not existed; otherwise, return true.
 		bool Get(const std::string& key, std::string& value);
 
+		//Load the paths to the keys level by level, with one batched read per level.
+		void Prefetch(const std::vector<std::string>& keys);
+		//Get for many keys, found[i] tells whether keys[i] exists.
+		void GetBatch(const std::vector<std::string>& keys, std::vector<std::string>& values, std::vector<bool>& found);
+
 		bool Exists(NodeFrm::POINTER node, const Location& key);
 
 		void GetAll(const std::string& key, std::vector<std::string>& values);
@@ -102,6 +179,10 @@ namespace bumo{
 
 		void UpdateHash();
 
+		//Hash independent dirty subtrees on the pool, NULL for serial mode.
+		//Storage callbacks may then be invoked from the pool's threads.
+		void SetHashPool(utils::ThreadPool* pool);
+
 		void FreeMemory(int depth);
 	
 		protocol::Node GetNode(const Location& key);
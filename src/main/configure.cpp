@@ -124,6 +124,18 @@ namespace bumo {
 		hash_type_ = 0; // 0 : SHA256, 1 :SM2
 		queue_limit_ = 10240;
 		queue_per_account_txs_limit_ = 64;
+		hash_thread_count_ = 4;
+		apply_thread_count_ = 4;
+		process_thread_count_ = 4;
+		pipeline_close_ = true;
+		node_cache_size_ = 256;
+		signature_cache_size_ = 50000;
+		isolate_pool_size_ = 8;
+		code_cache_size_ = 64;
+		code_cache_persist_ = false;
+		history_ledger_count_ = 0;
+		prune_ledger_per_round_ = 10;
+		fast_sync_ = false;
 	}
 
 	LedgerConfigure::~LedgerConfigure() {
@@ -140,6 +152,19 @@ namespace bumo {
 		Configure::GetValue(value, "max_trans_in_memory", max_trans_in_memory_);
 		Configure::GetValue(value, "hardfork_points", hardfork_points_);
 		Configure::GetValue(value, "use_atom_map", use_atom_map_);
+		Configure::GetValue(value, "hash_thread_count", hash_thread_count_);
+		Configure::GetValue(value, "apply_thread_count", apply_thread_count_);
+		Configure::GetValue(value, "process_thread_count", process_thread_count_);
+		Configure::GetValue(value, "pipeline_close", pipeline_close_);
+		Configure::GetValue(value, "node_cache_size", node_cache_size_);
+		Configure::GetValue(value, "signature_cache_size", signature_cache_size_);
+		Configure::GetValue(value, "isolate_pool_size", isolate_pool_size_);
+		Configure::GetValue(value, "code_cache_size", code_cache_size_);
+		Configure::GetValue(value, "code_cache_persist", code_cache_persist_);
+		Configure::GetValue(value, "history_ledger_count", history_ledger_count_);
+		Configure::GetValue(value, "prune_ledger_per_round", prune_ledger_per_round_);
+		Configure::GetValue(value, "fast_sync", fast_sync_);
+		Configure::GetValue(value, "fast_sync_validators", fast_sync_validators_);
 
 		Configure::GetValue(value["tx_pool"], "queue_limit", queue_limit_);
         Configure::GetValue(value["tx_pool"], "queue_per_account_txs_limit", queue_per_account_txs_limit_);
@@ -152,11 +177,24 @@ namespace bumo {
 			validation_privatekey_ = utils::Aes::HexDecrypto(validation_privatekey_, GetDataSecuretKey());
 		}
 		close_interval_ = close_interval_ * utils::MICRO_UNITS_PER_SEC; //micro second
+		node_cache_size_ *= utils::BYTES_PER_MEGA;
+		code_cache_size_ *= utils::BYTES_PER_MEGA;
 
 		if (max_apply_ledger_per_round_ == 0
 			|| max_trans_in_memory_ / max_apply_ledger_per_round_ == 0) {
 			return false;
 		}
+
+		if (process_thread_count_ == 0) {
+			LOG_STD_ERR("The process_thread_count must be greater than 0");
+			return false;
+		}
+
+		//The peers behind by less than this still sync from us.
+		if (history_ledger_count_ != 0 && history_ledger_count_ < HISTORY_LEDGER_COUNT_MIN) {
+			LOG_STD_ERR("The history_ledger_count must be 0 or no less than " FMT_I64, HISTORY_LEDGER_COUNT_MIN);
+			return false;
+		}
 		return true;
 	}
 
@@ -217,7 +255,9 @@ namespace bumo {
 			return false;
 		}
 
-		db_configure_.Load(values["db"]);
+		if (!db_configure_.Load(values["db"])) {
+			return false;
+		}
 		logger_configure_.Load(values["logger"]);
 		p2p_configure_.Load(values["p2p"]);
 		webserver_configure_.Load(values["webserver"]);
@@ -91,6 +91,20 @@ namespace bumo {
 		uint32_t queue_per_account_txs_limit_;
 		utils::StringList hardfork_points_;
 		bool use_atom_map_;
+		uint32_t hash_thread_count_; //0 : hash the account tree serially
+		uint32_t apply_thread_count_; //0 : apply the transactions serially
+		uint32_t process_thread_count_; //Threads pre-executing the consensus values, at least 1
+		bool pipeline_close_; //Seal a synced ledger in the close thread while the next one is executed
+		int64_t node_cache_size_; //Byte, 0 : disable the trie node cache
+		int64_t signature_cache_size_; //Transactions, 0 : disable the verified signature cache
+		uint32_t isolate_pool_size_; //Idle isolates kept for the contracts, 0 : create one per contract
+		int64_t code_cache_size_; //Byte, 0 : disable the code cache of the contracts
+		bool code_cache_persist_; //Keep the code cache data in the key value db too
+		const static int64_t HISTORY_LEDGER_COUNT_MIN = 1000;
+		int64_t history_ledger_count_; //0 : keep the transactions and consensus values of all the ledgers
+		uint32_t prune_ledger_per_round_; //Ledgers pruned every 500 ms at most
+		bool fast_sync_; //Download the state of a recent ledger instead of replaying from the genesis ledger
+		utils::StringList fast_sync_validators_; //Trusted validators of the checkpoint, empty : the genesis validators
 		bool Load(const Json::Value &value);
 	};
 
@@ -21,6 +21,8 @@
 #include <common/daemon.h>
 #include <overlay/peer_manager.h>
 #include <ledger/ledger_manager.h>
+#include <ledger/node_cache.h>
+#include <ledger/signature_cache.h>
 #include <consensus/consensus_manager.h>
 #include <glue/glue_manager.h>
 #include <api/web_server.h>
@@ -74,12 +76,16 @@ int main(int argc, char *argv[]){
 	bumo::Console::InitInstance();
 	bumo::PeerManager::InitInstance();
 	bumo::LedgerManager::InitInstance();
+	bumo::NodeCache::InitInstance();
+	bumo::SignatureCache::InitInstance();
 	bumo::ConsensusManager::InitInstance();
 	bumo::GlueManager::InitInstance();
 	bumo::WebSocketServer::InitInstance();
 	bumo::WebServer::InitInstance();
 	bumo::MonitorManager::InitInstance();
 	bumo::ContractManager::InitInstance();
+	bumo::IsolatePool::InitInstance();
+	bumo::CodeCache::InitInstance();
 
 	bumo::Argument arg;
 	if (arg.Parse(argc, argv)){
@@ -272,10 +278,14 @@ int main(int argc, char *argv[]){
 
 	} while (false);
 
+	bumo::CodeCache::ExitInstance();
+	bumo::IsolatePool::ExitInstance();
 	bumo::ContractManager::ExitInstance();
 	bumo::SlowTimer::ExitInstance();
 	bumo::GlueManager::ExitInstance();
 	bumo::LedgerManager::ExitInstance();
+	bumo::SignatureCache::ExitInstance();
+	bumo::NodeCache::ExitInstance();
 	bumo::PeerManager::ExitInstance();
 	bumo::WebSocketServer::ExitInstance();
 	bumo::WebServer::ExitInstance();
@@ -218,7 +218,7 @@ namespace bumo {
 	bool MonitorManager::OnLedgerStatus(protocol::WsMessage &message, int64_t conn_id) {
 		// Get the ledger status
 		monitor::LedgerStatus ledger_status;
-		ledger_status.mutable_ledger_header()->CopyFrom(LedgerManager::Instance().GetLastClosedLedger());
+		ledger_status.mutable_ledger_header()->CopyFrom(LedgerManager::Instance().GetWrittenLedger());
 		ledger_status.set_transaction_size(GlueManager::Instance().GetTransactionCacheSize());
 		ledger_status.set_account_count(LedgerManager::Instance().GetAccountNum());
 		ledger_status.set_timestamp(utils::Timestamp::HighResolution());
@@ -43,9 +43,11 @@ namespace bumo {
 		request_methods_[protocol::OVERLAY_MSGTYPE_LEDGERS] = std::bind(&PeerNetwork::OnMethodGetLedgers, this, std::placeholders::_1, std::placeholders::_2);
 		request_methods_[protocol::OVERLAY_MSGTYPE_PBFT] = std::bind(&PeerNetwork::OnMethodPbft, this, std::placeholders::_1, std::placeholders::_2);
 		request_methods_[protocol::OVERLAY_MSGTYPE_LEDGER_UPGRADE_NOTIFY] = std::bind(&PeerNetwork::OnMethodLedgerUpNotify, this, std::placeholders::_1, std::placeholders::_2);
+		request_methods_[protocol::OVERLAY_MSGTYPE_STATE_NODES] = std::bind(&PeerNetwork::OnMethodGetStateNodes, this, std::placeholders::_1, std::placeholders::_2);
 
 
 		response_methods_[protocol::OVERLAY_MSGTYPE_LEDGERS] = std::bind(&PeerNetwork::OnMethodLedgers, this, std::placeholders::_1, std::placeholders::_2);
+		response_methods_[protocol::OVERLAY_MSGTYPE_STATE_NODES] = std::bind(&PeerNetwork::OnMethodStateNodes, this, std::placeholders::_1, std::placeholders::_2);
 		response_methods_[protocol::OVERLAY_MSGTYPE_HELLO] = std::bind(&PeerNetwork::OnMethodHelloResponse, this, std::placeholders::_1, std::placeholders::_2);
 		last_update_peercache_time_ = 0;
 	}
@@ -273,6 +275,20 @@ namespace bumo {
 		return true;
 	}
 
+	bool PeerNetwork::OnMethodGetStateNodes(protocol::WsMessage &message, int64_t conn_id) {
+		protocol::GetStateNodes get_nodes;
+		get_nodes.ParseFromString(message.data());
+		LedgerManager::Instance().OnRequestStateNodes(get_nodes, conn_id);
+		return true;
+	}
+
+	bool PeerNetwork::OnMethodStateNodes(protocol::WsMessage &message, int64_t conn_id) {
+		protocol::StateNodes nodes;
+		nodes.ParseFromString(message.data());
+		LedgerManager::Instance().OnReceiveStateNodes(nodes, conn_id);
+		return true;
+	}
+
 	bool PeerNetwork::OnMethodHelloResponse(protocol::WsMessage &message, int64_t conn_id) {
 		utils::MutexGuard guard(conns_list_lock_);
 		Peer *peer = (Peer *)GetConnection(conn_id);
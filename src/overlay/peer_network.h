@@ -77,6 +77,8 @@ namespace bumo {
 		bool OnMethodTransaction(protocol::WsMessage &message, int64_t conn_id);
 		bool OnMethodGetLedgers(protocol::WsMessage &message, int64_t conn_id);
 		bool OnMethodLedgers(protocol::WsMessage &message, int64_t conn_id);
+		bool OnMethodGetStateNodes(protocol::WsMessage &message, int64_t conn_id);
+		bool OnMethodStateNodes(protocol::WsMessage &message, int64_t conn_id);
 		bool OnMethodPbft(protocol::WsMessage &message, int64_t conn_id);
 		bool OnMethodLedgerUpNotify(protocol::WsMessage &message, int64_t conn_id);
 		bool OnMethodHelloResponse(protocol::WsMessage &message, int64_t conn_id);
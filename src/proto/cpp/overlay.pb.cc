@@ -40,6 +40,13 @@ const ::google::protobuf::Descriptor* Ledgers_descriptor_ = NULL;
 const ::google::protobuf::internal::GeneratedMessageReflection*
   Ledgers_reflection_ = NULL;
 const ::google::protobuf::EnumDescriptor* Ledgers_SyncCode_descriptor_ = NULL;
+const ::google::protobuf::Descriptor* GetStateNodes_descriptor_ = NULL;
+const ::google::protobuf::internal::GeneratedMessageReflection*
+  GetStateNodes_reflection_ = NULL;
+const ::google::protobuf::Descriptor* StateNodes_descriptor_ = NULL;
+const ::google::protobuf::internal::GeneratedMessageReflection*
+  StateNodes_reflection_ = NULL;
+const ::google::protobuf::EnumDescriptor* StateNodes_SyncCode_descriptor_ = NULL;
 const ::google::protobuf::Descriptor* DontHave_descriptor_ = NULL;
 const ::google::protobuf::internal::GeneratedMessageReflection*
   DontHave_reflection_ = NULL;
@@ -49,6 +56,13 @@ const ::google::protobuf::internal::GeneratedMessageReflection*
 const ::google::protobuf::Descriptor* EntryList_descriptor_ = NULL;
 const ::google::protobuf::internal::GeneratedMessageReflection*
   EntryList_reflection_ = NULL;
+const ::google::protobuf::Descriptor* StateSyncEntry_descriptor_ = NULL;
+const ::google::protobuf::internal::GeneratedMessageReflection*
+  StateSyncEntry_reflection_ = NULL;
+const ::google::protobuf::EnumDescriptor* StateSyncEntry_EntryType_descriptor_ = NULL;
+const ::google::protobuf::Descriptor* StateSyncStatus_descriptor_ = NULL;
+const ::google::protobuf::internal::GeneratedMessageReflection*
+  StateSyncStatus_reflection_ = NULL;
 const ::google::protobuf::Descriptor* ChainHello_descriptor_ = NULL;
 const ::google::protobuf::internal::GeneratedMessageReflection*
   ChainHello_reflection_ = NULL;
@@ -194,7 +208,47 @@ void protobuf_AssignDesc_overlay_2eproto() {
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Ledgers, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(Ledgers, _is_default_instance_));
   Ledgers_SyncCode_descriptor_ = Ledgers_descriptor_->enum_type(0);
-  DontHave_descriptor_ = file->message_type(6);
+  GetStateNodes_descriptor_ = file->message_type(6);
+  static const int GetStateNodes_offsets_[3] = {
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(GetStateNodes, ledger_seq_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(GetStateNodes, keys_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(GetStateNodes, chain_id_),
+  };
+  GetStateNodes_reflection_ =
+    ::google::protobuf::internal::GeneratedMessageReflection::NewGeneratedMessageReflection(
+      GetStateNodes_descriptor_,
+      GetStateNodes::default_instance_,
+      GetStateNodes_offsets_,
+      -1,
+      -1,
+      -1,
+      sizeof(GetStateNodes),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(GetStateNodes, _internal_metadata_),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(GetStateNodes, _is_default_instance_));
+  StateNodes_descriptor_ = file->message_type(7);
+  static const int StateNodes_offsets_[8] = {
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateNodes, sync_code_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateNodes, ledger_seq_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateNodes, ledger_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateNodes, next_value_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateNodes, next_proof_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateNodes, keys_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateNodes, values_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateNodes, chain_id_),
+  };
+  StateNodes_reflection_ =
+    ::google::protobuf::internal::GeneratedMessageReflection::NewGeneratedMessageReflection(
+      StateNodes_descriptor_,
+      StateNodes::default_instance_,
+      StateNodes_offsets_,
+      -1,
+      -1,
+      -1,
+      sizeof(StateNodes),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateNodes, _internal_metadata_),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateNodes, _is_default_instance_));
+  StateNodes_SyncCode_descriptor_ = StateNodes_descriptor_->enum_type(0);
+  DontHave_descriptor_ = file->message_type(8);
   static const int DontHave_offsets_[2] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DontHave, type_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DontHave, hash_),
@@ -210,7 +264,7 @@ void protobuf_AssignDesc_overlay_2eproto() {
       sizeof(DontHave),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DontHave, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(DontHave, _is_default_instance_));
-  LedgerUpgradeNotify_descriptor_ = file->message_type(7);
+  LedgerUpgradeNotify_descriptor_ = file->message_type(9);
   static const int LedgerUpgradeNotify_offsets_[3] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(LedgerUpgradeNotify, nonce_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(LedgerUpgradeNotify, upgrade_),
@@ -227,7 +281,7 @@ void protobuf_AssignDesc_overlay_2eproto() {
       sizeof(LedgerUpgradeNotify),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(LedgerUpgradeNotify, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(LedgerUpgradeNotify, _is_default_instance_));
-  EntryList_descriptor_ = file->message_type(8);
+  EntryList_descriptor_ = file->message_type(10);
   static const int EntryList_offsets_[1] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EntryList, entry_),
   };
@@ -242,7 +296,47 @@ void protobuf_AssignDesc_overlay_2eproto() {
       sizeof(EntryList),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EntryList, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(EntryList, _is_default_instance_));
-  ChainHello_descriptor_ = file->message_type(9);
+  StateSyncEntry_descriptor_ = file->message_type(11);
+  static const int StateSyncEntry_offsets_[4] = {
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateSyncEntry, type_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateSyncEntry, prefix_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateSyncEntry, location_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateSyncEntry, hash_),
+  };
+  StateSyncEntry_reflection_ =
+    ::google::protobuf::internal::GeneratedMessageReflection::NewGeneratedMessageReflection(
+      StateSyncEntry_descriptor_,
+      StateSyncEntry::default_instance_,
+      StateSyncEntry_offsets_,
+      -1,
+      -1,
+      -1,
+      sizeof(StateSyncEntry),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateSyncEntry, _internal_metadata_),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateSyncEntry, _is_default_instance_));
+  StateSyncEntry_EntryType_descriptor_ = StateSyncEntry_descriptor_->enum_type(0);
+  StateSyncStatus_descriptor_ = file->message_type(12);
+  static const int StateSyncStatus_offsets_[7] = {
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateSyncStatus, ledger_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateSyncStatus, proof_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateSyncStatus, account_root_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateSyncStatus, pending_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateSyncStatus, account_count_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateSyncStatus, node_count_),
+    GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateSyncStatus, committing_),
+  };
+  StateSyncStatus_reflection_ =
+    ::google::protobuf::internal::GeneratedMessageReflection::NewGeneratedMessageReflection(
+      StateSyncStatus_descriptor_,
+      StateSyncStatus::default_instance_,
+      StateSyncStatus_offsets_,
+      -1,
+      -1,
+      -1,
+      sizeof(StateSyncStatus),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateSyncStatus, _internal_metadata_),
+      GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(StateSyncStatus, _is_default_instance_));
+  ChainHello_descriptor_ = file->message_type(13);
   static const int ChainHello_offsets_[2] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainHello, api_list_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainHello, timestamp_),
@@ -258,7 +352,7 @@ void protobuf_AssignDesc_overlay_2eproto() {
       sizeof(ChainHello),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainHello, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainHello, _is_default_instance_));
-  ChainStatus_descriptor_ = file->message_type(10);
+  ChainStatus_descriptor_ = file->message_type(14);
   static const int ChainStatus_offsets_[5] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainStatus, self_addr_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainStatus, ledger_version_),
@@ -277,7 +371,7 @@ void protobuf_AssignDesc_overlay_2eproto() {
       sizeof(ChainStatus),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainStatus, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainStatus, _is_default_instance_));
-  ChainPeerMessage_descriptor_ = file->message_type(11);
+  ChainPeerMessage_descriptor_ = file->message_type(15);
   static const int ChainPeerMessage_offsets_[3] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainPeerMessage, src_peer_addr_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainPeerMessage, des_peer_addrs_),
@@ -294,7 +388,7 @@ void protobuf_AssignDesc_overlay_2eproto() {
       sizeof(ChainPeerMessage),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainPeerMessage, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainPeerMessage, _is_default_instance_));
-  ChainSubscribeTx_descriptor_ = file->message_type(12);
+  ChainSubscribeTx_descriptor_ = file->message_type(16);
   static const int ChainSubscribeTx_offsets_[1] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainSubscribeTx, address_),
   };
@@ -309,7 +403,7 @@ void protobuf_AssignDesc_overlay_2eproto() {
       sizeof(ChainSubscribeTx),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainSubscribeTx, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainSubscribeTx, _is_default_instance_));
-  ChainResponse_descriptor_ = file->message_type(13);
+  ChainResponse_descriptor_ = file->message_type(17);
   static const int ChainResponse_offsets_[2] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainResponse, error_code_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainResponse, error_desc_),
@@ -325,7 +419,7 @@ void protobuf_AssignDesc_overlay_2eproto() {
       sizeof(ChainResponse),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainResponse, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainResponse, _is_default_instance_));
-  ChainTxStatus_descriptor_ = file->message_type(14);
+  ChainTxStatus_descriptor_ = file->message_type(18);
   static const int ChainTxStatus_offsets_[9] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainTxStatus, status_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainTxStatus, tx_hash_),
@@ -349,7 +443,7 @@ void protobuf_AssignDesc_overlay_2eproto() {
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainTxStatus, _internal_metadata_),
       GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainTxStatus, _is_default_instance_));
   ChainTxStatus_TxStatus_descriptor_ = ChainTxStatus_descriptor_->enum_type(0);
-  ChainInfoMessage_descriptor_ = file->message_type(15);
+  ChainInfoMessage_descriptor_ = file->message_type(19);
   static const int ChainInfoMessage_offsets_[2] = {
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainInfoMessage, seq_),
     GOOGLE_PROTOBUF_GENERATED_MESSAGE_FIELD_OFFSET(ChainInfoMessage, address_),
@@ -392,12 +486,20 @@ void protobuf_RegisterTypes(const ::std::string&) {
       GetLedgers_descriptor_, &GetLedgers::default_instance());
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
       Ledgers_descriptor_, &Ledgers::default_instance());
+  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
+      GetStateNodes_descriptor_, &GetStateNodes::default_instance());
+  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
+      StateNodes_descriptor_, &StateNodes::default_instance());
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
       DontHave_descriptor_, &DontHave::default_instance());
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
       LedgerUpgradeNotify_descriptor_, &LedgerUpgradeNotify::default_instance());
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
       EntryList_descriptor_, &EntryList::default_instance());
+  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
+      StateSyncEntry_descriptor_, &StateSyncEntry::default_instance());
+  ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
+      StateSyncStatus_descriptor_, &StateSyncStatus::default_instance());
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
       ChainHello_descriptor_, &ChainHello::default_instance());
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedMessage(
@@ -429,12 +531,20 @@ void protobuf_ShutdownFile_overlay_2eproto() {
   delete GetLedgers_reflection_;
   delete Ledgers::default_instance_;
   delete Ledgers_reflection_;
+  delete GetStateNodes::default_instance_;
+  delete GetStateNodes_reflection_;
+  delete StateNodes::default_instance_;
+  delete StateNodes_reflection_;
   delete DontHave::default_instance_;
   delete DontHave_reflection_;
   delete LedgerUpgradeNotify::default_instance_;
   delete LedgerUpgradeNotify_reflection_;
   delete EntryList::default_instance_;
   delete EntryList_reflection_;
+  delete StateSyncEntry::default_instance_;
+  delete StateSyncEntry_reflection_;
+  delete StateSyncStatus::default_instance_;
+  delete StateSyncStatus_reflection_;
   delete ChainHello::default_instance_;
   delete ChainHello_reflection_;
   delete ChainStatus::default_instance_;
@@ -474,51 +584,71 @@ void protobuf_AddDesc_overlay_2eproto() {
     "\022\025\n\rconnection_id\030\006 \001(\003\"&\n\005Peers\022\035\n\005peer"
     "s\030\001 \003(\0132\016.protocol.Peer\"M\n\nGetLedgers\022\r\n"
     "\005begin\030\001 \001(\003\022\013\n\003end\030\002 \001(\003\022\021\n\ttimestamp\030\003"
-    " \001(\003\022\020\n\010chain_id\030\004 \001(\003\"\361\001\n\007Ledgers\022(\n\006va"
+    " \001(\003\022\020\n\010chain_id\030\004 \001(\003\"\375\001\n\007Ledgers\022(\n\006va"
     "lues\030\001 \003(\0132\030.protocol.ConsensusValue\022-\n\t"
     "sync_code\030\002 \001(\0162\032.protocol.Ledgers.SyncC"
     "ode\022\017\n\007max_seq\030\003 \001(\003\022\r\n\005proof\030\004 \001(\014\022\020\n\010c"
-    "hain_id\030\005 \001(\003\"[\n\010SyncCode\022\006\n\002OK\020\000\022\017\n\013OUT"
+    "hain_id\030\005 \001(\003\"g\n\010SyncCode\022\006\n\002OK\020\000\022\017\n\013OUT"
     "_OF_SYNC\020\001\022\022\n\016OUT_OF_LEDGERS\020\002\022\010\n\004BUSY\020\003"
-    "\022\n\n\006REFUSE\020\004\022\014\n\010INTERNAL\020\005\"&\n\010DontHave\022\014"
-    "\n\004type\030\001 \001(\003\022\014\n\004hash\030\002 \001(\014\"v\n\023LedgerUpgr"
-    "adeNotify\022\r\n\005nonce\030\001 \001(\003\022(\n\007upgrade\030\002 \001("
-    "\0132\027.protocol.LedgerUpgrade\022&\n\tsignature\030"
-    "\003 \001(\0132\023.protocol.Signature\"\032\n\tEntryList\022"
-    "\r\n\005entry\030\001 \003(\014\"M\n\nChainHello\022,\n\010api_list"
-    "\030\001 \003(\0162\032.protocol.ChainMessageType\022\021\n\tti"
-    "mestamp\030\002 \001(\003\"z\n\013ChainStatus\022\021\n\tself_add"
-    "r\030\001 \001(\t\022\026\n\016ledger_version\030\002 \001(\003\022\027\n\017monit"
-    "or_version\030\003 \001(\003\022\024\n\014bumo_version\030\004 \001(\t\022\021"
-    "\n\ttimestamp\030\005 \001(\003\"O\n\020ChainPeerMessage\022\025\n"
-    "\rsrc_peer_addr\030\001 \001(\t\022\026\n\016des_peer_addrs\030\002"
-    " \003(\t\022\014\n\004data\030\003 \001(\014\"#\n\020ChainSubscribeTx\022\017"
-    "\n\007address\030\001 \003(\t\"7\n\rChainResponse\022\022\n\nerro"
-    "r_code\030\001 \001(\005\022\022\n\nerror_desc\030\002 \001(\t\"\325\002\n\rCha"
-    "inTxStatus\0220\n\006status\030\001 \001(\0162 .protocol.Ch"
-    "ainTxStatus.TxStatus\022\017\n\007tx_hash\030\002 \001(\t\022\026\n"
-    "\016source_address\030\003 \001(\t\022\032\n\022source_account_"
-    "seq\030\004 \001(\003\022\022\n\nledger_seq\030\005 \001(\003\022\027\n\017new_acc"
-    "ount_seq\030\006 \001(\003\022\'\n\nerror_code\030\007 \001(\0162\023.pro"
-    "tocol.ERRORCODE\022\022\n\nerror_desc\030\010 \001(\t\022\021\n\tt"
-    "imestamp\030\t \001(\003\"P\n\010TxStatus\022\r\n\tUNDEFINED\020"
-    "\000\022\r\n\tCONFIRMED\020\001\022\013\n\007PENDING\020\002\022\014\n\010COMPLET"
-    "E\020\003\022\013\n\007FAILURE\020\004\"0\n\020ChainInfoMessage\022\013\n\003"
-    "seq\030\001 \001(\003\022\017\n\007address\030\002 \001(\t*\203\002\n\024OVERLAY_M"
-    "ESSAGE_TYPE\022\030\n\024OVERLAY_MSGTYPE_NONE\020\000\022\030\n"
-    "\024OVERLAY_MSGTYPE_PING\020\001\022\031\n\025OVERLAY_MSGTY"
-    "PE_HELLO\020\002\022\031\n\025OVERLAY_MSGTYPE_PEERS\020\003\022\037\n"
-    "\033OVERLAY_MSGTYPE_TRANSACTION\020\004\022\033\n\027OVERLA"
-    "Y_MSGTYPE_LEDGERS\020\005\022\030\n\024OVERLAY_MSGTYPE_P"
-    "BFT\020\006\022)\n%OVERLAY_MSGTYPE_LEDGER_UPGRADE_"
-    "NOTIFY\020\007*\372\001\n\020ChainMessageType\022\023\n\017CHAIN_T"
-    "YPE_NONE\020\000\022\017\n\013CHAIN_HELLO\020\n\022\023\n\017CHAIN_TX_"
-    "STATUS\020\013\022\025\n\021CHAIN_PEER_ONLINE\020\014\022\026\n\022CHAIN"
-    "_PEER_OFFLINE\020\r\022\026\n\022CHAIN_PEER_MESSAGE\020\016\022"
-    "\033\n\027CHAIN_SUBMITTRANSACTION\020\017\022\027\n\023CHAIN_LE"
-    "DGER_HEADER\020\020\022\026\n\022CHAIN_SUBSCRIBE_TX\020\021\022\026\n"
-    "\022CHAIN_TX_ENV_STORE\020\022B\"\n io.bumo.sdk.cor"
-    "e.extend.protobufb\006proto3", 2305);
+    "\022\n\n\006REFUSE\020\004\022\014\n\010INTERNAL\020\005\022\n\n\006PRUNED\020\006\"C"
+    "\n\rGetStateNodes\022\022\n\nledger_seq\030\001 \001(\003\022\014\n\004k"
+    "eys\030\002 \003(\014\022\020\n\010chain_id\030\003 \001(\003\"\266\002\n\nStateNod"
+    "es\0220\n\tsync_code\030\001 \001(\0162\035.protocol.StateNo"
+    "des.SyncCode\022\022\n\nledger_seq\030\002 \001(\003\022 \n\006ledg"
+    "er\030\003 \001(\0132\020.protocol.Ledger\022,\n\nnext_value"
+    "\030\004 \001(\0132\030.protocol.ConsensusValue\022\022\n\nnext"
+    "_proof\030\005 \001(\014\022\014\n\004keys\030\006 \003(\014\022\016\n\006values\030\007 \003"
+    "(\014\022\020\n\010chain_id\030\010 \001(\003\"N\n\010SyncCode\022\006\n\002OK\020\000"
+    "\022\r\n\tNOT_READY\020\001\022\013\n\007EXPIRED\020\002\022\020\n\014OUT_OF_N"
+    "ODES\020\003\022\014\n\010INTERNAL\020\004\"&\n\010DontHave\022\014\n\004type"
+    "\030\001 \001(\003\022\014\n\004hash\030\002 \001(\014\"v\n\023LedgerUpgradeNot"
+    "ify\022\r\n\005nonce\030\001 \001(\003\022(\n\007upgrade\030\002 \001(\0132\027.pr"
+    "otocol.LedgerUpgrade\022&\n\tsignature\030\003 \001(\0132"
+    "\023.protocol.Signature\"\032\n\tEntryList\022\r\n\005ent"
+    "ry\030\001 \003(\014\"\254\001\n\016StateSyncEntry\0220\n\004type\030\001 \001("
+    "\0162\".protocol.StateSyncEntry.EntryType\022\016\n"
+    "\006prefix\030\002 \001(\014\022\020\n\010location\030\003 \001(\014\022\014\n\004hash\030"
+    "\004 \001(\014\"8\n\tEntryType\022\t\n\005INNER\020\000\022\013\n\007ACCOUNT"
+    "\020\001\022\010\n\004LEAF\020\002\022\t\n\005VALUE\020\003\"\302\001\n\017StateSyncSta"
+    "tus\022 \n\006ledger\030\001 \001(\0132\020.protocol.Ledger\022\r\n"
+    "\005proof\030\002 \001(\014\022\024\n\014account_root\030\003 \001(\014\022)\n\007pe"
+    "nding\030\004 \003(\0132\030.protocol.StateSyncEntry\022\025\n"
+    "\raccount_count\030\005 \001(\003\022\022\n\nnode_count\030\006 \001(\003"
+    "\022\022\n\ncommitting\030\007 \001(\010\"M\n\nChainHello\022,\n\010ap"
+    "i_list\030\001 \003(\0162\032.protocol.ChainMessageType"
+    "\022\021\n\ttimestamp\030\002 \001(\003\"z\n\013ChainStatus\022\021\n\tse"
+    "lf_addr\030\001 \001(\t\022\026\n\016ledger_version\030\002 \001(\003\022\027\n"
+    "\017monitor_version\030\003 \001(\003\022\024\n\014bumo_version\030\004"
+    " \001(\t\022\021\n\ttimestamp\030\005 \001(\003\"O\n\020ChainPeerMess"
+    "age\022\025\n\rsrc_peer_addr\030\001 \001(\t\022\026\n\016des_peer_a"
+    "ddrs\030\002 \003(\t\022\014\n\004data\030\003 \001(\014\"#\n\020ChainSubscri"
+    "beTx\022\017\n\007address\030\001 \003(\t\"7\n\rChainResponse\022\022"
+    "\n\nerror_code\030\001 \001(\005\022\022\n\nerror_desc\030\002 \001(\t\"\325"
+    "\002\n\rChainTxStatus\0220\n\006status\030\001 \001(\0162 .proto"
+    "col.ChainTxStatus.TxStatus\022\017\n\007tx_hash\030\002 "
+    "\001(\t\022\026\n\016source_address\030\003 \001(\t\022\032\n\022source_ac"
+    "count_seq\030\004 \001(\003\022\022\n\nledger_seq\030\005 \001(\003\022\027\n\017n"
+    "ew_account_seq\030\006 \001(\003\022\'\n\nerror_code\030\007 \001(\016"
+    "2\023.protocol.ERRORCODE\022\022\n\nerror_desc\030\010 \001("
+    "\t\022\021\n\ttimestamp\030\t \001(\003\"P\n\010TxStatus\022\r\n\tUNDE"
+    "FINED\020\000\022\r\n\tCONFIRMED\020\001\022\013\n\007PENDING\020\002\022\014\n\010C"
+    "OMPLETE\020\003\022\013\n\007FAILURE\020\004\"0\n\020ChainInfoMessa"
+    "ge\022\013\n\003seq\030\001 \001(\003\022\017\n\007address\030\002 \001(\t*\244\002\n\024OVE"
+    "RLAY_MESSAGE_TYPE\022\030\n\024OVERLAY_MSGTYPE_NON"
+    "E\020\000\022\030\n\024OVERLAY_MSGTYPE_PING\020\001\022\031\n\025OVERLAY"
+    "_MSGTYPE_HELLO\020\002\022\031\n\025OVERLAY_MSGTYPE_PEER"
+    "S\020\003\022\037\n\033OVERLAY_MSGTYPE_TRANSACTION\020\004\022\033\n\027"
+    "OVERLAY_MSGTYPE_LEDGERS\020\005\022\030\n\024OVERLAY_MSG"
+    "TYPE_PBFT\020\006\022)\n%OVERLAY_MSGTYPE_LEDGER_UP"
+    "GRADE_NOTIFY\020\007\022\037\n\033OVERLAY_MSGTYPE_STATE_"
+    "NODES\020\010*\372\001\n\020ChainMessageType\022\023\n\017CHAIN_TY"
+    "PE_NONE\020\000\022\017\n\013CHAIN_HELLO\020\n\022\023\n\017CHAIN_TX_S"
+    "TATUS\020\013\022\025\n\021CHAIN_PEER_ONLINE\020\014\022\026\n\022CHAIN_"
+    "PEER_OFFLINE\020\r\022\026\n\022CHAIN_PEER_MESSAGE\020\016\022\033"
+    "\n\027CHAIN_SUBMITTRANSACTION\020\017\022\027\n\023CHAIN_LED"
+    "GER_HEADER\020\020\022\026\n\022CHAIN_SUBSCRIBE_TX\020\021\022\026\n\022"
+    "CHAIN_TX_ENV_STORE\020\022B\"\n io.bumo.sdk.core"
+    ".extend.protobufb\006proto3", 3104);
   ::google::protobuf::MessageFactory::InternalRegisterGeneratedFile(
     "overlay.proto", &protobuf_RegisterTypes);
   Hello::default_instance_ = new Hello();
@@ -527,9 +657,13 @@ void protobuf_AddDesc_overlay_2eproto() {
   Peers::default_instance_ = new Peers();
   GetLedgers::default_instance_ = new GetLedgers();
   Ledgers::default_instance_ = new Ledgers();
+  GetStateNodes::default_instance_ = new GetStateNodes();
+  StateNodes::default_instance_ = new StateNodes();
   DontHave::default_instance_ = new DontHave();
   LedgerUpgradeNotify::default_instance_ = new LedgerUpgradeNotify();
   EntryList::default_instance_ = new EntryList();
+  StateSyncEntry::default_instance_ = new StateSyncEntry();
+  StateSyncStatus::default_instance_ = new StateSyncStatus();
   ChainHello::default_instance_ = new ChainHello();
   ChainStatus::default_instance_ = new ChainStatus();
   ChainPeerMessage::default_instance_ = new ChainPeerMessage();
@@ -543,9 +677,13 @@ void protobuf_AddDesc_overlay_2eproto() {
   Peers::default_instance_->InitAsDefaultInstance();
   GetLedgers::default_instance_->InitAsDefaultInstance();
   Ledgers::default_instance_->InitAsDefaultInstance();
+  GetStateNodes::default_instance_->InitAsDefaultInstance();
+  StateNodes::default_instance_->InitAsDefaultInstance();
   DontHave::default_instance_->InitAsDefaultInstance();
   LedgerUpgradeNotify::default_instance_->InitAsDefaultInstance();
   EntryList::default_instance_->InitAsDefaultInstance();
+  StateSyncEntry::default_instance_->InitAsDefaultInstance();
+  StateSyncStatus::default_instance_->InitAsDefaultInstance();
   ChainHello::default_instance_->InitAsDefaultInstance();
   ChainStatus::default_instance_->InitAsDefaultInstance();
   ChainPeerMessage::default_instance_->InitAsDefaultInstance();
@@ -576,6 +714,7 @@ bool OVERLAY_MESSAGE_TYPE_IsValid(int value) {
     case 5:
     case 6:
     case 7:
+    case 8:
       return true;
     default:
       return false;
@@ -2904,6 +3043,7 @@ bool Ledgers_SyncCode_IsValid(int value) {
     case 3:
     case 4:
     case 5:
+    case 6:
       return true;
     default:
       return false;
@@ -2917,6 +3057,7 @@ const Ledgers_SyncCode Ledgers::OUT_OF_LEDGERS;
 const Ledgers_SyncCode Ledgers::BUSY;
 const Ledgers_SyncCode Ledgers::REFUSE;
 const Ledgers_SyncCode Ledgers::INTERNAL;
+const Ledgers_SyncCode Ledgers::PRUNED;
 const Ledgers_SyncCode Ledgers::SyncCode_MIN;
 const Ledgers_SyncCode Ledgers::SyncCode_MAX;
 const int Ledgers::SyncCode_ARRAYSIZE;
@@ -3446,108 +3587,125 @@ void Ledgers::clear_chain_id() {
 // ===================================================================
 
 #if !defined(_MSC_VER) || _MSC_VER >= 1900
-const int DontHave::kTypeFieldNumber;
-const int DontHave::kHashFieldNumber;
+const int GetStateNodes::kLedgerSeqFieldNumber;
+const int GetStateNodes::kKeysFieldNumber;
+const int GetStateNodes::kChainIdFieldNumber;
 #endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
 
-DontHave::DontHave()
+GetStateNodes::GetStateNodes()
   : ::google::protobuf::Message(), _internal_metadata_(NULL) {
   SharedCtor();
-  // @@protoc_insertion_point(constructor:protocol.DontHave)
+  // @@protoc_insertion_point(constructor:protocol.GetStateNodes)
 }
 
-void DontHave::InitAsDefaultInstance() {
+void GetStateNodes::InitAsDefaultInstance() {
   _is_default_instance_ = true;
 }
 
-DontHave::DontHave(const DontHave& from)
+GetStateNodes::GetStateNodes(const GetStateNodes& from)
   : ::google::protobuf::Message(),
     _internal_metadata_(NULL) {
   SharedCtor();
   MergeFrom(from);
-  // @@protoc_insertion_point(copy_constructor:protocol.DontHave)
+  // @@protoc_insertion_point(copy_constructor:protocol.GetStateNodes)
 }
 
-void DontHave::SharedCtor() {
+void GetStateNodes::SharedCtor() {
     _is_default_instance_ = false;
   ::google::protobuf::internal::GetEmptyString();
   _cached_size_ = 0;
-  type_ = GOOGLE_LONGLONG(0);
-  hash_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  ledger_seq_ = GOOGLE_LONGLONG(0);
+  chain_id_ = GOOGLE_LONGLONG(0);
 }
 
-DontHave::~DontHave() {
-  // @@protoc_insertion_point(destructor:protocol.DontHave)
+GetStateNodes::~GetStateNodes() {
+  // @@protoc_insertion_point(destructor:protocol.GetStateNodes)
   SharedDtor();
 }
 
-void DontHave::SharedDtor() {
-  hash_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+void GetStateNodes::SharedDtor() {
   if (this != default_instance_) {
   }
 }
 
-void DontHave::SetCachedSize(int size) const {
+void GetStateNodes::SetCachedSize(int size) const {
   GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
   _cached_size_ = size;
   GOOGLE_SAFE_CONCURRENT_WRITES_END();
 }
-const ::google::protobuf::Descriptor* DontHave::descriptor() {
+const ::google::protobuf::Descriptor* GetStateNodes::descriptor() {
   protobuf_AssignDescriptorsOnce();
-  return DontHave_descriptor_;
+  return GetStateNodes_descriptor_;
 }
 
-const DontHave& DontHave::default_instance() {
+const GetStateNodes& GetStateNodes::default_instance() {
   if (default_instance_ == NULL) protobuf_AddDesc_overlay_2eproto();
   return *default_instance_;
 }
 
-DontHave* DontHave::default_instance_ = NULL;
+GetStateNodes* GetStateNodes::default_instance_ = NULL;
 
-DontHave* DontHave::New(::google::protobuf::Arena* arena) const {
-  DontHave* n = new DontHave;
+GetStateNodes* GetStateNodes::New(::google::protobuf::Arena* arena) const {
+  GetStateNodes* n = new GetStateNodes;
   if (arena != NULL) {
     arena->Own(n);
   }
   return n;
 }
 
-void DontHave::Clear() {
-// @@protoc_insertion_point(message_clear_start:protocol.DontHave)
-  type_ = GOOGLE_LONGLONG(0);
-  hash_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+void GetStateNodes::Clear() {
+// @@protoc_insertion_point(message_clear_start:protocol.GetStateNodes)
+  ledger_seq_ = GOOGLE_LONGLONG(0);
+  chain_id_ = GOOGLE_LONGLONG(0);
+  keys_.Clear();
 }
 
-bool DontHave::MergePartialFromCodedStream(
+bool GetStateNodes::MergePartialFromCodedStream(
     ::google::protobuf::io::CodedInputStream* input) {
 #define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
   ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:protocol.DontHave)
+  // @@protoc_insertion_point(parse_start:protocol.GetStateNodes)
   for (;;) {
     ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
     tag = p.first;
     if (!p.second) goto handle_unusual;
     switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
-      // optional int64 type = 1;
+      // optional int64 ledger_seq = 1;
       case 1: {
         if (tag == 8) {
           DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
                    ::google::protobuf::int64, ::google::protobuf::internal::WireFormatLite::TYPE_INT64>(
-                 input, &type_)));
+                 input, &ledger_seq_)));
 
         } else {
           goto handle_unusual;
         }
-        if (input->ExpectTag(18)) goto parse_hash;
+        if (input->ExpectTag(18)) goto parse_keys;
         break;
       }
 
-      // optional bytes hash = 2;
+      // repeated bytes keys = 2;
       case 2: {
         if (tag == 18) {
-         parse_hash:
+         parse_keys:
           DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
-                input, this->mutable_hash()));
+                input, this->add_keys()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(18)) goto parse_keys;
+        if (input->ExpectTag(24)) goto parse_chain_id;
+        break;
+      }
+
+      // optional int64 chain_id = 3;
+      case 3: {
+        if (tag == 24) {
+         parse_chain_id:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::int64, ::google::protobuf::internal::WireFormatLite::TYPE_INT64>(
+                 input, &chain_id_)));
+
         } else {
           goto handle_unusual;
         }
@@ -3568,66 +3726,82 @@ bool DontHave::MergePartialFromCodedStream(
     }
   }
 success:
-  // @@protoc_insertion_point(parse_success:protocol.DontHave)
+  // @@protoc_insertion_point(parse_success:protocol.GetStateNodes)
   return true;
 failure:
-  // @@protoc_insertion_point(parse_failure:protocol.DontHave)
+  // @@protoc_insertion_point(parse_failure:protocol.GetStateNodes)
   return false;
 #undef DO_
 }
 
-void DontHave::SerializeWithCachedSizes(
+void GetStateNodes::SerializeWithCachedSizes(
     ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:protocol.DontHave)
-  // optional int64 type = 1;
-  if (this->type() != 0) {
-    ::google::protobuf::internal::WireFormatLite::WriteInt64(1, this->type(), output);
+  // @@protoc_insertion_point(serialize_start:protocol.GetStateNodes)
+  // optional int64 ledger_seq = 1;
+  if (this->ledger_seq() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt64(1, this->ledger_seq(), output);
   }
 
-  // optional bytes hash = 2;
-  if (this->hash().size() > 0) {
-    ::google::protobuf::internal::WireFormatLite::WriteBytesMaybeAliased(
-      2, this->hash(), output);
+  // repeated bytes keys = 2;
+  for (int i = 0; i < this->keys_size(); i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytes(
+      2, this->keys(i), output);
   }
 
-  // @@protoc_insertion_point(serialize_end:protocol.DontHave)
+  // optional int64 chain_id = 3;
+  if (this->chain_id() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt64(3, this->chain_id(), output);
+  }
+
+  // @@protoc_insertion_point(serialize_end:protocol.GetStateNodes)
 }
 
-::google::protobuf::uint8* DontHave::InternalSerializeWithCachedSizesToArray(
+::google::protobuf::uint8* GetStateNodes::InternalSerializeWithCachedSizesToArray(
     bool deterministic, ::google::protobuf::uint8* target) const {
-  // @@protoc_insertion_point(serialize_to_array_start:protocol.DontHave)
-  // optional int64 type = 1;
-  if (this->type() != 0) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteInt64ToArray(1, this->type(), target);
+  // @@protoc_insertion_point(serialize_to_array_start:protocol.GetStateNodes)
+  // optional int64 ledger_seq = 1;
+  if (this->ledger_seq() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteInt64ToArray(1, this->ledger_seq(), target);
   }
 
-  // optional bytes hash = 2;
-  if (this->hash().size() > 0) {
-    target =
-      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
-        2, this->hash(), target);
+  // repeated bytes keys = 2;
+  for (int i = 0; i < this->keys_size(); i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteBytesToArray(2, this->keys(i), target);
   }
 
-  // @@protoc_insertion_point(serialize_to_array_end:protocol.DontHave)
+  // optional int64 chain_id = 3;
+  if (this->chain_id() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteInt64ToArray(3, this->chain_id(), target);
+  }
+
+  // @@protoc_insertion_point(serialize_to_array_end:protocol.GetStateNodes)
   return target;
 }
 
-int DontHave::ByteSize() const {
-// @@protoc_insertion_point(message_byte_size_start:protocol.DontHave)
+int GetStateNodes::ByteSize() const {
+// @@protoc_insertion_point(message_byte_size_start:protocol.GetStateNodes)
   int total_size = 0;
 
-  // optional int64 type = 1;
-  if (this->type() != 0) {
+  // optional int64 ledger_seq = 1;
+  if (this->ledger_seq() != 0) {
     total_size += 1 +
       ::google::protobuf::internal::WireFormatLite::Int64Size(
-        this->type());
+        this->ledger_seq());
   }
 
-  // optional bytes hash = 2;
-  if (this->hash().size() > 0) {
+  // optional int64 chain_id = 3;
+  if (this->chain_id() != 0) {
     total_size += 1 +
-      ::google::protobuf::internal::WireFormatLite::BytesSize(
-        this->hash());
+      ::google::protobuf::internal::WireFormatLite::Int64Size(
+        this->chain_id());
+  }
+
+  // repeated bytes keys = 2;
+  total_size += 1 * this->keys_size();
+  for (int i = 0; i < this->keys_size(); i++) {
+    total_size += ::google::protobuf::internal::WireFormatLite::BytesSize(
+      this->keys(i));
   }
 
   GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
@@ -3636,263 +3810,422 @@ int DontHave::ByteSize() const {
   return total_size;
 }
 
-void DontHave::MergeFrom(const ::google::protobuf::Message& from) {
-// @@protoc_insertion_point(generalized_merge_from_start:protocol.DontHave)
+void GetStateNodes::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:protocol.GetStateNodes)
   if (GOOGLE_PREDICT_FALSE(&from == this)) {
     ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
   }
-  const DontHave* source = 
-      ::google::protobuf::internal::DynamicCastToGenerated<const DontHave>(
+  const GetStateNodes* source = 
+      ::google::protobuf::internal::DynamicCastToGenerated<const GetStateNodes>(
           &from);
   if (source == NULL) {
-  // @@protoc_insertion_point(generalized_merge_from_cast_fail:protocol.DontHave)
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:protocol.GetStateNodes)
     ::google::protobuf::internal::ReflectionOps::Merge(from, this);
   } else {
-  // @@protoc_insertion_point(generalized_merge_from_cast_success:protocol.DontHave)
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:protocol.GetStateNodes)
     MergeFrom(*source);
   }
 }
 
-void DontHave::MergeFrom(const DontHave& from) {
-// @@protoc_insertion_point(class_specific_merge_from_start:protocol.DontHave)
+void GetStateNodes::MergeFrom(const GetStateNodes& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:protocol.GetStateNodes)
   if (GOOGLE_PREDICT_FALSE(&from == this)) {
     ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
   }
-  if (from.type() != 0) {
-    set_type(from.type());
+  keys_.MergeFrom(from.keys_);
+  if (from.ledger_seq() != 0) {
+    set_ledger_seq(from.ledger_seq());
   }
-  if (from.hash().size() > 0) {
-
-    hash_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.hash_);
+  if (from.chain_id() != 0) {
+    set_chain_id(from.chain_id());
   }
 }
 
-void DontHave::CopyFrom(const ::google::protobuf::Message& from) {
-// @@protoc_insertion_point(generalized_copy_from_start:protocol.DontHave)
+void GetStateNodes::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:protocol.GetStateNodes)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
-void DontHave::CopyFrom(const DontHave& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:protocol.DontHave)
+void GetStateNodes::CopyFrom(const GetStateNodes& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:protocol.GetStateNodes)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
-bool DontHave::IsInitialized() const {
+bool GetStateNodes::IsInitialized() const {
 
   return true;
 }
 
-void DontHave::Swap(DontHave* other) {
+void GetStateNodes::Swap(GetStateNodes* other) {
   if (other == this) return;
   InternalSwap(other);
 }
-void DontHave::InternalSwap(DontHave* other) {
-  std::swap(type_, other->type_);
-  hash_.Swap(&other->hash_);
+void GetStateNodes::InternalSwap(GetStateNodes* other) {
+  std::swap(ledger_seq_, other->ledger_seq_);
+  keys_.UnsafeArenaSwap(&other->keys_);
+  std::swap(chain_id_, other->chain_id_);
   _internal_metadata_.Swap(&other->_internal_metadata_);
   std::swap(_cached_size_, other->_cached_size_);
 }
 
-::google::protobuf::Metadata DontHave::GetMetadata() const {
+::google::protobuf::Metadata GetStateNodes::GetMetadata() const {
   protobuf_AssignDescriptorsOnce();
   ::google::protobuf::Metadata metadata;
-  metadata.descriptor = DontHave_descriptor_;
-  metadata.reflection = DontHave_reflection_;
+  metadata.descriptor = GetStateNodes_descriptor_;
+  metadata.reflection = GetStateNodes_reflection_;
   return metadata;
 }
 
 #if PROTOBUF_INLINE_NOT_IN_HEADERS
-// DontHave
+// GetStateNodes
 
-// optional int64 type = 1;
-void DontHave::clear_type() {
-  type_ = GOOGLE_LONGLONG(0);
+// optional int64 ledger_seq = 1;
+void GetStateNodes::clear_ledger_seq() {
+  ledger_seq_ = GOOGLE_LONGLONG(0);
 }
- ::google::protobuf::int64 DontHave::type() const {
-  // @@protoc_insertion_point(field_get:protocol.DontHave.type)
-  return type_;
+ ::google::protobuf::int64 GetStateNodes::ledger_seq() const {
+  // @@protoc_insertion_point(field_get:protocol.GetStateNodes.ledger_seq)
+  return ledger_seq_;
 }
- void DontHave::set_type(::google::protobuf::int64 value) {
+ void GetStateNodes::set_ledger_seq(::google::protobuf::int64 value) {
   
-  type_ = value;
-  // @@protoc_insertion_point(field_set:protocol.DontHave.type)
+  ledger_seq_ = value;
+  // @@protoc_insertion_point(field_set:protocol.GetStateNodes.ledger_seq)
 }
 
-// optional bytes hash = 2;
-void DontHave::clear_hash() {
-  hash_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+// repeated bytes keys = 2;
+int GetStateNodes::keys_size() const {
+  return keys_.size();
 }
- const ::std::string& DontHave::hash() const {
-  // @@protoc_insertion_point(field_get:protocol.DontHave.hash)
-  return hash_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+void GetStateNodes::clear_keys() {
+  keys_.Clear();
 }
- void DontHave::set_hash(const ::std::string& value) {
-  
-  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
-  // @@protoc_insertion_point(field_set:protocol.DontHave.hash)
+ const ::std::string& GetStateNodes::keys(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.GetStateNodes.keys)
+  return keys_.Get(index);
 }
- void DontHave::set_hash(const char* value) {
-  
-  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
-  // @@protoc_insertion_point(field_set_char:protocol.DontHave.hash)
+ ::std::string* GetStateNodes::mutable_keys(int index) {
+  // @@protoc_insertion_point(field_mutable:protocol.GetStateNodes.keys)
+  return keys_.Mutable(index);
 }
- void DontHave::set_hash(const void* value, size_t size) {
-  
-  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
-      ::std::string(reinterpret_cast<const char*>(value), size));
-  // @@protoc_insertion_point(field_set_pointer:protocol.DontHave.hash)
+ void GetStateNodes::set_keys(int index, const ::std::string& value) {
+  // @@protoc_insertion_point(field_set:protocol.GetStateNodes.keys)
+  keys_.Mutable(index)->assign(value);
 }
- ::std::string* DontHave::mutable_hash() {
-  
-  // @@protoc_insertion_point(field_mutable:protocol.DontHave.hash)
-  return hash_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+ void GetStateNodes::set_keys(int index, const char* value) {
+  keys_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:protocol.GetStateNodes.keys)
 }
- ::std::string* DontHave::release_hash() {
-  // @@protoc_insertion_point(field_release:protocol.DontHave.hash)
-  
-  return hash_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+ void GetStateNodes::set_keys(int index, const void* value, size_t size) {
+  keys_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:protocol.GetStateNodes.keys)
 }
- void DontHave::set_allocated_hash(::std::string* hash) {
-  if (hash != NULL) {
-    
-  } else {
-    
-  }
-  hash_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), hash);
-  // @@protoc_insertion_point(field_set_allocated:protocol.DontHave.hash)
+ ::std::string* GetStateNodes::add_keys() {
+  // @@protoc_insertion_point(field_add_mutable:protocol.GetStateNodes.keys)
+  return keys_.Add();
+}
+ void GetStateNodes::add_keys(const ::std::string& value) {
+  keys_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:protocol.GetStateNodes.keys)
+}
+ void GetStateNodes::add_keys(const char* value) {
+  keys_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:protocol.GetStateNodes.keys)
+}
+ void GetStateNodes::add_keys(const void* value, size_t size) {
+  keys_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:protocol.GetStateNodes.keys)
+}
+ const ::google::protobuf::RepeatedPtrField< ::std::string>&
+GetStateNodes::keys() const {
+  // @@protoc_insertion_point(field_list:protocol.GetStateNodes.keys)
+  return keys_;
+}
+ ::google::protobuf::RepeatedPtrField< ::std::string>*
+GetStateNodes::mutable_keys() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.GetStateNodes.keys)
+  return &keys_;
+}
+
+// optional int64 chain_id = 3;
+void GetStateNodes::clear_chain_id() {
+  chain_id_ = GOOGLE_LONGLONG(0);
+}
+ ::google::protobuf::int64 GetStateNodes::chain_id() const {
+  // @@protoc_insertion_point(field_get:protocol.GetStateNodes.chain_id)
+  return chain_id_;
+}
+ void GetStateNodes::set_chain_id(::google::protobuf::int64 value) {
+  
+  chain_id_ = value;
+  // @@protoc_insertion_point(field_set:protocol.GetStateNodes.chain_id)
 }
 
 #endif  // PROTOBUF_INLINE_NOT_IN_HEADERS
 
 // ===================================================================
 
+const ::google::protobuf::EnumDescriptor* StateNodes_SyncCode_descriptor() {
+  protobuf_AssignDescriptorsOnce();
+  return StateNodes_SyncCode_descriptor_;
+}
+bool StateNodes_SyncCode_IsValid(int value) {
+  switch(value) {
+    case 0:
+    case 1:
+    case 2:
+    case 3:
+    case 4:
+      return true;
+    default:
+      return false;
+  }
+}
+
 #if !defined(_MSC_VER) || _MSC_VER >= 1900
-const int LedgerUpgradeNotify::kNonceFieldNumber;
-const int LedgerUpgradeNotify::kUpgradeFieldNumber;
-const int LedgerUpgradeNotify::kSignatureFieldNumber;
+const StateNodes_SyncCode StateNodes::OK;
+const StateNodes_SyncCode StateNodes::NOT_READY;
+const StateNodes_SyncCode StateNodes::EXPIRED;
+const StateNodes_SyncCode StateNodes::OUT_OF_NODES;
+const StateNodes_SyncCode StateNodes::INTERNAL;
+const StateNodes_SyncCode StateNodes::SyncCode_MIN;
+const StateNodes_SyncCode StateNodes::SyncCode_MAX;
+const int StateNodes::SyncCode_ARRAYSIZE;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int StateNodes::kSyncCodeFieldNumber;
+const int StateNodes::kLedgerSeqFieldNumber;
+const int StateNodes::kLedgerFieldNumber;
+const int StateNodes::kNextValueFieldNumber;
+const int StateNodes::kNextProofFieldNumber;
+const int StateNodes::kKeysFieldNumber;
+const int StateNodes::kValuesFieldNumber;
+const int StateNodes::kChainIdFieldNumber;
 #endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
 
-LedgerUpgradeNotify::LedgerUpgradeNotify()
+StateNodes::StateNodes()
   : ::google::protobuf::Message(), _internal_metadata_(NULL) {
   SharedCtor();
-  // @@protoc_insertion_point(constructor:protocol.LedgerUpgradeNotify)
+  // @@protoc_insertion_point(constructor:protocol.StateNodes)
 }
 
-void LedgerUpgradeNotify::InitAsDefaultInstance() {
+void StateNodes::InitAsDefaultInstance() {
   _is_default_instance_ = true;
-  upgrade_ = const_cast< ::protocol::LedgerUpgrade*>(&::protocol::LedgerUpgrade::default_instance());
-  signature_ = const_cast< ::protocol::Signature*>(&::protocol::Signature::default_instance());
+  ledger_ = const_cast< ::protocol::Ledger*>(&::protocol::Ledger::default_instance());
+  next_value_ = const_cast< ::protocol::ConsensusValue*>(&::protocol::ConsensusValue::default_instance());
 }
 
-LedgerUpgradeNotify::LedgerUpgradeNotify(const LedgerUpgradeNotify& from)
+StateNodes::StateNodes(const StateNodes& from)
   : ::google::protobuf::Message(),
     _internal_metadata_(NULL) {
   SharedCtor();
   MergeFrom(from);
-  // @@protoc_insertion_point(copy_constructor:protocol.LedgerUpgradeNotify)
+  // @@protoc_insertion_point(copy_constructor:protocol.StateNodes)
 }
 
-void LedgerUpgradeNotify::SharedCtor() {
+void StateNodes::SharedCtor() {
     _is_default_instance_ = false;
+  ::google::protobuf::internal::GetEmptyString();
   _cached_size_ = 0;
-  nonce_ = GOOGLE_LONGLONG(0);
-  upgrade_ = NULL;
-  signature_ = NULL;
+  sync_code_ = 0;
+  ledger_seq_ = GOOGLE_LONGLONG(0);
+  ledger_ = NULL;
+  next_value_ = NULL;
+  next_proof_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  chain_id_ = GOOGLE_LONGLONG(0);
 }
 
-LedgerUpgradeNotify::~LedgerUpgradeNotify() {
-  // @@protoc_insertion_point(destructor:protocol.LedgerUpgradeNotify)
+StateNodes::~StateNodes() {
+  // @@protoc_insertion_point(destructor:protocol.StateNodes)
   SharedDtor();
 }
 
-void LedgerUpgradeNotify::SharedDtor() {
+void StateNodes::SharedDtor() {
+  next_proof_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
   if (this != default_instance_) {
-    delete upgrade_;
-    delete signature_;
+    delete ledger_;
+    delete next_value_;
   }
 }
 
-void LedgerUpgradeNotify::SetCachedSize(int size) const {
+void StateNodes::SetCachedSize(int size) const {
   GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
   _cached_size_ = size;
   GOOGLE_SAFE_CONCURRENT_WRITES_END();
 }
-const ::google::protobuf::Descriptor* LedgerUpgradeNotify::descriptor() {
+const ::google::protobuf::Descriptor* StateNodes::descriptor() {
   protobuf_AssignDescriptorsOnce();
-  return LedgerUpgradeNotify_descriptor_;
+  return StateNodes_descriptor_;
 }
 
-const LedgerUpgradeNotify& LedgerUpgradeNotify::default_instance() {
+const StateNodes& StateNodes::default_instance() {
   if (default_instance_ == NULL) protobuf_AddDesc_overlay_2eproto();
   return *default_instance_;
 }
 
-LedgerUpgradeNotify* LedgerUpgradeNotify::default_instance_ = NULL;
+StateNodes* StateNodes::default_instance_ = NULL;
 
-LedgerUpgradeNotify* LedgerUpgradeNotify::New(::google::protobuf::Arena* arena) const {
-  LedgerUpgradeNotify* n = new LedgerUpgradeNotify;
+StateNodes* StateNodes::New(::google::protobuf::Arena* arena) const {
+  StateNodes* n = new StateNodes;
   if (arena != NULL) {
     arena->Own(n);
   }
   return n;
 }
 
-void LedgerUpgradeNotify::Clear() {
-// @@protoc_insertion_point(message_clear_start:protocol.LedgerUpgradeNotify)
-  nonce_ = GOOGLE_LONGLONG(0);
-  if (GetArenaNoVirtual() == NULL && upgrade_ != NULL) delete upgrade_;
-  upgrade_ = NULL;
-  if (GetArenaNoVirtual() == NULL && signature_ != NULL) delete signature_;
-  signature_ = NULL;
+void StateNodes::Clear() {
+// @@protoc_insertion_point(message_clear_start:protocol.StateNodes)
+#if defined(__clang__)
+#define ZR_HELPER_(f) \
+  _Pragma("clang diagnostic push") \
+  _Pragma("clang diagnostic ignored \"-Winvalid-offsetof\"") \
+  __builtin_offsetof(StateNodes, f) \
+  _Pragma("clang diagnostic pop")
+#else
+#define ZR_HELPER_(f) reinterpret_cast<char*>(\
+  &reinterpret_cast<StateNodes*>(16)->f)
+#endif
+
+#define ZR_(first, last) do {\
+  ::memset(&first, 0,\
+           ZR_HELPER_(last) - ZR_HELPER_(first) + sizeof(last));\
+} while (0)
+
+  ZR_(chain_id_, sync_code_);
+  ledger_seq_ = GOOGLE_LONGLONG(0);
+  if (GetArenaNoVirtual() == NULL && ledger_ != NULL) delete ledger_;
+  ledger_ = NULL;
+  if (GetArenaNoVirtual() == NULL && next_value_ != NULL) delete next_value_;
+  next_value_ = NULL;
+  next_proof_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+
+#undef ZR_HELPER_
+#undef ZR_
+
+  keys_.Clear();
+  values_.Clear();
 }
 
-bool LedgerUpgradeNotify::MergePartialFromCodedStream(
+bool StateNodes::MergePartialFromCodedStream(
     ::google::protobuf::io::CodedInputStream* input) {
 #define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
   ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:protocol.LedgerUpgradeNotify)
+  // @@protoc_insertion_point(parse_start:protocol.StateNodes)
   for (;;) {
     ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
     tag = p.first;
     if (!p.second) goto handle_unusual;
     switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
-      // optional int64 nonce = 1;
+      // optional .protocol.StateNodes.SyncCode sync_code = 1;
       case 1: {
         if (tag == 8) {
+          int value;
           DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
-                   ::google::protobuf::int64, ::google::protobuf::internal::WireFormatLite::TYPE_INT64>(
-                 input, &nonce_)));
-
+                   int, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM>(
+                 input, &value)));
+          set_sync_code(static_cast< ::protocol::StateNodes_SyncCode >(value));
         } else {
           goto handle_unusual;
         }
-        if (input->ExpectTag(18)) goto parse_upgrade;
+        if (input->ExpectTag(16)) goto parse_ledger_seq;
         break;
       }
 
-      // optional .protocol.LedgerUpgrade upgrade = 2;
+      // optional int64 ledger_seq = 2;
       case 2: {
-        if (tag == 18) {
-         parse_upgrade:
-          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_upgrade()));
+        if (tag == 16) {
+         parse_ledger_seq:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::int64, ::google::protobuf::internal::WireFormatLite::TYPE_INT64>(
+                 input, &ledger_seq_)));
+
         } else {
           goto handle_unusual;
         }
-        if (input->ExpectTag(26)) goto parse_signature;
+        if (input->ExpectTag(26)) goto parse_ledger;
         break;
       }
 
-      // optional .protocol.Signature signature = 3;
+      // optional .protocol.Ledger ledger = 3;
       case 3: {
         if (tag == 26) {
-         parse_signature:
+         parse_ledger:
           DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
-               input, mutable_signature()));
+               input, mutable_ledger()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(34)) goto parse_next_value;
+        break;
+      }
+
+      // optional .protocol.ConsensusValue next_value = 4;
+      case 4: {
+        if (tag == 34) {
+         parse_next_value:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
+               input, mutable_next_value()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(42)) goto parse_next_proof;
+        break;
+      }
+
+      // optional bytes next_proof = 5;
+      case 5: {
+        if (tag == 42) {
+         parse_next_proof:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->mutable_next_proof()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(50)) goto parse_keys;
+        break;
+      }
+
+      // repeated bytes keys = 6;
+      case 6: {
+        if (tag == 50) {
+         parse_keys:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->add_keys()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(50)) goto parse_keys;
+        if (input->ExpectTag(58)) goto parse_values;
+        break;
+      }
+
+      // repeated bytes values = 7;
+      case 7: {
+        if (tag == 58) {
+         parse_values:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->add_values()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(58)) goto parse_values;
+        if (input->ExpectTag(64)) goto parse_chain_id;
+        break;
+      }
+
+      // optional int64 chain_id = 8;
+      case 8: {
+        if (tag == 64) {
+         parse_chain_id:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::int64, ::google::protobuf::internal::WireFormatLite::TYPE_INT64>(
+                 input, &chain_id_)));
+
         } else {
           goto handle_unusual;
         }
@@ -3913,86 +4246,179 @@ bool LedgerUpgradeNotify::MergePartialFromCodedStream(
     }
   }
 success:
-  // @@protoc_insertion_point(parse_success:protocol.LedgerUpgradeNotify)
+  // @@protoc_insertion_point(parse_success:protocol.StateNodes)
   return true;
 failure:
-  // @@protoc_insertion_point(parse_failure:protocol.LedgerUpgradeNotify)
+  // @@protoc_insertion_point(parse_failure:protocol.StateNodes)
   return false;
 #undef DO_
 }
 
-void LedgerUpgradeNotify::SerializeWithCachedSizes(
+void StateNodes::SerializeWithCachedSizes(
     ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:protocol.LedgerUpgradeNotify)
-  // optional int64 nonce = 1;
-  if (this->nonce() != 0) {
-    ::google::protobuf::internal::WireFormatLite::WriteInt64(1, this->nonce(), output);
+  // @@protoc_insertion_point(serialize_start:protocol.StateNodes)
+  // optional .protocol.StateNodes.SyncCode sync_code = 1;
+  if (this->sync_code() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteEnum(
+      1, this->sync_code(), output);
   }
 
-  // optional .protocol.LedgerUpgrade upgrade = 2;
-  if (this->has_upgrade()) {
+  // optional int64 ledger_seq = 2;
+  if (this->ledger_seq() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt64(2, this->ledger_seq(), output);
+  }
+
+  // optional .protocol.Ledger ledger = 3;
+  if (this->has_ledger()) {
     ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      2, *this->upgrade_, output);
+      3, *this->ledger_, output);
   }
 
-  // optional .protocol.Signature signature = 3;
-  if (this->has_signature()) {
+  // optional .protocol.ConsensusValue next_value = 4;
+  if (this->has_next_value()) {
     ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
-      3, *this->signature_, output);
+      4, *this->next_value_, output);
   }
 
-  // @@protoc_insertion_point(serialize_end:protocol.LedgerUpgradeNotify)
+  // optional bytes next_proof = 5;
+  if (this->next_proof().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytesMaybeAliased(
+      5, this->next_proof(), output);
+  }
+
+  // repeated bytes keys = 6;
+  for (int i = 0; i < this->keys_size(); i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytes(
+      6, this->keys(i), output);
+  }
+
+  // repeated bytes values = 7;
+  for (int i = 0; i < this->values_size(); i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytes(
+      7, this->values(i), output);
+  }
+
+  // optional int64 chain_id = 8;
+  if (this->chain_id() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt64(8, this->chain_id(), output);
+  }
+
+  // @@protoc_insertion_point(serialize_end:protocol.StateNodes)
 }
 
-::google::protobuf::uint8* LedgerUpgradeNotify::InternalSerializeWithCachedSizesToArray(
+::google::protobuf::uint8* StateNodes::InternalSerializeWithCachedSizesToArray(
     bool deterministic, ::google::protobuf::uint8* target) const {
-  // @@protoc_insertion_point(serialize_to_array_start:protocol.LedgerUpgradeNotify)
-  // optional int64 nonce = 1;
-  if (this->nonce() != 0) {
-    target = ::google::protobuf::internal::WireFormatLite::WriteInt64ToArray(1, this->nonce(), target);
+  // @@protoc_insertion_point(serialize_to_array_start:protocol.StateNodes)
+  // optional .protocol.StateNodes.SyncCode sync_code = 1;
+  if (this->sync_code() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteEnumToArray(
+      1, this->sync_code(), target);
   }
 
-  // optional .protocol.LedgerUpgrade upgrade = 2;
-  if (this->has_upgrade()) {
+  // optional int64 ledger_seq = 2;
+  if (this->ledger_seq() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteInt64ToArray(2, this->ledger_seq(), target);
+  }
+
+  // optional .protocol.Ledger ledger = 3;
+  if (this->has_ledger()) {
     target = ::google::protobuf::internal::WireFormatLite::
       InternalWriteMessageNoVirtualToArray(
-        2, *this->upgrade_, false, target);
+        3, *this->ledger_, false, target);
   }
 
-  // optional .protocol.Signature signature = 3;
-  if (this->has_signature()) {
+  // optional .protocol.ConsensusValue next_value = 4;
+  if (this->has_next_value()) {
     target = ::google::protobuf::internal::WireFormatLite::
       InternalWriteMessageNoVirtualToArray(
-        3, *this->signature_, false, target);
+        4, *this->next_value_, false, target);
   }
 
-  // @@protoc_insertion_point(serialize_to_array_end:protocol.LedgerUpgradeNotify)
+  // optional bytes next_proof = 5;
+  if (this->next_proof().size() > 0) {
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
+        5, this->next_proof(), target);
+  }
+
+  // repeated bytes keys = 6;
+  for (int i = 0; i < this->keys_size(); i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteBytesToArray(6, this->keys(i), target);
+  }
+
+  // repeated bytes values = 7;
+  for (int i = 0; i < this->values_size(); i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteBytesToArray(7, this->values(i), target);
+  }
+
+  // optional int64 chain_id = 8;
+  if (this->chain_id() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteInt64ToArray(8, this->chain_id(), target);
+  }
+
+  // @@protoc_insertion_point(serialize_to_array_end:protocol.StateNodes)
   return target;
 }
 
-int LedgerUpgradeNotify::ByteSize() const {
-// @@protoc_insertion_point(message_byte_size_start:protocol.LedgerUpgradeNotify)
+int StateNodes::ByteSize() const {
+// @@protoc_insertion_point(message_byte_size_start:protocol.StateNodes)
   int total_size = 0;
 
-  // optional int64 nonce = 1;
-  if (this->nonce() != 0) {
+  // optional .protocol.StateNodes.SyncCode sync_code = 1;
+  if (this->sync_code() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::EnumSize(this->sync_code());
+  }
+
+  // optional int64 ledger_seq = 2;
+  if (this->ledger_seq() != 0) {
     total_size += 1 +
       ::google::protobuf::internal::WireFormatLite::Int64Size(
-        this->nonce());
+        this->ledger_seq());
   }
 
-  // optional .protocol.LedgerUpgrade upgrade = 2;
-  if (this->has_upgrade()) {
+  // optional .protocol.Ledger ledger = 3;
+  if (this->has_ledger()) {
     total_size += 1 +
       ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-        *this->upgrade_);
+        *this->ledger_);
   }
 
-  // optional .protocol.Signature signature = 3;
-  if (this->has_signature()) {
+  // optional .protocol.ConsensusValue next_value = 4;
+  if (this->has_next_value()) {
     total_size += 1 +
       ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
-        *this->signature_);
+        *this->next_value_);
+  }
+
+  // optional bytes next_proof = 5;
+  if (this->next_proof().size() > 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::BytesSize(
+        this->next_proof());
+  }
+
+  // optional int64 chain_id = 8;
+  if (this->chain_id() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::Int64Size(
+        this->chain_id());
+  }
+
+  // repeated bytes keys = 6;
+  total_size += 1 * this->keys_size();
+  for (int i = 0; i < this->keys_size(); i++) {
+    total_size += ::google::protobuf::internal::WireFormatLite::BytesSize(
+      this->keys(i));
+  }
+
+  // repeated bytes values = 7;
+  total_size += 1 * this->values_size();
+  for (int i = 0; i < this->values_size(); i++) {
+    total_size += ::google::protobuf::internal::WireFormatLite::BytesSize(
+      this->values(i));
   }
 
   GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
@@ -4001,169 +4427,368 @@ int LedgerUpgradeNotify::ByteSize() const {
   return total_size;
 }
 
-void LedgerUpgradeNotify::MergeFrom(const ::google::protobuf::Message& from) {
-// @@protoc_insertion_point(generalized_merge_from_start:protocol.LedgerUpgradeNotify)
+void StateNodes::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:protocol.StateNodes)
   if (GOOGLE_PREDICT_FALSE(&from == this)) {
     ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
   }
-  const LedgerUpgradeNotify* source = 
-      ::google::protobuf::internal::DynamicCastToGenerated<const LedgerUpgradeNotify>(
+  const StateNodes* source = 
+      ::google::protobuf::internal::DynamicCastToGenerated<const StateNodes>(
           &from);
   if (source == NULL) {
-  // @@protoc_insertion_point(generalized_merge_from_cast_fail:protocol.LedgerUpgradeNotify)
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:protocol.StateNodes)
     ::google::protobuf::internal::ReflectionOps::Merge(from, this);
   } else {
-  // @@protoc_insertion_point(generalized_merge_from_cast_success:protocol.LedgerUpgradeNotify)
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:protocol.StateNodes)
     MergeFrom(*source);
   }
 }
 
-void LedgerUpgradeNotify::MergeFrom(const LedgerUpgradeNotify& from) {
-// @@protoc_insertion_point(class_specific_merge_from_start:protocol.LedgerUpgradeNotify)
+void StateNodes::MergeFrom(const StateNodes& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:protocol.StateNodes)
   if (GOOGLE_PREDICT_FALSE(&from == this)) {
     ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
   }
-  if (from.nonce() != 0) {
-    set_nonce(from.nonce());
+  keys_.MergeFrom(from.keys_);
+  values_.MergeFrom(from.values_);
+  if (from.sync_code() != 0) {
+    set_sync_code(from.sync_code());
   }
-  if (from.has_upgrade()) {
-    mutable_upgrade()->::protocol::LedgerUpgrade::MergeFrom(from.upgrade());
+  if (from.ledger_seq() != 0) {
+    set_ledger_seq(from.ledger_seq());
   }
-  if (from.has_signature()) {
-    mutable_signature()->::protocol::Signature::MergeFrom(from.signature());
+  if (from.has_ledger()) {
+    mutable_ledger()->::protocol::Ledger::MergeFrom(from.ledger());
+  }
+  if (from.has_next_value()) {
+    mutable_next_value()->::protocol::ConsensusValue::MergeFrom(from.next_value());
+  }
+  if (from.next_proof().size() > 0) {
+
+    next_proof_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.next_proof_);
+  }
+  if (from.chain_id() != 0) {
+    set_chain_id(from.chain_id());
   }
 }
 
-void LedgerUpgradeNotify::CopyFrom(const ::google::protobuf::Message& from) {
-// @@protoc_insertion_point(generalized_copy_from_start:protocol.LedgerUpgradeNotify)
+void StateNodes::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:protocol.StateNodes)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
-void LedgerUpgradeNotify::CopyFrom(const LedgerUpgradeNotify& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:protocol.LedgerUpgradeNotify)
+void StateNodes::CopyFrom(const StateNodes& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:protocol.StateNodes)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
-bool LedgerUpgradeNotify::IsInitialized() const {
+bool StateNodes::IsInitialized() const {
 
   return true;
 }
 
-void LedgerUpgradeNotify::Swap(LedgerUpgradeNotify* other) {
+void StateNodes::Swap(StateNodes* other) {
   if (other == this) return;
   InternalSwap(other);
 }
-void LedgerUpgradeNotify::InternalSwap(LedgerUpgradeNotify* other) {
-  std::swap(nonce_, other->nonce_);
-  std::swap(upgrade_, other->upgrade_);
-  std::swap(signature_, other->signature_);
+void StateNodes::InternalSwap(StateNodes* other) {
+  std::swap(sync_code_, other->sync_code_);
+  std::swap(ledger_seq_, other->ledger_seq_);
+  std::swap(ledger_, other->ledger_);
+  std::swap(next_value_, other->next_value_);
+  next_proof_.Swap(&other->next_proof_);
+  keys_.UnsafeArenaSwap(&other->keys_);
+  values_.UnsafeArenaSwap(&other->values_);
+  std::swap(chain_id_, other->chain_id_);
   _internal_metadata_.Swap(&other->_internal_metadata_);
   std::swap(_cached_size_, other->_cached_size_);
 }
 
-::google::protobuf::Metadata LedgerUpgradeNotify::GetMetadata() const {
+::google::protobuf::Metadata StateNodes::GetMetadata() const {
   protobuf_AssignDescriptorsOnce();
   ::google::protobuf::Metadata metadata;
-  metadata.descriptor = LedgerUpgradeNotify_descriptor_;
-  metadata.reflection = LedgerUpgradeNotify_reflection_;
+  metadata.descriptor = StateNodes_descriptor_;
+  metadata.reflection = StateNodes_reflection_;
   return metadata;
 }
 
 #if PROTOBUF_INLINE_NOT_IN_HEADERS
-// LedgerUpgradeNotify
+// StateNodes
 
-// optional int64 nonce = 1;
-void LedgerUpgradeNotify::clear_nonce() {
-  nonce_ = GOOGLE_LONGLONG(0);
+// optional .protocol.StateNodes.SyncCode sync_code = 1;
+void StateNodes::clear_sync_code() {
+  sync_code_ = 0;
 }
- ::google::protobuf::int64 LedgerUpgradeNotify::nonce() const {
-  // @@protoc_insertion_point(field_get:protocol.LedgerUpgradeNotify.nonce)
-  return nonce_;
+ ::protocol::StateNodes_SyncCode StateNodes::sync_code() const {
+  // @@protoc_insertion_point(field_get:protocol.StateNodes.sync_code)
+  return static_cast< ::protocol::StateNodes_SyncCode >(sync_code_);
 }
- void LedgerUpgradeNotify::set_nonce(::google::protobuf::int64 value) {
+ void StateNodes::set_sync_code(::protocol::StateNodes_SyncCode value) {
   
-  nonce_ = value;
-  // @@protoc_insertion_point(field_set:protocol.LedgerUpgradeNotify.nonce)
+  sync_code_ = value;
+  // @@protoc_insertion_point(field_set:protocol.StateNodes.sync_code)
 }
 
-// optional .protocol.LedgerUpgrade upgrade = 2;
-bool LedgerUpgradeNotify::has_upgrade() const {
-  return !_is_default_instance_ && upgrade_ != NULL;
+// optional int64 ledger_seq = 2;
+void StateNodes::clear_ledger_seq() {
+  ledger_seq_ = GOOGLE_LONGLONG(0);
 }
-void LedgerUpgradeNotify::clear_upgrade() {
-  if (GetArenaNoVirtual() == NULL && upgrade_ != NULL) delete upgrade_;
-  upgrade_ = NULL;
+ ::google::protobuf::int64 StateNodes::ledger_seq() const {
+  // @@protoc_insertion_point(field_get:protocol.StateNodes.ledger_seq)
+  return ledger_seq_;
 }
-const ::protocol::LedgerUpgrade& LedgerUpgradeNotify::upgrade() const {
-  // @@protoc_insertion_point(field_get:protocol.LedgerUpgradeNotify.upgrade)
-  return upgrade_ != NULL ? *upgrade_ : *default_instance_->upgrade_;
+ void StateNodes::set_ledger_seq(::google::protobuf::int64 value) {
+  
+  ledger_seq_ = value;
+  // @@protoc_insertion_point(field_set:protocol.StateNodes.ledger_seq)
 }
-::protocol::LedgerUpgrade* LedgerUpgradeNotify::mutable_upgrade() {
+
+// optional .protocol.Ledger ledger = 3;
+bool StateNodes::has_ledger() const {
+  return !_is_default_instance_ && ledger_ != NULL;
+}
+void StateNodes::clear_ledger() {
+  if (GetArenaNoVirtual() == NULL && ledger_ != NULL) delete ledger_;
+  ledger_ = NULL;
+}
+const ::protocol::Ledger& StateNodes::ledger() const {
+  // @@protoc_insertion_point(field_get:protocol.StateNodes.ledger)
+  return ledger_ != NULL ? *ledger_ : *default_instance_->ledger_;
+}
+::protocol::Ledger* StateNodes::mutable_ledger() {
   
-  if (upgrade_ == NULL) {
-    upgrade_ = new ::protocol::LedgerUpgrade;
+  if (ledger_ == NULL) {
+    ledger_ = new ::protocol::Ledger;
   }
-  // @@protoc_insertion_point(field_mutable:protocol.LedgerUpgradeNotify.upgrade)
-  return upgrade_;
+  // @@protoc_insertion_point(field_mutable:protocol.StateNodes.ledger)
+  return ledger_;
 }
-::protocol::LedgerUpgrade* LedgerUpgradeNotify::release_upgrade() {
-  // @@protoc_insertion_point(field_release:protocol.LedgerUpgradeNotify.upgrade)
+::protocol::Ledger* StateNodes::release_ledger() {
+  // @@protoc_insertion_point(field_release:protocol.StateNodes.ledger)
   
-  ::protocol::LedgerUpgrade* temp = upgrade_;
-  upgrade_ = NULL;
+  ::protocol::Ledger* temp = ledger_;
+  ledger_ = NULL;
   return temp;
 }
-void LedgerUpgradeNotify::set_allocated_upgrade(::protocol::LedgerUpgrade* upgrade) {
-  delete upgrade_;
-  upgrade_ = upgrade;
-  if (upgrade) {
+void StateNodes::set_allocated_ledger(::protocol::Ledger* ledger) {
+  delete ledger_;
+  ledger_ = ledger;
+  if (ledger) {
     
   } else {
     
   }
-  // @@protoc_insertion_point(field_set_allocated:protocol.LedgerUpgradeNotify.upgrade)
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateNodes.ledger)
 }
 
-// optional .protocol.Signature signature = 3;
-bool LedgerUpgradeNotify::has_signature() const {
-  return !_is_default_instance_ && signature_ != NULL;
+// optional .protocol.ConsensusValue next_value = 4;
+bool StateNodes::has_next_value() const {
+  return !_is_default_instance_ && next_value_ != NULL;
 }
-void LedgerUpgradeNotify::clear_signature() {
-  if (GetArenaNoVirtual() == NULL && signature_ != NULL) delete signature_;
-  signature_ = NULL;
+void StateNodes::clear_next_value() {
+  if (GetArenaNoVirtual() == NULL && next_value_ != NULL) delete next_value_;
+  next_value_ = NULL;
 }
-const ::protocol::Signature& LedgerUpgradeNotify::signature() const {
-  // @@protoc_insertion_point(field_get:protocol.LedgerUpgradeNotify.signature)
-  return signature_ != NULL ? *signature_ : *default_instance_->signature_;
+const ::protocol::ConsensusValue& StateNodes::next_value() const {
+  // @@protoc_insertion_point(field_get:protocol.StateNodes.next_value)
+  return next_value_ != NULL ? *next_value_ : *default_instance_->next_value_;
 }
-::protocol::Signature* LedgerUpgradeNotify::mutable_signature() {
+::protocol::ConsensusValue* StateNodes::mutable_next_value() {
   
-  if (signature_ == NULL) {
-    signature_ = new ::protocol::Signature;
+  if (next_value_ == NULL) {
+    next_value_ = new ::protocol::ConsensusValue;
   }
-  // @@protoc_insertion_point(field_mutable:protocol.LedgerUpgradeNotify.signature)
-  return signature_;
+  // @@protoc_insertion_point(field_mutable:protocol.StateNodes.next_value)
+  return next_value_;
 }
-::protocol::Signature* LedgerUpgradeNotify::release_signature() {
-  // @@protoc_insertion_point(field_release:protocol.LedgerUpgradeNotify.signature)
+::protocol::ConsensusValue* StateNodes::release_next_value() {
+  // @@protoc_insertion_point(field_release:protocol.StateNodes.next_value)
   
-  ::protocol::Signature* temp = signature_;
-  signature_ = NULL;
+  ::protocol::ConsensusValue* temp = next_value_;
+  next_value_ = NULL;
   return temp;
 }
-void LedgerUpgradeNotify::set_allocated_signature(::protocol::Signature* signature) {
-  delete signature_;
-  signature_ = signature;
-  if (signature) {
+void StateNodes::set_allocated_next_value(::protocol::ConsensusValue* next_value) {
+  delete next_value_;
+  next_value_ = next_value;
+  if (next_value) {
     
   } else {
     
   }
-  // @@protoc_insertion_point(field_set_allocated:protocol.LedgerUpgradeNotify.signature)
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateNodes.next_value)
+}
+
+// optional bytes next_proof = 5;
+void StateNodes::clear_next_proof() {
+  next_proof_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ const ::std::string& StateNodes::next_proof() const {
+  // @@protoc_insertion_point(field_get:protocol.StateNodes.next_proof)
+  return next_proof_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ void StateNodes::set_next_proof(const ::std::string& value) {
+  
+  next_proof_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.StateNodes.next_proof)
+}
+ void StateNodes::set_next_proof(const char* value) {
+  
+  next_proof_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.StateNodes.next_proof)
+}
+ void StateNodes::set_next_proof(const void* value, size_t size) {
+  
+  next_proof_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.StateNodes.next_proof)
+}
+ ::std::string* StateNodes::mutable_next_proof() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.StateNodes.next_proof)
+  return next_proof_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ ::std::string* StateNodes::release_next_proof() {
+  // @@protoc_insertion_point(field_release:protocol.StateNodes.next_proof)
+  
+  return next_proof_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ void StateNodes::set_allocated_next_proof(::std::string* next_proof) {
+  if (next_proof != NULL) {
+    
+  } else {
+    
+  }
+  next_proof_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), next_proof);
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateNodes.next_proof)
+}
+
+// repeated bytes keys = 6;
+int StateNodes::keys_size() const {
+  return keys_.size();
+}
+void StateNodes::clear_keys() {
+  keys_.Clear();
+}
+ const ::std::string& StateNodes::keys(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.StateNodes.keys)
+  return keys_.Get(index);
+}
+ ::std::string* StateNodes::mutable_keys(int index) {
+  // @@protoc_insertion_point(field_mutable:protocol.StateNodes.keys)
+  return keys_.Mutable(index);
+}
+ void StateNodes::set_keys(int index, const ::std::string& value) {
+  // @@protoc_insertion_point(field_set:protocol.StateNodes.keys)
+  keys_.Mutable(index)->assign(value);
+}
+ void StateNodes::set_keys(int index, const char* value) {
+  keys_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:protocol.StateNodes.keys)
+}
+ void StateNodes::set_keys(int index, const void* value, size_t size) {
+  keys_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:protocol.StateNodes.keys)
+}
+ ::std::string* StateNodes::add_keys() {
+  // @@protoc_insertion_point(field_add_mutable:protocol.StateNodes.keys)
+  return keys_.Add();
+}
+ void StateNodes::add_keys(const ::std::string& value) {
+  keys_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:protocol.StateNodes.keys)
+}
+ void StateNodes::add_keys(const char* value) {
+  keys_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:protocol.StateNodes.keys)
+}
+ void StateNodes::add_keys(const void* value, size_t size) {
+  keys_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:protocol.StateNodes.keys)
+}
+ const ::google::protobuf::RepeatedPtrField< ::std::string>&
+StateNodes::keys() const {
+  // @@protoc_insertion_point(field_list:protocol.StateNodes.keys)
+  return keys_;
+}
+ ::google::protobuf::RepeatedPtrField< ::std::string>*
+StateNodes::mutable_keys() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.StateNodes.keys)
+  return &keys_;
+}
+
+// repeated bytes values = 7;
+int StateNodes::values_size() const {
+  return values_.size();
+}
+void StateNodes::clear_values() {
+  values_.Clear();
+}
+ const ::std::string& StateNodes::values(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.StateNodes.values)
+  return values_.Get(index);
+}
+ ::std::string* StateNodes::mutable_values(int index) {
+  // @@protoc_insertion_point(field_mutable:protocol.StateNodes.values)
+  return values_.Mutable(index);
+}
+ void StateNodes::set_values(int index, const ::std::string& value) {
+  // @@protoc_insertion_point(field_set:protocol.StateNodes.values)
+  values_.Mutable(index)->assign(value);
+}
+ void StateNodes::set_values(int index, const char* value) {
+  values_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:protocol.StateNodes.values)
+}
+ void StateNodes::set_values(int index, const void* value, size_t size) {
+  values_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:protocol.StateNodes.values)
+}
+ ::std::string* StateNodes::add_values() {
+  // @@protoc_insertion_point(field_add_mutable:protocol.StateNodes.values)
+  return values_.Add();
+}
+ void StateNodes::add_values(const ::std::string& value) {
+  values_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:protocol.StateNodes.values)
+}
+ void StateNodes::add_values(const char* value) {
+  values_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:protocol.StateNodes.values)
+}
+ void StateNodes::add_values(const void* value, size_t size) {
+  values_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:protocol.StateNodes.values)
+}
+ const ::google::protobuf::RepeatedPtrField< ::std::string>&
+StateNodes::values() const {
+  // @@protoc_insertion_point(field_list:protocol.StateNodes.values)
+  return values_;
+}
+ ::google::protobuf::RepeatedPtrField< ::std::string>*
+StateNodes::mutable_values() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.StateNodes.values)
+  return &values_;
+}
+
+// optional int64 chain_id = 8;
+void StateNodes::clear_chain_id() {
+  chain_id_ = GOOGLE_LONGLONG(0);
+}
+ ::google::protobuf::int64 StateNodes::chain_id() const {
+  // @@protoc_insertion_point(field_get:protocol.StateNodes.chain_id)
+  return chain_id_;
+}
+ void StateNodes::set_chain_id(::google::protobuf::int64 value) {
+  
+  chain_id_ = value;
+  // @@protoc_insertion_point(field_set:protocol.StateNodes.chain_id)
 }
 
 #endif  // PROTOBUF_INLINE_NOT_IN_HEADERS
@@ -4171,93 +4796,111 @@ void LedgerUpgradeNotify::set_allocated_signature(::protocol::Signature* signatu
 // ===================================================================
 
 #if !defined(_MSC_VER) || _MSC_VER >= 1900
-const int EntryList::kEntryFieldNumber;
+const int DontHave::kTypeFieldNumber;
+const int DontHave::kHashFieldNumber;
 #endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
 
-EntryList::EntryList()
+DontHave::DontHave()
   : ::google::protobuf::Message(), _internal_metadata_(NULL) {
   SharedCtor();
-  // @@protoc_insertion_point(constructor:protocol.EntryList)
+  // @@protoc_insertion_point(constructor:protocol.DontHave)
 }
 
-void EntryList::InitAsDefaultInstance() {
+void DontHave::InitAsDefaultInstance() {
   _is_default_instance_ = true;
 }
 
-EntryList::EntryList(const EntryList& from)
+DontHave::DontHave(const DontHave& from)
   : ::google::protobuf::Message(),
     _internal_metadata_(NULL) {
   SharedCtor();
   MergeFrom(from);
-  // @@protoc_insertion_point(copy_constructor:protocol.EntryList)
+  // @@protoc_insertion_point(copy_constructor:protocol.DontHave)
 }
 
-void EntryList::SharedCtor() {
+void DontHave::SharedCtor() {
     _is_default_instance_ = false;
   ::google::protobuf::internal::GetEmptyString();
   _cached_size_ = 0;
+  type_ = GOOGLE_LONGLONG(0);
+  hash_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
 }
 
-EntryList::~EntryList() {
-  // @@protoc_insertion_point(destructor:protocol.EntryList)
+DontHave::~DontHave() {
+  // @@protoc_insertion_point(destructor:protocol.DontHave)
   SharedDtor();
 }
 
-void EntryList::SharedDtor() {
+void DontHave::SharedDtor() {
+  hash_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
   if (this != default_instance_) {
   }
 }
 
-void EntryList::SetCachedSize(int size) const {
+void DontHave::SetCachedSize(int size) const {
   GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
   _cached_size_ = size;
   GOOGLE_SAFE_CONCURRENT_WRITES_END();
 }
-const ::google::protobuf::Descriptor* EntryList::descriptor() {
+const ::google::protobuf::Descriptor* DontHave::descriptor() {
   protobuf_AssignDescriptorsOnce();
-  return EntryList_descriptor_;
+  return DontHave_descriptor_;
 }
 
-const EntryList& EntryList::default_instance() {
+const DontHave& DontHave::default_instance() {
   if (default_instance_ == NULL) protobuf_AddDesc_overlay_2eproto();
   return *default_instance_;
 }
 
-EntryList* EntryList::default_instance_ = NULL;
+DontHave* DontHave::default_instance_ = NULL;
 
-EntryList* EntryList::New(::google::protobuf::Arena* arena) const {
-  EntryList* n = new EntryList;
+DontHave* DontHave::New(::google::protobuf::Arena* arena) const {
+  DontHave* n = new DontHave;
   if (arena != NULL) {
     arena->Own(n);
   }
   return n;
 }
 
-void EntryList::Clear() {
-// @@protoc_insertion_point(message_clear_start:protocol.EntryList)
-  entry_.Clear();
+void DontHave::Clear() {
+// @@protoc_insertion_point(message_clear_start:protocol.DontHave)
+  type_ = GOOGLE_LONGLONG(0);
+  hash_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
 }
 
-bool EntryList::MergePartialFromCodedStream(
+bool DontHave::MergePartialFromCodedStream(
     ::google::protobuf::io::CodedInputStream* input) {
 #define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
   ::google::protobuf::uint32 tag;
-  // @@protoc_insertion_point(parse_start:protocol.EntryList)
+  // @@protoc_insertion_point(parse_start:protocol.DontHave)
   for (;;) {
     ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
     tag = p.first;
     if (!p.second) goto handle_unusual;
     switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
-      // repeated bytes entry = 1;
+      // optional int64 type = 1;
       case 1: {
-        if (tag == 10) {
-         parse_entry:
+        if (tag == 8) {
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::int64, ::google::protobuf::internal::WireFormatLite::TYPE_INT64>(
+                 input, &type_)));
+
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(18)) goto parse_hash;
+        break;
+      }
+
+      // optional bytes hash = 2;
+      case 2: {
+        if (tag == 18) {
+         parse_hash:
           DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
-                input, this->add_entry()));
+                input, this->mutable_hash()));
         } else {
           goto handle_unusual;
         }
-        if (input->ExpectTag(10)) goto parse_entry;
         if (input->ExpectAtEnd()) goto success;
         break;
       }
@@ -4275,46 +4918,753 @@ bool EntryList::MergePartialFromCodedStream(
     }
   }
 success:
-  // @@protoc_insertion_point(parse_success:protocol.EntryList)
+  // @@protoc_insertion_point(parse_success:protocol.DontHave)
   return true;
 failure:
-  // @@protoc_insertion_point(parse_failure:protocol.EntryList)
+  // @@protoc_insertion_point(parse_failure:protocol.DontHave)
   return false;
 #undef DO_
 }
 
-void EntryList::SerializeWithCachedSizes(
+void DontHave::SerializeWithCachedSizes(
     ::google::protobuf::io::CodedOutputStream* output) const {
-  // @@protoc_insertion_point(serialize_start:protocol.EntryList)
-  // repeated bytes entry = 1;
-  for (int i = 0; i < this->entry_size(); i++) {
-    ::google::protobuf::internal::WireFormatLite::WriteBytes(
-      1, this->entry(i), output);
+  // @@protoc_insertion_point(serialize_start:protocol.DontHave)
+  // optional int64 type = 1;
+  if (this->type() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt64(1, this->type(), output);
   }
 
-  // @@protoc_insertion_point(serialize_end:protocol.EntryList)
+  // optional bytes hash = 2;
+  if (this->hash().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytesMaybeAliased(
+      2, this->hash(), output);
+  }
+
+  // @@protoc_insertion_point(serialize_end:protocol.DontHave)
 }
 
-::google::protobuf::uint8* EntryList::InternalSerializeWithCachedSizesToArray(
+::google::protobuf::uint8* DontHave::InternalSerializeWithCachedSizesToArray(
     bool deterministic, ::google::protobuf::uint8* target) const {
-  // @@protoc_insertion_point(serialize_to_array_start:protocol.EntryList)
-  // repeated bytes entry = 1;
-  for (int i = 0; i < this->entry_size(); i++) {
-    target = ::google::protobuf::internal::WireFormatLite::
-      WriteBytesToArray(1, this->entry(i), target);
+  // @@protoc_insertion_point(serialize_to_array_start:protocol.DontHave)
+  // optional int64 type = 1;
+  if (this->type() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteInt64ToArray(1, this->type(), target);
   }
 
-  // @@protoc_insertion_point(serialize_to_array_end:protocol.EntryList)
+  // optional bytes hash = 2;
+  if (this->hash().size() > 0) {
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
+        2, this->hash(), target);
+  }
+
+  // @@protoc_insertion_point(serialize_to_array_end:protocol.DontHave)
   return target;
 }
 
-int EntryList::ByteSize() const {
-// @@protoc_insertion_point(message_byte_size_start:protocol.EntryList)
+int DontHave::ByteSize() const {
+// @@protoc_insertion_point(message_byte_size_start:protocol.DontHave)
   int total_size = 0;
 
-  // repeated bytes entry = 1;
-  total_size += 1 * this->entry_size();
-  for (int i = 0; i < this->entry_size(); i++) {
+  // optional int64 type = 1;
+  if (this->type() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::Int64Size(
+        this->type());
+  }
+
+  // optional bytes hash = 2;
+  if (this->hash().size() > 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::BytesSize(
+        this->hash());
+  }
+
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = total_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void DontHave::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:protocol.DontHave)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  const DontHave* source = 
+      ::google::protobuf::internal::DynamicCastToGenerated<const DontHave>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:protocol.DontHave)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:protocol.DontHave)
+    MergeFrom(*source);
+  }
+}
+
+void DontHave::MergeFrom(const DontHave& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:protocol.DontHave)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  if (from.type() != 0) {
+    set_type(from.type());
+  }
+  if (from.hash().size() > 0) {
+
+    hash_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.hash_);
+  }
+}
+
+void DontHave::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:protocol.DontHave)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void DontHave::CopyFrom(const DontHave& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:protocol.DontHave)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool DontHave::IsInitialized() const {
+
+  return true;
+}
+
+void DontHave::Swap(DontHave* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void DontHave::InternalSwap(DontHave* other) {
+  std::swap(type_, other->type_);
+  hash_.Swap(&other->hash_);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  std::swap(_cached_size_, other->_cached_size_);
+}
+
+::google::protobuf::Metadata DontHave::GetMetadata() const {
+  protobuf_AssignDescriptorsOnce();
+  ::google::protobuf::Metadata metadata;
+  metadata.descriptor = DontHave_descriptor_;
+  metadata.reflection = DontHave_reflection_;
+  return metadata;
+}
+
+#if PROTOBUF_INLINE_NOT_IN_HEADERS
+// DontHave
+
+// optional int64 type = 1;
+void DontHave::clear_type() {
+  type_ = GOOGLE_LONGLONG(0);
+}
+ ::google::protobuf::int64 DontHave::type() const {
+  // @@protoc_insertion_point(field_get:protocol.DontHave.type)
+  return type_;
+}
+ void DontHave::set_type(::google::protobuf::int64 value) {
+  
+  type_ = value;
+  // @@protoc_insertion_point(field_set:protocol.DontHave.type)
+}
+
+// optional bytes hash = 2;
+void DontHave::clear_hash() {
+  hash_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ const ::std::string& DontHave::hash() const {
+  // @@protoc_insertion_point(field_get:protocol.DontHave.hash)
+  return hash_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ void DontHave::set_hash(const ::std::string& value) {
+  
+  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.DontHave.hash)
+}
+ void DontHave::set_hash(const char* value) {
+  
+  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.DontHave.hash)
+}
+ void DontHave::set_hash(const void* value, size_t size) {
+  
+  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.DontHave.hash)
+}
+ ::std::string* DontHave::mutable_hash() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.DontHave.hash)
+  return hash_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ ::std::string* DontHave::release_hash() {
+  // @@protoc_insertion_point(field_release:protocol.DontHave.hash)
+  
+  return hash_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ void DontHave::set_allocated_hash(::std::string* hash) {
+  if (hash != NULL) {
+    
+  } else {
+    
+  }
+  hash_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), hash);
+  // @@protoc_insertion_point(field_set_allocated:protocol.DontHave.hash)
+}
+
+#endif  // PROTOBUF_INLINE_NOT_IN_HEADERS
+
+// ===================================================================
+
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int LedgerUpgradeNotify::kNonceFieldNumber;
+const int LedgerUpgradeNotify::kUpgradeFieldNumber;
+const int LedgerUpgradeNotify::kSignatureFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+LedgerUpgradeNotify::LedgerUpgradeNotify()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:protocol.LedgerUpgradeNotify)
+}
+
+void LedgerUpgradeNotify::InitAsDefaultInstance() {
+  _is_default_instance_ = true;
+  upgrade_ = const_cast< ::protocol::LedgerUpgrade*>(&::protocol::LedgerUpgrade::default_instance());
+  signature_ = const_cast< ::protocol::Signature*>(&::protocol::Signature::default_instance());
+}
+
+LedgerUpgradeNotify::LedgerUpgradeNotify(const LedgerUpgradeNotify& from)
+  : ::google::protobuf::Message(),
+    _internal_metadata_(NULL) {
+  SharedCtor();
+  MergeFrom(from);
+  // @@protoc_insertion_point(copy_constructor:protocol.LedgerUpgradeNotify)
+}
+
+void LedgerUpgradeNotify::SharedCtor() {
+    _is_default_instance_ = false;
+  _cached_size_ = 0;
+  nonce_ = GOOGLE_LONGLONG(0);
+  upgrade_ = NULL;
+  signature_ = NULL;
+}
+
+LedgerUpgradeNotify::~LedgerUpgradeNotify() {
+  // @@protoc_insertion_point(destructor:protocol.LedgerUpgradeNotify)
+  SharedDtor();
+}
+
+void LedgerUpgradeNotify::SharedDtor() {
+  if (this != default_instance_) {
+    delete upgrade_;
+    delete signature_;
+  }
+}
+
+void LedgerUpgradeNotify::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* LedgerUpgradeNotify::descriptor() {
+  protobuf_AssignDescriptorsOnce();
+  return LedgerUpgradeNotify_descriptor_;
+}
+
+const LedgerUpgradeNotify& LedgerUpgradeNotify::default_instance() {
+  if (default_instance_ == NULL) protobuf_AddDesc_overlay_2eproto();
+  return *default_instance_;
+}
+
+LedgerUpgradeNotify* LedgerUpgradeNotify::default_instance_ = NULL;
+
+LedgerUpgradeNotify* LedgerUpgradeNotify::New(::google::protobuf::Arena* arena) const {
+  LedgerUpgradeNotify* n = new LedgerUpgradeNotify;
+  if (arena != NULL) {
+    arena->Own(n);
+  }
+  return n;
+}
+
+void LedgerUpgradeNotify::Clear() {
+// @@protoc_insertion_point(message_clear_start:protocol.LedgerUpgradeNotify)
+  nonce_ = GOOGLE_LONGLONG(0);
+  if (GetArenaNoVirtual() == NULL && upgrade_ != NULL) delete upgrade_;
+  upgrade_ = NULL;
+  if (GetArenaNoVirtual() == NULL && signature_ != NULL) delete signature_;
+  signature_ = NULL;
+}
+
+bool LedgerUpgradeNotify::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:protocol.LedgerUpgradeNotify)
+  for (;;) {
+    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // optional int64 nonce = 1;
+      case 1: {
+        if (tag == 8) {
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::int64, ::google::protobuf::internal::WireFormatLite::TYPE_INT64>(
+                 input, &nonce_)));
+
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(18)) goto parse_upgrade;
+        break;
+      }
+
+      // optional .protocol.LedgerUpgrade upgrade = 2;
+      case 2: {
+        if (tag == 18) {
+         parse_upgrade:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
+               input, mutable_upgrade()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(26)) goto parse_signature;
+        break;
+      }
+
+      // optional .protocol.Signature signature = 3;
+      case 3: {
+        if (tag == 26) {
+         parse_signature:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
+               input, mutable_signature()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectAtEnd()) goto success;
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0 ||
+            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormatLite::SkipField(input, tag));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:protocol.LedgerUpgradeNotify)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:protocol.LedgerUpgradeNotify)
+  return false;
+#undef DO_
+}
+
+void LedgerUpgradeNotify::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:protocol.LedgerUpgradeNotify)
+  // optional int64 nonce = 1;
+  if (this->nonce() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt64(1, this->nonce(), output);
+  }
+
+  // optional .protocol.LedgerUpgrade upgrade = 2;
+  if (this->has_upgrade()) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      2, *this->upgrade_, output);
+  }
+
+  // optional .protocol.Signature signature = 3;
+  if (this->has_signature()) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      3, *this->signature_, output);
+  }
+
+  // @@protoc_insertion_point(serialize_end:protocol.LedgerUpgradeNotify)
+}
+
+::google::protobuf::uint8* LedgerUpgradeNotify::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  // @@protoc_insertion_point(serialize_to_array_start:protocol.LedgerUpgradeNotify)
+  // optional int64 nonce = 1;
+  if (this->nonce() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteInt64ToArray(1, this->nonce(), target);
+  }
+
+  // optional .protocol.LedgerUpgrade upgrade = 2;
+  if (this->has_upgrade()) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageNoVirtualToArray(
+        2, *this->upgrade_, false, target);
+  }
+
+  // optional .protocol.Signature signature = 3;
+  if (this->has_signature()) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageNoVirtualToArray(
+        3, *this->signature_, false, target);
+  }
+
+  // @@protoc_insertion_point(serialize_to_array_end:protocol.LedgerUpgradeNotify)
+  return target;
+}
+
+int LedgerUpgradeNotify::ByteSize() const {
+// @@protoc_insertion_point(message_byte_size_start:protocol.LedgerUpgradeNotify)
+  int total_size = 0;
+
+  // optional int64 nonce = 1;
+  if (this->nonce() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::Int64Size(
+        this->nonce());
+  }
+
+  // optional .protocol.LedgerUpgrade upgrade = 2;
+  if (this->has_upgrade()) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
+        *this->upgrade_);
+  }
+
+  // optional .protocol.Signature signature = 3;
+  if (this->has_signature()) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
+        *this->signature_);
+  }
+
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = total_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void LedgerUpgradeNotify::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:protocol.LedgerUpgradeNotify)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  const LedgerUpgradeNotify* source = 
+      ::google::protobuf::internal::DynamicCastToGenerated<const LedgerUpgradeNotify>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:protocol.LedgerUpgradeNotify)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:protocol.LedgerUpgradeNotify)
+    MergeFrom(*source);
+  }
+}
+
+void LedgerUpgradeNotify::MergeFrom(const LedgerUpgradeNotify& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:protocol.LedgerUpgradeNotify)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  if (from.nonce() != 0) {
+    set_nonce(from.nonce());
+  }
+  if (from.has_upgrade()) {
+    mutable_upgrade()->::protocol::LedgerUpgrade::MergeFrom(from.upgrade());
+  }
+  if (from.has_signature()) {
+    mutable_signature()->::protocol::Signature::MergeFrom(from.signature());
+  }
+}
+
+void LedgerUpgradeNotify::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:protocol.LedgerUpgradeNotify)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void LedgerUpgradeNotify::CopyFrom(const LedgerUpgradeNotify& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:protocol.LedgerUpgradeNotify)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool LedgerUpgradeNotify::IsInitialized() const {
+
+  return true;
+}
+
+void LedgerUpgradeNotify::Swap(LedgerUpgradeNotify* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void LedgerUpgradeNotify::InternalSwap(LedgerUpgradeNotify* other) {
+  std::swap(nonce_, other->nonce_);
+  std::swap(upgrade_, other->upgrade_);
+  std::swap(signature_, other->signature_);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  std::swap(_cached_size_, other->_cached_size_);
+}
+
+::google::protobuf::Metadata LedgerUpgradeNotify::GetMetadata() const {
+  protobuf_AssignDescriptorsOnce();
+  ::google::protobuf::Metadata metadata;
+  metadata.descriptor = LedgerUpgradeNotify_descriptor_;
+  metadata.reflection = LedgerUpgradeNotify_reflection_;
+  return metadata;
+}
+
+#if PROTOBUF_INLINE_NOT_IN_HEADERS
+// LedgerUpgradeNotify
+
+// optional int64 nonce = 1;
+void LedgerUpgradeNotify::clear_nonce() {
+  nonce_ = GOOGLE_LONGLONG(0);
+}
+ ::google::protobuf::int64 LedgerUpgradeNotify::nonce() const {
+  // @@protoc_insertion_point(field_get:protocol.LedgerUpgradeNotify.nonce)
+  return nonce_;
+}
+ void LedgerUpgradeNotify::set_nonce(::google::protobuf::int64 value) {
+  
+  nonce_ = value;
+  // @@protoc_insertion_point(field_set:protocol.LedgerUpgradeNotify.nonce)
+}
+
+// optional .protocol.LedgerUpgrade upgrade = 2;
+bool LedgerUpgradeNotify::has_upgrade() const {
+  return !_is_default_instance_ && upgrade_ != NULL;
+}
+void LedgerUpgradeNotify::clear_upgrade() {
+  if (GetArenaNoVirtual() == NULL && upgrade_ != NULL) delete upgrade_;
+  upgrade_ = NULL;
+}
+const ::protocol::LedgerUpgrade& LedgerUpgradeNotify::upgrade() const {
+  // @@protoc_insertion_point(field_get:protocol.LedgerUpgradeNotify.upgrade)
+  return upgrade_ != NULL ? *upgrade_ : *default_instance_->upgrade_;
+}
+::protocol::LedgerUpgrade* LedgerUpgradeNotify::mutable_upgrade() {
+  
+  if (upgrade_ == NULL) {
+    upgrade_ = new ::protocol::LedgerUpgrade;
+  }
+  // @@protoc_insertion_point(field_mutable:protocol.LedgerUpgradeNotify.upgrade)
+  return upgrade_;
+}
+::protocol::LedgerUpgrade* LedgerUpgradeNotify::release_upgrade() {
+  // @@protoc_insertion_point(field_release:protocol.LedgerUpgradeNotify.upgrade)
+  
+  ::protocol::LedgerUpgrade* temp = upgrade_;
+  upgrade_ = NULL;
+  return temp;
+}
+void LedgerUpgradeNotify::set_allocated_upgrade(::protocol::LedgerUpgrade* upgrade) {
+  delete upgrade_;
+  upgrade_ = upgrade;
+  if (upgrade) {
+    
+  } else {
+    
+  }
+  // @@protoc_insertion_point(field_set_allocated:protocol.LedgerUpgradeNotify.upgrade)
+}
+
+// optional .protocol.Signature signature = 3;
+bool LedgerUpgradeNotify::has_signature() const {
+  return !_is_default_instance_ && signature_ != NULL;
+}
+void LedgerUpgradeNotify::clear_signature() {
+  if (GetArenaNoVirtual() == NULL && signature_ != NULL) delete signature_;
+  signature_ = NULL;
+}
+const ::protocol::Signature& LedgerUpgradeNotify::signature() const {
+  // @@protoc_insertion_point(field_get:protocol.LedgerUpgradeNotify.signature)
+  return signature_ != NULL ? *signature_ : *default_instance_->signature_;
+}
+::protocol::Signature* LedgerUpgradeNotify::mutable_signature() {
+  
+  if (signature_ == NULL) {
+    signature_ = new ::protocol::Signature;
+  }
+  // @@protoc_insertion_point(field_mutable:protocol.LedgerUpgradeNotify.signature)
+  return signature_;
+}
+::protocol::Signature* LedgerUpgradeNotify::release_signature() {
+  // @@protoc_insertion_point(field_release:protocol.LedgerUpgradeNotify.signature)
+  
+  ::protocol::Signature* temp = signature_;
+  signature_ = NULL;
+  return temp;
+}
+void LedgerUpgradeNotify::set_allocated_signature(::protocol::Signature* signature) {
+  delete signature_;
+  signature_ = signature;
+  if (signature) {
+    
+  } else {
+    
+  }
+  // @@protoc_insertion_point(field_set_allocated:protocol.LedgerUpgradeNotify.signature)
+}
+
+#endif  // PROTOBUF_INLINE_NOT_IN_HEADERS
+
+// ===================================================================
+
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int EntryList::kEntryFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+EntryList::EntryList()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:protocol.EntryList)
+}
+
+void EntryList::InitAsDefaultInstance() {
+  _is_default_instance_ = true;
+}
+
+EntryList::EntryList(const EntryList& from)
+  : ::google::protobuf::Message(),
+    _internal_metadata_(NULL) {
+  SharedCtor();
+  MergeFrom(from);
+  // @@protoc_insertion_point(copy_constructor:protocol.EntryList)
+}
+
+void EntryList::SharedCtor() {
+    _is_default_instance_ = false;
+  ::google::protobuf::internal::GetEmptyString();
+  _cached_size_ = 0;
+}
+
+EntryList::~EntryList() {
+  // @@protoc_insertion_point(destructor:protocol.EntryList)
+  SharedDtor();
+}
+
+void EntryList::SharedDtor() {
+  if (this != default_instance_) {
+  }
+}
+
+void EntryList::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* EntryList::descriptor() {
+  protobuf_AssignDescriptorsOnce();
+  return EntryList_descriptor_;
+}
+
+const EntryList& EntryList::default_instance() {
+  if (default_instance_ == NULL) protobuf_AddDesc_overlay_2eproto();
+  return *default_instance_;
+}
+
+EntryList* EntryList::default_instance_ = NULL;
+
+EntryList* EntryList::New(::google::protobuf::Arena* arena) const {
+  EntryList* n = new EntryList;
+  if (arena != NULL) {
+    arena->Own(n);
+  }
+  return n;
+}
+
+void EntryList::Clear() {
+// @@protoc_insertion_point(message_clear_start:protocol.EntryList)
+  entry_.Clear();
+}
+
+bool EntryList::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:protocol.EntryList)
+  for (;;) {
+    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // repeated bytes entry = 1;
+      case 1: {
+        if (tag == 10) {
+         parse_entry:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->add_entry()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(10)) goto parse_entry;
+        if (input->ExpectAtEnd()) goto success;
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0 ||
+            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormatLite::SkipField(input, tag));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:protocol.EntryList)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:protocol.EntryList)
+  return false;
+#undef DO_
+}
+
+void EntryList::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:protocol.EntryList)
+  // repeated bytes entry = 1;
+  for (int i = 0; i < this->entry_size(); i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytes(
+      1, this->entry(i), output);
+  }
+
+  // @@protoc_insertion_point(serialize_end:protocol.EntryList)
+}
+
+::google::protobuf::uint8* EntryList::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  // @@protoc_insertion_point(serialize_to_array_start:protocol.EntryList)
+  // repeated bytes entry = 1;
+  for (int i = 0; i < this->entry_size(); i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      WriteBytesToArray(1, this->entry(i), target);
+  }
+
+  // @@protoc_insertion_point(serialize_to_array_end:protocol.EntryList)
+  return target;
+}
+
+int EntryList::ByteSize() const {
+// @@protoc_insertion_point(message_byte_size_start:protocol.EntryList)
+  int total_size = 0;
+
+  // repeated bytes entry = 1;
+  total_size += 1 * this->entry_size();
+  for (int i = 0; i < this->entry_size(); i++) {
     total_size += ::google::protobuf::internal::WireFormatLite::BytesSize(
       this->entry(i));
   }
@@ -4325,124 +5675,1334 @@ int EntryList::ByteSize() const {
   return total_size;
 }
 
-void EntryList::MergeFrom(const ::google::protobuf::Message& from) {
-// @@protoc_insertion_point(generalized_merge_from_start:protocol.EntryList)
+void EntryList::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:protocol.EntryList)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  const EntryList* source = 
+      ::google::protobuf::internal::DynamicCastToGenerated<const EntryList>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:protocol.EntryList)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:protocol.EntryList)
+    MergeFrom(*source);
+  }
+}
+
+void EntryList::MergeFrom(const EntryList& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:protocol.EntryList)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  entry_.MergeFrom(from.entry_);
+}
+
+void EntryList::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:protocol.EntryList)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void EntryList::CopyFrom(const EntryList& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:protocol.EntryList)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool EntryList::IsInitialized() const {
+
+  return true;
+}
+
+void EntryList::Swap(EntryList* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void EntryList::InternalSwap(EntryList* other) {
+  entry_.UnsafeArenaSwap(&other->entry_);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  std::swap(_cached_size_, other->_cached_size_);
+}
+
+::google::protobuf::Metadata EntryList::GetMetadata() const {
+  protobuf_AssignDescriptorsOnce();
+  ::google::protobuf::Metadata metadata;
+  metadata.descriptor = EntryList_descriptor_;
+  metadata.reflection = EntryList_reflection_;
+  return metadata;
+}
+
+#if PROTOBUF_INLINE_NOT_IN_HEADERS
+// EntryList
+
+// repeated bytes entry = 1;
+int EntryList::entry_size() const {
+  return entry_.size();
+}
+void EntryList::clear_entry() {
+  entry_.Clear();
+}
+ const ::std::string& EntryList::entry(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.EntryList.entry)
+  return entry_.Get(index);
+}
+ ::std::string* EntryList::mutable_entry(int index) {
+  // @@protoc_insertion_point(field_mutable:protocol.EntryList.entry)
+  return entry_.Mutable(index);
+}
+ void EntryList::set_entry(int index, const ::std::string& value) {
+  // @@protoc_insertion_point(field_set:protocol.EntryList.entry)
+  entry_.Mutable(index)->assign(value);
+}
+ void EntryList::set_entry(int index, const char* value) {
+  entry_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:protocol.EntryList.entry)
+}
+ void EntryList::set_entry(int index, const void* value, size_t size) {
+  entry_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:protocol.EntryList.entry)
+}
+ ::std::string* EntryList::add_entry() {
+  // @@protoc_insertion_point(field_add_mutable:protocol.EntryList.entry)
+  return entry_.Add();
+}
+ void EntryList::add_entry(const ::std::string& value) {
+  entry_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:protocol.EntryList.entry)
+}
+ void EntryList::add_entry(const char* value) {
+  entry_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:protocol.EntryList.entry)
+}
+ void EntryList::add_entry(const void* value, size_t size) {
+  entry_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:protocol.EntryList.entry)
+}
+ const ::google::protobuf::RepeatedPtrField< ::std::string>&
+EntryList::entry() const {
+  // @@protoc_insertion_point(field_list:protocol.EntryList.entry)
+  return entry_;
+}
+ ::google::protobuf::RepeatedPtrField< ::std::string>*
+EntryList::mutable_entry() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.EntryList.entry)
+  return &entry_;
+}
+
+#endif  // PROTOBUF_INLINE_NOT_IN_HEADERS
+
+// ===================================================================
+
+const ::google::protobuf::EnumDescriptor* StateSyncEntry_EntryType_descriptor() {
+  protobuf_AssignDescriptorsOnce();
+  return StateSyncEntry_EntryType_descriptor_;
+}
+bool StateSyncEntry_EntryType_IsValid(int value) {
+  switch(value) {
+    case 0:
+    case 1:
+    case 2:
+    case 3:
+      return true;
+    default:
+      return false;
+  }
+}
+
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const StateSyncEntry_EntryType StateSyncEntry::INNER;
+const StateSyncEntry_EntryType StateSyncEntry::ACCOUNT;
+const StateSyncEntry_EntryType StateSyncEntry::LEAF;
+const StateSyncEntry_EntryType StateSyncEntry::VALUE;
+const StateSyncEntry_EntryType StateSyncEntry::EntryType_MIN;
+const StateSyncEntry_EntryType StateSyncEntry::EntryType_MAX;
+const int StateSyncEntry::EntryType_ARRAYSIZE;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int StateSyncEntry::kTypeFieldNumber;
+const int StateSyncEntry::kPrefixFieldNumber;
+const int StateSyncEntry::kLocationFieldNumber;
+const int StateSyncEntry::kHashFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+StateSyncEntry::StateSyncEntry()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:protocol.StateSyncEntry)
+}
+
+void StateSyncEntry::InitAsDefaultInstance() {
+  _is_default_instance_ = true;
+}
+
+StateSyncEntry::StateSyncEntry(const StateSyncEntry& from)
+  : ::google::protobuf::Message(),
+    _internal_metadata_(NULL) {
+  SharedCtor();
+  MergeFrom(from);
+  // @@protoc_insertion_point(copy_constructor:protocol.StateSyncEntry)
+}
+
+void StateSyncEntry::SharedCtor() {
+    _is_default_instance_ = false;
+  ::google::protobuf::internal::GetEmptyString();
+  _cached_size_ = 0;
+  type_ = 0;
+  prefix_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  location_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  hash_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+
+StateSyncEntry::~StateSyncEntry() {
+  // @@protoc_insertion_point(destructor:protocol.StateSyncEntry)
+  SharedDtor();
+}
+
+void StateSyncEntry::SharedDtor() {
+  prefix_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  location_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  hash_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  if (this != default_instance_) {
+  }
+}
+
+void StateSyncEntry::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* StateSyncEntry::descriptor() {
+  protobuf_AssignDescriptorsOnce();
+  return StateSyncEntry_descriptor_;
+}
+
+const StateSyncEntry& StateSyncEntry::default_instance() {
+  if (default_instance_ == NULL) protobuf_AddDesc_overlay_2eproto();
+  return *default_instance_;
+}
+
+StateSyncEntry* StateSyncEntry::default_instance_ = NULL;
+
+StateSyncEntry* StateSyncEntry::New(::google::protobuf::Arena* arena) const {
+  StateSyncEntry* n = new StateSyncEntry;
+  if (arena != NULL) {
+    arena->Own(n);
+  }
+  return n;
+}
+
+void StateSyncEntry::Clear() {
+// @@protoc_insertion_point(message_clear_start:protocol.StateSyncEntry)
+  type_ = 0;
+  prefix_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  location_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  hash_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+
+bool StateSyncEntry::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:protocol.StateSyncEntry)
+  for (;;) {
+    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // optional .protocol.StateSyncEntry.EntryType type = 1;
+      case 1: {
+        if (tag == 8) {
+          int value;
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   int, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM>(
+                 input, &value)));
+          set_type(static_cast< ::protocol::StateSyncEntry_EntryType >(value));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(18)) goto parse_prefix;
+        break;
+      }
+
+      // optional bytes prefix = 2;
+      case 2: {
+        if (tag == 18) {
+         parse_prefix:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->mutable_prefix()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(26)) goto parse_location;
+        break;
+      }
+
+      // optional bytes location = 3;
+      case 3: {
+        if (tag == 26) {
+         parse_location:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->mutable_location()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(34)) goto parse_hash;
+        break;
+      }
+
+      // optional bytes hash = 4;
+      case 4: {
+        if (tag == 34) {
+         parse_hash:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->mutable_hash()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectAtEnd()) goto success;
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0 ||
+            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormatLite::SkipField(input, tag));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:protocol.StateSyncEntry)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:protocol.StateSyncEntry)
+  return false;
+#undef DO_
+}
+
+void StateSyncEntry::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:protocol.StateSyncEntry)
+  // optional .protocol.StateSyncEntry.EntryType type = 1;
+  if (this->type() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteEnum(
+      1, this->type(), output);
+  }
+
+  // optional bytes prefix = 2;
+  if (this->prefix().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytesMaybeAliased(
+      2, this->prefix(), output);
+  }
+
+  // optional bytes location = 3;
+  if (this->location().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytesMaybeAliased(
+      3, this->location(), output);
+  }
+
+  // optional bytes hash = 4;
+  if (this->hash().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytesMaybeAliased(
+      4, this->hash(), output);
+  }
+
+  // @@protoc_insertion_point(serialize_end:protocol.StateSyncEntry)
+}
+
+::google::protobuf::uint8* StateSyncEntry::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  // @@protoc_insertion_point(serialize_to_array_start:protocol.StateSyncEntry)
+  // optional .protocol.StateSyncEntry.EntryType type = 1;
+  if (this->type() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteEnumToArray(
+      1, this->type(), target);
+  }
+
+  // optional bytes prefix = 2;
+  if (this->prefix().size() > 0) {
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
+        2, this->prefix(), target);
+  }
+
+  // optional bytes location = 3;
+  if (this->location().size() > 0) {
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
+        3, this->location(), target);
+  }
+
+  // optional bytes hash = 4;
+  if (this->hash().size() > 0) {
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
+        4, this->hash(), target);
+  }
+
+  // @@protoc_insertion_point(serialize_to_array_end:protocol.StateSyncEntry)
+  return target;
+}
+
+int StateSyncEntry::ByteSize() const {
+// @@protoc_insertion_point(message_byte_size_start:protocol.StateSyncEntry)
+  int total_size = 0;
+
+  // optional .protocol.StateSyncEntry.EntryType type = 1;
+  if (this->type() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::EnumSize(this->type());
+  }
+
+  // optional bytes prefix = 2;
+  if (this->prefix().size() > 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::BytesSize(
+        this->prefix());
+  }
+
+  // optional bytes location = 3;
+  if (this->location().size() > 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::BytesSize(
+        this->location());
+  }
+
+  // optional bytes hash = 4;
+  if (this->hash().size() > 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::BytesSize(
+        this->hash());
+  }
+
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = total_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void StateSyncEntry::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:protocol.StateSyncEntry)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  const StateSyncEntry* source = 
+      ::google::protobuf::internal::DynamicCastToGenerated<const StateSyncEntry>(
+          &from);
+  if (source == NULL) {
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:protocol.StateSyncEntry)
+    ::google::protobuf::internal::ReflectionOps::Merge(from, this);
+  } else {
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:protocol.StateSyncEntry)
+    MergeFrom(*source);
+  }
+}
+
+void StateSyncEntry::MergeFrom(const StateSyncEntry& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:protocol.StateSyncEntry)
+  if (GOOGLE_PREDICT_FALSE(&from == this)) {
+    ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
+  }
+  if (from.type() != 0) {
+    set_type(from.type());
+  }
+  if (from.prefix().size() > 0) {
+
+    prefix_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.prefix_);
+  }
+  if (from.location().size() > 0) {
+
+    location_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.location_);
+  }
+  if (from.hash().size() > 0) {
+
+    hash_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.hash_);
+  }
+}
+
+void StateSyncEntry::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:protocol.StateSyncEntry)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+void StateSyncEntry::CopyFrom(const StateSyncEntry& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:protocol.StateSyncEntry)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+bool StateSyncEntry::IsInitialized() const {
+
+  return true;
+}
+
+void StateSyncEntry::Swap(StateSyncEntry* other) {
+  if (other == this) return;
+  InternalSwap(other);
+}
+void StateSyncEntry::InternalSwap(StateSyncEntry* other) {
+  std::swap(type_, other->type_);
+  prefix_.Swap(&other->prefix_);
+  location_.Swap(&other->location_);
+  hash_.Swap(&other->hash_);
+  _internal_metadata_.Swap(&other->_internal_metadata_);
+  std::swap(_cached_size_, other->_cached_size_);
+}
+
+::google::protobuf::Metadata StateSyncEntry::GetMetadata() const {
+  protobuf_AssignDescriptorsOnce();
+  ::google::protobuf::Metadata metadata;
+  metadata.descriptor = StateSyncEntry_descriptor_;
+  metadata.reflection = StateSyncEntry_reflection_;
+  return metadata;
+}
+
+#if PROTOBUF_INLINE_NOT_IN_HEADERS
+// StateSyncEntry
+
+// optional .protocol.StateSyncEntry.EntryType type = 1;
+void StateSyncEntry::clear_type() {
+  type_ = 0;
+}
+ ::protocol::StateSyncEntry_EntryType StateSyncEntry::type() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncEntry.type)
+  return static_cast< ::protocol::StateSyncEntry_EntryType >(type_);
+}
+ void StateSyncEntry::set_type(::protocol::StateSyncEntry_EntryType value) {
+  
+  type_ = value;
+  // @@protoc_insertion_point(field_set:protocol.StateSyncEntry.type)
+}
+
+// optional bytes prefix = 2;
+void StateSyncEntry::clear_prefix() {
+  prefix_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ const ::std::string& StateSyncEntry::prefix() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncEntry.prefix)
+  return prefix_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ void StateSyncEntry::set_prefix(const ::std::string& value) {
+  
+  prefix_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.StateSyncEntry.prefix)
+}
+ void StateSyncEntry::set_prefix(const char* value) {
+  
+  prefix_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.StateSyncEntry.prefix)
+}
+ void StateSyncEntry::set_prefix(const void* value, size_t size) {
+  
+  prefix_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.StateSyncEntry.prefix)
+}
+ ::std::string* StateSyncEntry::mutable_prefix() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.StateSyncEntry.prefix)
+  return prefix_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ ::std::string* StateSyncEntry::release_prefix() {
+  // @@protoc_insertion_point(field_release:protocol.StateSyncEntry.prefix)
+  
+  return prefix_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ void StateSyncEntry::set_allocated_prefix(::std::string* prefix) {
+  if (prefix != NULL) {
+    
+  } else {
+    
+  }
+  prefix_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), prefix);
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateSyncEntry.prefix)
+}
+
+// optional bytes location = 3;
+void StateSyncEntry::clear_location() {
+  location_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ const ::std::string& StateSyncEntry::location() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncEntry.location)
+  return location_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ void StateSyncEntry::set_location(const ::std::string& value) {
+  
+  location_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.StateSyncEntry.location)
+}
+ void StateSyncEntry::set_location(const char* value) {
+  
+  location_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.StateSyncEntry.location)
+}
+ void StateSyncEntry::set_location(const void* value, size_t size) {
+  
+  location_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.StateSyncEntry.location)
+}
+ ::std::string* StateSyncEntry::mutable_location() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.StateSyncEntry.location)
+  return location_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ ::std::string* StateSyncEntry::release_location() {
+  // @@protoc_insertion_point(field_release:protocol.StateSyncEntry.location)
+  
+  return location_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ void StateSyncEntry::set_allocated_location(::std::string* location) {
+  if (location != NULL) {
+    
+  } else {
+    
+  }
+  location_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), location);
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateSyncEntry.location)
+}
+
+// optional bytes hash = 4;
+void StateSyncEntry::clear_hash() {
+  hash_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ const ::std::string& StateSyncEntry::hash() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncEntry.hash)
+  return hash_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ void StateSyncEntry::set_hash(const ::std::string& value) {
+  
+  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.StateSyncEntry.hash)
+}
+ void StateSyncEntry::set_hash(const char* value) {
+  
+  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.StateSyncEntry.hash)
+}
+ void StateSyncEntry::set_hash(const void* value, size_t size) {
+  
+  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.StateSyncEntry.hash)
+}
+ ::std::string* StateSyncEntry::mutable_hash() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.StateSyncEntry.hash)
+  return hash_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ ::std::string* StateSyncEntry::release_hash() {
+  // @@protoc_insertion_point(field_release:protocol.StateSyncEntry.hash)
+  
+  return hash_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ void StateSyncEntry::set_allocated_hash(::std::string* hash) {
+  if (hash != NULL) {
+    
+  } else {
+    
+  }
+  hash_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), hash);
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateSyncEntry.hash)
+}
+
+#endif  // PROTOBUF_INLINE_NOT_IN_HEADERS
+
+// ===================================================================
+
+#if !defined(_MSC_VER) || _MSC_VER >= 1900
+const int StateSyncStatus::kLedgerFieldNumber;
+const int StateSyncStatus::kProofFieldNumber;
+const int StateSyncStatus::kAccountRootFieldNumber;
+const int StateSyncStatus::kPendingFieldNumber;
+const int StateSyncStatus::kAccountCountFieldNumber;
+const int StateSyncStatus::kNodeCountFieldNumber;
+const int StateSyncStatus::kCommittingFieldNumber;
+#endif  // !defined(_MSC_VER) || _MSC_VER >= 1900
+
+StateSyncStatus::StateSyncStatus()
+  : ::google::protobuf::Message(), _internal_metadata_(NULL) {
+  SharedCtor();
+  // @@protoc_insertion_point(constructor:protocol.StateSyncStatus)
+}
+
+void StateSyncStatus::InitAsDefaultInstance() {
+  _is_default_instance_ = true;
+  ledger_ = const_cast< ::protocol::Ledger*>(&::protocol::Ledger::default_instance());
+}
+
+StateSyncStatus::StateSyncStatus(const StateSyncStatus& from)
+  : ::google::protobuf::Message(),
+    _internal_metadata_(NULL) {
+  SharedCtor();
+  MergeFrom(from);
+  // @@protoc_insertion_point(copy_constructor:protocol.StateSyncStatus)
+}
+
+void StateSyncStatus::SharedCtor() {
+    _is_default_instance_ = false;
+  ::google::protobuf::internal::GetEmptyString();
+  _cached_size_ = 0;
+  ledger_ = NULL;
+  proof_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  account_root_.UnsafeSetDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  account_count_ = GOOGLE_LONGLONG(0);
+  node_count_ = GOOGLE_LONGLONG(0);
+  committing_ = false;
+}
+
+StateSyncStatus::~StateSyncStatus() {
+  // @@protoc_insertion_point(destructor:protocol.StateSyncStatus)
+  SharedDtor();
+}
+
+void StateSyncStatus::SharedDtor() {
+  proof_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  account_root_.DestroyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  if (this != default_instance_) {
+    delete ledger_;
+  }
+}
+
+void StateSyncStatus::SetCachedSize(int size) const {
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+}
+const ::google::protobuf::Descriptor* StateSyncStatus::descriptor() {
+  protobuf_AssignDescriptorsOnce();
+  return StateSyncStatus_descriptor_;
+}
+
+const StateSyncStatus& StateSyncStatus::default_instance() {
+  if (default_instance_ == NULL) protobuf_AddDesc_overlay_2eproto();
+  return *default_instance_;
+}
+
+StateSyncStatus* StateSyncStatus::default_instance_ = NULL;
+
+StateSyncStatus* StateSyncStatus::New(::google::protobuf::Arena* arena) const {
+  StateSyncStatus* n = new StateSyncStatus;
+  if (arena != NULL) {
+    arena->Own(n);
+  }
+  return n;
+}
+
+void StateSyncStatus::Clear() {
+// @@protoc_insertion_point(message_clear_start:protocol.StateSyncStatus)
+#if defined(__clang__)
+#define ZR_HELPER_(f) \
+  _Pragma("clang diagnostic push") \
+  _Pragma("clang diagnostic ignored \"-Winvalid-offsetof\"") \
+  __builtin_offsetof(StateSyncStatus, f) \
+  _Pragma("clang diagnostic pop")
+#else
+#define ZR_HELPER_(f) reinterpret_cast<char*>(\
+  &reinterpret_cast<StateSyncStatus*>(16)->f)
+#endif
+
+#define ZR_(first, last) do {\
+  ::memset(&first, 0,\
+           ZR_HELPER_(last) - ZR_HELPER_(first) + sizeof(last));\
+} while (0)
+
+  ZR_(account_count_, committing_);
+  if (GetArenaNoVirtual() == NULL && ledger_ != NULL) delete ledger_;
+  ledger_ = NULL;
+  proof_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+  account_root_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+
+#undef ZR_HELPER_
+#undef ZR_
+
+  pending_.Clear();
+}
+
+bool StateSyncStatus::MergePartialFromCodedStream(
+    ::google::protobuf::io::CodedInputStream* input) {
+#define DO_(EXPRESSION) if (!GOOGLE_PREDICT_TRUE(EXPRESSION)) goto failure
+  ::google::protobuf::uint32 tag;
+  // @@protoc_insertion_point(parse_start:protocol.StateSyncStatus)
+  for (;;) {
+    ::std::pair< ::google::protobuf::uint32, bool> p = input->ReadTagWithCutoff(127);
+    tag = p.first;
+    if (!p.second) goto handle_unusual;
+    switch (::google::protobuf::internal::WireFormatLite::GetTagFieldNumber(tag)) {
+      // optional .protocol.Ledger ledger = 1;
+      case 1: {
+        if (tag == 10) {
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtual(
+               input, mutable_ledger()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(18)) goto parse_proof;
+        break;
+      }
+
+      // optional bytes proof = 2;
+      case 2: {
+        if (tag == 18) {
+         parse_proof:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->mutable_proof()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(26)) goto parse_account_root;
+        break;
+      }
+
+      // optional bytes account_root = 3;
+      case 3: {
+        if (tag == 26) {
+         parse_account_root:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadBytes(
+                input, this->mutable_account_root()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(34)) goto parse_pending;
+        break;
+      }
+
+      // repeated .protocol.StateSyncEntry pending = 4;
+      case 4: {
+        if (tag == 34) {
+         parse_pending:
+          DO_(input->IncrementRecursionDepth());
+         parse_loop_pending:
+          DO_(::google::protobuf::internal::WireFormatLite::ReadMessageNoVirtualNoRecursionDepth(
+                input, add_pending()));
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(34)) goto parse_loop_pending;
+        input->UnsafeDecrementRecursionDepth();
+        if (input->ExpectTag(40)) goto parse_account_count;
+        break;
+      }
+
+      // optional int64 account_count = 5;
+      case 5: {
+        if (tag == 40) {
+         parse_account_count:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::int64, ::google::protobuf::internal::WireFormatLite::TYPE_INT64>(
+                 input, &account_count_)));
+
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(48)) goto parse_node_count;
+        break;
+      }
+
+      // optional int64 node_count = 6;
+      case 6: {
+        if (tag == 48) {
+         parse_node_count:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   ::google::protobuf::int64, ::google::protobuf::internal::WireFormatLite::TYPE_INT64>(
+                 input, &node_count_)));
+
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectTag(56)) goto parse_committing;
+        break;
+      }
+
+      // optional bool committing = 7;
+      case 7: {
+        if (tag == 56) {
+         parse_committing:
+          DO_((::google::protobuf::internal::WireFormatLite::ReadPrimitive<
+                   bool, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL>(
+                 input, &committing_)));
+
+        } else {
+          goto handle_unusual;
+        }
+        if (input->ExpectAtEnd()) goto success;
+        break;
+      }
+
+      default: {
+      handle_unusual:
+        if (tag == 0 ||
+            ::google::protobuf::internal::WireFormatLite::GetTagWireType(tag) ==
+            ::google::protobuf::internal::WireFormatLite::WIRETYPE_END_GROUP) {
+          goto success;
+        }
+        DO_(::google::protobuf::internal::WireFormatLite::SkipField(input, tag));
+        break;
+      }
+    }
+  }
+success:
+  // @@protoc_insertion_point(parse_success:protocol.StateSyncStatus)
+  return true;
+failure:
+  // @@protoc_insertion_point(parse_failure:protocol.StateSyncStatus)
+  return false;
+#undef DO_
+}
+
+void StateSyncStatus::SerializeWithCachedSizes(
+    ::google::protobuf::io::CodedOutputStream* output) const {
+  // @@protoc_insertion_point(serialize_start:protocol.StateSyncStatus)
+  // optional .protocol.Ledger ledger = 1;
+  if (this->has_ledger()) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      1, *this->ledger_, output);
+  }
+
+  // optional bytes proof = 2;
+  if (this->proof().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytesMaybeAliased(
+      2, this->proof(), output);
+  }
+
+  // optional bytes account_root = 3;
+  if (this->account_root().size() > 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBytesMaybeAliased(
+      3, this->account_root(), output);
+  }
+
+  // repeated .protocol.StateSyncEntry pending = 4;
+  for (unsigned int i = 0, n = this->pending_size(); i < n; i++) {
+    ::google::protobuf::internal::WireFormatLite::WriteMessageMaybeToArray(
+      4, this->pending(i), output);
+  }
+
+  // optional int64 account_count = 5;
+  if (this->account_count() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt64(5, this->account_count(), output);
+  }
+
+  // optional int64 node_count = 6;
+  if (this->node_count() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteInt64(6, this->node_count(), output);
+  }
+
+  // optional bool committing = 7;
+  if (this->committing() != 0) {
+    ::google::protobuf::internal::WireFormatLite::WriteBool(7, this->committing(), output);
+  }
+
+  // @@protoc_insertion_point(serialize_end:protocol.StateSyncStatus)
+}
+
+::google::protobuf::uint8* StateSyncStatus::InternalSerializeWithCachedSizesToArray(
+    bool deterministic, ::google::protobuf::uint8* target) const {
+  // @@protoc_insertion_point(serialize_to_array_start:protocol.StateSyncStatus)
+  // optional .protocol.Ledger ledger = 1;
+  if (this->has_ledger()) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageNoVirtualToArray(
+        1, *this->ledger_, false, target);
+  }
+
+  // optional bytes proof = 2;
+  if (this->proof().size() > 0) {
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
+        2, this->proof(), target);
+  }
+
+  // optional bytes account_root = 3;
+  if (this->account_root().size() > 0) {
+    target =
+      ::google::protobuf::internal::WireFormatLite::WriteBytesToArray(
+        3, this->account_root(), target);
+  }
+
+  // repeated .protocol.StateSyncEntry pending = 4;
+  for (unsigned int i = 0, n = this->pending_size(); i < n; i++) {
+    target = ::google::protobuf::internal::WireFormatLite::
+      InternalWriteMessageNoVirtualToArray(
+        4, this->pending(i), false, target);
+  }
+
+  // optional int64 account_count = 5;
+  if (this->account_count() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteInt64ToArray(5, this->account_count(), target);
+  }
+
+  // optional int64 node_count = 6;
+  if (this->node_count() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteInt64ToArray(6, this->node_count(), target);
+  }
+
+  // optional bool committing = 7;
+  if (this->committing() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::WriteBoolToArray(7, this->committing(), target);
+  }
+
+  // @@protoc_insertion_point(serialize_to_array_end:protocol.StateSyncStatus)
+  return target;
+}
+
+int StateSyncStatus::ByteSize() const {
+// @@protoc_insertion_point(message_byte_size_start:protocol.StateSyncStatus)
+  int total_size = 0;
+
+  // optional .protocol.Ledger ledger = 1;
+  if (this->has_ledger()) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
+        *this->ledger_);
+  }
+
+  // optional bytes proof = 2;
+  if (this->proof().size() > 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::BytesSize(
+        this->proof());
+  }
+
+  // optional bytes account_root = 3;
+  if (this->account_root().size() > 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::BytesSize(
+        this->account_root());
+  }
+
+  // optional int64 account_count = 5;
+  if (this->account_count() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::Int64Size(
+        this->account_count());
+  }
+
+  // optional int64 node_count = 6;
+  if (this->node_count() != 0) {
+    total_size += 1 +
+      ::google::protobuf::internal::WireFormatLite::Int64Size(
+        this->node_count());
+  }
+
+  // optional bool committing = 7;
+  if (this->committing() != 0) {
+    total_size += 1 + 1;
+  }
+
+  // repeated .protocol.StateSyncEntry pending = 4;
+  total_size += 1 * this->pending_size();
+  for (int i = 0; i < this->pending_size(); i++) {
+    total_size +=
+      ::google::protobuf::internal::WireFormatLite::MessageSizeNoVirtual(
+        this->pending(i));
+  }
+
+  GOOGLE_SAFE_CONCURRENT_WRITES_BEGIN();
+  _cached_size_ = total_size;
+  GOOGLE_SAFE_CONCURRENT_WRITES_END();
+  return total_size;
+}
+
+void StateSyncStatus::MergeFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_merge_from_start:protocol.StateSyncStatus)
   if (GOOGLE_PREDICT_FALSE(&from == this)) {
     ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
   }
-  const EntryList* source = 
-      ::google::protobuf::internal::DynamicCastToGenerated<const EntryList>(
+  const StateSyncStatus* source = 
+      ::google::protobuf::internal::DynamicCastToGenerated<const StateSyncStatus>(
           &from);
   if (source == NULL) {
-  // @@protoc_insertion_point(generalized_merge_from_cast_fail:protocol.EntryList)
+  // @@protoc_insertion_point(generalized_merge_from_cast_fail:protocol.StateSyncStatus)
     ::google::protobuf::internal::ReflectionOps::Merge(from, this);
   } else {
-  // @@protoc_insertion_point(generalized_merge_from_cast_success:protocol.EntryList)
+  // @@protoc_insertion_point(generalized_merge_from_cast_success:protocol.StateSyncStatus)
     MergeFrom(*source);
   }
 }
 
-void EntryList::MergeFrom(const EntryList& from) {
-// @@protoc_insertion_point(class_specific_merge_from_start:protocol.EntryList)
+void StateSyncStatus::MergeFrom(const StateSyncStatus& from) {
+// @@protoc_insertion_point(class_specific_merge_from_start:protocol.StateSyncStatus)
   if (GOOGLE_PREDICT_FALSE(&from == this)) {
     ::google::protobuf::internal::MergeFromFail(__FILE__, __LINE__);
   }
-  entry_.MergeFrom(from.entry_);
+  pending_.MergeFrom(from.pending_);
+  if (from.has_ledger()) {
+    mutable_ledger()->::protocol::Ledger::MergeFrom(from.ledger());
+  }
+  if (from.proof().size() > 0) {
+
+    proof_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.proof_);
+  }
+  if (from.account_root().size() > 0) {
+
+    account_root_.AssignWithDefault(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), from.account_root_);
+  }
+  if (from.account_count() != 0) {
+    set_account_count(from.account_count());
+  }
+  if (from.node_count() != 0) {
+    set_node_count(from.node_count());
+  }
+  if (from.committing() != 0) {
+    set_committing(from.committing());
+  }
 }
 
-void EntryList::CopyFrom(const ::google::protobuf::Message& from) {
-// @@protoc_insertion_point(generalized_copy_from_start:protocol.EntryList)
+void StateSyncStatus::CopyFrom(const ::google::protobuf::Message& from) {
+// @@protoc_insertion_point(generalized_copy_from_start:protocol.StateSyncStatus)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
-void EntryList::CopyFrom(const EntryList& from) {
-// @@protoc_insertion_point(class_specific_copy_from_start:protocol.EntryList)
+void StateSyncStatus::CopyFrom(const StateSyncStatus& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:protocol.StateSyncStatus)
   if (&from == this) return;
   Clear();
   MergeFrom(from);
 }
 
-bool EntryList::IsInitialized() const {
+bool StateSyncStatus::IsInitialized() const {
 
   return true;
 }
 
-void EntryList::Swap(EntryList* other) {
+void StateSyncStatus::Swap(StateSyncStatus* other) {
   if (other == this) return;
   InternalSwap(other);
 }
-void EntryList::InternalSwap(EntryList* other) {
-  entry_.UnsafeArenaSwap(&other->entry_);
+void StateSyncStatus::InternalSwap(StateSyncStatus* other) {
+  std::swap(ledger_, other->ledger_);
+  proof_.Swap(&other->proof_);
+  account_root_.Swap(&other->account_root_);
+  pending_.UnsafeArenaSwap(&other->pending_);
+  std::swap(account_count_, other->account_count_);
+  std::swap(node_count_, other->node_count_);
+  std::swap(committing_, other->committing_);
   _internal_metadata_.Swap(&other->_internal_metadata_);
   std::swap(_cached_size_, other->_cached_size_);
 }
 
-::google::protobuf::Metadata EntryList::GetMetadata() const {
+::google::protobuf::Metadata StateSyncStatus::GetMetadata() const {
   protobuf_AssignDescriptorsOnce();
   ::google::protobuf::Metadata metadata;
-  metadata.descriptor = EntryList_descriptor_;
-  metadata.reflection = EntryList_reflection_;
+  metadata.descriptor = StateSyncStatus_descriptor_;
+  metadata.reflection = StateSyncStatus_reflection_;
   return metadata;
 }
 
 #if PROTOBUF_INLINE_NOT_IN_HEADERS
-// EntryList
+// StateSyncStatus
 
-// repeated bytes entry = 1;
-int EntryList::entry_size() const {
-  return entry_.size();
+// optional .protocol.Ledger ledger = 1;
+bool StateSyncStatus::has_ledger() const {
+  return !_is_default_instance_ && ledger_ != NULL;
 }
-void EntryList::clear_entry() {
-  entry_.Clear();
+void StateSyncStatus::clear_ledger() {
+  if (GetArenaNoVirtual() == NULL && ledger_ != NULL) delete ledger_;
+  ledger_ = NULL;
 }
- const ::std::string& EntryList::entry(int index) const {
-  // @@protoc_insertion_point(field_get:protocol.EntryList.entry)
-  return entry_.Get(index);
+const ::protocol::Ledger& StateSyncStatus::ledger() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncStatus.ledger)
+  return ledger_ != NULL ? *ledger_ : *default_instance_->ledger_;
 }
- ::std::string* EntryList::mutable_entry(int index) {
-  // @@protoc_insertion_point(field_mutable:protocol.EntryList.entry)
-  return entry_.Mutable(index);
+::protocol::Ledger* StateSyncStatus::mutable_ledger() {
+  
+  if (ledger_ == NULL) {
+    ledger_ = new ::protocol::Ledger;
+  }
+  // @@protoc_insertion_point(field_mutable:protocol.StateSyncStatus.ledger)
+  return ledger_;
 }
- void EntryList::set_entry(int index, const ::std::string& value) {
-  // @@protoc_insertion_point(field_set:protocol.EntryList.entry)
-  entry_.Mutable(index)->assign(value);
+::protocol::Ledger* StateSyncStatus::release_ledger() {
+  // @@protoc_insertion_point(field_release:protocol.StateSyncStatus.ledger)
+  
+  ::protocol::Ledger* temp = ledger_;
+  ledger_ = NULL;
+  return temp;
 }
- void EntryList::set_entry(int index, const char* value) {
-  entry_.Mutable(index)->assign(value);
-  // @@protoc_insertion_point(field_set_char:protocol.EntryList.entry)
+void StateSyncStatus::set_allocated_ledger(::protocol::Ledger* ledger) {
+  delete ledger_;
+  ledger_ = ledger;
+  if (ledger) {
+    
+  } else {
+    
+  }
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateSyncStatus.ledger)
 }
- void EntryList::set_entry(int index, const void* value, size_t size) {
-  entry_.Mutable(index)->assign(
-    reinterpret_cast<const char*>(value), size);
-  // @@protoc_insertion_point(field_set_pointer:protocol.EntryList.entry)
+
+// optional bytes proof = 2;
+void StateSyncStatus::clear_proof() {
+  proof_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
 }
- ::std::string* EntryList::add_entry() {
-  // @@protoc_insertion_point(field_add_mutable:protocol.EntryList.entry)
-  return entry_.Add();
+ const ::std::string& StateSyncStatus::proof() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncStatus.proof)
+  return proof_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
 }
- void EntryList::add_entry(const ::std::string& value) {
-  entry_.Add()->assign(value);
-  // @@protoc_insertion_point(field_add:protocol.EntryList.entry)
+ void StateSyncStatus::set_proof(const ::std::string& value) {
+  
+  proof_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.StateSyncStatus.proof)
 }
- void EntryList::add_entry(const char* value) {
-  entry_.Add()->assign(value);
-  // @@protoc_insertion_point(field_add_char:protocol.EntryList.entry)
+ void StateSyncStatus::set_proof(const char* value) {
+  
+  proof_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.StateSyncStatus.proof)
 }
- void EntryList::add_entry(const void* value, size_t size) {
-  entry_.Add()->assign(reinterpret_cast<const char*>(value), size);
-  // @@protoc_insertion_point(field_add_pointer:protocol.EntryList.entry)
+ void StateSyncStatus::set_proof(const void* value, size_t size) {
+  
+  proof_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.StateSyncStatus.proof)
 }
- const ::google::protobuf::RepeatedPtrField< ::std::string>&
-EntryList::entry() const {
-  // @@protoc_insertion_point(field_list:protocol.EntryList.entry)
-  return entry_;
+ ::std::string* StateSyncStatus::mutable_proof() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.StateSyncStatus.proof)
+  return proof_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
 }
- ::google::protobuf::RepeatedPtrField< ::std::string>*
-EntryList::mutable_entry() {
-  // @@protoc_insertion_point(field_mutable_list:protocol.EntryList.entry)
-  return &entry_;
+ ::std::string* StateSyncStatus::release_proof() {
+  // @@protoc_insertion_point(field_release:protocol.StateSyncStatus.proof)
+  
+  return proof_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ void StateSyncStatus::set_allocated_proof(::std::string* proof) {
+  if (proof != NULL) {
+    
+  } else {
+    
+  }
+  proof_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), proof);
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateSyncStatus.proof)
+}
+
+// optional bytes account_root = 3;
+void StateSyncStatus::clear_account_root() {
+  account_root_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ const ::std::string& StateSyncStatus::account_root() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncStatus.account_root)
+  return account_root_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ void StateSyncStatus::set_account_root(const ::std::string& value) {
+  
+  account_root_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.StateSyncStatus.account_root)
+}
+ void StateSyncStatus::set_account_root(const char* value) {
+  
+  account_root_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.StateSyncStatus.account_root)
+}
+ void StateSyncStatus::set_account_root(const void* value, size_t size) {
+  
+  account_root_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.StateSyncStatus.account_root)
+}
+ ::std::string* StateSyncStatus::mutable_account_root() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.StateSyncStatus.account_root)
+  return account_root_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ ::std::string* StateSyncStatus::release_account_root() {
+  // @@protoc_insertion_point(field_release:protocol.StateSyncStatus.account_root)
+  
+  return account_root_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+ void StateSyncStatus::set_allocated_account_root(::std::string* account_root) {
+  if (account_root != NULL) {
+    
+  } else {
+    
+  }
+  account_root_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), account_root);
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateSyncStatus.account_root)
+}
+
+// repeated .protocol.StateSyncEntry pending = 4;
+int StateSyncStatus::pending_size() const {
+  return pending_.size();
+}
+void StateSyncStatus::clear_pending() {
+  pending_.Clear();
+}
+const ::protocol::StateSyncEntry& StateSyncStatus::pending(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncStatus.pending)
+  return pending_.Get(index);
+}
+::protocol::StateSyncEntry* StateSyncStatus::mutable_pending(int index) {
+  // @@protoc_insertion_point(field_mutable:protocol.StateSyncStatus.pending)
+  return pending_.Mutable(index);
+}
+::protocol::StateSyncEntry* StateSyncStatus::add_pending() {
+  // @@protoc_insertion_point(field_add:protocol.StateSyncStatus.pending)
+  return pending_.Add();
+}
+::google::protobuf::RepeatedPtrField< ::protocol::StateSyncEntry >*
+StateSyncStatus::mutable_pending() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.StateSyncStatus.pending)
+  return &pending_;
+}
+const ::google::protobuf::RepeatedPtrField< ::protocol::StateSyncEntry >&
+StateSyncStatus::pending() const {
+  // @@protoc_insertion_point(field_list:protocol.StateSyncStatus.pending)
+  return pending_;
+}
+
+// optional int64 account_count = 5;
+void StateSyncStatus::clear_account_count() {
+  account_count_ = GOOGLE_LONGLONG(0);
+}
+ ::google::protobuf::int64 StateSyncStatus::account_count() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncStatus.account_count)
+  return account_count_;
+}
+ void StateSyncStatus::set_account_count(::google::protobuf::int64 value) {
+  
+  account_count_ = value;
+  // @@protoc_insertion_point(field_set:protocol.StateSyncStatus.account_count)
+}
+
+// optional int64 node_count = 6;
+void StateSyncStatus::clear_node_count() {
+  node_count_ = GOOGLE_LONGLONG(0);
+}
+ ::google::protobuf::int64 StateSyncStatus::node_count() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncStatus.node_count)
+  return node_count_;
+}
+ void StateSyncStatus::set_node_count(::google::protobuf::int64 value) {
+  
+  node_count_ = value;
+  // @@protoc_insertion_point(field_set:protocol.StateSyncStatus.node_count)
+}
+
+// optional bool committing = 7;
+void StateSyncStatus::clear_committing() {
+  committing_ = false;
+}
+ bool StateSyncStatus::committing() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncStatus.committing)
+  return committing_;
+}
+ void StateSyncStatus::set_committing(bool value) {
+  
+  committing_ = value;
+  // @@protoc_insertion_point(field_set:protocol.StateSyncStatus.committing)
 }
 
 #endif  // PROTOBUF_INLINE_NOT_IN_HEADERS
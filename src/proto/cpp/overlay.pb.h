@@ -49,12 +49,16 @@ class ChainTxStatus;
 class DontHave;
 class EntryList;
 class GetLedgers;
+class GetStateNodes;
 class Hello;
 class HelloResponse;
 class LedgerUpgradeNotify;
 class Ledgers;
 class Peer;
 class Peers;
+class StateNodes;
+class StateSyncEntry;
+class StateSyncStatus;
 
 enum Ledgers_SyncCode {
   Ledgers_SyncCode_OK = 0,
@@ -63,12 +67,13 @@ enum Ledgers_SyncCode {
   Ledgers_SyncCode_BUSY = 3,
   Ledgers_SyncCode_REFUSE = 4,
   Ledgers_SyncCode_INTERNAL = 5,
+  Ledgers_SyncCode_PRUNED = 6,
   Ledgers_SyncCode_Ledgers_SyncCode_INT_MIN_SENTINEL_DO_NOT_USE_ = ::google::protobuf::kint32min,
   Ledgers_SyncCode_Ledgers_SyncCode_INT_MAX_SENTINEL_DO_NOT_USE_ = ::google::protobuf::kint32max
 };
 bool Ledgers_SyncCode_IsValid(int value);
 const Ledgers_SyncCode Ledgers_SyncCode_SyncCode_MIN = Ledgers_SyncCode_OK;
-const Ledgers_SyncCode Ledgers_SyncCode_SyncCode_MAX = Ledgers_SyncCode_INTERNAL;
+const Ledgers_SyncCode Ledgers_SyncCode_SyncCode_MAX = Ledgers_SyncCode_PRUNED;
 const int Ledgers_SyncCode_SyncCode_ARRAYSIZE = Ledgers_SyncCode_SyncCode_MAX + 1;
 
 const ::google::protobuf::EnumDescriptor* Ledgers_SyncCode_descriptor();
@@ -81,6 +86,53 @@ inline bool Ledgers_SyncCode_Parse(
   return ::google::protobuf::internal::ParseNamedEnum<Ledgers_SyncCode>(
     Ledgers_SyncCode_descriptor(), name, value);
 }
+enum StateNodes_SyncCode {
+  StateNodes_SyncCode_OK = 0,
+  StateNodes_SyncCode_NOT_READY = 1,
+  StateNodes_SyncCode_EXPIRED = 2,
+  StateNodes_SyncCode_OUT_OF_NODES = 3,
+  StateNodes_SyncCode_INTERNAL = 4,
+  StateNodes_SyncCode_StateNodes_SyncCode_INT_MIN_SENTINEL_DO_NOT_USE_ = ::google::protobuf::kint32min,
+  StateNodes_SyncCode_StateNodes_SyncCode_INT_MAX_SENTINEL_DO_NOT_USE_ = ::google::protobuf::kint32max
+};
+bool StateNodes_SyncCode_IsValid(int value);
+const StateNodes_SyncCode StateNodes_SyncCode_SyncCode_MIN = StateNodes_SyncCode_OK;
+const StateNodes_SyncCode StateNodes_SyncCode_SyncCode_MAX = StateNodes_SyncCode_INTERNAL;
+const int StateNodes_SyncCode_SyncCode_ARRAYSIZE = StateNodes_SyncCode_SyncCode_MAX + 1;
+
+const ::google::protobuf::EnumDescriptor* StateNodes_SyncCode_descriptor();
+inline const ::std::string& StateNodes_SyncCode_Name(StateNodes_SyncCode value) {
+  return ::google::protobuf::internal::NameOfEnum(
+    StateNodes_SyncCode_descriptor(), value);
+}
+inline bool StateNodes_SyncCode_Parse(
+    const ::std::string& name, StateNodes_SyncCode* value) {
+  return ::google::protobuf::internal::ParseNamedEnum<StateNodes_SyncCode>(
+    StateNodes_SyncCode_descriptor(), name, value);
+}
+enum StateSyncEntry_EntryType {
+  StateSyncEntry_EntryType_INNER = 0,
+  StateSyncEntry_EntryType_ACCOUNT = 1,
+  StateSyncEntry_EntryType_LEAF = 2,
+  StateSyncEntry_EntryType_VALUE = 3,
+  StateSyncEntry_EntryType_StateSyncEntry_EntryType_INT_MIN_SENTINEL_DO_NOT_USE_ = ::google::protobuf::kint32min,
+  StateSyncEntry_EntryType_StateSyncEntry_EntryType_INT_MAX_SENTINEL_DO_NOT_USE_ = ::google::protobuf::kint32max
+};
+bool StateSyncEntry_EntryType_IsValid(int value);
+const StateSyncEntry_EntryType StateSyncEntry_EntryType_EntryType_MIN = StateSyncEntry_EntryType_INNER;
+const StateSyncEntry_EntryType StateSyncEntry_EntryType_EntryType_MAX = StateSyncEntry_EntryType_VALUE;
+const int StateSyncEntry_EntryType_EntryType_ARRAYSIZE = StateSyncEntry_EntryType_EntryType_MAX + 1;
+
+const ::google::protobuf::EnumDescriptor* StateSyncEntry_EntryType_descriptor();
+inline const ::std::string& StateSyncEntry_EntryType_Name(StateSyncEntry_EntryType value) {
+  return ::google::protobuf::internal::NameOfEnum(
+    StateSyncEntry_EntryType_descriptor(), value);
+}
+inline bool StateSyncEntry_EntryType_Parse(
+    const ::std::string& name, StateSyncEntry_EntryType* value) {
+  return ::google::protobuf::internal::ParseNamedEnum<StateSyncEntry_EntryType>(
+    StateSyncEntry_EntryType_descriptor(), name, value);
+}
 enum ChainTxStatus_TxStatus {
   ChainTxStatus_TxStatus_UNDEFINED = 0,
   ChainTxStatus_TxStatus_CONFIRMED = 1,
@@ -114,12 +166,13 @@ enum OVERLAY_MESSAGE_TYPE {
   OVERLAY_MSGTYPE_LEDGERS = 5,
   OVERLAY_MSGTYPE_PBFT = 6,
   OVERLAY_MSGTYPE_LEDGER_UPGRADE_NOTIFY = 7,
+  OVERLAY_MSGTYPE_STATE_NODES = 8,
   OVERLAY_MESSAGE_TYPE_INT_MIN_SENTINEL_DO_NOT_USE_ = ::google::protobuf::kint32min,
   OVERLAY_MESSAGE_TYPE_INT_MAX_SENTINEL_DO_NOT_USE_ = ::google::protobuf::kint32max
 };
 bool OVERLAY_MESSAGE_TYPE_IsValid(int value);
 const OVERLAY_MESSAGE_TYPE OVERLAY_MESSAGE_TYPE_MIN = OVERLAY_MSGTYPE_NONE;
-const OVERLAY_MESSAGE_TYPE OVERLAY_MESSAGE_TYPE_MAX = OVERLAY_MSGTYPE_LEDGER_UPGRADE_NOTIFY;
+const OVERLAY_MESSAGE_TYPE OVERLAY_MESSAGE_TYPE_MAX = OVERLAY_MSGTYPE_STATE_NODES;
 const int OVERLAY_MESSAGE_TYPE_ARRAYSIZE = OVERLAY_MESSAGE_TYPE_MAX + 1;
 
 const ::google::protobuf::EnumDescriptor* OVERLAY_MESSAGE_TYPE_descriptor();
@@ -780,6 +833,8 @@ class Ledgers : public ::google::protobuf::Message /* @@protoc_insertion_point(c
     Ledgers_SyncCode_REFUSE;
   static const SyncCode INTERNAL =
     Ledgers_SyncCode_INTERNAL;
+  static const SyncCode PRUNED =
+    Ledgers_SyncCode_PRUNED;
   static inline bool SyncCode_IsValid(int value) {
     return Ledgers_SyncCode_IsValid(value);
   }
@@ -864,6 +919,306 @@ class Ledgers : public ::google::protobuf::Message /* @@protoc_insertion_point(c
 };
 // -------------------------------------------------------------------
 
+class GetStateNodes : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:protocol.GetStateNodes) */ {
+ public:
+  GetStateNodes();
+  virtual ~GetStateNodes();
+
+  GetStateNodes(const GetStateNodes& from);
+
+  inline GetStateNodes& operator=(const GetStateNodes& from) {
+    CopyFrom(from);
+    return *this;
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const GetStateNodes& default_instance();
+
+  void Swap(GetStateNodes* other);
+
+  // implements Message ----------------------------------------------
+
+  inline GetStateNodes* New() const { return New(NULL); }
+
+  GetStateNodes* New(::google::protobuf::Arena* arena) const;
+  void CopyFrom(const ::google::protobuf::Message& from);
+  void MergeFrom(const ::google::protobuf::Message& from);
+  void CopyFrom(const GetStateNodes& from);
+  void MergeFrom(const GetStateNodes& from);
+  void Clear();
+  bool IsInitialized() const;
+
+  int ByteSize() const;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input);
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* output) const;
+  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const {
+    return InternalSerializeWithCachedSizesToArray(false, output);
+  }
+  int GetCachedSize() const { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const;
+  void InternalSwap(GetStateNodes* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return _internal_metadata_.arena();
+  }
+  inline void* MaybeArenaPtr() const {
+    return _internal_metadata_.raw_arena_ptr();
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // optional int64 ledger_seq = 1;
+  void clear_ledger_seq();
+  static const int kLedgerSeqFieldNumber = 1;
+  ::google::protobuf::int64 ledger_seq() const;
+  void set_ledger_seq(::google::protobuf::int64 value);
+
+  // repeated bytes keys = 2;
+  int keys_size() const;
+  void clear_keys();
+  static const int kKeysFieldNumber = 2;
+  const ::std::string& keys(int index) const;
+  ::std::string* mutable_keys(int index);
+  void set_keys(int index, const ::std::string& value);
+  void set_keys(int index, const char* value);
+  void set_keys(int index, const void* value, size_t size);
+  ::std::string* add_keys();
+  void add_keys(const ::std::string& value);
+  void add_keys(const char* value);
+  void add_keys(const void* value, size_t size);
+  const ::google::protobuf::RepeatedPtrField< ::std::string>& keys() const;
+  ::google::protobuf::RepeatedPtrField< ::std::string>* mutable_keys();
+
+  // optional int64 chain_id = 3;
+  void clear_chain_id();
+  static const int kChainIdFieldNumber = 3;
+  ::google::protobuf::int64 chain_id() const;
+  void set_chain_id(::google::protobuf::int64 value);
+
+  // @@protoc_insertion_point(class_scope:protocol.GetStateNodes)
+ private:
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  bool _is_default_instance_;
+  ::google::protobuf::int64 ledger_seq_;
+  ::google::protobuf::RepeatedPtrField< ::std::string> keys_;
+  ::google::protobuf::int64 chain_id_;
+  mutable int _cached_size_;
+  friend void  protobuf_AddDesc_overlay_2eproto();
+  friend void protobuf_AssignDesc_overlay_2eproto();
+  friend void protobuf_ShutdownFile_overlay_2eproto();
+
+  void InitAsDefaultInstance();
+  static GetStateNodes* default_instance_;
+};
+// -------------------------------------------------------------------
+
+class StateNodes : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:protocol.StateNodes) */ {
+ public:
+  StateNodes();
+  virtual ~StateNodes();
+
+  StateNodes(const StateNodes& from);
+
+  inline StateNodes& operator=(const StateNodes& from) {
+    CopyFrom(from);
+    return *this;
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const StateNodes& default_instance();
+
+  void Swap(StateNodes* other);
+
+  // implements Message ----------------------------------------------
+
+  inline StateNodes* New() const { return New(NULL); }
+
+  StateNodes* New(::google::protobuf::Arena* arena) const;
+  void CopyFrom(const ::google::protobuf::Message& from);
+  void MergeFrom(const ::google::protobuf::Message& from);
+  void CopyFrom(const StateNodes& from);
+  void MergeFrom(const StateNodes& from);
+  void Clear();
+  bool IsInitialized() const;
+
+  int ByteSize() const;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input);
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* output) const;
+  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const {
+    return InternalSerializeWithCachedSizesToArray(false, output);
+  }
+  int GetCachedSize() const { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const;
+  void InternalSwap(StateNodes* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return _internal_metadata_.arena();
+  }
+  inline void* MaybeArenaPtr() const {
+    return _internal_metadata_.raw_arena_ptr();
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const;
+
+  // nested types ----------------------------------------------------
+
+  typedef StateNodes_SyncCode SyncCode;
+  static const SyncCode OK =
+    StateNodes_SyncCode_OK;
+  static const SyncCode NOT_READY =
+    StateNodes_SyncCode_NOT_READY;
+  static const SyncCode EXPIRED =
+    StateNodes_SyncCode_EXPIRED;
+  static const SyncCode OUT_OF_NODES =
+    StateNodes_SyncCode_OUT_OF_NODES;
+  static const SyncCode INTERNAL =
+    StateNodes_SyncCode_INTERNAL;
+  static inline bool SyncCode_IsValid(int value) {
+    return StateNodes_SyncCode_IsValid(value);
+  }
+  static const SyncCode SyncCode_MIN =
+    StateNodes_SyncCode_SyncCode_MIN;
+  static const SyncCode SyncCode_MAX =
+    StateNodes_SyncCode_SyncCode_MAX;
+  static const int SyncCode_ARRAYSIZE =
+    StateNodes_SyncCode_SyncCode_ARRAYSIZE;
+  static inline const ::google::protobuf::EnumDescriptor*
+  SyncCode_descriptor() {
+    return StateNodes_SyncCode_descriptor();
+  }
+  static inline const ::std::string& SyncCode_Name(SyncCode value) {
+    return StateNodes_SyncCode_Name(value);
+  }
+  static inline bool SyncCode_Parse(const ::std::string& name,
+      SyncCode* value) {
+    return StateNodes_SyncCode_Parse(name, value);
+  }
+
+  // accessors -------------------------------------------------------
+
+  // optional .protocol.StateNodes.SyncCode sync_code = 1;
+  void clear_sync_code();
+  static const int kSyncCodeFieldNumber = 1;
+  ::protocol::StateNodes_SyncCode sync_code() const;
+  void set_sync_code(::protocol::StateNodes_SyncCode value);
+
+  // optional int64 ledger_seq = 2;
+  void clear_ledger_seq();
+  static const int kLedgerSeqFieldNumber = 2;
+  ::google::protobuf::int64 ledger_seq() const;
+  void set_ledger_seq(::google::protobuf::int64 value);
+
+  // optional .protocol.Ledger ledger = 3;
+  bool has_ledger() const;
+  void clear_ledger();
+  static const int kLedgerFieldNumber = 3;
+  const ::protocol::Ledger& ledger() const;
+  ::protocol::Ledger* mutable_ledger();
+  ::protocol::Ledger* release_ledger();
+  void set_allocated_ledger(::protocol::Ledger* ledger);
+
+  // optional .protocol.ConsensusValue next_value = 4;
+  bool has_next_value() const;
+  void clear_next_value();
+  static const int kNextValueFieldNumber = 4;
+  const ::protocol::ConsensusValue& next_value() const;
+  ::protocol::ConsensusValue* mutable_next_value();
+  ::protocol::ConsensusValue* release_next_value();
+  void set_allocated_next_value(::protocol::ConsensusValue* next_value);
+
+  // optional bytes next_proof = 5;
+  void clear_next_proof();
+  static const int kNextProofFieldNumber = 5;
+  const ::std::string& next_proof() const;
+  void set_next_proof(const ::std::string& value);
+  void set_next_proof(const char* value);
+  void set_next_proof(const void* value, size_t size);
+  ::std::string* mutable_next_proof();
+  ::std::string* release_next_proof();
+  void set_allocated_next_proof(::std::string* next_proof);
+
+  // repeated bytes keys = 6;
+  int keys_size() const;
+  void clear_keys();
+  static const int kKeysFieldNumber = 6;
+  const ::std::string& keys(int index) const;
+  ::std::string* mutable_keys(int index);
+  void set_keys(int index, const ::std::string& value);
+  void set_keys(int index, const char* value);
+  void set_keys(int index, const void* value, size_t size);
+  ::std::string* add_keys();
+  void add_keys(const ::std::string& value);
+  void add_keys(const char* value);
+  void add_keys(const void* value, size_t size);
+  const ::google::protobuf::RepeatedPtrField< ::std::string>& keys() const;
+  ::google::protobuf::RepeatedPtrField< ::std::string>* mutable_keys();
+
+  // repeated bytes values = 7;
+  int values_size() const;
+  void clear_values();
+  static const int kValuesFieldNumber = 7;
+  const ::std::string& values(int index) const;
+  ::std::string* mutable_values(int index);
+  void set_values(int index, const ::std::string& value);
+  void set_values(int index, const char* value);
+  void set_values(int index, const void* value, size_t size);
+  ::std::string* add_values();
+  void add_values(const ::std::string& value);
+  void add_values(const char* value);
+  void add_values(const void* value, size_t size);
+  const ::google::protobuf::RepeatedPtrField< ::std::string>& values() const;
+  ::google::protobuf::RepeatedPtrField< ::std::string>* mutable_values();
+
+  // optional int64 chain_id = 8;
+  void clear_chain_id();
+  static const int kChainIdFieldNumber = 8;
+  ::google::protobuf::int64 chain_id() const;
+  void set_chain_id(::google::protobuf::int64 value);
+
+  // @@protoc_insertion_point(class_scope:protocol.StateNodes)
+ private:
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  bool _is_default_instance_;
+  ::google::protobuf::int64 ledger_seq_;
+  ::protocol::Ledger* ledger_;
+  ::protocol::ConsensusValue* next_value_;
+  ::google::protobuf::internal::ArenaStringPtr next_proof_;
+  ::google::protobuf::RepeatedPtrField< ::std::string> keys_;
+  ::google::protobuf::RepeatedPtrField< ::std::string> values_;
+  ::google::protobuf::int64 chain_id_;
+  int sync_code_;
+  mutable int _cached_size_;
+  friend void  protobuf_AddDesc_overlay_2eproto();
+  friend void protobuf_AssignDesc_overlay_2eproto();
+  friend void protobuf_ShutdownFile_overlay_2eproto();
+
+  void InitAsDefaultInstance();
+  static StateNodes* default_instance_;
+};
+// -------------------------------------------------------------------
+
 class DontHave : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:protocol.DontHave) */ {
  public:
   DontHave();
@@ -1152,32 +1507,32 @@ class EntryList : public ::google::protobuf::Message /* @@protoc_insertion_point
 };
 // -------------------------------------------------------------------
 
-class ChainHello : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:protocol.ChainHello) */ {
+class StateSyncEntry : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:protocol.StateSyncEntry) */ {
  public:
-  ChainHello();
-  virtual ~ChainHello();
+  StateSyncEntry();
+  virtual ~StateSyncEntry();
 
-  ChainHello(const ChainHello& from);
+  StateSyncEntry(const StateSyncEntry& from);
 
-  inline ChainHello& operator=(const ChainHello& from) {
+  inline StateSyncEntry& operator=(const StateSyncEntry& from) {
     CopyFrom(from);
     return *this;
   }
 
   static const ::google::protobuf::Descriptor* descriptor();
-  static const ChainHello& default_instance();
+  static const StateSyncEntry& default_instance();
 
-  void Swap(ChainHello* other);
+  void Swap(StateSyncEntry* other);
 
   // implements Message ----------------------------------------------
 
-  inline ChainHello* New() const { return New(NULL); }
+  inline StateSyncEntry* New() const { return New(NULL); }
 
-  ChainHello* New(::google::protobuf::Arena* arena) const;
+  StateSyncEntry* New(::google::protobuf::Arena* arena) const;
   void CopyFrom(const ::google::protobuf::Message& from);
   void MergeFrom(const ::google::protobuf::Message& from);
-  void CopyFrom(const ChainHello& from);
-  void MergeFrom(const ChainHello& from);
+  void CopyFrom(const StateSyncEntry& from);
+  void MergeFrom(const StateSyncEntry& from);
   void Clear();
   bool IsInitialized() const;
 
@@ -1196,7 +1551,7 @@ class ChainHello : public ::google::protobuf::Message /* @@protoc_insertion_poin
   void SharedCtor();
   void SharedDtor();
   void SetCachedSize(int size) const;
-  void InternalSwap(ChainHello* other);
+  void InternalSwap(StateSyncEntry* other);
   private:
   inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
     return _internal_metadata_.arena();
@@ -1210,68 +1565,122 @@ class ChainHello : public ::google::protobuf::Message /* @@protoc_insertion_poin
 
   // nested types ----------------------------------------------------
 
-  // accessors -------------------------------------------------------
+  typedef StateSyncEntry_EntryType EntryType;
+  static const EntryType INNER =
+    StateSyncEntry_EntryType_INNER;
+  static const EntryType ACCOUNT =
+    StateSyncEntry_EntryType_ACCOUNT;
+  static const EntryType LEAF =
+    StateSyncEntry_EntryType_LEAF;
+  static const EntryType VALUE =
+    StateSyncEntry_EntryType_VALUE;
+  static inline bool EntryType_IsValid(int value) {
+    return StateSyncEntry_EntryType_IsValid(value);
+  }
+  static const EntryType EntryType_MIN =
+    StateSyncEntry_EntryType_EntryType_MIN;
+  static const EntryType EntryType_MAX =
+    StateSyncEntry_EntryType_EntryType_MAX;
+  static const int EntryType_ARRAYSIZE =
+    StateSyncEntry_EntryType_EntryType_ARRAYSIZE;
+  static inline const ::google::protobuf::EnumDescriptor*
+  EntryType_descriptor() {
+    return StateSyncEntry_EntryType_descriptor();
+  }
+  static inline const ::std::string& EntryType_Name(EntryType value) {
+    return StateSyncEntry_EntryType_Name(value);
+  }
+  static inline bool EntryType_Parse(const ::std::string& name,
+      EntryType* value) {
+    return StateSyncEntry_EntryType_Parse(name, value);
+  }
 
-  // repeated .protocol.ChainMessageType api_list = 1;
-  int api_list_size() const;
-  void clear_api_list();
-  static const int kApiListFieldNumber = 1;
-  ::protocol::ChainMessageType api_list(int index) const;
-  void set_api_list(int index, ::protocol::ChainMessageType value);
-  void add_api_list(::protocol::ChainMessageType value);
-  const ::google::protobuf::RepeatedField<int>& api_list() const;
-  ::google::protobuf::RepeatedField<int>* mutable_api_list();
+  // accessors -------------------------------------------------------
 
-  // optional int64 timestamp = 2;
-  void clear_timestamp();
-  static const int kTimestampFieldNumber = 2;
-  ::google::protobuf::int64 timestamp() const;
-  void set_timestamp(::google::protobuf::int64 value);
+  // optional .protocol.StateSyncEntry.EntryType type = 1;
+  void clear_type();
+  static const int kTypeFieldNumber = 1;
+  ::protocol::StateSyncEntry_EntryType type() const;
+  void set_type(::protocol::StateSyncEntry_EntryType value);
+
+  // optional bytes prefix = 2;
+  void clear_prefix();
+  static const int kPrefixFieldNumber = 2;
+  const ::std::string& prefix() const;
+  void set_prefix(const ::std::string& value);
+  void set_prefix(const char* value);
+  void set_prefix(const void* value, size_t size);
+  ::std::string* mutable_prefix();
+  ::std::string* release_prefix();
+  void set_allocated_prefix(::std::string* prefix);
+
+  // optional bytes location = 3;
+  void clear_location();
+  static const int kLocationFieldNumber = 3;
+  const ::std::string& location() const;
+  void set_location(const ::std::string& value);
+  void set_location(const char* value);
+  void set_location(const void* value, size_t size);
+  ::std::string* mutable_location();
+  ::std::string* release_location();
+  void set_allocated_location(::std::string* location);
+
+  // optional bytes hash = 4;
+  void clear_hash();
+  static const int kHashFieldNumber = 4;
+  const ::std::string& hash() const;
+  void set_hash(const ::std::string& value);
+  void set_hash(const char* value);
+  void set_hash(const void* value, size_t size);
+  ::std::string* mutable_hash();
+  ::std::string* release_hash();
+  void set_allocated_hash(::std::string* hash);
 
-  // @@protoc_insertion_point(class_scope:protocol.ChainHello)
+  // @@protoc_insertion_point(class_scope:protocol.StateSyncEntry)
  private:
 
   ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
   bool _is_default_instance_;
-  ::google::protobuf::RepeatedField<int> api_list_;
-  mutable int _api_list_cached_byte_size_;
-  ::google::protobuf::int64 timestamp_;
+  ::google::protobuf::internal::ArenaStringPtr prefix_;
+  ::google::protobuf::internal::ArenaStringPtr location_;
+  ::google::protobuf::internal::ArenaStringPtr hash_;
+  int type_;
   mutable int _cached_size_;
   friend void  protobuf_AddDesc_overlay_2eproto();
   friend void protobuf_AssignDesc_overlay_2eproto();
   friend void protobuf_ShutdownFile_overlay_2eproto();
 
   void InitAsDefaultInstance();
-  static ChainHello* default_instance_;
+  static StateSyncEntry* default_instance_;
 };
 // -------------------------------------------------------------------
 
-class ChainStatus : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:protocol.ChainStatus) */ {
+class StateSyncStatus : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:protocol.StateSyncStatus) */ {
  public:
-  ChainStatus();
-  virtual ~ChainStatus();
+  StateSyncStatus();
+  virtual ~StateSyncStatus();
 
-  ChainStatus(const ChainStatus& from);
+  StateSyncStatus(const StateSyncStatus& from);
 
-  inline ChainStatus& operator=(const ChainStatus& from) {
+  inline StateSyncStatus& operator=(const StateSyncStatus& from) {
     CopyFrom(from);
     return *this;
   }
 
   static const ::google::protobuf::Descriptor* descriptor();
-  static const ChainStatus& default_instance();
+  static const StateSyncStatus& default_instance();
 
-  void Swap(ChainStatus* other);
+  void Swap(StateSyncStatus* other);
 
   // implements Message ----------------------------------------------
 
-  inline ChainStatus* New() const { return New(NULL); }
+  inline StateSyncStatus* New() const { return New(NULL); }
 
-  ChainStatus* New(::google::protobuf::Arena* arena) const;
+  StateSyncStatus* New(::google::protobuf::Arena* arena) const;
   void CopyFrom(const ::google::protobuf::Message& from);
   void MergeFrom(const ::google::protobuf::Message& from);
-  void CopyFrom(const ChainStatus& from);
-  void MergeFrom(const ChainStatus& from);
+  void CopyFrom(const StateSyncStatus& from);
+  void MergeFrom(const StateSyncStatus& from);
   void Clear();
   bool IsInitialized() const;
 
@@ -1290,7 +1699,7 @@ class ChainStatus : public ::google::protobuf::Message /* @@protoc_insertion_poi
   void SharedCtor();
   void SharedDtor();
   void SetCachedSize(int size) const;
-  void InternalSwap(ChainStatus* other);
+  void InternalSwap(StateSyncStatus* other);
   private:
   inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
     return _internal_metadata_.arena();
@@ -1306,24 +1715,261 @@ class ChainStatus : public ::google::protobuf::Message /* @@protoc_insertion_poi
 
   // accessors -------------------------------------------------------
 
-  // optional string self_addr = 1;
-  void clear_self_addr();
-  static const int kSelfAddrFieldNumber = 1;
-  const ::std::string& self_addr() const;
-  void set_self_addr(const ::std::string& value);
-  void set_self_addr(const char* value);
-  void set_self_addr(const char* value, size_t size);
-  ::std::string* mutable_self_addr();
-  ::std::string* release_self_addr();
-  void set_allocated_self_addr(::std::string* self_addr);
+  // optional .protocol.Ledger ledger = 1;
+  bool has_ledger() const;
+  void clear_ledger();
+  static const int kLedgerFieldNumber = 1;
+  const ::protocol::Ledger& ledger() const;
+  ::protocol::Ledger* mutable_ledger();
+  ::protocol::Ledger* release_ledger();
+  void set_allocated_ledger(::protocol::Ledger* ledger);
 
-  // optional int64 ledger_version = 2;
-  void clear_ledger_version();
-  static const int kLedgerVersionFieldNumber = 2;
-  ::google::protobuf::int64 ledger_version() const;
-  void set_ledger_version(::google::protobuf::int64 value);
+  // optional bytes proof = 2;
+  void clear_proof();
+  static const int kProofFieldNumber = 2;
+  const ::std::string& proof() const;
+  void set_proof(const ::std::string& value);
+  void set_proof(const char* value);
+  void set_proof(const void* value, size_t size);
+  ::std::string* mutable_proof();
+  ::std::string* release_proof();
+  void set_allocated_proof(::std::string* proof);
 
-  // optional int64 monitor_version = 3;
+  // optional bytes account_root = 3;
+  void clear_account_root();
+  static const int kAccountRootFieldNumber = 3;
+  const ::std::string& account_root() const;
+  void set_account_root(const ::std::string& value);
+  void set_account_root(const char* value);
+  void set_account_root(const void* value, size_t size);
+  ::std::string* mutable_account_root();
+  ::std::string* release_account_root();
+  void set_allocated_account_root(::std::string* account_root);
+
+  // repeated .protocol.StateSyncEntry pending = 4;
+  int pending_size() const;
+  void clear_pending();
+  static const int kPendingFieldNumber = 4;
+  const ::protocol::StateSyncEntry& pending(int index) const;
+  ::protocol::StateSyncEntry* mutable_pending(int index);
+  ::protocol::StateSyncEntry* add_pending();
+  ::google::protobuf::RepeatedPtrField< ::protocol::StateSyncEntry >*
+      mutable_pending();
+  const ::google::protobuf::RepeatedPtrField< ::protocol::StateSyncEntry >&
+      pending() const;
+
+  // optional int64 account_count = 5;
+  void clear_account_count();
+  static const int kAccountCountFieldNumber = 5;
+  ::google::protobuf::int64 account_count() const;
+  void set_account_count(::google::protobuf::int64 value);
+
+  // optional int64 node_count = 6;
+  void clear_node_count();
+  static const int kNodeCountFieldNumber = 6;
+  ::google::protobuf::int64 node_count() const;
+  void set_node_count(::google::protobuf::int64 value);
+
+  // optional bool committing = 7;
+  void clear_committing();
+  static const int kCommittingFieldNumber = 7;
+  bool committing() const;
+  void set_committing(bool value);
+
+  // @@protoc_insertion_point(class_scope:protocol.StateSyncStatus)
+ private:
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  bool _is_default_instance_;
+  ::protocol::Ledger* ledger_;
+  ::google::protobuf::internal::ArenaStringPtr proof_;
+  ::google::protobuf::internal::ArenaStringPtr account_root_;
+  ::google::protobuf::RepeatedPtrField< ::protocol::StateSyncEntry > pending_;
+  ::google::protobuf::int64 account_count_;
+  ::google::protobuf::int64 node_count_;
+  bool committing_;
+  mutable int _cached_size_;
+  friend void  protobuf_AddDesc_overlay_2eproto();
+  friend void protobuf_AssignDesc_overlay_2eproto();
+  friend void protobuf_ShutdownFile_overlay_2eproto();
+
+  void InitAsDefaultInstance();
+  static StateSyncStatus* default_instance_;
+};
+// -------------------------------------------------------------------
+
+class ChainHello : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:protocol.ChainHello) */ {
+ public:
+  ChainHello();
+  virtual ~ChainHello();
+
+  ChainHello(const ChainHello& from);
+
+  inline ChainHello& operator=(const ChainHello& from) {
+    CopyFrom(from);
+    return *this;
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const ChainHello& default_instance();
+
+  void Swap(ChainHello* other);
+
+  // implements Message ----------------------------------------------
+
+  inline ChainHello* New() const { return New(NULL); }
+
+  ChainHello* New(::google::protobuf::Arena* arena) const;
+  void CopyFrom(const ::google::protobuf::Message& from);
+  void MergeFrom(const ::google::protobuf::Message& from);
+  void CopyFrom(const ChainHello& from);
+  void MergeFrom(const ChainHello& from);
+  void Clear();
+  bool IsInitialized() const;
+
+  int ByteSize() const;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input);
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* output) const;
+  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const {
+    return InternalSerializeWithCachedSizesToArray(false, output);
+  }
+  int GetCachedSize() const { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const;
+  void InternalSwap(ChainHello* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return _internal_metadata_.arena();
+  }
+  inline void* MaybeArenaPtr() const {
+    return _internal_metadata_.raw_arena_ptr();
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // repeated .protocol.ChainMessageType api_list = 1;
+  int api_list_size() const;
+  void clear_api_list();
+  static const int kApiListFieldNumber = 1;
+  ::protocol::ChainMessageType api_list(int index) const;
+  void set_api_list(int index, ::protocol::ChainMessageType value);
+  void add_api_list(::protocol::ChainMessageType value);
+  const ::google::protobuf::RepeatedField<int>& api_list() const;
+  ::google::protobuf::RepeatedField<int>* mutable_api_list();
+
+  // optional int64 timestamp = 2;
+  void clear_timestamp();
+  static const int kTimestampFieldNumber = 2;
+  ::google::protobuf::int64 timestamp() const;
+  void set_timestamp(::google::protobuf::int64 value);
+
+  // @@protoc_insertion_point(class_scope:protocol.ChainHello)
+ private:
+
+  ::google::protobuf::internal::InternalMetadataWithArena _internal_metadata_;
+  bool _is_default_instance_;
+  ::google::protobuf::RepeatedField<int> api_list_;
+  mutable int _api_list_cached_byte_size_;
+  ::google::protobuf::int64 timestamp_;
+  mutable int _cached_size_;
+  friend void  protobuf_AddDesc_overlay_2eproto();
+  friend void protobuf_AssignDesc_overlay_2eproto();
+  friend void protobuf_ShutdownFile_overlay_2eproto();
+
+  void InitAsDefaultInstance();
+  static ChainHello* default_instance_;
+};
+// -------------------------------------------------------------------
+
+class ChainStatus : public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:protocol.ChainStatus) */ {
+ public:
+  ChainStatus();
+  virtual ~ChainStatus();
+
+  ChainStatus(const ChainStatus& from);
+
+  inline ChainStatus& operator=(const ChainStatus& from) {
+    CopyFrom(from);
+    return *this;
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor();
+  static const ChainStatus& default_instance();
+
+  void Swap(ChainStatus* other);
+
+  // implements Message ----------------------------------------------
+
+  inline ChainStatus* New() const { return New(NULL); }
+
+  ChainStatus* New(::google::protobuf::Arena* arena) const;
+  void CopyFrom(const ::google::protobuf::Message& from);
+  void MergeFrom(const ::google::protobuf::Message& from);
+  void CopyFrom(const ChainStatus& from);
+  void MergeFrom(const ChainStatus& from);
+  void Clear();
+  bool IsInitialized() const;
+
+  int ByteSize() const;
+  bool MergePartialFromCodedStream(
+      ::google::protobuf::io::CodedInputStream* input);
+  void SerializeWithCachedSizes(
+      ::google::protobuf::io::CodedOutputStream* output) const;
+  ::google::protobuf::uint8* InternalSerializeWithCachedSizesToArray(
+      bool deterministic, ::google::protobuf::uint8* output) const;
+  ::google::protobuf::uint8* SerializeWithCachedSizesToArray(::google::protobuf::uint8* output) const {
+    return InternalSerializeWithCachedSizesToArray(false, output);
+  }
+  int GetCachedSize() const { return _cached_size_; }
+  private:
+  void SharedCtor();
+  void SharedDtor();
+  void SetCachedSize(int size) const;
+  void InternalSwap(ChainStatus* other);
+  private:
+  inline ::google::protobuf::Arena* GetArenaNoVirtual() const {
+    return _internal_metadata_.arena();
+  }
+  inline void* MaybeArenaPtr() const {
+    return _internal_metadata_.raw_arena_ptr();
+  }
+  public:
+
+  ::google::protobuf::Metadata GetMetadata() const;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  // optional string self_addr = 1;
+  void clear_self_addr();
+  static const int kSelfAddrFieldNumber = 1;
+  const ::std::string& self_addr() const;
+  void set_self_addr(const ::std::string& value);
+  void set_self_addr(const char* value);
+  void set_self_addr(const char* value, size_t size);
+  ::std::string* mutable_self_addr();
+  ::std::string* release_self_addr();
+  void set_allocated_self_addr(::std::string* self_addr);
+
+  // optional int64 ledger_version = 2;
+  void clear_ledger_version();
+  static const int kLedgerVersionFieldNumber = 2;
+  ::google::protobuf::int64 ledger_version() const;
+  void set_ledger_version(::google::protobuf::int64 value);
+
+  // optional int64 monitor_version = 3;
   void clear_monitor_version();
   static const int kMonitorVersionFieldNumber = 3;
   ::google::protobuf::int64 monitor_version() const;
@@ -2537,75 +3183,438 @@ inline void Ledgers::set_chain_id(::google::protobuf::int64 value) {
 
 // -------------------------------------------------------------------
 
-// DontHave
+// GetStateNodes
 
-// optional int64 type = 1;
-inline void DontHave::clear_type() {
-  type_ = GOOGLE_LONGLONG(0);
+// optional int64 ledger_seq = 1;
+inline void GetStateNodes::clear_ledger_seq() {
+  ledger_seq_ = GOOGLE_LONGLONG(0);
 }
-inline ::google::protobuf::int64 DontHave::type() const {
-  // @@protoc_insertion_point(field_get:protocol.DontHave.type)
-  return type_;
+inline ::google::protobuf::int64 GetStateNodes::ledger_seq() const {
+  // @@protoc_insertion_point(field_get:protocol.GetStateNodes.ledger_seq)
+  return ledger_seq_;
 }
-inline void DontHave::set_type(::google::protobuf::int64 value) {
+inline void GetStateNodes::set_ledger_seq(::google::protobuf::int64 value) {
   
-  type_ = value;
-  // @@protoc_insertion_point(field_set:protocol.DontHave.type)
+  ledger_seq_ = value;
+  // @@protoc_insertion_point(field_set:protocol.GetStateNodes.ledger_seq)
 }
 
-// optional bytes hash = 2;
-inline void DontHave::clear_hash() {
-  hash_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+// repeated bytes keys = 2;
+inline int GetStateNodes::keys_size() const {
+  return keys_.size();
 }
-inline const ::std::string& DontHave::hash() const {
-  // @@protoc_insertion_point(field_get:protocol.DontHave.hash)
-  return hash_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+inline void GetStateNodes::clear_keys() {
+  keys_.Clear();
 }
-inline void DontHave::set_hash(const ::std::string& value) {
-  
-  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
-  // @@protoc_insertion_point(field_set:protocol.DontHave.hash)
+inline const ::std::string& GetStateNodes::keys(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.GetStateNodes.keys)
+  return keys_.Get(index);
 }
-inline void DontHave::set_hash(const char* value) {
-  
-  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
-  // @@protoc_insertion_point(field_set_char:protocol.DontHave.hash)
+inline ::std::string* GetStateNodes::mutable_keys(int index) {
+  // @@protoc_insertion_point(field_mutable:protocol.GetStateNodes.keys)
+  return keys_.Mutable(index);
 }
-inline void DontHave::set_hash(const void* value, size_t size) {
-  
-  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
-      ::std::string(reinterpret_cast<const char*>(value), size));
-  // @@protoc_insertion_point(field_set_pointer:protocol.DontHave.hash)
+inline void GetStateNodes::set_keys(int index, const ::std::string& value) {
+  // @@protoc_insertion_point(field_set:protocol.GetStateNodes.keys)
+  keys_.Mutable(index)->assign(value);
 }
-inline ::std::string* DontHave::mutable_hash() {
-  
-  // @@protoc_insertion_point(field_mutable:protocol.DontHave.hash)
-  return hash_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+inline void GetStateNodes::set_keys(int index, const char* value) {
+  keys_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:protocol.GetStateNodes.keys)
 }
-inline ::std::string* DontHave::release_hash() {
-  // @@protoc_insertion_point(field_release:protocol.DontHave.hash)
-  
-  return hash_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+inline void GetStateNodes::set_keys(int index, const void* value, size_t size) {
+  keys_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:protocol.GetStateNodes.keys)
 }
-inline void DontHave::set_allocated_hash(::std::string* hash) {
-  if (hash != NULL) {
-    
-  } else {
-    
-  }
-  hash_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), hash);
-  // @@protoc_insertion_point(field_set_allocated:protocol.DontHave.hash)
+inline ::std::string* GetStateNodes::add_keys() {
+  // @@protoc_insertion_point(field_add_mutable:protocol.GetStateNodes.keys)
+  return keys_.Add();
+}
+inline void GetStateNodes::add_keys(const ::std::string& value) {
+  keys_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:protocol.GetStateNodes.keys)
+}
+inline void GetStateNodes::add_keys(const char* value) {
+  keys_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:protocol.GetStateNodes.keys)
+}
+inline void GetStateNodes::add_keys(const void* value, size_t size) {
+  keys_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:protocol.GetStateNodes.keys)
+}
+inline const ::google::protobuf::RepeatedPtrField< ::std::string>&
+GetStateNodes::keys() const {
+  // @@protoc_insertion_point(field_list:protocol.GetStateNodes.keys)
+  return keys_;
+}
+inline ::google::protobuf::RepeatedPtrField< ::std::string>*
+GetStateNodes::mutable_keys() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.GetStateNodes.keys)
+  return &keys_;
+}
+
+// optional int64 chain_id = 3;
+inline void GetStateNodes::clear_chain_id() {
+  chain_id_ = GOOGLE_LONGLONG(0);
+}
+inline ::google::protobuf::int64 GetStateNodes::chain_id() const {
+  // @@protoc_insertion_point(field_get:protocol.GetStateNodes.chain_id)
+  return chain_id_;
+}
+inline void GetStateNodes::set_chain_id(::google::protobuf::int64 value) {
+  
+  chain_id_ = value;
+  // @@protoc_insertion_point(field_set:protocol.GetStateNodes.chain_id)
 }
 
 // -------------------------------------------------------------------
 
-// LedgerUpgradeNotify
+// StateNodes
 
-// optional int64 nonce = 1;
-inline void LedgerUpgradeNotify::clear_nonce() {
-  nonce_ = GOOGLE_LONGLONG(0);
+// optional .protocol.StateNodes.SyncCode sync_code = 1;
+inline void StateNodes::clear_sync_code() {
+  sync_code_ = 0;
 }
-inline ::google::protobuf::int64 LedgerUpgradeNotify::nonce() const {
+inline ::protocol::StateNodes_SyncCode StateNodes::sync_code() const {
+  // @@protoc_insertion_point(field_get:protocol.StateNodes.sync_code)
+  return static_cast< ::protocol::StateNodes_SyncCode >(sync_code_);
+}
+inline void StateNodes::set_sync_code(::protocol::StateNodes_SyncCode value) {
+  
+  sync_code_ = value;
+  // @@protoc_insertion_point(field_set:protocol.StateNodes.sync_code)
+}
+
+// optional int64 ledger_seq = 2;
+inline void StateNodes::clear_ledger_seq() {
+  ledger_seq_ = GOOGLE_LONGLONG(0);
+}
+inline ::google::protobuf::int64 StateNodes::ledger_seq() const {
+  // @@protoc_insertion_point(field_get:protocol.StateNodes.ledger_seq)
+  return ledger_seq_;
+}
+inline void StateNodes::set_ledger_seq(::google::protobuf::int64 value) {
+  
+  ledger_seq_ = value;
+  // @@protoc_insertion_point(field_set:protocol.StateNodes.ledger_seq)
+}
+
+// optional .protocol.Ledger ledger = 3;
+inline bool StateNodes::has_ledger() const {
+  return !_is_default_instance_ && ledger_ != NULL;
+}
+inline void StateNodes::clear_ledger() {
+  if (GetArenaNoVirtual() == NULL && ledger_ != NULL) delete ledger_;
+  ledger_ = NULL;
+}
+inline const ::protocol::Ledger& StateNodes::ledger() const {
+  // @@protoc_insertion_point(field_get:protocol.StateNodes.ledger)
+  return ledger_ != NULL ? *ledger_ : *default_instance_->ledger_;
+}
+inline ::protocol::Ledger* StateNodes::mutable_ledger() {
+  
+  if (ledger_ == NULL) {
+    ledger_ = new ::protocol::Ledger;
+  }
+  // @@protoc_insertion_point(field_mutable:protocol.StateNodes.ledger)
+  return ledger_;
+}
+inline ::protocol::Ledger* StateNodes::release_ledger() {
+  // @@protoc_insertion_point(field_release:protocol.StateNodes.ledger)
+  
+  ::protocol::Ledger* temp = ledger_;
+  ledger_ = NULL;
+  return temp;
+}
+inline void StateNodes::set_allocated_ledger(::protocol::Ledger* ledger) {
+  delete ledger_;
+  ledger_ = ledger;
+  if (ledger) {
+    
+  } else {
+    
+  }
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateNodes.ledger)
+}
+
+// optional .protocol.ConsensusValue next_value = 4;
+inline bool StateNodes::has_next_value() const {
+  return !_is_default_instance_ && next_value_ != NULL;
+}
+inline void StateNodes::clear_next_value() {
+  if (GetArenaNoVirtual() == NULL && next_value_ != NULL) delete next_value_;
+  next_value_ = NULL;
+}
+inline const ::protocol::ConsensusValue& StateNodes::next_value() const {
+  // @@protoc_insertion_point(field_get:protocol.StateNodes.next_value)
+  return next_value_ != NULL ? *next_value_ : *default_instance_->next_value_;
+}
+inline ::protocol::ConsensusValue* StateNodes::mutable_next_value() {
+  
+  if (next_value_ == NULL) {
+    next_value_ = new ::protocol::ConsensusValue;
+  }
+  // @@protoc_insertion_point(field_mutable:protocol.StateNodes.next_value)
+  return next_value_;
+}
+inline ::protocol::ConsensusValue* StateNodes::release_next_value() {
+  // @@protoc_insertion_point(field_release:protocol.StateNodes.next_value)
+  
+  ::protocol::ConsensusValue* temp = next_value_;
+  next_value_ = NULL;
+  return temp;
+}
+inline void StateNodes::set_allocated_next_value(::protocol::ConsensusValue* next_value) {
+  delete next_value_;
+  next_value_ = next_value;
+  if (next_value) {
+    
+  } else {
+    
+  }
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateNodes.next_value)
+}
+
+// optional bytes next_proof = 5;
+inline void StateNodes::clear_next_proof() {
+  next_proof_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& StateNodes::next_proof() const {
+  // @@protoc_insertion_point(field_get:protocol.StateNodes.next_proof)
+  return next_proof_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void StateNodes::set_next_proof(const ::std::string& value) {
+  
+  next_proof_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.StateNodes.next_proof)
+}
+inline void StateNodes::set_next_proof(const char* value) {
+  
+  next_proof_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.StateNodes.next_proof)
+}
+inline void StateNodes::set_next_proof(const void* value, size_t size) {
+  
+  next_proof_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.StateNodes.next_proof)
+}
+inline ::std::string* StateNodes::mutable_next_proof() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.StateNodes.next_proof)
+  return next_proof_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* StateNodes::release_next_proof() {
+  // @@protoc_insertion_point(field_release:protocol.StateNodes.next_proof)
+  
+  return next_proof_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void StateNodes::set_allocated_next_proof(::std::string* next_proof) {
+  if (next_proof != NULL) {
+    
+  } else {
+    
+  }
+  next_proof_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), next_proof);
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateNodes.next_proof)
+}
+
+// repeated bytes keys = 6;
+inline int StateNodes::keys_size() const {
+  return keys_.size();
+}
+inline void StateNodes::clear_keys() {
+  keys_.Clear();
+}
+inline const ::std::string& StateNodes::keys(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.StateNodes.keys)
+  return keys_.Get(index);
+}
+inline ::std::string* StateNodes::mutable_keys(int index) {
+  // @@protoc_insertion_point(field_mutable:protocol.StateNodes.keys)
+  return keys_.Mutable(index);
+}
+inline void StateNodes::set_keys(int index, const ::std::string& value) {
+  // @@protoc_insertion_point(field_set:protocol.StateNodes.keys)
+  keys_.Mutable(index)->assign(value);
+}
+inline void StateNodes::set_keys(int index, const char* value) {
+  keys_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:protocol.StateNodes.keys)
+}
+inline void StateNodes::set_keys(int index, const void* value, size_t size) {
+  keys_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:protocol.StateNodes.keys)
+}
+inline ::std::string* StateNodes::add_keys() {
+  // @@protoc_insertion_point(field_add_mutable:protocol.StateNodes.keys)
+  return keys_.Add();
+}
+inline void StateNodes::add_keys(const ::std::string& value) {
+  keys_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:protocol.StateNodes.keys)
+}
+inline void StateNodes::add_keys(const char* value) {
+  keys_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:protocol.StateNodes.keys)
+}
+inline void StateNodes::add_keys(const void* value, size_t size) {
+  keys_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:protocol.StateNodes.keys)
+}
+inline const ::google::protobuf::RepeatedPtrField< ::std::string>&
+StateNodes::keys() const {
+  // @@protoc_insertion_point(field_list:protocol.StateNodes.keys)
+  return keys_;
+}
+inline ::google::protobuf::RepeatedPtrField< ::std::string>*
+StateNodes::mutable_keys() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.StateNodes.keys)
+  return &keys_;
+}
+
+// repeated bytes values = 7;
+inline int StateNodes::values_size() const {
+  return values_.size();
+}
+inline void StateNodes::clear_values() {
+  values_.Clear();
+}
+inline const ::std::string& StateNodes::values(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.StateNodes.values)
+  return values_.Get(index);
+}
+inline ::std::string* StateNodes::mutable_values(int index) {
+  // @@protoc_insertion_point(field_mutable:protocol.StateNodes.values)
+  return values_.Mutable(index);
+}
+inline void StateNodes::set_values(int index, const ::std::string& value) {
+  // @@protoc_insertion_point(field_set:protocol.StateNodes.values)
+  values_.Mutable(index)->assign(value);
+}
+inline void StateNodes::set_values(int index, const char* value) {
+  values_.Mutable(index)->assign(value);
+  // @@protoc_insertion_point(field_set_char:protocol.StateNodes.values)
+}
+inline void StateNodes::set_values(int index, const void* value, size_t size) {
+  values_.Mutable(index)->assign(
+    reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_set_pointer:protocol.StateNodes.values)
+}
+inline ::std::string* StateNodes::add_values() {
+  // @@protoc_insertion_point(field_add_mutable:protocol.StateNodes.values)
+  return values_.Add();
+}
+inline void StateNodes::add_values(const ::std::string& value) {
+  values_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add:protocol.StateNodes.values)
+}
+inline void StateNodes::add_values(const char* value) {
+  values_.Add()->assign(value);
+  // @@protoc_insertion_point(field_add_char:protocol.StateNodes.values)
+}
+inline void StateNodes::add_values(const void* value, size_t size) {
+  values_.Add()->assign(reinterpret_cast<const char*>(value), size);
+  // @@protoc_insertion_point(field_add_pointer:protocol.StateNodes.values)
+}
+inline const ::google::protobuf::RepeatedPtrField< ::std::string>&
+StateNodes::values() const {
+  // @@protoc_insertion_point(field_list:protocol.StateNodes.values)
+  return values_;
+}
+inline ::google::protobuf::RepeatedPtrField< ::std::string>*
+StateNodes::mutable_values() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.StateNodes.values)
+  return &values_;
+}
+
+// optional int64 chain_id = 8;
+inline void StateNodes::clear_chain_id() {
+  chain_id_ = GOOGLE_LONGLONG(0);
+}
+inline ::google::protobuf::int64 StateNodes::chain_id() const {
+  // @@protoc_insertion_point(field_get:protocol.StateNodes.chain_id)
+  return chain_id_;
+}
+inline void StateNodes::set_chain_id(::google::protobuf::int64 value) {
+  
+  chain_id_ = value;
+  // @@protoc_insertion_point(field_set:protocol.StateNodes.chain_id)
+}
+
+// -------------------------------------------------------------------
+
+// DontHave
+
+// optional int64 type = 1;
+inline void DontHave::clear_type() {
+  type_ = GOOGLE_LONGLONG(0);
+}
+inline ::google::protobuf::int64 DontHave::type() const {
+  // @@protoc_insertion_point(field_get:protocol.DontHave.type)
+  return type_;
+}
+inline void DontHave::set_type(::google::protobuf::int64 value) {
+  
+  type_ = value;
+  // @@protoc_insertion_point(field_set:protocol.DontHave.type)
+}
+
+// optional bytes hash = 2;
+inline void DontHave::clear_hash() {
+  hash_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& DontHave::hash() const {
+  // @@protoc_insertion_point(field_get:protocol.DontHave.hash)
+  return hash_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void DontHave::set_hash(const ::std::string& value) {
+  
+  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.DontHave.hash)
+}
+inline void DontHave::set_hash(const char* value) {
+  
+  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.DontHave.hash)
+}
+inline void DontHave::set_hash(const void* value, size_t size) {
+  
+  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.DontHave.hash)
+}
+inline ::std::string* DontHave::mutable_hash() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.DontHave.hash)
+  return hash_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* DontHave::release_hash() {
+  // @@protoc_insertion_point(field_release:protocol.DontHave.hash)
+  
+  return hash_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void DontHave::set_allocated_hash(::std::string* hash) {
+  if (hash != NULL) {
+    
+  } else {
+    
+  }
+  hash_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), hash);
+  // @@protoc_insertion_point(field_set_allocated:protocol.DontHave.hash)
+}
+
+// -------------------------------------------------------------------
+
+// LedgerUpgradeNotify
+
+// optional int64 nonce = 1;
+inline void LedgerUpgradeNotify::clear_nonce() {
+  nonce_ = GOOGLE_LONGLONG(0);
+}
+inline ::google::protobuf::int64 LedgerUpgradeNotify::nonce() const {
   // @@protoc_insertion_point(field_get:protocol.LedgerUpgradeNotify.nonce)
   return nonce_;
 }
@@ -2752,6 +3761,358 @@ EntryList::mutable_entry() {
 
 // -------------------------------------------------------------------
 
+// StateSyncEntry
+
+// optional .protocol.StateSyncEntry.EntryType type = 1;
+inline void StateSyncEntry::clear_type() {
+  type_ = 0;
+}
+inline ::protocol::StateSyncEntry_EntryType StateSyncEntry::type() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncEntry.type)
+  return static_cast< ::protocol::StateSyncEntry_EntryType >(type_);
+}
+inline void StateSyncEntry::set_type(::protocol::StateSyncEntry_EntryType value) {
+  
+  type_ = value;
+  // @@protoc_insertion_point(field_set:protocol.StateSyncEntry.type)
+}
+
+// optional bytes prefix = 2;
+inline void StateSyncEntry::clear_prefix() {
+  prefix_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& StateSyncEntry::prefix() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncEntry.prefix)
+  return prefix_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void StateSyncEntry::set_prefix(const ::std::string& value) {
+  
+  prefix_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.StateSyncEntry.prefix)
+}
+inline void StateSyncEntry::set_prefix(const char* value) {
+  
+  prefix_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.StateSyncEntry.prefix)
+}
+inline void StateSyncEntry::set_prefix(const void* value, size_t size) {
+  
+  prefix_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.StateSyncEntry.prefix)
+}
+inline ::std::string* StateSyncEntry::mutable_prefix() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.StateSyncEntry.prefix)
+  return prefix_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* StateSyncEntry::release_prefix() {
+  // @@protoc_insertion_point(field_release:protocol.StateSyncEntry.prefix)
+  
+  return prefix_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void StateSyncEntry::set_allocated_prefix(::std::string* prefix) {
+  if (prefix != NULL) {
+    
+  } else {
+    
+  }
+  prefix_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), prefix);
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateSyncEntry.prefix)
+}
+
+// optional bytes location = 3;
+inline void StateSyncEntry::clear_location() {
+  location_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& StateSyncEntry::location() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncEntry.location)
+  return location_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void StateSyncEntry::set_location(const ::std::string& value) {
+  
+  location_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.StateSyncEntry.location)
+}
+inline void StateSyncEntry::set_location(const char* value) {
+  
+  location_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.StateSyncEntry.location)
+}
+inline void StateSyncEntry::set_location(const void* value, size_t size) {
+  
+  location_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.StateSyncEntry.location)
+}
+inline ::std::string* StateSyncEntry::mutable_location() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.StateSyncEntry.location)
+  return location_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* StateSyncEntry::release_location() {
+  // @@protoc_insertion_point(field_release:protocol.StateSyncEntry.location)
+  
+  return location_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void StateSyncEntry::set_allocated_location(::std::string* location) {
+  if (location != NULL) {
+    
+  } else {
+    
+  }
+  location_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), location);
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateSyncEntry.location)
+}
+
+// optional bytes hash = 4;
+inline void StateSyncEntry::clear_hash() {
+  hash_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& StateSyncEntry::hash() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncEntry.hash)
+  return hash_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void StateSyncEntry::set_hash(const ::std::string& value) {
+  
+  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.StateSyncEntry.hash)
+}
+inline void StateSyncEntry::set_hash(const char* value) {
+  
+  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.StateSyncEntry.hash)
+}
+inline void StateSyncEntry::set_hash(const void* value, size_t size) {
+  
+  hash_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.StateSyncEntry.hash)
+}
+inline ::std::string* StateSyncEntry::mutable_hash() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.StateSyncEntry.hash)
+  return hash_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* StateSyncEntry::release_hash() {
+  // @@protoc_insertion_point(field_release:protocol.StateSyncEntry.hash)
+  
+  return hash_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void StateSyncEntry::set_allocated_hash(::std::string* hash) {
+  if (hash != NULL) {
+    
+  } else {
+    
+  }
+  hash_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), hash);
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateSyncEntry.hash)
+}
+
+// -------------------------------------------------------------------
+
+// StateSyncStatus
+
+// optional .protocol.Ledger ledger = 1;
+inline bool StateSyncStatus::has_ledger() const {
+  return !_is_default_instance_ && ledger_ != NULL;
+}
+inline void StateSyncStatus::clear_ledger() {
+  if (GetArenaNoVirtual() == NULL && ledger_ != NULL) delete ledger_;
+  ledger_ = NULL;
+}
+inline const ::protocol::Ledger& StateSyncStatus::ledger() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncStatus.ledger)
+  return ledger_ != NULL ? *ledger_ : *default_instance_->ledger_;
+}
+inline ::protocol::Ledger* StateSyncStatus::mutable_ledger() {
+  
+  if (ledger_ == NULL) {
+    ledger_ = new ::protocol::Ledger;
+  }
+  // @@protoc_insertion_point(field_mutable:protocol.StateSyncStatus.ledger)
+  return ledger_;
+}
+inline ::protocol::Ledger* StateSyncStatus::release_ledger() {
+  // @@protoc_insertion_point(field_release:protocol.StateSyncStatus.ledger)
+  
+  ::protocol::Ledger* temp = ledger_;
+  ledger_ = NULL;
+  return temp;
+}
+inline void StateSyncStatus::set_allocated_ledger(::protocol::Ledger* ledger) {
+  delete ledger_;
+  ledger_ = ledger;
+  if (ledger) {
+    
+  } else {
+    
+  }
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateSyncStatus.ledger)
+}
+
+// optional bytes proof = 2;
+inline void StateSyncStatus::clear_proof() {
+  proof_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& StateSyncStatus::proof() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncStatus.proof)
+  return proof_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void StateSyncStatus::set_proof(const ::std::string& value) {
+  
+  proof_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.StateSyncStatus.proof)
+}
+inline void StateSyncStatus::set_proof(const char* value) {
+  
+  proof_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.StateSyncStatus.proof)
+}
+inline void StateSyncStatus::set_proof(const void* value, size_t size) {
+  
+  proof_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.StateSyncStatus.proof)
+}
+inline ::std::string* StateSyncStatus::mutable_proof() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.StateSyncStatus.proof)
+  return proof_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* StateSyncStatus::release_proof() {
+  // @@protoc_insertion_point(field_release:protocol.StateSyncStatus.proof)
+  
+  return proof_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void StateSyncStatus::set_allocated_proof(::std::string* proof) {
+  if (proof != NULL) {
+    
+  } else {
+    
+  }
+  proof_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), proof);
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateSyncStatus.proof)
+}
+
+// optional bytes account_root = 3;
+inline void StateSyncStatus::clear_account_root() {
+  account_root_.ClearToEmptyNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline const ::std::string& StateSyncStatus::account_root() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncStatus.account_root)
+  return account_root_.GetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void StateSyncStatus::set_account_root(const ::std::string& value) {
+  
+  account_root_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), value);
+  // @@protoc_insertion_point(field_set:protocol.StateSyncStatus.account_root)
+}
+inline void StateSyncStatus::set_account_root(const char* value) {
+  
+  account_root_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), ::std::string(value));
+  // @@protoc_insertion_point(field_set_char:protocol.StateSyncStatus.account_root)
+}
+inline void StateSyncStatus::set_account_root(const void* value, size_t size) {
+  
+  account_root_.SetNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(),
+      ::std::string(reinterpret_cast<const char*>(value), size));
+  // @@protoc_insertion_point(field_set_pointer:protocol.StateSyncStatus.account_root)
+}
+inline ::std::string* StateSyncStatus::mutable_account_root() {
+  
+  // @@protoc_insertion_point(field_mutable:protocol.StateSyncStatus.account_root)
+  return account_root_.MutableNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline ::std::string* StateSyncStatus::release_account_root() {
+  // @@protoc_insertion_point(field_release:protocol.StateSyncStatus.account_root)
+  
+  return account_root_.ReleaseNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited());
+}
+inline void StateSyncStatus::set_allocated_account_root(::std::string* account_root) {
+  if (account_root != NULL) {
+    
+  } else {
+    
+  }
+  account_root_.SetAllocatedNoArena(&::google::protobuf::internal::GetEmptyStringAlreadyInited(), account_root);
+  // @@protoc_insertion_point(field_set_allocated:protocol.StateSyncStatus.account_root)
+}
+
+// repeated .protocol.StateSyncEntry pending = 4;
+inline int StateSyncStatus::pending_size() const {
+  return pending_.size();
+}
+inline void StateSyncStatus::clear_pending() {
+  pending_.Clear();
+}
+inline const ::protocol::StateSyncEntry& StateSyncStatus::pending(int index) const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncStatus.pending)
+  return pending_.Get(index);
+}
+inline ::protocol::StateSyncEntry* StateSyncStatus::mutable_pending(int index) {
+  // @@protoc_insertion_point(field_mutable:protocol.StateSyncStatus.pending)
+  return pending_.Mutable(index);
+}
+inline ::protocol::StateSyncEntry* StateSyncStatus::add_pending() {
+  // @@protoc_insertion_point(field_add:protocol.StateSyncStatus.pending)
+  return pending_.Add();
+}
+inline ::google::protobuf::RepeatedPtrField< ::protocol::StateSyncEntry >*
+StateSyncStatus::mutable_pending() {
+  // @@protoc_insertion_point(field_mutable_list:protocol.StateSyncStatus.pending)
+  return &pending_;
+}
+inline const ::google::protobuf::RepeatedPtrField< ::protocol::StateSyncEntry >&
+StateSyncStatus::pending() const {
+  // @@protoc_insertion_point(field_list:protocol.StateSyncStatus.pending)
+  return pending_;
+}
+
+// optional int64 account_count = 5;
+inline void StateSyncStatus::clear_account_count() {
+  account_count_ = GOOGLE_LONGLONG(0);
+}
+inline ::google::protobuf::int64 StateSyncStatus::account_count() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncStatus.account_count)
+  return account_count_;
+}
+inline void StateSyncStatus::set_account_count(::google::protobuf::int64 value) {
+  
+  account_count_ = value;
+  // @@protoc_insertion_point(field_set:protocol.StateSyncStatus.account_count)
+}
+
+// optional int64 node_count = 6;
+inline void StateSyncStatus::clear_node_count() {
+  node_count_ = GOOGLE_LONGLONG(0);
+}
+inline ::google::protobuf::int64 StateSyncStatus::node_count() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncStatus.node_count)
+  return node_count_;
+}
+inline void StateSyncStatus::set_node_count(::google::protobuf::int64 value) {
+  
+  node_count_ = value;
+  // @@protoc_insertion_point(field_set:protocol.StateSyncStatus.node_count)
+}
+
+// optional bool committing = 7;
+inline void StateSyncStatus::clear_committing() {
+  committing_ = false;
+}
+inline bool StateSyncStatus::committing() const {
+  // @@protoc_insertion_point(field_get:protocol.StateSyncStatus.committing)
+  return committing_;
+}
+inline void StateSyncStatus::set_committing(bool value) {
+  
+  committing_ = value;
+  // @@protoc_insertion_point(field_set:protocol.StateSyncStatus.committing)
+}
+
+// -------------------------------------------------------------------
+
 // ChainHello
 
 // repeated .protocol.ChainMessageType api_list = 1;
@@ -3513,6 +4874,14 @@ inline void ChainInfoMessage::set_allocated_address(::std::string* address) {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
@@ -3527,6 +4896,16 @@ template <>
 inline const EnumDescriptor* GetEnumDescriptor< ::protocol::Ledgers_SyncCode>() {
   return ::protocol::Ledgers_SyncCode_descriptor();
 }
+template <> struct is_proto_enum< ::protocol::StateNodes_SyncCode> : ::google::protobuf::internal::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::protocol::StateNodes_SyncCode>() {
+  return ::protocol::StateNodes_SyncCode_descriptor();
+}
+template <> struct is_proto_enum< ::protocol::StateSyncEntry_EntryType> : ::google::protobuf::internal::true_type {};
+template <>
+inline const EnumDescriptor* GetEnumDescriptor< ::protocol::StateSyncEntry_EntryType>() {
+  return ::protocol::StateSyncEntry_EntryType_descriptor();
+}
 template <> struct is_proto_enum< ::protocol::ChainTxStatus_TxStatus> : ::google::protobuf::internal::true_type {};
 template <>
 inline const EnumDescriptor* GetEnumDescriptor< ::protocol::ChainTxStatus_TxStatus>() {
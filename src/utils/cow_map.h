@@ -0,0 +1,91 @@
+#ifndef TEMPLATE_COW_MAP_H
+#define TEMPLATE_COW_MAP_H
+
+#include <map>
+#include <vector>
+#include <memory>
+
+namespace utils
+{
+	//A map copied in constant time. The copies share the layers written so far,
+	//and a write into a shared layer starts a new layer above it, so only the written entries are copied.
+	//The chain of layers is merged into one when it grows beyond MAX_DEPTH.
+	template<class KEY, class VALUE, class Compare = std::less<KEY>>
+	class CowMap
+	{
+	public:
+		typedef std::map<KEY, VALUE, Compare> Map;
+
+		static const size_t MAX_DEPTH = 8;
+
+	private:
+		struct Layer{
+			Map entries_;
+			std::shared_ptr<const Layer> parent_;
+			size_t depth_;
+
+			Layer() :depth_(0){}
+		};
+
+		std::shared_ptr<Layer> top_;
+
+	public:
+		//The value of the key, NULL if it is not in the map.
+		const VALUE* Find(const KEY& key) const{
+			for (const Layer* layer = top_.get(); layer != NULL; layer = layer->parent_.get()){
+				auto it = layer->entries_.find(key);
+				if (it != layer->entries_.end()){
+					return &it->second;
+				}
+			}
+			return NULL;
+		}
+
+		void Set(const KEY& key, const VALUE& value){
+			Writable()[key] = value;
+		}
+
+		//All the entries, the upper layers override the lower ones.
+		void GetAll(Map& result) const{
+			std::vector<const Layer*> layers;
+			for (const Layer* layer = top_.get(); layer != NULL; layer = layer->parent_.get()){
+				layers.push_back(layer);
+			}
+
+			result.clear();
+			for (size_t i = layers.size(); i > 0; i--){
+				const Map& entries = layers[i - 1]->entries_;
+				for (auto it = entries.begin(); it != entries.end(); it++){
+					result[it->first] = it->second;
+				}
+			}
+		}
+
+		size_t Depth() const{
+			return top_ == nullptr ? 0 : top_->depth_ + 1;
+		}
+
+	private:
+		Map& Writable(){
+			//Only this map refers to the top layer, it can be written in place.
+			if (top_ != nullptr && top_.use_count() == 1){
+				return top_->entries_;
+			}
+
+			std::shared_ptr<Layer> layer = std::make_shared<Layer>();
+			if (top_ != nullptr){
+				if (top_->depth_ + 1 >= MAX_DEPTH){
+					GetAll(layer->entries_);
+				}
+				else{
+					layer->parent_ = top_;
+					layer->depth_ = top_->depth_ + 1;
+				}
+			}
+			top_ = layer;
+			return top_->entries_;
+		}
+	};
+}
+
+#endif //TEMPLATE_COW_MAP_H
@@ -0,0 +1,172 @@
+#include "gtest/gtest.h"
+#include "utils/strings.h"
+#include "utils/timestamp.h"
+#include "ledger/environment.h"
+
+class AccountCowTest : public testing::Test{
+protected:
+
+	// Sets up the test fixture.
+	virtual void SetUp(){
+	}
+
+	// Tears down the test fixture.
+	virtual void TearDown(){
+	}
+
+protected:
+	void UT_Cow_Map();
+	void UT_Call_Chain();
+	void UT_Call_Chain_Benchmark();
+	void UT_Unchanged_Account();
+	void CallChain(size_t metadata_count, size_t depth);
+};
+
+TEST_F(AccountCowTest, UT_Cow_Map){ UT_Cow_Map(); }
+TEST_F(AccountCowTest, UT_Call_Chain){ UT_Call_Chain(); }
+TEST_F(AccountCowTest, DISABLED_UT_Call_Chain_Benchmark){ UT_Call_Chain_Benchmark(); }
+TEST_F(AccountCowTest, UT_Unchanged_Account){ UT_Unchanged_Account(); }
+
+void AccountCowTest::UT_Cow_Map(){
+	utils::CowMap<int, int> map;
+	for (int i = 0; i < 100; i++){
+		map.Set(i, i);
+	}
+
+	//The copies see the same entries, and the writes of either do not reach the other.
+	std::vector<utils::CowMap<int, int> > copies;
+	copies.push_back(map);
+	for (int n = 1; n < 50; n++){
+		copies.push_back(copies.back());
+		copies.back().Set(n, -n);
+		EXPECT_LE(copies.back().Depth(), (size_t)(utils::CowMap<int, int>::MAX_DEPTH));
+	}
+	map.Set(0, 1000);
+
+	for (int n = 0; n < 50; n++){
+		for (int i = 0; i < 100; i++){
+			const int* value = copies[n].Find(i);
+			ASSERT_TRUE(value != NULL);
+			EXPECT_EQ((i > 0 && i <= n) ? -i : i, *value);
+		}
+		EXPECT_TRUE(copies[n].Find(100) == NULL);
+
+		std::map<int, int> all;
+		copies[n].GetAll(all);
+		EXPECT_EQ(100, all.size());
+	}
+	EXPECT_EQ(1000, *map.Find(0));
+}
+
+//A contract called through a chain of stack frames, each of them reading its account and writing one metadata.
+void AccountCowTest::CallChain(size_t metadata_count, size_t depth){
+	const std::string address = "contract";
+	std::shared_ptr<bumo::Environment> root = std::make_shared<bumo::Environment>();
+
+	protocol::Account account;
+	account.set_address(address);
+	account.mutable_contract()->set_payload("'use strict';function main(input){}");
+	bumo::AccountFrm::pointer contract = std::make_shared<bumo::AccountFrm>(account);
+	for (size_t i = 0; i < metadata_count; i++){
+		protocol::KeyPair kp;
+		kp.set_key(utils::String::Format("key-" FMT_SIZE, i));
+		kp.set_value(std::string(64, 'v'));
+		kp.set_version(1);
+		contract->SetMetaData(kp);
+	}
+	root->AddEntry(address, contract);
+	root->Commit();
+	root->GetEntry(address, contract);
+
+	int64_t time0 = utils::Timestamp::HighResolution();
+	std::vector<std::shared_ptr<bumo::Environment> > frames;
+	frames.push_back(root);
+	for (size_t d = 1; d <= depth; d++){
+		std::shared_ptr<bumo::Environment> frame = frames.back()->NewStackFrameEnv();
+		bumo::AccountFrm::pointer frame_contract;
+		ASSERT_TRUE(frame->GetEntry(address, frame_contract));
+
+		protocol::KeyPair kp;
+		kp.set_key(utils::String::Format("call-" FMT_SIZE, d));
+		kp.set_value("value");
+		kp.set_version(1);
+		frame_contract->SetMetaData(kp);
+		frames.push_back(frame);
+	}
+	for (size_t d = depth; d > 0; d--){
+		frames[d]->Commit();
+	}
+	root->Commit();
+	int64_t time1 = utils::Timestamp::HighResolution();
+
+	//The same copies of the cached metadata with the former deep copy.
+	int64_t time2 = utils::Timestamp::HighResolution();
+	std::map<std::string, bumo::AccountFrm::DataCache<protocol::KeyPair> > metadata;
+	contract->metadata_.GetAll(metadata);
+	for (size_t d = 1; d <= depth; d++){
+		std::map<std::string, bumo::AccountFrm::DataCache<protocol::KeyPair> > copy = metadata;
+		bumo::AccountFrm::DataCache<protocol::KeyPair> rec;
+		rec.action_ = utils::ADD;
+		copy[utils::String::Format("call-" FMT_SIZE, d)] = rec;
+		metadata.swap(copy);
+	}
+	int64_t time3 = utils::Timestamp::HighResolution();
+
+	RecordProperty(utils::String::Format("copy_on_write_us_" FMT_SIZE, metadata_count), (int)(time1 - time0));
+	RecordProperty(utils::String::Format("deep_copy_us_" FMT_SIZE, metadata_count), (int)(time3 - time2));
+
+	bumo::AccountFrm::pointer result;
+	ASSERT_TRUE(root->GetEntry(address, result));
+	protocol::KeyPair kp;
+	for (size_t i = 0; i < metadata_count; i += 97){
+		EXPECT_TRUE(result->GetMetaData(utils::String::Format("key-" FMT_SIZE, i), kp));
+	}
+	for (size_t d = 1; d <= depth; d++){
+		EXPECT_TRUE(result->GetMetaData(utils::String::Format("call-" FMT_SIZE, d), kp));
+		EXPECT_EQ("value", kp.value());
+	}
+
+	//The account read before the calls is not changed by them.
+	EXPECT_FALSE(contract->metadata_.Find("call-1") != NULL);
+}
+
+void AccountCowTest::UT_Call_Chain(){
+	CallChain(10, 10);
+}
+
+void AccountCowTest::UT_Call_Chain_Benchmark(){
+	CallChain(1000, 64);
+	CallChain(10000, 64);
+	CallChain(100000, 64);
+}
+
+void AccountCowTest::UT_Unchanged_Account(){
+	protocol::Account account;
+	account.set_address("account");
+	account.set_nonce(1);
+	account.set_balance(100);
+	account.set_assets_hash(std::string(32, 'a'));
+	account.set_metadatas_hash(std::string(32, 'm'));
+
+	bumo::AccountFrm::pointer stored = std::make_shared<bumo::AccountFrm>(account);
+	stored->SetStored(std::make_shared<std::string>(account.SerializeAsString()));
+
+	//Read only, the tries keep their hashes and the account is not written.
+	bumo::AccountFrm::DataCache<protocol::KeyPair> rec;
+	rec.action_ = utils::MAX;
+	rec.data_.set_key("key");
+	rec.data_.set_value("value");
+	stored->metadata_.Set("key", rec);
+	bumo::AccountFrm::pointer copy = std::make_shared<bumo::AccountFrm>(stored);
+	EXPECT_EQ(0, copy->UpdateHash(nullptr));
+	EXPECT_TRUE(copy->IsStored(copy->Serializer()));
+
+	copy->AddBalance(1);
+	EXPECT_FALSE(copy->IsStored(copy->Serializer()));
+	copy->AddBalance(-1);
+	EXPECT_TRUE(copy->IsStored(copy->Serializer()));
+
+	//An account not read from the tree is always written.
+	bumo::AccountFrm::pointer created = std::make_shared<bumo::AccountFrm>(account);
+	EXPECT_FALSE(created->IsStored(created->Serializer()));
+}
@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+#include "utils/timestamp.h"
+#include "ledger/close_pipeline.h"
+
+class ClosePipelineTest : public testing::Test{
+protected:
+
+	// Sets up the test fixture.
+	virtual void SetUp(){
+	}
+
+	// Tears down the test fixture.
+	virtual void TearDown(){
+	}
+
+protected:
+	void UT_Seal_In_Order();
+	void UT_Seal_Inline();
+	void Seal(bool enabled);
+};
+
+TEST_F(ClosePipelineTest, UT_Seal_In_Order){ UT_Seal_In_Order(); }
+TEST_F(ClosePipelineTest, UT_Seal_Inline){ UT_Seal_Inline(); }
+
+//The ledgers are sealed one at a time in the order they are handed over.
+void ClosePipelineTest::Seal(bool enabled){
+	bumo::ClosePipeline pipeline;
+	ASSERT_TRUE(pipeline.Initialize(enabled));
+	EXPECT_EQ(enabled, pipeline.enabled());
+
+	std::vector<int64_t> sealed;
+	volatile long running = 0;
+	for (int64_t seq = 1; seq <= 20; seq++){
+		pipeline.Seal(seq, [&sealed, &running, seq](){
+			EXPECT_EQ(1, utils::AtomicInc(&running));
+			utils::Sleep(2);
+			sealed.push_back(seq);
+			utils::AtomicDec(&running);
+		});
+		if (!enabled){
+			EXPECT_EQ((size_t)seq, sealed.size());
+		}
+	}
+	pipeline.Wait();
+	EXPECT_EQ(0, pipeline.sealing_seq());
+
+	ASSERT_EQ(20, sealed.size());
+	for (size_t i = 0; i < sealed.size(); i++){
+		EXPECT_EQ((int64_t)i + 1, sealed[i]);
+	}
+
+	pipeline.OnRunAhead(true);
+	pipeline.OnRunAhead(false);
+	Json::Value status;
+	pipeline.GetModuleStatus(status);
+	EXPECT_EQ(20, status["sealed_count"].asInt64());
+	EXPECT_EQ(1, status["ahead_used_count"].asInt64());
+	EXPECT_EQ(1, status["ahead_discarded_count"].asInt64());
+	EXPECT_TRUE(pipeline.Exit());
+}
+
+void ClosePipelineTest::UT_Seal_In_Order(){
+	Seal(true);
+}
+
+void ClosePipelineTest::UT_Seal_Inline(){
+	Seal(false);
+}
@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+#include "utils/logger.h"
+#include "utils/file.h"
+#include "main/configure.h"
+#include "contract/code_cache.h"
+
+class CodeCacheTest : public testing::Test{
+protected:
+
+	// Sets up the test fixture.
+	virtual void SetUp(){
+		if (utils::Logger::GetInstance() == NULL){
+			utils::Logger::InitInstance();
+			utils::Logger::Instance().Initialize(utils::LOG_DEST_NONE, utils::LOG_LEVEL_NONE, "", false);
+		}
+		bumo::CodeCache::InitInstance();
+	}
+
+	// Tears down the test fixture.
+	virtual void TearDown(){
+		bumo::CodeCache::ExitInstance();
+	}
+
+protected:
+	void UT_Key();
+	void UT_Put_Get();
+	void UT_Persist();
+};
+
+TEST_F(CodeCacheTest, UT_Key){ UT_Key(); }
+TEST_F(CodeCacheTest, UT_Put_Get){ UT_Put_Get(); }
+TEST_F(CodeCacheTest, UT_Persist){ UT_Persist(); }
+
+void CodeCacheTest::UT_Key(){
+	const std::string code = "'use strict';function main(input){}";
+	EXPECT_EQ(bumo::CodeCache::Key("__enable_check_time__", code), bumo::CodeCache::Key("__enable_check_time__", code));
+	//The same code compiled without checking the time is another script.
+	EXPECT_NE(bumo::CodeCache::Key("__enable_check_time__", code), bumo::CodeCache::Key("", code));
+	EXPECT_NE(bumo::CodeCache::Key("a", "bc"), bumo::CodeCache::Key("ab", "c"));
+}
+
+void CodeCacheTest::UT_Put_Get(){
+	bumo::CodeCache &cache = bumo::CodeCache::Instance();
+	cache.Put("disabled", "data");
+	EXPECT_TRUE(cache.Get("disabled") == nullptr);
+
+	cache.Initialize(300, false);
+	cache.Put("a", std::string(100, 'a'));
+	cache.Put("b", std::string(100, 'b'));
+	cache.Put("c", std::string(100, 'c'));
+	ASSERT_TRUE(cache.Get("a") != nullptr);
+	EXPECT_EQ(std::string(100, 'a'), *cache.Get("a"));
+
+	//Over the capacity, the least recently used is evicted.
+	cache.Put("d", std::string(100, 'd'));
+	EXPECT_TRUE(cache.Get("b") == nullptr);
+	EXPECT_TRUE(cache.Get("a") != nullptr);
+	EXPECT_TRUE(cache.Get("d") != nullptr);
+
+	//The data rejected is not given again.
+	cache.Remove("a");
+	EXPECT_TRUE(cache.Get("a") == nullptr);
+
+	cache.OnCompiled(true, 10);
+	cache.OnCompiled(false, 1000);
+	Json::Value status;
+	cache.GetModuleStatus(status);
+	EXPECT_EQ(2, status["count"].asInt64());
+	EXPECT_EQ(200, status["size"].asInt64());
+	EXPECT_EQ(1, status["eviction_count"].asInt64());
+	EXPECT_EQ(1, status["rejected_count"].asInt64());
+	EXPECT_EQ("50.00%", status["hit_rate"].asString());
+}
+
+void CodeCacheTest::UT_Persist(){
+	if (bumo::Configure::GetInstance() == NULL){
+		bumo::Configure::InitInstance();
+	}
+	bumo::DbConfigure db_config;
+	std::string path = utils::File::GetTempDirectory() + "/code_cache_test";
+	db_config.keyvalue_db_path_ = path + "_keyvalue.db";
+	db_config.ledger_db_path_ = path + "_ledger.db";
+	db_config.account_db_path_ = path + "_account.db";
+	bumo::Storage::InitInstance();
+	ASSERT_TRUE(bumo::Storage::Instance().Initialize(db_config, true));
+	ASSERT_TRUE(bumo::Storage::Instance().Initialize(db_config, false));
+	bumo::KeyValueDb *db = bumo::Storage::Instance().keyvalue_db();
+
+	//Written by the timer, not by the contracts.
+	bumo::CodeCache &cache = bumo::CodeCache::Instance();
+	cache.Initialize(300, true);
+	cache.Put("a", std::string(100, 'a'));
+	cache.Put("b", std::string(100, 'b'));
+	cache.Put("c", std::string(100, 'c'));
+	std::string value;
+	EXPECT_EQ(0, db->Get(utils::String::Format("%s_%s", bumo::General::CODE_CACHE_PREFIX, utils::String::BinToHexString("a").c_str()), value));
+
+	//The evicted data is deleted from the db too.
+	cache.Put("d", std::string(100, 'd'));
+	cache.Exit();
+	EXPECT_EQ(1, db->Get(utils::String::Format("%s_%s", bumo::General::CODE_CACHE_PREFIX, utils::String::BinToHexString("d").c_str()), value));
+	EXPECT_EQ(0, db->Get(utils::String::Format("%s_%s", bumo::General::CODE_CACHE_PREFIX, utils::String::BinToHexString("a").c_str()), value));
+
+	//Loaded after a restart, the entries over a smaller capacity are deleted.
+	bumo::CodeCache::ExitInstance();
+	bumo::CodeCache::InitInstance();
+	bumo::CodeCache::Instance().Initialize(200, true);
+	bumo::CodeCache::Instance().Exit();
+	Json::Value status;
+	bumo::CodeCache::Instance().GetModuleStatus(status);
+	EXPECT_EQ(3, status["load_count"].asInt64());
+	EXPECT_EQ(2, status["count"].asInt64());
+	int found = 0;
+	const char *keys[] = { "b", "c", "d" };
+	for (size_t i = 0; i < 3; i++){
+		if (db->Get(utils::String::Format("%s_%s", bumo::General::CODE_CACHE_PREFIX, utils::String::BinToHexString(keys[i]).c_str()), value) == 1){
+			EXPECT_TRUE(bumo::CodeCache::Instance().Get(keys[i]) != nullptr);
+			found++;
+		}
+	}
+	EXPECT_EQ(2, found);
+
+	bumo::Storage::Instance().Exit();
+	bumo::Storage::ExitInstance();
+	utils::File::DeleteFolder(db_config.keyvalue_db_path_);
+	utils::File::DeleteFolder(db_config.ledger_db_path_);
+	utils::File::DeleteFolder(db_config.account_db_path_);
+}
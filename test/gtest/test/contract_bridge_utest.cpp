@@ -0,0 +1,141 @@
+#include "gtest/gtest.h"
+#include "utils/strings.h"
+#include "utils/timestamp.h"
+#include "utils/logger.h"
+#include "contract/v8_contract.h"
+
+class ContractBridgeTest : public testing::Test{
+protected:
+
+	// Sets up the test case.
+	static void SetUpTestCase(){
+		if (utils::Logger::GetInstance() == NULL){
+			utils::Logger::InitInstance();
+			utils::Logger::Instance().Initialize(utils::LOG_DEST_NONE, utils::LOG_LEVEL_NONE, "", false);
+		}
+
+		std::string argv0 = testing::internal::GetArgvs()[0];
+		v8::V8::InitializeICUDefaultLocation(argv0.c_str());
+		v8::V8::InitializeExternalStartupData(argv0.c_str());
+		platform_ = v8::platform::CreateDefaultPlatform();
+		v8::V8::InitializePlatform(platform_);
+		v8::V8::Initialize();
+		params_.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+
+		bumo::IsolatePool::InitInstance();
+		bumo::IsolatePool::Instance().Initialize(params_, LEVEL_COUNT);
+	}
+
+	// Tears down the test case.
+	static void TearDownTestCase(){
+		bumo::IsolatePool::Instance().Exit();
+		bumo::IsolatePool::ExitInstance();
+		v8::V8::Dispose();
+		v8::V8::ShutdownPlatform();
+		delete platform_;
+		delete params_.array_buffer_allocator;
+	}
+
+protected:
+	void UT_Query_Chain();
+	void UT_Query_Chain_Benchmark();
+	//The average time of a query, in us
+	int64_t QueryChain(int query_count);
+	static bool Query(int level, const std::string &input, Json::Value &js_result);
+
+	static const int LEVEL_COUNT = 4;
+	static v8::Platform *platform_;
+	static v8::Isolate::CreateParams params_;
+};
+
+v8::Platform *ContractBridgeTest::platform_ = NULL;
+v8::Isolate::CreateParams ContractBridgeTest::params_;
+
+TEST_F(ContractBridgeTest, UT_Query_Chain){ UT_Query_Chain(); }
+TEST_F(ContractBridgeTest, DISABLED_UT_Query_Chain_Benchmark){ UT_Query_Chain_Benchmark(); }
+
+//One contract of a contractQuery chain, in its own isolate. It queries the next one, adds its level to the
+//object returned and returns it, the result is handed back as ContractManager::Query does.
+bool ContractBridgeTest::Query(int level, const std::string &input, Json::Value &js_result){
+	Json::Value next_result;
+	if (level + 1 < LEVEL_COUNT && !Query(level + 1, input, next_result)){
+		return false;
+	}
+
+	v8::Isolate *isolate = bumo::IsolatePool::Instance().Lease();
+	bool ret = false;
+	do {
+		v8::Locker locker(isolate);
+		v8::Isolate::Scope isolate_scope(isolate);
+		v8::HandleScope handle_scope(isolate);
+		v8::Local<v8::Context> context = v8::Context::New(isolate);
+		v8::Context::Scope context_scope(context);
+
+		std::string code = utils::String::Format("'use strict';function main(input){ var obj = JSON.parse(input); obj.levels.push(%d); return JSON.stringify(obj); }", level);
+		v8::Local<v8::Script> script;
+		v8::Local<v8::Value> result;
+		if (!v8::Script::Compile(context, v8::String::NewFromUtf8(isolate, code.c_str(), v8::NewStringType::kNormal).ToLocalChecked()).ToLocal(&script) ||
+			!script->Run(context).ToLocal(&result)){
+			break;
+		}
+
+		v8::Local<v8::Value> main;
+		if (!context->Global()->Get(context, v8::String::NewFromUtf8(isolate, "main", v8::NewStringType::kNormal).ToLocalChecked()).ToLocal(&main) ||
+			!main->IsFunction()){
+			break;
+		}
+
+		v8::Local<v8::Value> argv[1];
+		if (level + 1 < LEVEL_COUNT){
+			bumo::V8Contract::CppJsonToJsValue(isolate, next_result["result"], argv[0]);
+		}
+		else{
+			argv[0] = v8::String::NewFromUtf8(isolate, input.c_str(), v8::NewStringType::kNormal).ToLocalChecked();
+		}
+
+		v8::Local<v8::Value> call_result;
+		if (!v8::Local<v8::Function>::Cast(main)->Call(context, context->Global(), 1, argv).ToLocal(&call_result)){
+			break;
+		}
+
+		Json::Value temp_result;
+		bumo::V8Contract::JsValueToCppJson(context, call_result, temp_result);
+		js_result["result"].swap(temp_result);
+		ret = true;
+	} while (false);
+
+	bumo::IsolatePool::Instance().Return(isolate, false);
+	return ret;
+}
+
+int64_t ContractBridgeTest::QueryChain(int query_count){
+	//An object of about 100KB
+	Json::Value object;
+	object["levels"] = Json::Value(Json::arrayValue);
+	for (int i = 0; i < 1000; i++){
+		object["items"][utils::String::Format("item-%d", i)] = std::string(80, 'x');
+	}
+	std::string input = object.toFastString();
+
+	Json::Value js_result;
+	int64_t time0 = utils::Timestamp::HighResolution();
+	for (int i = 0; i < query_count; i++){
+		js_result.clear();
+		EXPECT_TRUE(Query(0, input, js_result));
+	}
+	int64_t time1 = utils::Timestamp::HighResolution();
+
+	Json::Value result;
+	EXPECT_TRUE(result.fromString(js_result["result"]["value"].asString()));
+	EXPECT_EQ(LEVEL_COUNT, (int)result["levels"].size());
+	EXPECT_EQ(1000, (int)result["items"].size());
+	return (time1 - time0) / query_count;
+}
+
+void ContractBridgeTest::UT_Query_Chain(){
+	QueryChain(1);
+}
+
+void ContractBridgeTest::UT_Query_Chain_Benchmark(){
+	RecordProperty("query_us", (int)QueryChain(100));
+}
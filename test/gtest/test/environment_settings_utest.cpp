@@ -0,0 +1,140 @@
+#include "gtest/gtest.h"
+#include "utils/strings.h"
+#include "utils/timestamp.h"
+#include "ledger/environment.h"
+
+class EnvironmentSettingsTest : public testing::Test{
+protected:
+
+	// Sets up the test fixture.
+	virtual void SetUp(){
+		//The unknown fee types are logged.
+		if (utils::Logger::GetInstance() == NULL){
+			utils::Logger::InitInstance();
+			utils::Logger::Instance().Initialize(utils::LOG_DEST_NONE, utils::LOG_LEVEL_NONE, "", false);
+		}
+	}
+
+	// Tears down the test fixture.
+	virtual void TearDown(){
+	}
+
+protected:
+	void UT_Voted_Fee();
+	void UT_Voted_Validators();
+	void UT_Close_Benchmark();
+};
+
+TEST_F(EnvironmentSettingsTest, UT_Voted_Fee){ UT_Voted_Fee(); }
+TEST_F(EnvironmentSettingsTest, UT_Voted_Validators){ UT_Voted_Validators(); }
+TEST_F(EnvironmentSettingsTest, DISABLED_UT_Close_Benchmark){ UT_Close_Benchmark(); }
+
+void EnvironmentSettingsTest::UT_Voted_Fee(){
+	protocol::FeeConfig old_fee;
+	old_fee.set_gas_price(1000);
+	old_fee.set_base_reserve(10000000);
+
+	std::shared_ptr<bumo::Environment> root = std::make_shared<bumo::Environment>();
+	protocol::FeeConfig new_fee;
+	EXPECT_FALSE(root->GetVotedFee(old_fee, new_fee));
+	EXPECT_EQ(1000, new_fee.gas_price());
+
+	//A vote in a stack frame is seen by the root once the frame is committed.
+	std::shared_ptr<bumo::Environment> frame = root->NewStackFrameEnv();
+	EXPECT_TRUE(frame->UpdateFeeConfig(protocol::FeeConfig_Type_GAS_PRICE, 2000));
+	EXPECT_FALSE(frame->UpdateFeeConfig(protocol::FeeConfig_Type_UNKNOWN, 1));
+	EXPECT_FALSE(root->GetVotedFee(old_fee, new_fee));
+	frame->Commit();
+	root->Commit();
+
+	EXPECT_TRUE(root->GetVotedFee(old_fee, new_fee));
+	EXPECT_EQ(2000, new_fee.gas_price());
+	EXPECT_EQ(10000000, new_fee.base_reserve());
+
+	//A later vote of the other fee keeps the first one, a discarded frame changes nothing.
+	frame = root->NewStackFrameEnv();
+	frame->UpdateFeeConfig(protocol::FeeConfig_Type_BASE_RESERVE, 5);
+	frame->Commit();
+	std::shared_ptr<bumo::Environment> discarded = root->NewStackFrameEnv();
+	discarded->UpdateFeeConfig(protocol::FeeConfig_Type_GAS_PRICE, 3000);
+	root->Commit();
+
+	EXPECT_TRUE(root->GetVotedFee(old_fee, new_fee));
+	EXPECT_EQ(2000, new_fee.gas_price());
+	EXPECT_EQ(5, new_fee.base_reserve());
+
+	//The same fees are no change.
+	EXPECT_FALSE(root->GetVotedFee(new_fee, new_fee));
+}
+
+void EnvironmentSettingsTest::UT_Voted_Validators(){
+	protocol::ValidatorSet old_set;
+	protocol::Validator *validator = old_set.add_validators();
+	validator->set_address("old");
+	validator->set_pledge_coin_amount(1);
+
+	std::shared_ptr<bumo::Environment> root = std::make_shared<bumo::Environment>();
+	protocol::ValidatorSet new_set;
+	EXPECT_FALSE(root->GetVotedValidators(old_set, new_set));
+	EXPECT_EQ(old_set.SerializeAsString(), new_set.SerializeAsString());
+
+	protocol::ValidatorSet voted;
+	Json::Value json;
+	for (int i = 0; i < 100; i++){
+		validator = voted.add_validators();
+		validator->set_address(utils::String::Format("validator-%d", i));
+		validator->set_pledge_coin_amount(100 - i);
+		json[i].append(validator->address());
+		json[i].append(100 - i);
+	}
+
+	std::shared_ptr<bumo::Environment> frame = root->NewStackFrameEnv();
+	frame->UpdateNewValidators(voted, json);
+	frame->Commit();
+	root->Commit();
+
+	new_set.Clear();
+	EXPECT_TRUE(root->GetVotedValidators(old_set, new_set));
+	EXPECT_EQ(voted.SerializeAsString(), new_set.SerializeAsString());
+
+	//The contract reads back the value it set, not the parsed set.
+	const bumo::Environment::ValidatorSetting &setting = root->GetValidators();
+	ASSERT_TRUE(setting.json_ != NULL);
+	EXPECT_EQ(json, *setting.json_);
+	EXPECT_EQ(voted.SerializeAsString(), setting.validators_.SerializeAsString());
+}
+
+//Votes of both settings in each ledger, read at its close.
+void EnvironmentSettingsTest::UT_Close_Benchmark(){
+	protocol::ValidatorSet voted;
+	Json::Value json;
+	for (int i = 0; i < 100; i++){
+		protocol::Validator *validator = voted.add_validators();
+		validator->set_address(utils::String::Format("buQvalidator%034d", i));
+		validator->set_pledge_coin_amount(500000000000 + i);
+		json[i].append(validator->address());
+		json[i].append(utils::String::ToString(validator->pledge_coin_amount()));
+	}
+
+	protocol::FeeConfig fees;
+	protocol::ValidatorSet validators;
+	const int ledger_count = 1000;
+	int64_t time0 = utils::Timestamp::HighResolution();
+	for (int n = 0; n < ledger_count; n++){
+		std::shared_ptr<bumo::Environment> root = std::make_shared<bumo::Environment>();
+		std::shared_ptr<bumo::Environment> frame = root->NewStackFrameEnv();
+		frame->UpdateFeeConfig(protocol::FeeConfig_Type_GAS_PRICE, 1000 + n);
+		frame->UpdateNewValidators(voted, json);
+		frame->Commit();
+		root->Commit();
+
+		protocol::FeeConfig new_fees;
+		protocol::ValidatorSet new_set;
+		ASSERT_TRUE(root->GetVotedFee(fees, new_fees));
+		ASSERT_TRUE(root->GetVotedValidators(validators, new_set));
+		fees = new_fees;
+		ASSERT_EQ(100, new_set.validators_size());
+	}
+	int64_t time1 = utils::Timestamp::HighResolution();
+	RecordProperty("close_us", (int)(time1 - time0));
+}
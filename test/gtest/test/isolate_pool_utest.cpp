@@ -0,0 +1,152 @@
+#include "gtest/gtest.h"
+#include "utils/timestamp.h"
+#include "utils/logger.h"
+#include "contract/isolate_pool.h"
+#include <libplatform/libplatform.h>
+
+class IsolatePoolTest : public testing::Test{
+protected:
+
+	// Sets up the test case.
+	static void SetUpTestCase(){
+		if (utils::Logger::GetInstance() == NULL){
+			utils::Logger::InitInstance();
+			utils::Logger::Instance().Initialize(utils::LOG_DEST_NONE, utils::LOG_LEVEL_NONE, "", false);
+		}
+
+		std::string argv0 = testing::internal::GetArgvs()[0];
+		v8::V8::InitializeICUDefaultLocation(argv0.c_str());
+		v8::V8::InitializeExternalStartupData(argv0.c_str());
+		platform_ = v8::platform::CreateDefaultPlatform();
+		v8::V8::InitializePlatform(platform_);
+		v8::V8::Initialize();
+		params_.array_buffer_allocator = v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+	}
+
+	// Tears down the test case.
+	static void TearDownTestCase(){
+		v8::V8::Dispose();
+		v8::V8::ShutdownPlatform();
+		delete platform_;
+		delete params_.array_buffer_allocator;
+	}
+
+	// Sets up the test fixture.
+	virtual void SetUp(){
+		bumo::IsolatePool::InitInstance();
+	}
+
+	// Tears down the test fixture.
+	virtual void TearDown(){
+		bumo::IsolatePool::Instance().Exit();
+		bumo::IsolatePool::ExitInstance();
+	}
+
+protected:
+	void UT_Lease_Return();
+	void UT_Main_Benchmark();
+	static bool RunMain(v8::Isolate *isolate);
+
+	static v8::Platform *platform_;
+	static v8::Isolate::CreateParams params_;
+};
+
+v8::Platform *IsolatePoolTest::platform_ = NULL;
+v8::Isolate::CreateParams IsolatePoolTest::params_;
+
+TEST_F(IsolatePoolTest, UT_Lease_Return){ UT_Lease_Return(); }
+TEST_F(IsolatePoolTest, DISABLED_UT_Main_Benchmark){ UT_Main_Benchmark(); }
+
+//Called under the lock of the isolate, as the contracts do.
+bool IsolatePoolTest::RunMain(v8::Isolate *isolate){
+	v8::Isolate::Scope isolate_scope(isolate);
+	v8::HandleScope handle_scope(isolate);
+	v8::Local<v8::Context> context = v8::Context::New(isolate);
+	v8::Context::Scope context_scope(context);
+
+	v8::Local<v8::String> source = v8::String::NewFromUtf8(isolate, "'use strict';function main(input){ return input; }", v8::NewStringType::kNormal).ToLocalChecked();
+	v8::Local<v8::Script> script;
+	v8::Local<v8::Value> result;
+	if (!v8::Script::Compile(context, source).ToLocal(&script) || !script->Run(context).ToLocal(&result)){
+		return false;
+	}
+
+	v8::Local<v8::Value> main;
+	if (!context->Global()->Get(context, v8::String::NewFromUtf8(isolate, "main", v8::NewStringType::kNormal).ToLocalChecked()).ToLocal(&main) ||
+		!main->IsFunction()){
+		return false;
+	}
+
+	v8::Local<v8::Value> argv[1] = { v8::String::NewFromUtf8(isolate, "{}", v8::NewStringType::kNormal).ToLocalChecked() };
+	return v8::Local<v8::Function>::Cast(main)->Call(context, context->Global(), 1, argv).ToLocal(&result);
+}
+
+void IsolatePoolTest::UT_Lease_Return(){
+	bumo::IsolatePool &pool = bumo::IsolatePool::Instance();
+	ASSERT_TRUE(pool.Initialize(params_, 2));
+
+	//Nested contracts lease more isolates than the capacity, the ones over it are disposed when returned.
+	v8::Isolate *isolates[3];
+	for (int i = 0; i < 3; i++){
+		isolates[i] = pool.Lease();
+		v8::Locker locker(isolates[i]);
+		EXPECT_TRUE(RunMain(isolates[i]));
+	}
+	for (int i = 2; i >= 0; i--){
+		pool.Return(isolates[i], false);
+	}
+
+	//A reused isolate starts from about the heap of a new one.
+	v8::Isolate *isolate = pool.Lease();
+	do {
+		v8::Locker locker(isolate);
+		EXPECT_LT(std::abs(bumo::IsolatePool::UsedHeapSize(isolate) - pool.fresh_heap_size()), (int64_t)utils::BYTES_PER_MEGA);
+	} while (false);
+	pool.Return(isolate, true);
+
+	Json::Value status;
+	pool.GetModuleStatus(status);
+	EXPECT_EQ(3, status["created_count"].asInt64());
+	EXPECT_EQ(3, status["reused_count"].asInt64());
+	EXPECT_EQ(2, status["disposed_count"].asInt64());
+	EXPECT_EQ(1, status["idle_count"].asInt64());
+	EXPECT_EQ(0, status["leased_count"].asInt64());
+	EXPECT_EQ(3, status["peak_leased_count"].asInt64());
+}
+
+void IsolatePoolTest::UT_Main_Benchmark(){
+	const int call_count = 10000;
+
+	//A new isolate per call, as before the pool.
+	int64_t time0 = utils::Timestamp::HighResolution();
+	for (int i = 0; i < call_count; i++){
+		v8::Isolate *isolate = v8::Isolate::New(params_);
+		do {
+			v8::Locker locker(isolate);
+			ASSERT_TRUE(RunMain(isolate));
+		} while (false);
+		isolate->Dispose();
+	}
+	int64_t time1 = utils::Timestamp::HighResolution();
+
+	bumo::IsolatePool &pool = bumo::IsolatePool::Instance();
+	ASSERT_TRUE(pool.Initialize(params_, 8));
+	int64_t time2 = utils::Timestamp::HighResolution();
+	for (int i = 0; i < call_count; i++){
+		v8::Isolate *isolate = pool.Lease();
+		do {
+			v8::Locker locker(isolate);
+			ASSERT_TRUE(RunMain(isolate));
+		} while (false);
+		pool.Return(isolate, false);
+	}
+	int64_t time3 = utils::Timestamp::HighResolution();
+
+	Json::Value status;
+	pool.GetModuleStatus(status);
+	RecordProperty("new_isolate_ms", (int)((time1 - time0) / utils::MICRO_UNITS_PER_MILLI));
+	RecordProperty("pooled_isolate_ms", (int)((time3 - time2) / utils::MICRO_UNITS_PER_MILLI));
+	RecordProperty("create_time", status["create_time"].asString());
+	RecordProperty("reset_time", status["reset_time"].asString());
+	EXPECT_EQ(call_count, status["reused_count"].asInt64());
+}
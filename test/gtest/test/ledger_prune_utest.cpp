@@ -0,0 +1,122 @@
+#include "gtest/gtest.h"
+#include "utils/logger.h"
+#include "utils/file.h"
+#include "main/configure.h"
+#include "common/general.h"
+#include "common/storage.h"
+#include "ledger/ledger_manager.h"
+
+//The consensus values served to the peers once the old ledgers are pruned.
+class LedgerPruneTest : public testing::Test{
+protected:
+
+	// Sets up the test fixture.
+	virtual void SetUp(){
+		if (utils::Logger::GetInstance() == NULL){
+			utils::Logger::InitInstance();
+			utils::Logger::Instance().Initialize(utils::LOG_DEST_NONE, utils::LOG_LEVEL_NONE, "", false);
+		}
+
+		if (bumo::Configure::GetInstance() == NULL){
+			bumo::Configure::InitInstance();
+		}
+
+		std::string path = utils::File::GetTempDirectory() + "/ledger_prune_test";
+		db_config_.keyvalue_db_path_ = path + "_keyvalue.db";
+		db_config_.ledger_db_path_ = path + "_ledger.db";
+		db_config_.account_db_path_ = path + "_account.db";
+		bumo::Storage::InitInstance();
+		ASSERT_TRUE(bumo::Storage::Instance().Initialize(db_config_, true));
+		ASSERT_TRUE(bumo::Storage::Instance().Initialize(db_config_, false));
+		bumo::LedgerManager::InitInstance();
+
+		//The consensus values of the ledgers after the pruned ones.
+		for (int64_t seq = PRUNED_SEQ + 1; seq <= LCL_SEQ; seq++){
+			protocol::ConsensusValue value;
+			value.set_ledger_seq(seq);
+			value.set_previous_proof(utils::String::Format("proof" FMT_I64, seq - 1));
+			ASSERT_TRUE(bumo::Storage::Instance().ledger_db()->Put(bumo::ComposePrefix(bumo::General::CONSENSUS_VALUE_PREFIX, seq), value.SerializeAsString()));
+		}
+	}
+
+	// Tears down the test fixture.
+	virtual void TearDown(){
+		bumo::LedgerManager::ExitInstance();
+		bumo::Storage::Instance().Exit();
+		bumo::Storage::ExitInstance();
+		utils::File::DeleteFolder(db_config_.keyvalue_db_path_);
+		utils::File::DeleteFolder(db_config_.ledger_db_path_);
+		utils::File::DeleteFolder(db_config_.account_db_path_);
+	}
+
+	static const int64_t PRUNED_SEQ = 10;
+	static const int64_t LCL_SEQ = 20;
+
+protected:
+	void UT_Get_Ledgers_Pruned();
+	void UT_Get_Ledgers();
+	static protocol::GetLedgers NewRequest(int64_t begin, int64_t end);
+
+	bumo::DbConfigure db_config_;
+};
+
+const int64_t LedgerPruneTest::PRUNED_SEQ;
+const int64_t LedgerPruneTest::LCL_SEQ;
+
+TEST_F(LedgerPruneTest, UT_Get_Ledgers_Pruned){ UT_Get_Ledgers_Pruned(); }
+TEST_F(LedgerPruneTest, UT_Get_Ledgers){ UT_Get_Ledgers(); }
+
+protocol::GetLedgers LedgerPruneTest::NewRequest(int64_t begin, int64_t end){
+	protocol::GetLedgers message;
+	message.set_begin(begin);
+	message.set_end(end);
+	return message;
+}
+
+void LedgerPruneTest::UT_Get_Ledgers_Pruned(){
+	bumo::LedgerManager &manager = bumo::LedgerManager::Instance();
+
+	//A range starting at or below the pruned ledger gets no value, the peer moves on to another node.
+	protocol::Ledgers ledgers;
+	ASSERT_TRUE(manager.GetLedgers(NewRequest(PRUNED_SEQ - 2, PRUNED_SEQ + 2), LCL_SEQ, "lcl", PRUNED_SEQ, ledgers));
+	EXPECT_EQ(protocol::Ledgers::PRUNED, ledgers.sync_code());
+	EXPECT_EQ(LCL_SEQ, ledgers.max_seq());
+	EXPECT_EQ(0, ledgers.values_size());
+	EXPECT_TRUE(ledgers.proof().empty());
+
+	ledgers.Clear();
+	ASSERT_TRUE(manager.GetLedgers(NewRequest(PRUNED_SEQ, PRUNED_SEQ), LCL_SEQ, "lcl", PRUNED_SEQ, ledgers));
+	EXPECT_EQ(protocol::Ledgers::PRUNED, ledgers.sync_code());
+	EXPECT_EQ(0, ledgers.values_size());
+
+	//The ranges above the closed ledger or too long get no reply.
+	ledgers.Clear();
+	EXPECT_FALSE(manager.GetLedgers(NewRequest(PRUNED_SEQ - 2, LCL_SEQ + 1), LCL_SEQ, "lcl", PRUNED_SEQ, ledgers));
+	EXPECT_FALSE(manager.GetLedgers(NewRequest(1, 6), LCL_SEQ, "lcl", PRUNED_SEQ, ledgers));
+}
+
+void LedgerPruneTest::UT_Get_Ledgers(){
+	bumo::LedgerManager &manager = bumo::LedgerManager::Instance();
+
+	//The proof of the last value is the previous proof of the next one.
+	protocol::Ledgers ledgers;
+	ASSERT_TRUE(manager.GetLedgers(NewRequest(PRUNED_SEQ + 1, PRUNED_SEQ + 3), LCL_SEQ, "lcl", PRUNED_SEQ, ledgers));
+	EXPECT_NE(protocol::Ledgers::PRUNED, ledgers.sync_code());
+	EXPECT_EQ(LCL_SEQ, ledgers.max_seq());
+	ASSERT_EQ(3, ledgers.values_size());
+	for (int32_t i = 0; i < ledgers.values_size(); i++){
+		EXPECT_EQ(PRUNED_SEQ + 1 + i, ledgers.values(i).ledger_seq());
+	}
+	EXPECT_EQ(utils::String::Format("proof" FMT_I64, PRUNED_SEQ + 3), ledgers.proof());
+
+	//Up to the closed ledger, whose proof is kept by the ledger manager.
+	ledgers.Clear();
+	ASSERT_TRUE(manager.GetLedgers(NewRequest(LCL_SEQ - 1, LCL_SEQ), LCL_SEQ, "lcl", PRUNED_SEQ, ledgers));
+	EXPECT_EQ(2, ledgers.values_size());
+	EXPECT_EQ("lcl", ledgers.proof());
+
+	//Nothing is pruned before the pruning starts.
+	ledgers.Clear();
+	EXPECT_FALSE(manager.GetLedgers(NewRequest(PRUNED_SEQ - 1, PRUNED_SEQ), LCL_SEQ, "lcl", 0, ledgers));
+	EXPECT_NE(protocol::Ledgers::PRUNED, ledgers.sync_code());
+}
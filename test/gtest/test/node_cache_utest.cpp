@@ -0,0 +1,125 @@
+#include "gtest/gtest.h"
+#include "ledger/node_cache.h"
+
+class NodeCacheTest : public testing::Test{
+protected:
+
+	// Sets up the test fixture.
+	virtual void SetUp(){
+		bumo::NodeCache::InitInstance();
+		bumo::NodeCache::Instance().SetCapacity(1024 * 1024);
+	}
+
+	// Tears down the test fixture.
+	virtual void TearDown(){
+		bumo::NodeCache::ExitInstance();
+	}
+
+protected:
+	void UT_Stale_Put();
+	void UT_Staged_Commit();
+	void UT_Snapshot_Seq();
+	static bumo::NodeInfo NewNode(uint32_t bitmap);
+};
+
+TEST_F(NodeCacheTest, UT_Stale_Put){ UT_Stale_Put(); }
+TEST_F(NodeCacheTest, UT_Staged_Commit){ UT_Staged_Commit(); }
+TEST_F(NodeCacheTest, UT_Snapshot_Seq){ UT_Snapshot_Seq(); }
+
+bumo::NodeInfo NodeCacheTest::NewNode(uint32_t bitmap){
+	bumo::NodeInfo info;
+	info.bitmap_ = bitmap;
+	return info;
+}
+
+void NodeCacheTest::UT_Stale_Put(){
+	bumo::NodeCache &cache = bumo::NodeCache::Instance();
+	bumo::NodeInfo info;
+	int64_t generation = -1;
+	EXPECT_FALSE(cache.Get("a", info, generation));
+
+	//A ledger committed between the read of the database and the Put, the node read may be older than it.
+	WRITE_BATCH batch;
+	cache.Commit(&batch, 1);
+	cache.Put("a", NewNode(1), generation);
+	EXPECT_FALSE(cache.Get("a", info, generation));
+
+	//Loaded again after the commit.
+	cache.Put("a", NewNode(2), generation);
+	ASSERT_TRUE(cache.Get("a", info, generation));
+	EXPECT_EQ(2u, info.bitmap_);
+}
+
+void NodeCacheTest::UT_Staged_Commit(){
+	bumo::NodeCache &cache = bumo::NodeCache::Instance();
+	bumo::NodeInfo info;
+	int64_t generation = -1;
+	EXPECT_FALSE(cache.Get("a", info, generation));
+	cache.Put("a", NewNode(1), generation);
+	EXPECT_FALSE(cache.Get("b", info, generation));
+	cache.Put("b", NewNode(1), generation);
+
+	//The nodes of a batch are not seen before it is written.
+	WRITE_BATCH batch;
+	bumo::NodeInfo changed = NewNode(3);
+	cache.Stage(&batch, "a", &changed);
+	cache.Stage(&batch, "b", NULL);
+	cache.Stage(&batch, "c", &changed);
+	ASSERT_TRUE(cache.Get("a", info, generation));
+	EXPECT_EQ(1u, info.bitmap_);
+	EXPECT_FALSE(cache.Get("c", info, generation));
+
+	//Another batch, written first, does not take them.
+	WRITE_BATCH other;
+	cache.Commit(&other, 1);
+	ASSERT_TRUE(cache.Get("a", info, generation));
+	EXPECT_EQ(1u, info.bitmap_);
+
+	cache.Commit(&batch, 2);
+	ASSERT_TRUE(cache.Get("a", info, generation));
+	EXPECT_EQ(3u, info.bitmap_);
+	EXPECT_FALSE(cache.Get("b", info, generation));
+	ASSERT_TRUE(cache.Get("c", info, generation));
+	EXPECT_EQ(3u, info.bitmap_);
+}
+
+void NodeCacheTest::UT_Snapshot_Seq(){
+	bumo::NodeCache &cache = bumo::NodeCache::Instance();
+	WRITE_BATCH batch1;
+	bumo::NodeInfo node = NewNode(1);
+	cache.Stage(&batch1, "a", &node);
+	cache.Stage(&batch1, "b", &node);
+	cache.Commit(&batch1, 1);
+
+	WRITE_BATCH batch2;
+	node = NewNode(2);
+	cache.Stage(&batch2, "a", &node);
+	cache.Commit(&batch2, 2);
+
+	//A snapshot of ledger 1 gets the node unchanged since, not the one changed by ledger 2.
+	bumo::NodeInfo info;
+	int64_t generation = 0;
+	ASSERT_TRUE(cache.Get("b", info, generation, 1));
+	EXPECT_EQ(1u, info.bitmap_);
+	EXPECT_FALSE(cache.Get("a", info, generation, 1));
+	//What it loads from its snapshot is not put.
+	EXPECT_EQ(-1, generation);
+	cache.Put("a", NewNode(1), generation);
+	ASSERT_TRUE(cache.Get("a", info, generation));
+	EXPECT_EQ(2u, info.bitmap_);
+
+	//The latest state reads the same nodes as the snapshot of the last ledger.
+	ASSERT_TRUE(cache.Get("a", info, generation, 2));
+	EXPECT_EQ(2u, info.bitmap_);
+
+	//Nothing is known of a ledger not committed yet.
+	EXPECT_FALSE(cache.Get("b", info, generation, 3));
+	EXPECT_EQ(-1, generation);
+
+	//After a clear, the cache holds the state of the given ledger only.
+	cache.Clear(5);
+	EXPECT_FALSE(cache.Get("a", info, generation, 5));
+	cache.Put("a", NewNode(4), generation);
+	ASSERT_TRUE(cache.Get("a", info, generation, 5));
+	EXPECT_EQ(4u, info.bitmap_);
+}
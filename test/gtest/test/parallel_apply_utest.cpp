@@ -0,0 +1,401 @@
+#include "gtest/gtest.h"
+#include "utils/strings.h"
+#include "utils/crypto.h"
+#include "utils/timestamp.h"
+#include "utils/logger.h"
+#include "common/storage.h"
+#include "main/configure.h"
+#include "ledger/parallel_executor.h"
+#include "ledger/ledger_manager.h"
+#include "ledger/ledgercontext_manager.h"
+
+//Accounts kept in memory, so the benchmark only measures the execution.
+class MemoryEnvironment : public bumo::Environment{
+public:
+	MemoryEnvironment(const std::map<std::string, protocol::Account>& accounts) :accounts_(accounts){}
+
+	virtual bool GetFromDB(const std::string& address, bumo::AccountFrm::pointer& account_ptr){
+		auto it = accounts_.find(address);
+		if (it == accounts_.end()){
+			return false;
+		}
+		account_ptr = std::make_shared<bumo::AccountFrm>(it->second);
+		return true;
+	}
+
+private:
+	const std::map<std::string, protocol::Account>& accounts_;
+};
+
+class ParallelApplyTest : public testing::Test{
+protected:
+
+	// Sets up the test fixture.
+	virtual void SetUp(){
+		pool_.Init("apply-test", 8);
+	}
+
+	// Tears down the test fixture.
+	virtual void TearDown(){
+		pool_.Exit();
+	}
+
+	struct Payment{
+		std::string source_;
+		std::string dest_;
+		int64_t amount_;
+	};
+
+	utils::ThreadPool pool_;
+	std::map<std::string, protocol::Account> accounts_;
+
+protected:
+	void UT_Parallel_Apply_Identical();
+	void UT_Parallel_Apply_Benchmark();
+	static std::string Address(size_t i);
+	static bool Pay(const Payment& payment, std::shared_ptr<bumo::Environment> environment);
+	void CompareApply(const std::string& name, const std::vector<Payment>& payments, bool known_dest);
+};
+
+TEST_F(ParallelApplyTest, UT_Parallel_Apply_Identical){ UT_Parallel_Apply_Identical(); }
+TEST_F(ParallelApplyTest, DISABLED_UT_Parallel_Apply_Benchmark){ UT_Parallel_Apply_Benchmark(); }
+
+std::string ParallelApplyTest::Address(size_t i){
+	return utils::String::Format("account-" FMT_SIZE, i);
+}
+
+//A payment as the ledger applies it: the nonce is kept even if the payment fails.
+bool ParallelApplyTest::Pay(const Payment& payment, std::shared_ptr<bumo::Environment> environment){
+	//Stands for the signature checks of a transaction.
+	std::string digest = payment.source_;
+	for (int i = 0; i < 200; i++){
+		digest = utils::Sha256::Crypto(digest);
+	}
+
+	bumo::AccountFrm::pointer source;
+	if (!environment->GetEntry(payment.source_, source)){
+		return false;
+	}
+	source->NonceIncrease();
+	environment->Commit();
+
+	do {
+		environment->GetEntry(payment.source_, source);
+		if (source->GetAccountBalance() < payment.amount_){
+			break;
+		}
+
+		bumo::AccountFrm::pointer dest;
+		if (!environment->GetEntry(payment.dest_, dest)){
+			protocol::Account account;
+			account.set_address(payment.dest_);
+			dest = std::make_shared<bumo::AccountFrm>(account);
+			environment->AddEntry(payment.dest_, dest);
+		}
+
+		source->AddBalance(-payment.amount_);
+		dest->AddBalance(payment.amount_);
+		environment->Commit();
+	} while (false);
+
+	environment->ClearChangeBuf();
+	return true;
+}
+
+//Without the known destinations, the payments to the same account are run ahead and conflict.
+void ParallelApplyTest::CompareApply(const std::string& name, const std::vector<Payment>& payments, bool known_dest){
+	std::shared_ptr<bumo::Environment> serial_env = std::make_shared<MemoryEnvironment>(accounts_);
+	std::shared_ptr<bumo::Environment> parallel_env = std::make_shared<MemoryEnvironment>(accounts_);
+
+	int64_t time0 = utils::Timestamp::HighResolution();
+	for (size_t i = 0; i < payments.size(); i++){
+		Pay(payments[i], serial_env);
+	}
+	int64_t time1 = utils::Timestamp::HighResolution();
+
+	bumo::ParallelExecutor executor(&pool_, parallel_env, [&payments](int32_t index, std::shared_ptr<bumo::Environment> environment){
+		return Pay(payments[index], environment);
+	});
+	for (size_t i = 0; i < payments.size(); i++){
+		std::vector<std::string> accounts;
+		accounts.push_back(payments[i].source_);
+		if (known_dest){
+			accounts.push_back(payments[i].dest_);
+		}
+		executor.Add(true, accounts);
+	}
+	for (size_t i = 0; i < payments.size(); i++){
+		if (executor.Validate((int32_t)i)){
+			executor.Commit((int32_t)i);
+		}
+		else{
+			Pay(payments[i], parallel_env);
+		}
+	}
+	int64_t time2 = utils::Timestamp::HighResolution();
+
+	RecordProperty(name + "_serial_us", (int)(time1 - time0));
+	RecordProperty(name + "_parallel_us", (int)(time2 - time1));
+	RecordProperty(name + "_conflicts", (int)executor.conflict_count_);
+
+	const bumo::Environment::Map& serial_data = serial_env->GetData();
+	const bumo::Environment::Map& parallel_data = parallel_env->GetData();
+	ASSERT_EQ(serial_data.size(), parallel_data.size());
+	for (auto it = serial_data.begin(); it != serial_data.end(); it++){
+		auto iter = parallel_data.find(it->first);
+		ASSERT_TRUE(iter != parallel_data.end());
+		EXPECT_EQ(it->second.ptr_->Serializer(), iter->second.ptr_->Serializer());
+	}
+}
+
+void ParallelApplyTest::UT_Parallel_Apply_Identical(){
+	for (size_t i = 0; i < 100; i++){
+		protocol::Account account;
+		account.set_address(Address(i));
+		account.set_balance(10);
+		accounts_[account.address()] = account;
+	}
+
+	//Chains of payments through the same accounts, some of them failing for the balance.
+	std::vector<Payment> payments;
+	for (size_t i = 0; i < 3000; i++){
+		Payment payment;
+		payment.source_ = Address((i * 7) % 100);
+		payment.dest_ = Address((i * 13 + i / 100) % 120);
+		payment.amount_ = (int64_t)(i % 9);
+		payments.push_back(payment);
+	}
+	CompareApply("mixed", payments, false);
+	CompareApply("mixed_known", payments, true);
+}
+
+void ParallelApplyTest::UT_Parallel_Apply_Benchmark(){
+	const size_t payment_count = 20000;
+	for (size_t i = 0; i < payment_count; i++){
+		protocol::Account account;
+		account.set_address(Address(i));
+		account.set_balance(1000000);
+		accounts_[account.address()] = account;
+	}
+
+	//Every payment between accounts of its own.
+	std::vector<Payment> payments;
+	for (size_t i = 0; i < payment_count; i++){
+		Payment payment;
+		payment.source_ = Address(i);
+		payment.dest_ = Address(payment_count + i);
+		payment.amount_ = 1;
+		payments.push_back(payment);
+	}
+	CompareApply("disjoint", payments, true);
+
+	//Every payment to the same account.
+	for (size_t i = 0; i < payment_count; i++){
+		payments[i].dest_ = Address(payment_count);
+	}
+	CompareApply("hot_account", payments, true);
+	CompareApply("hot_account_unknown", payments, false);
+}
+
+//Payments with fees applied through the ledger, serially and then ahead in the apply pool of the ledger manager.
+class LedgerApplyTest : public testing::Test{
+protected:
+
+	// Sets up the test fixture.
+	virtual void SetUp(){
+		if (utils::Logger::GetInstance() == NULL){
+			utils::Logger::InitInstance();
+			utils::Logger::Instance().Initialize(utils::LOG_DEST_NONE, utils::LOG_LEVEL_NONE, "", false);
+		}
+
+		if (bumo::Configure::GetInstance() == NULL){
+			bumo::Configure::InitInstance();
+		}
+
+		std::string path = utils::File::GetTempDirectory() + "/ledger_apply_test";
+		db_config_.keyvalue_db_path_ = path + "_keyvalue.db";
+		db_config_.ledger_db_path_ = path + "_ledger.db";
+		db_config_.account_db_path_ = path + "_account.db";
+		bumo::Storage::InitInstance();
+		ASSERT_TRUE(bumo::Storage::Instance().Initialize(db_config_, true));
+		ASSERT_TRUE(bumo::Storage::Instance().Initialize(db_config_, false));
+		bumo::LedgerManager::InitInstance();
+
+		for (size_t i = 0; i < 48; i++){
+			keys_.push_back(std::make_shared<bumo::PrivateKey>(bumo::SIGNTYPE_ED25519));
+		}
+		BuildState();
+	}
+
+	// Tears down the test fixture.
+	virtual void TearDown(){
+		bumo::LedgerManager::Instance().apply_pool_.Exit();
+		bumo::LedgerManager::ExitInstance();
+		bumo::Storage::Instance().Exit();
+		bumo::Storage::ExitInstance();
+		utils::File::DeleteFolder(db_config_.keyvalue_db_path_);
+		utils::File::DeleteFolder(db_config_.ledger_db_path_);
+		utils::File::DeleteFolder(db_config_.account_db_path_);
+	}
+
+	//The ledger applied in one of the modes.
+	struct Applied{
+		std::string hash_;
+		int64_t fee_;
+		std::vector<int32_t> codes_;
+	};
+
+	static const size_t ACCOUNT_COUNT = 40;
+	static const int64_t LEDGER_SEQ = 3;
+
+	bumo::DbConfigure db_config_;
+	std::vector<std::shared_ptr<bumo::PrivateKey> > keys_;
+
+protected:
+	void UT_Parallel_Apply_Ledger_Identical();
+	void BuildState();
+	protocol::ConsensusValue NewValue();
+	void ApplyAll(protocol::ConsensusValue value, std::vector<Applied> &applied);
+	bool Apply(bumo::LedgerFrm::APPLY_MODE mode, const protocol::ConsensusValue &value, protocol::ConsensusValueValidation &validation, Applied &applied);
+};
+
+TEST_F(LedgerApplyTest, UT_Parallel_Apply_Ledger_Identical){ UT_Parallel_Apply_Ledger_Identical(); }
+
+//The accounts of all the keys but the last ones, and the validators of the ledger before.
+void LedgerApplyTest::BuildState(){
+	bumo::KeyValueDb *account_db = bumo::Storage::Instance().account_db();
+	std::shared_ptr<WRITE_BATCH> batch = std::make_shared<WRITE_BATCH>();
+	bumo::KVTrie accounts;
+	accounts.Init(account_db, batch, bumo::General::ACCOUNT_PREFIX, 4);
+	for (size_t i = 0; i < ACCOUNT_COUNT; i++){
+		bumo::AccountFrm::pointer account = bumo::AccountFrm::CreatAccountFrm(keys_[i]->GetEncAddress(), 1000000000);
+		accounts.Set(bumo::DecodeAddress(account->GetAccountAddress()), account->Serializer());
+	}
+	accounts.UpdateHash();
+	accounts.AddToDB();
+
+	protocol::ValidatorSet validators;
+	for (size_t i = ACCOUNT_COUNT - 2; i < ACCOUNT_COUNT + 2; i++){
+		validators.add_validators()->set_address(keys_[i]->GetEncAddress());
+	}
+	protocol::LedgerHeader header;
+	header.set_seq(LEDGER_SEQ - 1);
+	header.set_account_tree_hash(accounts.GetRootHash());
+	header.set_validators_hash(bumo::HashWrapper::Crypto(validators.SerializeAsString()));
+	batch->Put(utils::String::Format("validators-%s", utils::String::BinToHexString(header.validators_hash()).c_str()), validators.SerializeAsString());
+	ASSERT_TRUE(account_db->WriteBatch(*batch));
+	ASSERT_TRUE(bumo::Storage::Instance().ledger_db()->Put(bumo::ComposePrefix(bumo::General::LEDGER_PREFIX, LEDGER_SEQ - 1), header.SerializeAsString()));
+
+	bumo::LedgerManager::Instance().tree_ = new bumo::KVTrie();
+	bumo::LedgerManager::Instance().tree_->Init(account_db, std::make_shared<WRITE_BATCH>(), bumo::General::ACCOUNT_PREFIX, 4);
+}
+
+//Chains of payments through the same accounts, to the new accounts of the last keys as well,
+//one in seven failing for the balance.
+protocol::ConsensusValue LedgerApplyTest::NewValue(){
+	protocol::ConsensusValue value;
+	value.set_ledger_seq(LEDGER_SEQ);
+	value.set_close_time(utils::Timestamp::HighResolution());
+
+	std::vector<int64_t> nonces(ACCOUNT_COUNT, 0);
+	for (size_t i = 0; i < 400; i++){
+		size_t source = (i * 7) % ACCOUNT_COUNT;
+		size_t dest = (i * 13 + i / 50) % keys_.size();
+		if (dest == source){
+			dest = ACCOUNT_COUNT;
+		}
+		protocol::TransactionEnv *env = value.mutable_txset()->add_txs();
+		protocol::Transaction *tx = env->mutable_transaction();
+		tx->set_source_address(keys_[source]->GetEncAddress());
+		tx->set_nonce(++nonces[source]);
+		tx->set_gas_price(1000);
+		tx->set_fee_limit(1000000);
+
+		protocol::Operation *ope = tx->add_operations();
+		ope->set_type(protocol::Operation_Type_PAY_COIN);
+		ope->mutable_pay_coin()->set_dest_address(keys_[dest]->GetEncAddress());
+		ope->mutable_pay_coin()->set_amount(i % 7 == 0 ? 2000000000 : (int64_t)(i + 1) * 1000);
+
+		protocol::Signature *signature = env->add_signatures();
+		signature->set_public_key(keys_[source]->GetEncPublicKey());
+		signature->set_sign_data(keys_[source]->Sign(tx->SerializeAsString()));
+	}
+	return value;
+}
+
+//Apply the value in a ledger of its own, the hash covers the account tree with the ledger committed.
+bool LedgerApplyTest::Apply(bumo::LedgerFrm::APPLY_MODE mode, const protocol::ConsensusValue &value, protocol::ConsensusValueValidation &validation, Applied &applied){
+	bumo::LedgerContext context("", value);
+	bumo::LedgerFrm ledger;
+	protocol::LedgerHeader *header = ledger.ProtoLedger().mutable_header();
+	header->set_seq(value.ledger_seq());
+	header->set_close_time(value.close_time());
+	header->set_chain_id(bumo::General::GetSelfChainId());
+
+	bool ret = false;
+	if (mode == bumo::LedgerFrm::APPLY_MODE_PROPOSE){
+		bumo::ProposeTxsResult result;
+		ret = ledger.ApplyPropose(value, &context, result);
+		EXPECT_TRUE(result.need_dropped_tx_.empty());
+		validation = result.cons_validation_;
+	}
+	else if (mode == bumo::LedgerFrm::APPLY_MODE_CHECK){
+		ret = ledger.ApplyCheck(value, &context);
+	}
+	else{
+		ret = ledger.ApplyFollow(value, &context);
+	}
+
+	applied.fee_ = ledger.total_fee_;
+	for (size_t i = 0; i < ledger.apply_tx_frms_.size(); i++){
+		applied.codes_.push_back(ledger.apply_tx_frms_[i]->GetResult().code());
+	}
+
+	bumo::KVTrie trie;
+	trie.Init(bumo::Storage::Instance().account_db(), std::make_shared<WRITE_BATCH>(), bumo::General::ACCOUNT_PREFIX, 4);
+	bumo::LedgerFrm::CommitStat stat;
+	ledger.Commit(&trie, stat);
+	trie.UpdateHash();
+	header->set_account_tree_hash(trie.GetRootHash());
+	header->set_hash("");
+	applied.hash_ = bumo::HashWrapper::Crypto(ledger.ProtoLedger().SerializeAsString());
+	return ret;
+}
+
+//Propose the value, then check and follow it with the validation of the proposal.
+void LedgerApplyTest::ApplyAll(protocol::ConsensusValue value, std::vector<Applied> &applied){
+	applied.resize(3);
+	protocol::ConsensusValueValidation validation;
+	EXPECT_TRUE(Apply(bumo::LedgerFrm::APPLY_MODE_PROPOSE, value, validation, applied[0]));
+
+	*value.mutable_validation() = validation;
+	EXPECT_TRUE(Apply(bumo::LedgerFrm::APPLY_MODE_CHECK, value, validation, applied[1]));
+	EXPECT_TRUE(Apply(bumo::LedgerFrm::APPLY_MODE_FOLLOW, value, validation, applied[2]));
+}
+
+void LedgerApplyTest::UT_Parallel_Apply_Ledger_Identical(){
+	protocol::ConsensusValue value = NewValue();
+
+	//The pool is not started, so the ledgers are applied serially.
+	std::vector<Applied> serial;
+	ApplyAll(value, serial);
+
+	bumo::LedgerManager::Instance().apply_pool_.Init("apply-test", 4);
+	std::vector<Applied> parallel;
+	ApplyAll(value, parallel);
+
+	size_t failed = 0;
+	for (size_t i = 0; i < serial[0].codes_.size(); i++){
+		failed += (serial[0].codes_[i] != 0 ? 1 : 0);
+	}
+	EXPECT_EQ((size_t)value.txset().txs_size(), serial[0].codes_.size());
+	EXPECT_GT(failed, (size_t)0);
+	EXPECT_GT(serial[0].fee_, 0);
+
+	for (size_t i = 0; i < serial.size(); i++){
+		EXPECT_EQ(serial[0].hash_, serial[i].hash_);
+		EXPECT_EQ(serial[i].hash_, parallel[i].hash_);
+		EXPECT_EQ(serial[i].fee_, parallel[i].fee_);
+		EXPECT_EQ(serial[i].codes_, parallel[i].codes_);
+	}
+}
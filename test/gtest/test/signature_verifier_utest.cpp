@@ -0,0 +1,229 @@
+#include "gtest/gtest.h"
+#include "utils/strings.h"
+#include "utils/timestamp.h"
+#include "utils/logger.h"
+#include "common/private_key.h"
+#include "common/general.h"
+#include "ledger/signature_verifier.h"
+#include "ledger/signature_cache.h"
+
+class SignatureVerifierTest : public testing::Test{
+protected:
+
+	// Sets up the test fixture.
+	virtual void SetUp(){
+		//The invalid signatures are logged.
+		if (utils::Logger::GetInstance() == NULL){
+			utils::Logger::InitInstance();
+			utils::Logger::Instance().Initialize(utils::LOG_DEST_NONE, utils::LOG_LEVEL_NONE, "", false);
+		}
+		pool_.Init("verify-test", 4);
+	}
+
+	// Tears down the test fixture.
+	virtual void TearDown(){
+		pool_.Exit();
+	}
+
+	utils::ThreadPool pool_;
+
+protected:
+	void UT_Verify_Identical();
+	void UT_Verify_Torsion();
+	void UT_Verify_Benchmark();
+	void UT_Verify_Cached();
+	static void NewTxSet(size_t count, size_t invalid_every, protocol::TransactionEnvSet &txset);
+	static void AddSignature(protocol::TransactionEnv *env, const std::string &raw_pub_key, const std::string &sign_data);
+	void CompareVerify(const protocol::TransactionEnvSet &txset);
+};
+
+TEST_F(SignatureVerifierTest, UT_Verify_Identical){ UT_Verify_Identical(); }
+TEST_F(SignatureVerifierTest, UT_Verify_Torsion){ UT_Verify_Torsion(); }
+TEST_F(SignatureVerifierTest, DISABLED_UT_Verify_Benchmark){ UT_Verify_Benchmark(); }
+TEST_F(SignatureVerifierTest, UT_Verify_Cached){ UT_Verify_Cached(); }
+
+//Transactions of a few signers, every invalid_every one of their signatures broken.
+void SignatureVerifierTest::NewTxSet(size_t count, size_t invalid_every, protocol::TransactionEnvSet &txset){
+	std::vector<std::shared_ptr<bumo::PrivateKey> > keys;
+	for (size_t i = 0; i < 8; i++){
+		keys.push_back(std::make_shared<bumo::PrivateKey>(bumo::SIGNTYPE_ED25519));
+	}
+
+	for (size_t i = 0; i < count; i++){
+		protocol::TransactionEnv *env = txset.add_txs();
+		protocol::Transaction *tx = env->mutable_transaction();
+		tx->set_source_address(keys[i % keys.size()]->GetEncAddress());
+		tx->set_nonce((int64_t)i + 1);
+		std::string data = tx->SerializeAsString();
+
+		//Some transactions are signed twice.
+		for (size_t j = 0; j <= i % 2; j++){
+			const bumo::PrivateKey &key = *keys[(i + j) % keys.size()];
+			protocol::Signature *signature = env->add_signatures();
+			signature->set_public_key(key.GetEncPublicKey());
+			signature->set_sign_data(key.Sign(data));
+			if (invalid_every > 0 && (i + j) % invalid_every == 0){
+				(*signature->mutable_sign_data())[0] ^= 1;
+			}
+		}
+	}
+}
+
+void SignatureVerifierTest::AddSignature(protocol::TransactionEnv *env, const std::string &raw_pub_key, const std::string &sign_data){
+	bumo::PublicKey pubkey;
+	pubkey.Init(raw_pub_key);
+	protocol::Signature *signature = env->add_signatures();
+	signature->set_public_key(pubkey.GetEncPublicKey());
+	signature->set_sign_data(sign_data);
+}
+
+void SignatureVerifierTest::CompareVerify(const protocol::TransactionEnvSet &txset){
+	std::vector<bumo::SignatureVerifier::Signers> expected(txset.txs_size());
+	for (int32_t i = 0; i < txset.txs_size(); i++){
+		const protocol::TransactionEnv &env = txset.txs(i);
+		std::string data = env.transaction().SerializeAsString();
+		for (int32_t j = 0; j < env.signatures_size(); j++){
+			if (bumo::PublicKey::Verify(data, env.signatures(j).sign_data(), env.signatures(j).public_key())){
+				expected[i].insert(bumo::PublicKey(env.signatures(j).public_key()).GetEncAddress());
+			}
+		}
+	}
+
+	std::vector<bumo::SignatureVerifier::Verified> serial;
+	bumo::SignatureVerifier(NULL).Verify(txset, serial);
+
+	std::vector<bumo::SignatureVerifier::Verified> parallel;
+	bumo::SignatureVerifier(&pool_).Verify(txset, parallel);
+
+	ASSERT_EQ(expected.size(), serial.size());
+	ASSERT_EQ(expected.size(), parallel.size());
+	for (size_t i = 0; i < expected.size(); i++){
+		EXPECT_TRUE(expected[i] == serial[i].signers_);
+		EXPECT_TRUE(expected[i] == parallel[i].signers_);
+		EXPECT_EQ(txset.txs(i).transaction().SerializeAsString(), serial[i].data_);
+		EXPECT_EQ(bumo::HashWrapper::Crypto(serial[i].data_), parallel[i].hash_);
+	}
+}
+
+void SignatureVerifierTest::UT_Verify_Identical(){
+	protocol::TransactionEnvSet txset;
+	NewTxSet(500, 37, txset);
+	CompareVerify(txset);
+
+	protocol::TransactionEnvSet small;
+	NewTxSet(3, 2, small);
+	CompareVerify(small);
+
+	Json::Value status;
+	bumo::SignatureVerifier::GetModuleStatus(status);
+	EXPECT_GT(status["invalid_count"].asInt64(), 0);
+}
+
+//Signatures with points of small order or encoded out of the field among valid ones.
+//A cofactorless batch check may accept them where the single check does not.
+void SignatureVerifierTest::UT_Verify_Torsion(){
+	//The identity as y = 1 and as y = p + 1, which is not canonical.
+	std::string identity(32, '\0');
+	identity[0] = 0x01;
+	std::string identity_non_canonical(32, (char)0xff);
+	identity_non_canonical[0] = (char)0xee;
+	identity_non_canonical[31] = 0x7f;
+	//A point of order 8 and y = -1 of order 2.
+	std::string order8 = utils::String::HexStringToBin("26e8958fc2b227b045c3f489f2ef98f0d5dfac05d3c63339b13802886d53fc05");
+	std::string order2 = utils::String::HexStringToBin("ecffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f");
+	std::string zero(32, '\0');
+
+	//The non canonical R passes the batch equation of ed25519-donna, but not the single check.
+	protocol::TransactionEnvSet txset;
+	NewTxSet(200, 0, txset);
+	for (int32_t i = 0; i < txset.txs_size(); i += 10){
+		AddSignature(txset.mutable_txs(i), identity, identity_non_canonical + zero);
+	}
+	CompareVerify(txset);
+
+	std::vector<bumo::SignatureVerifier::Verified> txs;
+	bumo::SignatureVerifier(&pool_).Verify(txset, txs);
+	bumo::PublicKey pubkey;
+	pubkey.Init(identity);
+	EXPECT_FALSE(bumo::PublicKey::Verify(txs[0].data_, identity_non_canonical + zero, pubkey.GetEncPublicKey()));
+	for (int32_t i = 0; i < txset.txs_size(); i += 10){
+		EXPECT_EQ(0, txs[i].signers_.count(pubkey.GetEncAddress()));
+		EXPECT_EQ(1, txs[i].signers_.size());
+	}
+
+	//Keys and R of small order and an S with the high bits set give what the single check gives.
+	txset.Clear();
+	NewTxSet(200, 0, txset);
+	for (int32_t i = 0; i < txset.txs_size(); i += 10){
+		protocol::TransactionEnv *env = txset.mutable_txs(i);
+		std::string real_key = bumo::PublicKey(env->signatures(0).public_key()).GetRawPublicKey();
+		std::string real_r = env->signatures(0).sign_data().substr(0, 32);
+		AddSignature(env, identity, identity + zero);
+		AddSignature(env, order8, identity + zero);
+		AddSignature(env, order2, order8 + zero);
+		AddSignature(env, real_key, order8 + env->signatures(0).sign_data().substr(32));
+		AddSignature(env, real_key, real_r + std::string(31, (char)0xff) + (char)0x0f);
+	}
+	CompareVerify(txset);
+}
+
+void SignatureVerifierTest::UT_Verify_Benchmark(){
+	protocol::TransactionEnvSet txset;
+	NewTxSet(5000, 0, txset);
+	int64_t time0 = utils::Timestamp::HighResolution();
+	std::vector<bumo::SignatureVerifier::Verified> serial;
+	bumo::SignatureVerifier(NULL).Verify(txset, serial);
+	int64_t time1 = utils::Timestamp::HighResolution();
+	std::vector<bumo::SignatureVerifier::Verified> parallel;
+	bumo::SignatureVerifier(&pool_).Verify(txset, parallel);
+	int64_t time2 = utils::Timestamp::HighResolution();
+
+	RecordProperty("serial_us", (int)(time1 - time0));
+	RecordProperty("parallel_us", (int)(time2 - time1));
+}
+
+void SignatureVerifierTest::UT_Verify_Cached(){
+	bumo::SignatureCache::InitInstance();
+	bumo::SignatureCache::Instance().SetCapacity(1000);
+
+	protocol::TransactionEnvSet txset;
+	NewTxSet(600, 37, txset);
+	CompareVerify(txset);
+
+	//A transaction with a signature not cached is verified again.
+	protocol::TransactionEnvSet resigned = txset;
+	(*resigned.mutable_txs(1)->mutable_signatures(0)->mutable_sign_data())[1] ^= 1;
+	Json::Value before;
+	bumo::SignatureCache::Instance().GetModuleStatus(before);
+	CompareVerify(resigned);
+
+	Json::Value status;
+	bumo::SignatureCache::Instance().GetModuleStatus(status);
+	EXPECT_EQ(600, status["count"].asInt64());
+	EXPECT_EQ(before["hit_count"].asInt64() + 2 * 600 - 1, status["hit_count"].asInt64());
+
+	bumo::SignatureCache::Instance().SetCapacity(100);
+	bumo::SignatureCache::Instance().GetModuleStatus(status);
+	EXPECT_EQ(100, status["count"].asInt64());
+
+	//The envelopes of one transaction with ever new signatures do not grow its entry without limit.
+	std::vector<protocol::TransactionEnv> envs(200);
+	std::set<std::string> signers;
+	for (size_t i = 0; i < envs.size(); i++){
+		envs[i].mutable_transaction()->set_nonce(1);
+		envs[i].add_signatures()->set_sign_data(utils::String::Format("sign" FMT_SIZE, i));
+		bumo::SignatureCache::Instance().Put("same", envs[i], std::vector<std::string>(1, ""));
+		EXPECT_TRUE(bumo::SignatureCache::Instance().Get("same", envs[i], signers));
+	}
+	EXPECT_FALSE(bumo::SignatureCache::Instance().Get("same", envs[0], signers));
+
+	//The same bytes split at another point between the public key and the signature are another signature.
+	const protocol::Signature &signature = txset.txs(0).signatures(0);
+	protocol::TransactionEnv split = txset.txs(0);
+	split.mutable_signatures(0)->set_public_key(signature.public_key() + signature.sign_data().substr(0, 8));
+	split.mutable_signatures(0)->set_sign_data(signature.sign_data().substr(8));
+	bumo::SignatureCache::Instance().Put("split", txset.txs(0), std::vector<std::string>(1, txset.txs(0).transaction().source_address()));
+	EXPECT_TRUE(bumo::SignatureCache::Instance().Get("split", txset.txs(0), signers));
+	EXPECT_FALSE(bumo::SignatureCache::Instance().Get("split", split, signers));
+	bumo::SignatureCache::ExitInstance();
+}
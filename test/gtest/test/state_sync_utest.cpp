@@ -0,0 +1,210 @@
+#include <map>
+#include "gtest/gtest.h"
+#include "utils/strings.h"
+#include "utils/logger.h"
+#include "common/general.h"
+#include "common/private_key.h"
+#include "ledger/kv_trie.h"
+#include "ledger/state_stage.h"
+
+//Database kept in memory, the batches are applied at once.
+class MemoryDb : public bumo::KeyValueDb{
+public:
+	std::map<std::string, std::string> values_;
+
+	virtual bool Open(const std::string &, int){ return true; }
+	virtual bool Close(){ return true; }
+	virtual int32_t Get(const std::string &key, std::string &value){
+		auto it = values_.find(key);
+		if (it == values_.end()){
+			return 0;
+		}
+		value = it->second;
+		return 1;
+	}
+	virtual bool Put(const std::string &key, const std::string &value){
+		values_[key] = value;
+		return true;
+	}
+	virtual bool Delete(const std::string &key){
+		values_.erase(key);
+		return true;
+	}
+	virtual bool GetOptions(Json::Value &){ return false; }
+	virtual bool WriteBatch(WRITE_BATCH &values, bool){
+		Handler handler(this);
+		return values.Iterate(&handler).ok();
+	}
+	virtual void* NewIterator(){ return NULL; }
+
+	size_t StagedCount(){
+		std::string prefix = bumo::StateStage::StagedKey("");
+		size_t count = 0;
+		for (auto it = values_.lower_bound(prefix); it != values_.end() && it->first.compare(0, prefix.size(), prefix) == 0; it++){
+			count++;
+		}
+		return count;
+	}
+
+private:
+	class Handler : public WRITE_BATCH::Handler{
+	public:
+		Handler(MemoryDb *db) :db_(db){}
+		virtual void Put(const SLICE &key, const SLICE &value){
+			db_->values_[key.ToString()] = value.ToString();
+		}
+		virtual void Delete(const SLICE &key){
+			db_->values_.erase(key.ToString());
+		}
+	private:
+		MemoryDb *db_;
+	};
+};
+
+class StateSyncTest : public testing::Test{
+protected:
+	virtual void SetUp(){
+		if (utils::Logger::GetInstance() == NULL){
+			utils::Logger::InitInstance();
+			utils::Logger::Instance().Initialize(utils::LOG_DEST_NONE, utils::LOG_LEVEL_NONE, "", false);
+		}
+		BuildSource();
+
+		//The genesis state has other values at the same keys.
+		for (auto it = source_.values_.begin(); it != source_.values_.end(); it++){
+			dest_.values_[it->first] = "genesis";
+		}
+	}
+
+	void BuildSource(){
+		bumo::KVTrie accounts;
+		accounts.Init(&source_, std::make_shared<WRITE_BATCH>(), bumo::General::ACCOUNT_PREFIX, 4);
+		for (int32_t i = 0; i < 64; i++){
+			std::string address = bumo::EncodeAddress(utils::String::Format("account%013d", i));
+			protocol::Account account;
+			account.set_address(address);
+			account.set_balance(i);
+
+			if (i % 4 == 0){
+				bumo::KVTrie metadata;
+				metadata.Init(&source_, std::make_shared<WRITE_BATCH>(), bumo::ComposePrefix(bumo::General::METADATA_PREFIX, bumo::DecodeAddress(address)), 1);
+				for (int32_t j = 0; j < 8; j++){
+					metadata.Set(utils::String::Format("key%d", j), utils::String::Format("value%d", j));
+				}
+				metadata.UpdateHash();
+				metadata.AddToDB();
+				account.set_metadatas_hash(metadata.GetRootHash());
+			}
+			accounts.Set(bumo::DecodeAddress(address), account.SerializeAsString());
+		}
+		accounts.UpdateHash();
+		accounts.AddToDB();
+
+		std::string validators = "validators";
+		std::string fees = "fees";
+		protocol::LedgerHeader *header = status_.mutable_ledger()->mutable_header();
+		header->set_seq(2000);
+		header->set_account_tree_hash(accounts.GetRootHash());
+		header->set_validators_hash(bumo::HashWrapper::Crypto(validators));
+		header->set_fees_hash(bumo::HashWrapper::Crypto(fees));
+		source_.values_[utils::String::Format("validators-%s", utils::String::BinToHexString(header->validators_hash()).c_str())] = validators;
+		source_.values_[utils::String::Format("fees-%s", utils::String::BinToHexString(header->fees_hash()).c_str())] = fees;
+	}
+
+	//Stage every node of the source state in the destination, as the download does.
+	void Download(){
+		bumo::StateSyncEntries pending;
+		bumo::StateStage::AddRootEntries(status_.ledger().header(), pending);
+		while (pending.size() > 0){
+			protocol::StateSyncEntry entry = pending.Get(pending.size() - 1);
+			pending.RemoveLast();
+
+			std::string key = bumo::StateStage::EntryKey(entry);
+			std::string value;
+			ASSERT_EQ(1, source_.Get(key, value));
+			ASSERT_TRUE(bumo::StateStage::Expand(entry, value, pending));
+			if (bumo::StateStage::IsRoot(entry)){
+				status_.set_account_root(value);
+			}
+			else{
+				dest_.Put(bumo::StateStage::StagedKey(key), value);
+			}
+		}
+	}
+
+	std::string StagedKeyOf(const std::string &prefix){
+		std::string staged = bumo::StateStage::StagedKey(prefix);
+		auto it = dest_.values_.lower_bound(staged);
+		return it == dest_.values_.end() ? "" : it->first;
+	}
+
+	MemoryDb source_;
+	MemoryDb dest_;
+	protocol::StateSyncStatus status_;
+};
+
+TEST_F(StateSyncTest, UT_Verify_Keeps_Genesis){
+	Download();
+	size_t staged = dest_.StagedCount();
+	EXPECT_GT(staged, (size_t)64);
+
+	EXPECT_TRUE(bumo::StateStage::Verify(&dest_, status_));
+	EXPECT_EQ(staged, dest_.StagedCount());
+	for (auto it = source_.values_.begin(); it != source_.values_.end(); it++){
+		auto found = dest_.values_.find(it->first);
+		if (found != dest_.values_.end()){
+			EXPECT_EQ("genesis", found->second);
+		}
+	}
+}
+
+TEST_F(StateSyncTest, UT_Verify_Rejects_Corrupted_Node){
+	Download();
+	std::string key = StagedKeyOf(bumo::General::ACCOUNT_PREFIX);
+	ASSERT_FALSE(key.empty());
+	dest_.values_[key] += "x";
+	EXPECT_FALSE(bumo::StateStage::Verify(&dest_, status_));
+
+	//A missing node as well.
+	Download();
+	key = StagedKeyOf(bumo::General::METADATA_PREFIX);
+	ASSERT_FALSE(key.empty());
+	dest_.values_.erase(key);
+	EXPECT_FALSE(bumo::StateStage::Verify(&dest_, status_));
+}
+
+TEST_F(StateSyncTest, UT_Discard){
+	Download();
+	bumo::StateStage::Discard(&dest_, status_);
+	EXPECT_EQ((size_t)0, dest_.StagedCount());
+	for (auto it = dest_.values_.begin(); it != dest_.values_.end(); it++){
+		EXPECT_EQ("genesis", it->second);
+	}
+}
+
+TEST_F(StateSyncTest, UT_Apply){
+	//A node of the genesis state matching the checkpoint is not downloaded again.
+	std::string validators_key = utils::String::Format("validators-%s",
+		utils::String::BinToHexString(status_.ledger().header().validators_hash()).c_str());
+	dest_.values_[validators_key] = source_.values_[validators_key];
+	Download();
+	dest_.Delete(bumo::StateStage::StagedKey(validators_key));
+
+	ASSERT_TRUE(bumo::StateStage::Verify(&dest_, status_));
+	bumo::StateStage::Apply(&dest_, status_);
+	EXPECT_EQ((size_t)0, dest_.StagedCount());
+	dest_.Put(bumo::General::ACCOUNT_PREFIX + std::string(1, bumo::Trie::EVEN_PREFIX), status_.account_root());
+
+	for (auto it = source_.values_.begin(); it != source_.values_.end(); it++){
+		EXPECT_EQ(it->second, dest_.values_[it->first]);
+	}
+
+	bumo::KVTrie accounts;
+	accounts.Init(&dest_, std::make_shared<WRITE_BATCH>(), bumo::General::ACCOUNT_PREFIX, 4);
+	accounts.UpdateHash();
+	EXPECT_EQ(status_.ledger().header().account_tree_hash(), accounts.GetRootHash());
+
+	//Applied again after a restart, nothing is left to move.
+	bumo::StateStage::Apply(&dest_, status_);
+	EXPECT_TRUE(bumo::StateStage::Verify(&dest_, status_));
+}
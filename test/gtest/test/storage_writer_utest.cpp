@@ -0,0 +1,255 @@
+#include "gtest/gtest.h"
+#include "utils/logger.h"
+#include "utils/file.h"
+#include "utils/thread.h"
+#include "common/general.h"
+#include "common/storage.h"
+#include "common/private_key.h"
+#include "ledger/kv_trie.h"
+#include "ledger/state_view.h"
+#include "proto/cpp/overlay.pb.h"
+
+//The closed ledgers written by the background storage writer.
+class StorageWriterTest : public testing::Test{
+protected:
+
+	// Sets up the test fixture.
+	virtual void SetUp(){
+		if (utils::Logger::GetInstance() == NULL){
+			utils::Logger::InitInstance();
+			utils::Logger::Instance().Initialize(utils::LOG_DEST_NONE, utils::LOG_LEVEL_NONE, "", false);
+		}
+
+		std::string path = utils::File::GetTempDirectory() + "/storage_writer_test";
+		db_config_.keyvalue_db_path_ = path + "_keyvalue.db";
+		db_config_.ledger_db_path_ = path + "_ledger.db";
+		db_config_.account_db_path_ = path + "_account.db";
+		db_config_.async_commit_ = true;
+		bumo::Storage::InitInstance();
+		ASSERT_TRUE(bumo::Storage::Instance().Initialize(db_config_, true));
+		ASSERT_TRUE(bumo::Storage::Instance().Initialize(db_config_, false));
+	}
+
+	// Tears down the test fixture.
+	virtual void TearDown(){
+		bumo::Storage::Instance().Exit();
+		bumo::Storage::ExitInstance();
+		utils::File::DeleteFolder(db_config_.keyvalue_db_path_);
+		utils::File::DeleteFolder(db_config_.ledger_db_path_);
+		utils::File::DeleteFolder(db_config_.account_db_path_);
+	}
+
+protected:
+	void UT_Pending_Reads();
+	void UT_Pending_Owner();
+	void UT_Rewind_Partial();
+	void UT_Snapshot_View();
+
+	//Write the ledger seq and wait until it is durable.
+	static void WriteLedger(int64_t seq, std::shared_ptr<WRITE_BATCH> ledger_batch, std::shared_ptr<WRITE_BATCH> account_batch);
+	static std::string Read(bumo::KeyValueDb *db, const std::string &key);
+
+	bumo::DbConfigure db_config_;
+};
+
+TEST_F(StorageWriterTest, UT_Pending_Reads){ UT_Pending_Reads(); }
+TEST_F(StorageWriterTest, UT_Pending_Owner){ UT_Pending_Owner(); }
+TEST_F(StorageWriterTest, UT_Rewind_Partial){ UT_Rewind_Partial(); }
+TEST_F(StorageWriterTest, UT_Snapshot_View){ UT_Snapshot_View(); }
+
+void StorageWriterTest::WriteLedger(int64_t seq, std::shared_ptr<WRITE_BATCH> ledger_batch, std::shared_ptr<WRITE_BATCH> account_batch){
+	bumo::StorageWriter &writer = bumo::Storage::Instance().writer();
+	writer.Write(seq, ledger_batch, account_batch);
+	utils::Semaphore written;
+	writer.OnWritten(seq, [&written](){
+		written.Signal();
+	});
+	while (!written.Wait()){
+	}
+}
+
+std::string StorageWriterTest::Read(bumo::KeyValueDb *db, const std::string &key){
+	std::string value;
+	int32_t ret = db->Get(key, value);
+	EXPECT_GE(ret, 0);
+	return ret > 0 ? value : "";
+}
+
+void StorageWriterTest::UT_Pending_Reads(){
+	bumo::StorageWriter &writer = bumo::Storage::Instance().writer();
+	bumo::KeyValueDb *ledger_db = bumo::Storage::Instance().ledger_db();
+	bumo::KeyValueDb *account_db = bumo::Storage::Instance().account_db();
+
+	std::shared_ptr<WRITE_BATCH> ledger_batch = std::make_shared<WRITE_BATCH>();
+	std::shared_ptr<WRITE_BATCH> account_batch = std::make_shared<WRITE_BATCH>();
+	ledger_batch->Put("l", "1");
+	account_batch->Put("a", "1");
+	account_batch->Put("d", "1");
+	WriteLedger(1, ledger_batch, account_batch);
+	EXPECT_EQ(1, writer.written_seq());
+
+	//Stall the writer thread once the ledger 2 is written, so the ledger 3 stays queued.
+	utils::Semaphore entered;
+	utils::Semaphore release;
+	writer.OnWritten(2, [&entered, &release](){
+		entered.Signal();
+		while (!release.Wait()){
+		}
+	});
+	ledger_batch = std::make_shared<WRITE_BATCH>();
+	account_batch = std::make_shared<WRITE_BATCH>();
+	ledger_batch->Put("l", "2");
+	account_batch->Put("a", "2");
+	writer.Write(2, ledger_batch, account_batch);
+	while (!entered.Wait()){
+	}
+
+	ledger_batch = std::make_shared<WRITE_BATCH>();
+	account_batch = std::make_shared<WRITE_BATCH>();
+	ledger_batch->Put("l", "3");
+	account_batch->Put("a", "3");
+	account_batch->Delete("d");
+	writer.Write(3, ledger_batch, account_batch);
+
+	//Before WriteJobs the reads get the pending values, a pending delete as not found.
+	EXPECT_EQ("3", Read(ledger_db, "l"));
+	EXPECT_EQ("3", Read(account_db, "a"));
+	std::string value;
+	EXPECT_EQ(0, account_db->Get("d", value));
+	EXPECT_EQ(2, writer.written_seq());
+
+	//The snapshots hold what is written only.
+	std::unique_ptr<bumo::KeyValueDb> snapshot(account_db->NewSnapshot());
+	ASSERT_TRUE(snapshot != nullptr);
+	EXPECT_EQ("2", Read(snapshot.get(), "a"));
+	EXPECT_EQ("1", Read(snapshot.get(), "d"));
+	snapshot.reset();
+
+	//After WriteJobs the same values are read from the databases.
+	release.Signal();
+	utils::Semaphore written;
+	writer.OnWritten(3, [&written](){
+		written.Signal();
+	});
+	while (!written.Wait()){
+	}
+	EXPECT_EQ(3, writer.written_seq());
+	EXPECT_EQ("3", Read(ledger_db, "l"));
+	EXPECT_EQ("3", Read(account_db, "a"));
+	EXPECT_EQ(0, account_db->Get("d", value));
+
+	snapshot.reset(account_db->NewSnapshot());
+	ASSERT_TRUE(snapshot != nullptr);
+	EXPECT_EQ("3", Read(snapshot.get(), "a"));
+	EXPECT_EQ(0, snapshot->Get("d", value));
+}
+
+void StorageWriterTest::UT_Pending_Owner(){
+	bumo::KeyValueDb *db = bumo::Storage::Instance().keyvalue_db();
+	WRITE_BATCH batch2;
+	batch2.Put("a", "2");
+	batch2.Put("b", "2");
+	db->AddPending(batch2, 2);
+
+	WRITE_BATCH batch3;
+	batch3.Put("a", "3");
+	db->AddPending(batch3, 3);
+	EXPECT_EQ("3", Read(db, "a"));
+	EXPECT_EQ("2", Read(db, "b"));
+
+	//The job 2 written, the value of the job 3 stays pending.
+	db->RemovePending(batch2, 2);
+	EXPECT_EQ("3", Read(db, "a"));
+	std::string value;
+	EXPECT_EQ(0, db->Get("b", value));
+
+	db->RemovePending(batch3, 3);
+	EXPECT_EQ(0, db->Get("a", value));
+}
+
+void StorageWriterTest::UT_Rewind_Partial(){
+	bumo::KeyValueDb *ledger_db = bumo::Storage::Instance().ledger_db();
+
+	//The ledgers 2 and 3 reached the ledger db but not the account db, the ledger 3 has no transaction.
+	WRITE_BATCH batch;
+	for (int64_t seq = 1; seq <= 3; seq++){
+		if (seq < 3){
+			protocol::EntryList list;
+			list.add_entry(utils::String::Format("tx" FMT_I64, seq));
+			batch.Put(bumo::ComposePrefix(bumo::General::LEDGER_TRANSACTION_PREFIX, seq), list.SerializeAsString());
+			batch.Put(bumo::ComposePrefix(bumo::General::TRANSACTION_PREFIX, list.entry(0)), "tx");
+		}
+		batch.Put(bumo::ComposePrefix(bumo::General::LEDGER_PREFIX, seq), "ledger");
+		batch.Put(bumo::ComposePrefix(bumo::General::CONSENSUS_VALUE_PREFIX, seq), "value");
+	}
+	batch.Put(bumo::General::KEY_LEDGER_SEQ, "3");
+	ASSERT_TRUE(ledger_db->WriteBatch(batch));
+
+	ASSERT_TRUE(bumo::StorageWriter::Rewind(ledger_db, 3, 1));
+	EXPECT_EQ("1", Read(ledger_db, bumo::General::KEY_LEDGER_SEQ));
+	EXPECT_EQ("ledger", Read(ledger_db, bumo::ComposePrefix(bumo::General::LEDGER_PREFIX, 1)));
+	EXPECT_EQ("value", Read(ledger_db, bumo::ComposePrefix(bumo::General::CONSENSUS_VALUE_PREFIX, 1)));
+	EXPECT_EQ("tx", Read(ledger_db, bumo::ComposePrefix(bumo::General::TRANSACTION_PREFIX, "tx1")));
+	EXPECT_NE("", Read(ledger_db, bumo::ComposePrefix(bumo::General::LEDGER_TRANSACTION_PREFIX, 1)));
+	for (int64_t seq = 2; seq <= 3; seq++){
+		EXPECT_EQ("", Read(ledger_db, bumo::ComposePrefix(bumo::General::LEDGER_PREFIX, seq)));
+		EXPECT_EQ("", Read(ledger_db, bumo::ComposePrefix(bumo::General::CONSENSUS_VALUE_PREFIX, seq)));
+		EXPECT_EQ("", Read(ledger_db, bumo::ComposePrefix(bumo::General::LEDGER_TRANSACTION_PREFIX, seq)));
+	}
+	EXPECT_EQ("", Read(ledger_db, bumo::ComposePrefix(bumo::General::TRANSACTION_PREFIX, "tx2")));
+}
+
+void StorageWriterTest::UT_Snapshot_View(){
+	bumo::StorageWriter &writer = bumo::Storage::Instance().writer();
+	bumo::PrivateKey key1(bumo::SIGNTYPE_ED25519);
+	bumo::PrivateKey key2(bumo::SIGNTYPE_ED25519);
+	std::string address1 = key1.GetEncAddress();
+	std::string address2 = key2.GetEncAddress();
+
+	//The account tree of the ledger 1, then the ledger 2 changing it.
+	std::shared_ptr<WRITE_BATCH> account_batch = std::make_shared<WRITE_BATCH>();
+	bumo::KVTrie trie;
+	trie.Init(bumo::Storage::Instance().account_db(), account_batch, bumo::General::ACCOUNT_PREFIX, 4);
+	trie.Set(bumo::DecodeAddress(address1), bumo::AccountFrm::CreatAccountFrm(address1, 1)->Serializer());
+	trie.UpdateHash();
+	WriteLedger(1, std::make_shared<WRITE_BATCH>(), account_batch);
+	std::shared_ptr<bumo::StorageSnapshot> snapshot1 = writer.WaitSnapshot(1);
+	ASSERT_TRUE(snapshot1 != nullptr);
+	EXPECT_EQ(1, snapshot1->seq_);
+
+	account_batch = std::make_shared<WRITE_BATCH>();
+	trie.Init(bumo::Storage::Instance().account_db(), account_batch, bumo::General::ACCOUNT_PREFIX, 4);
+	trie.Set(bumo::DecodeAddress(address1), bumo::AccountFrm::CreatAccountFrm(address1, 2)->Serializer());
+	trie.Set(bumo::DecodeAddress(address2), bumo::AccountFrm::CreatAccountFrm(address2, 2)->Serializer());
+	trie.UpdateHash();
+	WriteLedger(2, std::make_shared<WRITE_BATCH>(), account_batch);
+
+	//The view of the ledger 1 does not see the ledger written after it.
+	bumo::StateView view1(snapshot1);
+	EXPECT_EQ(1, view1.seq());
+	bumo::AccountFrm::pointer account;
+	ASSERT_TRUE(view1.GetAccount(address1, account));
+	EXPECT_EQ(1, account->GetAccountBalance());
+	EXPECT_FALSE(view1.GetAccount(address2, account));
+
+	std::shared_ptr<bumo::StorageSnapshot> snapshot2 = writer.snapshot();
+	ASSERT_TRUE(snapshot2 != nullptr);
+	EXPECT_EQ(2, snapshot2->seq_);
+	EXPECT_EQ(snapshot2, writer.WaitSnapshot(1));
+	bumo::StateView view2(snapshot2);
+	ASSERT_TRUE(view2.GetAccount(address1, account));
+	EXPECT_EQ(2, account->GetAccountBalance());
+	ASSERT_TRUE(view2.GetAccount(address2, account));
+	EXPECT_EQ(2, account->GetAccountBalance());
+
+	//An overlay ledger, sealed and not written yet, is read ahead of the snapshot.
+	bumo::StateView::AccountMap overlay;
+	overlay[address2] = bumo::AccountFrm::CreatAccountFrm(address2, 3);
+	view1.SetOverlay(2, overlay);
+	EXPECT_EQ(2, view1.seq());
+	ASSERT_TRUE(view1.GetAccount(address2, account));
+	EXPECT_EQ(3, account->GetAccountBalance());
+	ASSERT_TRUE(view1.GetAccount(address1, account));
+	EXPECT_EQ(1, account->GetAccountBalance());
+	EXPECT_FALSE(view1.ContractRefused());
+}
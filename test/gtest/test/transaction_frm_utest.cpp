@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+#include "utils/strings.h"
+#include "utils/timestamp.h"
+#include "utils/logger.h"
+#include "common/private_key.h"
+#include "ledger/transaction_frm.h"
+#include "ledger/signature_verifier.h"
+
+class TransactionFrmTest : public testing::Test{
+protected:
+
+	// Sets up the test fixture.
+	virtual void SetUp(){
+		if (utils::Logger::GetInstance() == NULL){
+			utils::Logger::InitInstance();
+			utils::Logger::Instance().Initialize(utils::LOG_DEST_NONE, utils::LOG_LEVEL_NONE, "", false);
+		}
+	}
+
+	// Tears down the test fixture.
+	virtual void TearDown(){
+	}
+
+protected:
+	void NewTxset(bumo::PrivateKey &key, int64_t count, protocol::TransactionEnvSet &txset);
+	void UT_Frames_Of_Txset();
+	void UT_Frames_Of_Txset_Benchmark();
+};
+
+TEST_F(TransactionFrmTest, UT_Frames_Of_Txset){ UT_Frames_Of_Txset(); }
+TEST_F(TransactionFrmTest, DISABLED_UT_Frames_Of_Txset_Benchmark){ UT_Frames_Of_Txset_Benchmark(); }
+
+void TransactionFrmTest::NewTxset(bumo::PrivateKey &key, int64_t count, protocol::TransactionEnvSet &txset){
+	for (int64_t i = 0; i < count; i++){
+		protocol::TransactionEnv *env = txset.add_txs();
+		protocol::Transaction *tx = env->mutable_transaction();
+		tx->set_source_address(key.GetEncAddress());
+		tx->set_nonce(i + 1);
+		tx->set_fee_limit(1000000);
+		tx->set_gas_price(1000);
+		protocol::Operation *ope = tx->add_operations();
+		ope->set_type(protocol::Operation_Type_PAY_COIN);
+		ope->mutable_pay_coin()->set_dest_address(key.GetEncAddress());
+		ope->mutable_pay_coin()->set_amount(i);
+
+		protocol::Signature *signature = env->add_signatures();
+		signature->set_public_key(key.GetEncPublicKey());
+		signature->set_sign_data(key.Sign(tx->SerializeAsString()));
+	}
+}
+
+//The frames built one by one, and from the transactions serialized, hashed and verified with the set, are the same.
+void TransactionFrmTest::UT_Frames_Of_Txset(){
+	bumo::PrivateKey key(bumo::SIGNTYPE_ED25519);
+	protocol::TransactionEnvSet txset;
+	NewTxset(key, 100, txset);
+
+	std::vector<bumo::TransactionFrm::pointer> frames;
+	for (int32_t i = 0; i < txset.txs_size(); i++){
+		frames.push_back(std::make_shared<bumo::TransactionFrm>(txset.txs(i)));
+	}
+
+	std::vector<bumo::SignatureVerifier::Verified> verified;
+	bumo::SignatureVerifier(NULL).Verify(txset, verified);
+	std::vector<bumo::TransactionFrm::pointer> set_frames;
+	for (int32_t i = 0; i < txset.txs_size(); i++){
+		set_frames.push_back(std::make_shared<bumo::TransactionFrm>(txset.txs(i), verified[i].data_, verified[i].hash_, verified[i].signers_));
+	}
+
+	protocol::Account account;
+	account.set_address(key.GetEncAddress());
+	account.mutable_priv()->set_master_weight(1);
+	account.mutable_priv()->mutable_thresholds()->set_tx_threshold(1);
+	bumo::AccountFrm::pointer source = std::make_shared<bumo::AccountFrm>(account);
+	for (size_t i = 0; i < frames.size(); i++){
+		EXPECT_EQ(frames[i]->GetContentHash(), set_frames[i]->GetContentHash());
+		EXPECT_EQ(frames[i]->GetContentData(), set_frames[i]->GetContentData());
+		EXPECT_EQ(frames[i]->GetFullData(), set_frames[i]->GetFullData());
+		EXPECT_TRUE(frames[i]->SignerHashPriv(source, protocol::Operation_Type_PAY_COIN));
+		EXPECT_TRUE(set_frames[i]->SignerHashPriv(source, protocol::Operation_Type_PAY_COIN));
+	}
+}
+
+//The time is mostly the serialization, hashing and verification.
+void TransactionFrmTest::UT_Frames_Of_Txset_Benchmark(){
+	bumo::PrivateKey key(bumo::SIGNTYPE_ED25519);
+	protocol::TransactionEnvSet txset;
+	NewTxset(key, 1000, txset);
+
+	int64_t time0 = utils::Timestamp::HighResolution();
+	std::vector<bumo::TransactionFrm::pointer> frames;
+	for (int32_t i = 0; i < txset.txs_size(); i++){
+		frames.push_back(std::make_shared<bumo::TransactionFrm>(txset.txs(i)));
+	}
+	int64_t time1 = utils::Timestamp::HighResolution();
+
+	std::vector<bumo::SignatureVerifier::Verified> verified;
+	bumo::SignatureVerifier(NULL).Verify(txset, verified);
+	std::vector<bumo::TransactionFrm::pointer> set_frames;
+	for (int32_t i = 0; i < txset.txs_size(); i++){
+		set_frames.push_back(std::make_shared<bumo::TransactionFrm>(txset.txs(i), verified[i].data_, verified[i].hash_, verified[i].signers_));
+	}
+	int64_t time2 = utils::Timestamp::HighResolution();
+
+	RecordProperty("one_by_one_us", (int)(time1 - time0));
+	RecordProperty("with_set_us", (int)(time2 - time1));
+}
@@ -0,0 +1,316 @@
+#include "gtest/gtest.h"
+#include "utils/strings.h"
+#include "utils/crypto.h"
+#include "utils/random.h"
+#include "utils/timestamp.h"
+#include "ledger/trie.h"
+
+//Trie kept in memory, so the benchmark only measures hashing.
+class MemoryTrie : public bumo::Trie{
+public:
+	MemoryTrie() :load_count_(0), batch_count_(0){
+		bumo::Location location;
+		location.push_back(0);
+		root_ = bumo::NodeFrm::Create(location);
+	}
+
+	bumo::NodeFrm::POINTER Root(){
+		return root_;
+	}
+
+	//Start over from the stored root, as a node restarting on the same database would.
+	void Reload(){
+		root_ = bumo::NodeFrm::Create(root_->location_);
+		bumo::NodeInfo info;
+		if (storage_load(root_->location_, info)){
+			root_->SetInfo(info);
+		}
+	}
+
+	//Node reads, and the StorageLoadNodes calls among them.
+	int64_t load_count_;
+	int64_t batch_count_;
+
+protected:
+	virtual bool storage_load(const bumo::Location& location, bumo::NodeInfo& info){
+		utils::MutexGuard guard(mutex_);
+		load_count_++;
+		auto it = nodes_.find(location);
+		if (it == nodes_.end()){
+			return false;
+		}
+		return info.Parse(it->second);
+	}
+
+	virtual void StorageLoadNodes(const std::vector<bumo::Location>& locations, std::vector<bumo::NodeInfo>& infos, std::vector<bool>& found){
+		bumo::Trie::StorageLoadNodes(locations, infos, found);
+		utils::MutexGuard guard(mutex_);
+		batch_count_++;
+	}
+
+	virtual void StorageSaveNode(bumo::NodeFrm::POINTER node){
+		std::string buff = node->info_.Serialize();
+		utils::MutexGuard guard(mutex_);
+		nodes_[node->location_] = buff;
+	}
+
+	virtual void StorageSaveLeaf(bumo::NodeFrm::POINTER node){
+		utils::MutexGuard guard(mutex_);
+		leaves_[node->location_] = *node->leaf_;
+	}
+
+	virtual void StorageDeleteNode(bumo::NodeFrm::POINTER node){
+		utils::MutexGuard guard(mutex_);
+		nodes_.erase(node->location_);
+	}
+
+	virtual void StorageDeleteLeaf(bumo::NodeFrm::POINTER node){
+		utils::MutexGuard guard(mutex_);
+		leaves_.erase(node->location_);
+	}
+
+	virtual bool StorageGetLeaf(const bumo::Location& location, std::string& value){
+		utils::MutexGuard guard(mutex_);
+		auto it = leaves_.find(location);
+		if (it == leaves_.end()){
+			return false;
+		}
+		value = it->second;
+		return true;
+	}
+
+	virtual std::string HashCrypto(const std::string& input){
+		return utils::Sha256::Crypto(input);
+	}
+
+private:
+	utils::Mutex mutex_;
+	std::map<bumo::Location, std::string> nodes_;
+	std::map<bumo::Location, std::string> leaves_;
+};
+
+class TrieHashTest : public testing::Test{
+protected:
+
+	// Sets up the test fixture.
+	virtual void SetUp(){
+		pool_.Init("trie-test", 8);
+	}
+
+	// Tears down the test fixture.
+	virtual void TearDown(){
+		pool_.Exit();
+	}
+
+	utils::ThreadPool pool_;
+
+protected:
+	void UT_Parallel_Hash_Identical();
+	void UT_Parallel_Hash_Benchmark();
+	void CompareHash(size_t key_count);
+};
+
+TEST_F(TrieHashTest, UT_Parallel_Hash_Identical){ UT_Parallel_Hash_Identical(); }
+TEST_F(TrieHashTest, DISABLED_UT_Parallel_Hash_Benchmark){ UT_Parallel_Hash_Benchmark(); }
+
+void TrieHashTest::CompareHash(size_t key_count){
+	MemoryTrie serial_trie;
+	MemoryTrie parallel_trie;
+	parallel_trie.SetHashPool(&pool_);
+
+	for (size_t i = 0; i < key_count; i++){
+		std::string key = utils::Sha256::Crypto(utils::String::ToString((int64_t)i)).substr(0, 20);
+		std::string value = utils::String::Format("value-" FMT_SIZE, i);
+		serial_trie.Set(key, value);
+		parallel_trie.Set(key, value);
+	}
+
+	int64_t time0 = utils::Timestamp::HighResolution();
+	serial_trie.UpdateHash();
+	int64_t time1 = utils::Timestamp::HighResolution();
+	parallel_trie.UpdateHash();
+	int64_t time2 = utils::Timestamp::HighResolution();
+
+	EXPECT_EQ(serial_trie.GetRootHash(), parallel_trie.GetRootHash());
+	RecordProperty(utils::String::Format("serial_hash_us_" FMT_SIZE, key_count), (int)(time1 - time0));
+	RecordProperty(utils::String::Format("parallel_hash_us_" FMT_SIZE, key_count), (int)(time2 - time1));
+
+	//Modify a part of the keys again, so only some subtrees are dirty.
+	for (size_t i = 0; i < key_count; i += 7){
+		std::string key = utils::Sha256::Crypto(utils::String::ToString((int64_t)i)).substr(0, 20);
+		if (i % 2 == 0){
+			serial_trie.Delete(key);
+			parallel_trie.Delete(key);
+		}
+		else{
+			serial_trie.Set(key, "modified");
+			parallel_trie.Set(key, "modified");
+		}
+	}
+	serial_trie.UpdateHash();
+	parallel_trie.UpdateHash();
+	EXPECT_EQ(serial_trie.GetRootHash(), parallel_trie.GetRootHash());
+}
+
+void TrieHashTest::UT_Parallel_Hash_Identical(){
+	CompareHash(0);
+	CompareHash(1);
+	CompareHash(17);
+	CompareHash(1000);
+}
+
+void TrieHashTest::UT_Parallel_Hash_Benchmark(){
+	CompareHash(10000);
+	CompareHash(100000);
+	CompareHash(1000000);
+}
+
+class TrieNodeTest : public testing::Test{
+protected:
+
+	// Sets up the test fixture.
+	virtual void SetUp(){
+	}
+
+	// Tears down the test fixture.
+	virtual void TearDown(){
+	}
+
+protected:
+	void UT_Node_Serialize();
+	void UT_Memory_Benchmark();
+	void UT_Batch_Get();
+	void MemoryUsage(bumo::NodeFrm::POINTER node, int64_t& node_count, int64_t& compact_size, int64_t& proto_size);
+};
+
+TEST_F(TrieNodeTest, UT_Node_Serialize){ UT_Node_Serialize(); }
+TEST_F(TrieNodeTest, DISABLED_UT_Memory_Benchmark){ UT_Memory_Benchmark(); }
+TEST_F(TrieNodeTest, UT_Batch_Get){ UT_Batch_Get(); }
+
+void TrieNodeTest::UT_Node_Serialize(){
+	for (int n = 0; n < 1000; n++){
+		protocol::Node node;
+		for (int i = 0; i < bumo::NodeInfo::BRANCH_COUNT; i++){
+			protocol::Child* child = node.add_children();
+			int64_t r = rand() % 4;
+			if (r == 0){
+				continue;
+			}
+			child->set_sublocation(utils::Sha256::Crypto(utils::String::ToString(r * n + i)).substr(0, (size_t)(n % 30 + 1)));
+			child->set_childtype(r == 1 ? protocol::LEAF : protocol::INNER);
+			if (r != 3){
+				child->set_hash(utils::Sha256::Crypto(child->sublocation()));
+			}
+		}
+
+		bumo::NodeInfo info;
+		info.FromProto(node);
+		std::string buff = info.Serialize();
+		EXPECT_EQ(node.SerializeAsString(), buff);
+
+		bumo::NodeInfo parsed;
+		EXPECT_TRUE(parsed.Parse(buff));
+		EXPECT_EQ(buff, parsed.Serialize());
+
+		protocol::Node back;
+		parsed.ToProto(back);
+		EXPECT_EQ(node.SerializeAsString(), back.SerializeAsString());
+	}
+}
+
+void TrieNodeTest::MemoryUsage(bumo::NodeFrm::POINTER node, int64_t& node_count, int64_t& compact_size, int64_t& proto_size){
+	const int64_t control_block = 2 * sizeof(void*);
+	const int64_t location_heap = node->location_.capacity() > 15 ? node->location_.capacity() + 1 : 0;
+
+	node_count++;
+	compact_size += control_block + sizeof(bumo::NodeFrm) - sizeof(bumo::NodeInfo) + location_heap
+		+ node->info_.MemorySize() + node->children_.capacity() * sizeof(bumo::NodeFrm::POINTER);
+
+	//The former layout: 16 child pointers, a shared leaf pointer and a protocol::Node with 17 children.
+	protocol::Node info;
+	node->info_.ToProto(info);
+	proto_size += control_block + sizeof(bumo::Location) + location_heap + 16 * sizeof(bumo::NodeFrm::POINTER)
+		+ sizeof(std::shared_ptr<std::string>) + 2 * sizeof(bool) + info.SpaceUsed();
+
+	for (size_t i = 0; i < node->children_.size(); i++){
+		if (node->children_[i] != nullptr){
+			MemoryUsage(node->children_[i], node_count, compact_size, proto_size);
+		}
+	}
+}
+
+void TrieNodeTest::UT_Memory_Benchmark(){
+	const size_t account_count = 1000000;
+	MemoryTrie trie;
+	for (size_t i = 0; i < account_count; i++){
+		std::string address = utils::Sha256::Crypto(utils::String::ToString((int64_t)i)).substr(0, 20);
+		trie.Set(address, utils::String::Format("account-" FMT_SIZE, i));
+	}
+	trie.UpdateHash();
+	std::string root_hash = trie.GetRootHash();
+
+	//Load the whole tree back from the stored nodes.
+	trie.Reload();
+	int64_t time0 = utils::Timestamp::HighResolution();
+	for (size_t i = 0; i < account_count; i++){
+		std::string address = utils::Sha256::Crypto(utils::String::ToString((int64_t)i)).substr(0, 20);
+		std::string value;
+		EXPECT_TRUE(trie.Get(address, value));
+	}
+	int64_t time1 = utils::Timestamp::HighResolution();
+
+	int64_t node_count = 0, compact_size = 0, proto_size = 0;
+	MemoryUsage(trie.Root(), node_count, compact_size, proto_size);
+	RecordProperty("node_count", (int)node_count);
+	RecordProperty("load_ms", (int)((time1 - time0) / utils::MICRO_UNITS_PER_MILLI));
+	RecordProperty("compact_bytes_per_node", (int)(compact_size / node_count));
+	RecordProperty("protobuf_bytes_per_node", (int)(proto_size / node_count));
+
+	trie.UpdateHash();
+	EXPECT_EQ(root_hash, trie.GetRootHash());
+}
+
+void TrieNodeTest::UT_Batch_Get(){
+	const size_t account_count = 100000;
+	MemoryTrie trie;
+	for (size_t i = 0; i < account_count; i++){
+		std::string address = utils::Sha256::Crypto(utils::String::ToString((int64_t)i)).substr(0, 20);
+		trie.Set(address, utils::String::Format("account-" FMT_SIZE, i));
+	}
+	trie.UpdateHash();
+
+	//Every 50th account, and some that do not exist.
+	std::vector<std::string> keys;
+	for (size_t i = 0; i < account_count + 1000; i += 50){
+		keys.push_back(utils::Sha256::Crypto(utils::String::ToString((int64_t)i)).substr(0, 20));
+	}
+
+	trie.Reload();
+	trie.load_count_ = 0;
+	for (size_t i = 0; i < keys.size(); i++){
+		std::string value;
+		trie.Get(keys[i], value);
+	}
+	int64_t point_loads = trie.load_count_;
+
+	trie.Reload();
+	trie.load_count_ = 0;
+	trie.batch_count_ = 0;
+	std::vector<std::string> values;
+	std::vector<bool> found;
+	trie.GetBatch(keys, values, found);
+	RecordProperty("point_loads", (int)point_loads);
+	RecordProperty("batch_count", (int)trie.batch_count_);
+	EXPECT_EQ(point_loads, trie.load_count_);
+	EXPECT_LT(trie.batch_count_, 10);
+
+	ASSERT_EQ(keys.size(), values.size());
+	for (size_t i = 0; i < keys.size(); i++){
+		std::string value;
+		bool exists = trie.Get(keys[i], value);
+		EXPECT_EQ(exists, (bool)found[i]);
+		EXPECT_EQ(i * 50 < account_count, (bool)found[i]);
+		EXPECT_EQ(value, values[i]);
+	}
+	EXPECT_EQ(point_loads, trie.load_count_);
+}